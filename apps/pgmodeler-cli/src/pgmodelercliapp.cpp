@@ -18,6 +18,8 @@
 
 #include "pgmodelercliapp.h"
 #include "utilsns.h"
+#include <QSaveFile>
+#include <QTemporaryFile>
 #include "settings/appearanceconfigwidget.h"
 
 QTextStream PgModelerCliApp::out(stdout);
@@ -73,6 +75,9 @@ const QString PgModelerCliApp::DebugMode("--debug-mode");
 const QString PgModelerCliApp::FilterObjects("--filter-objects");
 const QString PgModelerCliApp::MatchByName("--match-by-name");
 const QString PgModelerCliApp::ForceChildren("--force-children");
+const QString PgModelerCliApp::CatalogConns("--catalog-conns");
+const QString PgModelerCliApp::RecordCatalog("--record-catalog");
+const QString PgModelerCliApp::ReplayCatalog("--replay-catalog");
 const QString PgModelerCliApp::OnlyMatching("--only-matching");
 const QString PgModelerCliApp::PartialDiff("--partial");
 const QString PgModelerCliApp::Force("--force");
@@ -91,6 +96,8 @@ const QString PgModelerCliApp::NoSequenceReuse("--no-sequence-reuse");
 const QString PgModelerCliApp::NoCascadeDrop("--no-cascade");
 const QString PgModelerCliApp::ForceRecreateObjs("--force-recreate-objs");
 const QString PgModelerCliApp::OnlyUnmodifiable("--only-unmodifiable");
+const QString PgModelerCliApp::ParallelDiff("--parallel-diff");
+const QString PgModelerCliApp::UseSnapshot("--use-snapshot");
 const QString PgModelerCliApp::CreateConfigs("--create-configs");
 const QString PgModelerCliApp::MissingOnly("--missing-only");
 
@@ -123,7 +130,9 @@ attribs_map PgModelerCliApp::short_opts = {
 	{ NoSequenceReuse, "-ns" },	{ NoCascadeDrop, "-nd" },	{ ForceRecreateObjs, "-nf" },
 	{ OnlyUnmodifiable, "-nu" },	{ NoIndex, "-ni" },	{ Split, "-sp" },
 	{ SystemWide, "-sw" },	{ CreateConfigs, "-cc" }, { Force, "-ff" },
-	{ MissingOnly, "-mo" }, { DependenciesSql, "-ds" }, { ChildrenSql, "-cs" }
+	{ MissingOnly, "-mo" }, { DependenciesSql, "-ds" }, { ChildrenSql, "-cs" },
+	{ ParallelDiff, "-pc" }, { UseSnapshot, "-us" }, { CatalogConns, "-cn" },
+	{ RecordCatalog, "-rc" }, { ReplayCatalog, "-rp" }
 };
 
 std::map<QString, bool> PgModelerCliApp::long_opts = {
@@ -148,7 +157,9 @@ std::map<QString, bool> PgModelerCliApp::long_opts = {
 	{ ForceRecreateObjs, false },	{ OnlyUnmodifiable, false },	{ ExportToDict, false },
 	{ NoIndex, false },	{ Split, false },	{ SystemWide, false },
 	{ CreateConfigs, false }, { Force, false }, { MissingOnly, false },
-	{ DependenciesSql, false }, { ChildrenSql, false }
+	{ DependenciesSql, false }, { ChildrenSql, false }, { ParallelDiff, false },
+	{ UseSnapshot, false }, { CatalogConns, true },
+	{ RecordCatalog, true }, { ReplayCatalog, true }
 };
 
 std::map<QString, QStringList> PgModelerCliApp::accepted_opts = {
@@ -162,13 +173,13 @@ std::map<QString, QStringList> PgModelerCliApp::accepted_opts = {
 											 DropDatabase, DropObjects, Simulate, UseTmpNames }},
 
 	{{ ImportDb }, { InputDb, Output, IgnoreImportErrors, ImportSystemObjs, ImportExtensionObjs,
-									 FilterObjects, OnlyMatching, MatchByName, ForceChildren, DebugMode, ConnAlias,
-									 Host, Port, User, Passwd, InitialDb }},
+									 FilterObjects, OnlyMatching, MatchByName, ForceChildren, DebugMode, CatalogConns,
+									 RecordCatalog, ReplayCatalog, ConnAlias, Host, Port, User, Passwd, InitialDb }},
 
 	{{ Diff }, { Input, PgSqlVer, IgnoreDuplicates, IgnoreErrorCodes, CompareTo, PartialDiff, Force,
 							 StartDate, EndDate, SaveDiff, ApplyDiff, NoDiffPreview, DropClusterObjs, RevokePermissions,
 							 DropMissingObjs, ForceDropColsConstrs, RenameDb, NoCascadeDrop,
-							 NoSequenceReuse, ForceRecreateObjs, OnlyUnmodifiable }},
+							 NoSequenceReuse, ForceRecreateObjs, OnlyUnmodifiable, ParallelDiff, UseSnapshot }},
 
 	{{ DbmMimeType }, { SystemWide, Force }},
 	{{ FixModel },	{ Input, Output, FixTries }},
@@ -469,6 +480,9 @@ void PgModelerCliApp::showMenu()
 	printText(tr("  %1, %2\t\t    Makes the objects matching to be performed over their names instead of their signature ([schema].[name]).").arg(short_opts[MatchByName]).arg(MatchByName));
 	printText(tr("  %1, %2 [OBJECTS]   Forces the importing of children objects related to tables/views/foreign tables matched by the filter(s). The OBJECTS is a comma separated list types.").arg(short_opts[ForceChildren]).arg(ForceChildren));
 	printText(tr("  %1, %2\t\t    Runs the import in debug mode printing all queries executed in the server.").arg(short_opts[DebugMode]).arg(DebugMode));
+	printText(tr("  %1, %2 [NUMBER]\t    Amount of connections (1-%3) used to retrieve the objects from the catalog concurrently. All connections share the same transaction snapshot.").arg(short_opts[CatalogConns]).arg(CatalogConns).arg(DatabaseImportHelper::MaxCatalogConnections));
+	printText(tr("  %1, %2 [FILE]    Records the results of all catalog queries in the provided file so the operation can be reproduced later without a server.").arg(short_opts[RecordCatalog]).arg(RecordCatalog));
+	printText(tr("  %1, %2 [FILE]    Replays a catalog recording instead of querying the server. No command is sent to the server, so the options and objects must match the recorded ones.").arg(short_opts[ReplayCatalog]).arg(ReplayCatalog));
 	printText();
 
 	printText(tr("Diff options: "));
@@ -489,6 +503,8 @@ void PgModelerCliApp::showMenu()
 	printText(tr("  %1, %2\t    Don't reuse sequences on serial columns. Drop the old sequence assigned to a serial column and creates a new one.").arg(short_opts[NoSequenceReuse]).arg(NoSequenceReuse));
 	printText(tr("  %1, %2\t    Forces recreating the objects. Instead of an ALTER command, the DROP and CREATE commands are used to create new versions of the objects.").arg(short_opts[ForceRecreateObjs]).arg(ForceRecreateObjs));
 	printText(tr("  %1, %2\t    Recreates only the unmodifiable objects. These objects are the ones that can't be changed via ALTER command.").arg(short_opts[OnlyUnmodifiable]).arg(OnlyUnmodifiable));
+	printText(tr("  %1, %2\t\t    Compares the objects' code using multiple threads. The generated diff is the same as the one produced by the sequential comparison.").arg(short_opts[ParallelDiff]).arg(ParallelDiff));
+	printText(tr("  %1, %2\t\t    Saves the imported databases as snapshots and reuses them in the next diffs while the databases' catalogs remain unchanged.").arg(short_opts[UseSnapshot]).arg(UseSnapshot));
 	printText();
 
 	printText(tr("Model fix options: ") );
@@ -690,6 +706,15 @@ void PgModelerCliApp::parseOptions(attribs_map &opts)
 		if(upd_mime && opts[DbmMimeType]!=Install && opts[DbmMimeType]!=Uninstall)
 			throw Exception(tr("Invalid action specified to mime type update option!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+		if(opts.count(RecordCatalog) && opts.count(ReplayCatalog))
+			throw Exception(tr("The options `%1' and `%2' can't be used at the same time!").arg(RecordCatalog, ReplayCatalog), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		/* When replaying a catalog recording no command is sent to the server,
+		 * so operations that run DDL on the database can't be performed */
+		if(opts.count(ReplayCatalog) && (opts.count(ApplyDiff) || opts.count(ExportToDbms)))
+			throw Exception(tr("The option `%1' can't be used together with `%2' since no command is sent to the server when replaying a catalog recording!")
+											.arg(ReplayCatalog, opts.count(ApplyDiff) ? ApplyDiff : ExportToDbms), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
 		if(create_configs && opts.count(Force) && opts.count(MissingOnly))
 			throw Exception(tr("The options `%1' and `%2' can't be used together when handling configuration files!").arg(Force).arg(MissingOnly), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
@@ -823,6 +848,11 @@ int PgModelerCliApp::exec()
 		{
 			showVersionInfo();
 
+			if(parsed_opts.count(RecordCatalog))
+				Connection::startRecording(parsed_opts[RecordCatalog]);
+			else if(parsed_opts.count(ReplayCatalog))
+				Connection::startReplay(parsed_opts[ReplayCatalog]);
+
 			if(parsed_opts.count(ListConns))
 				 listConnections();
 			else if(parsed_opts.count(FixModel))
@@ -837,12 +867,23 @@ int PgModelerCliApp::exec()
 				diffModelDatabase();
 			else
 				exportModel();
+
+			// Writes the catalog recording file (if any)
+			Connection::stopRecording();
 		}
 
 		return 0;
 	}
 	catch(Exception &e)
 	{
+		/* Stops the recording/replaying even on failures so the catalog results
+		 * gathered so far are written and the connections leave the replay mode */
+		try
+		{
+			Connection::stopRecording();
+		}
+		catch(Exception &){}
+
 		throw e;
 	}
 }
@@ -1882,6 +1923,10 @@ void PgModelerCliApp::importDatabase(DatabaseModel *model, Connection conn)
 																 parsed_opts.count(IgnoreImportErrors) > 0,
 																 parsed_opts.count(DebugMode) > 0,
 																 !parsed_opts.count(Diff), !parsed_opts.count(Diff));
+		import_hlp->setUseSnapshot(parsed_opts.count(Diff) && parsed_opts.count(UseSnapshot));
+
+		if(parsed_opts.count(CatalogConns))
+			import_hlp->setCatalogConnections(parsed_opts[CatalogConns].toUInt());
 
 		model->createSystemObjects(true);
 		import_hlp->setSelectedOIDs(model, obj_oids, col_oids);
@@ -1973,6 +2018,7 @@ void PgModelerCliApp::diffModelDatabase()
 	diff_hlp->setDiffOption(ModelsDiffHelper::OptPreserveDbName, !parsed_opts.count(RenameDb));
 	diff_hlp->setDiffOption(ModelsDiffHelper::OptDontDropMissingObjs, !parsed_opts.count(DropMissingObjs));
 	diff_hlp->setDiffOption(ModelsDiffHelper::OptDropMissingColsConstr, !parsed_opts.count(ForceDropColsConstrs));
+	diff_hlp->setDiffOption(ModelsDiffHelper::OptParallelComparison, parsed_opts.count(ParallelDiff));
 
 	if(!parsed_opts[PgSqlVer].isEmpty())
 		diff_hlp->setPgSQLVersion(parsed_opts[PgSqlVer]);
@@ -1983,17 +2029,53 @@ void PgModelerCliApp::diffModelDatabase()
 		extra_connection.close();
 	}
 
+	/* The diff code is written straight to the output file when saving it, or to a temporary file
+	 * that is then used to preview and apply the diff, avoiding to hold very large scripts in memory */
+	QSaveFile diff_out_file;
+	QTemporaryFile diff_tmp_file;
+
+	if(parsed_opts.count(SaveDiff))
+	{
+		diff_out_file.setFileName(parsed_opts[Output]);
+
+		if(!diff_out_file.open(QIODevice::WriteOnly))
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(parsed_opts[Output]),
+											ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		diff_hlp->setDiffOutput(&diff_out_file);
+	}
+	else
+	{
+		diff_tmp_file.setFileTemplate(GlobalAttributes::getTemporaryFilePath(QString("diff_XXXXXX.sql")));
+
+		if(!diff_tmp_file.open())
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(diff_tmp_file.fileTemplate()),
+											ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		diff_hlp->setDiffOutput(&diff_tmp_file);
+	}
+
 	printMessage(tr("Comparing the generated models..."));
 	diff_hlp->diffModels();
+	diff_hlp->setDiffOutput(nullptr);
+
+	if(!diff_hlp->hasDiffCode())
+	{
+		//Discards the output so an existing file is kept untouched
+		if(diff_out_file.isOpen())
+			diff_out_file.cancelWriting();
 
-	if(diff_hlp->getDiffDefinition().isEmpty())
 		printMessage(tr("No differences were detected."));
+	}
 	else
 	{
 		if(parsed_opts.count(SaveDiff))
 		{
 			printMessage(tr("Saving diff to file `%1'").arg(parsed_opts[Output]));
-			UtilsNs::saveFile(parsed_opts[Output], diff_hlp->getDiffDefinition().toUtf8());
+
+			if(!diff_out_file.commit())
+				throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(parsed_opts[Output]),
+												ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 		}
 		else
 		{
@@ -2001,21 +2083,24 @@ void PgModelerCliApp::diffModelDatabase()
 
 			if(!parsed_opts.count(NoDiffPreview))
 			{
-				QString res, buff, line;
-				QTextStream in(stdin), preview;
+				QString res, line;
+				QTextStream in(stdin), preview(&diff_tmp_file);
 
-				buff += "\n** Press ENTER to scroll the preview **\n";
-				buff += "\n### DIFF PREVIEW ###\n\n";
-				buff += diff_hlp->getDiffDefinition();
-				buff += "\n### END OF PREVIEW  ###\n\n";
+				diff_tmp_file.flush();
+				diff_tmp_file.seek(0);
 
-				preview.setString(&buff, QIODevice::ReadOnly);
+				res += "\n** Press ENTER to scroll the preview **\n";
+				res += "\n### DIFF PREVIEW ###\n\n";
 
+				//The preview is paged directly from the diff file, 30 lines at a time
 				while(!preview.atEnd())
 				{
 					line = preview.readLine();
 					res.append(line + '\n');
 
+					if(preview.atEnd())
+						res += "\n### END OF PREVIEW  ###\n\n";
+
 					if(res.count(QChar('\n')) >= 30 || preview.atEnd())
 					{
 						out << res;
@@ -2050,9 +2135,9 @@ void PgModelerCliApp::diffModelDatabase()
 			if(apply_diff)
 			{
 				printMessage(tr("Applying diff to the database `%1'...").arg(dbname));
-				export_hlp->setExportToDBMSParams(diff_hlp->getDiffDefinition(),
-												 &extra_connection,
-												 parsed_opts[CompareTo], parsed_opts.count(IgnoreDuplicates));
+				export_hlp->setExportToDBMSParams(&diff_tmp_file,
+																 &extra_connection,
+																 parsed_opts[CompareTo], parsed_opts.count(IgnoreDuplicates));
 
 				if(parsed_opts.count(IgnoreErrorCodes))
 					export_hlp->setIgnoredErrors(parsed_opts[IgnoreErrorCodes].split(','));
@@ -176,6 +176,9 @@ class PgModelerCliApp: public Application {
 		MatchByName,
 		ForceChildren,
 		AllChildren,
+		CatalogConns,
+		RecordCatalog,
+		ReplayCatalog,
 
 		PartialDiff,
 		Force,
@@ -194,6 +197,8 @@ class PgModelerCliApp: public Application {
 		NoCascadeDrop,
 		ForceRecreateObjs,
 		OnlyUnmodifiable,
+		ParallelDiff,
+		UseSnapshot,
 
 		CreateConfigs,
 		MissingOnly,
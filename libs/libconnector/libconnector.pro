@@ -10,11 +10,17 @@ DEFINES += CONNECTOR_SYMBOLS
 HEADERS += src/connectorglobal.h \
 	   src/resultset.h \
 	   src/connection.h \
-	   src/catalog.h
+	   src/catalog.h \
+	   src/catalogrecorder.h \
+	   src/asynccommand.h \
+	   src/connectionpool.h
 
 SOURCES += src/resultset.cpp \
 	   src/connection.cpp \
-	   src/catalog.cpp
+	   src/catalog.cpp \
+	   src/catalogrecorder.cpp \
+	   src/asynccommand.cpp \
+	   src/connectionpool.cpp
 
 unix|windows: LIBS += $$PGSQL_LIB \
 		      $$LIBCORE_LIB \
@@ -0,0 +1,608 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "asynccommand.h"
+#include <QTextStream>
+
+// The timer is a child of the command so it's moved together when the command is moved to another thread
+AsyncCommand::AsyncCommand(Connection &conn, QObject *parent) : QObject(parent), timeout_timer(this)
+{
+	connection = &conn;
+	status = NotStarted;
+	read_notifier = write_notifier = nullptr;
+	timeout = 0;
+	cancel_requested = timed_out = false;
+	last_result = nullptr;
+	rows_batch_size = fetched_rows = 0;
+	fetch_paused = false;
+	rows_batch = nullptr;
+	send_time = first_byte_time = last_byte_time = -1;
+	received_bytes = 0;
+
+	timeout_timer.setSingleShot(true);
+	connect(&timeout_timer, &QTimer::timeout, this, &AsyncCommand::handleTimeout);
+}
+
+AsyncCommand::~AsyncCommand()
+{
+	if(status == Running && !connection->replay_conn)
+	{
+		PGresult *res = nullptr;
+
+		/* The connection can't be used for other commands while it's still busy,
+		 * so the running command is cancelled and its remaining results are discarded */
+		stopWatching();
+		connection->requestCancel();
+
+		while((res = PQgetResult(connection->connection)))
+			PQclear(res);
+	}
+
+	if(last_result)
+		PQclear(last_result);
+
+	if(rows_batch)
+		PQclear(rows_batch);
+}
+
+void AsyncCommand::start(const QString &sql, unsigned timeout_ms)
+{
+	if(status == Running)
+		throw Exception(ErrorCode::AsyncCommandRunning, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	if(!connection->isStablished())
+		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	try
+	{
+		connection->validateConnectionStatus();
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+	}
+
+	Connection::clearNotices();
+	result.clearResultSet();
+	error = Exception();
+	command = sql;
+	timeout = timeout_ms;
+	cancel_requested = timed_out = false;
+	fetched_rows = 0;
+	fetch_paused = false;
+	send_time = first_byte_time = last_byte_time = -1;
+	received_bytes = 0;
+	exec_timer.start();
+
+	if(last_result)
+	{
+		PQclear(last_result);
+		last_result = nullptr;
+	}
+
+	if(rows_batch)
+	{
+		PQclear(rows_batch);
+		rows_batch = nullptr;
+	}
+
+	/* When replaying a catalog recording there's no server to wait for, so the recorded result
+	 * is delivered in the next event loop iteration keeping the asynchronous behavior */
+	if(connection->replay_conn)
+	{
+		status = Running;
+		send_time = 0;
+
+		QTimer::singleShot(0, this, [this](){
+			if(status != Running)
+				return;
+
+			// The command was cancelled before the recorded result was delivered
+			if(cancel_requested)
+			{
+				finishCommand();
+				return;
+			}
+
+			try
+			{
+				storeResult(Connection::recorder.createResult(connection->connection_params[Connection::ParamDbName], command));
+				finishCommand();
+			}
+			catch(Exception &e)
+			{
+				failCommand(Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e));
+			}
+		});
+
+		return;
+	}
+
+	PGconn *pg_conn = connection->connection;
+
+	// The SQL tool runs database level commands through this method so the pooled sessions must be released as well
+	connection->releaseDatabaseSessions(sql);
+	PQsetnonblocking(pg_conn, 1);
+
+	if(!PQsendQuery(pg_conn, sql.toStdString().c_str()))
+	{
+		QString err_msg = PQerrorMessage(pg_conn);
+
+		PQsetnonblocking(pg_conn, 0);
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted).arg(err_msg),
+										ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	}
+
+	/* In streaming mode the rows are retrieved in chunks (or one by one in older libpq versions).
+	 * This must be configured right after sending the command and before collecting any result */
+	if(rows_batch_size > 0)
+	{
+#ifdef LIBPQ_HAS_CHUNK_MODE
+		PQsetChunkedRowsMode(pg_conn, rows_batch_size);
+#else
+		PQsetSingleRowMode(pg_conn);
+#endif
+	}
+
+	status = Running;
+
+	read_notifier = new QSocketNotifier(PQsocket(pg_conn), QSocketNotifier::Read, this);
+	connect(read_notifier, &QSocketNotifier::activated, this, &AsyncCommand::readResults);
+
+	write_notifier = new QSocketNotifier(PQsocket(pg_conn), QSocketNotifier::Write, this);
+	write_notifier->setEnabled(false);
+	connect(write_notifier, &QSocketNotifier::activated, this, &AsyncCommand::flushCommand);
+
+	if(timeout > 0)
+		timeout_timer.start(timeout);
+
+	// Large commands may not be sent at once, in that case the remaining data is sent when the socket is writable
+	flushCommand();
+}
+
+void AsyncCommand::flushCommand()
+{
+	if(status != Running)
+		return;
+
+	int ret = PQflush(connection->connection);
+
+	if(ret < 0)
+	{
+		failCommand(Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+													.arg(PQerrorMessage(connection->connection)),
+													ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__));
+		return;
+	}
+
+	// Zero means that all the command data was sent to the server
+	if(ret == 0 && send_time < 0)
+		send_time = exec_timer.nsecsElapsed() / 1000;
+
+	write_notifier->setEnabled(ret == 1);
+}
+
+void AsyncCommand::readResults()
+{
+	if(status != Running || fetch_paused)
+		return;
+
+	PGconn *pg_conn = connection->connection;
+	PGresult *res = nullptr;
+	ExecStatusType res_status;
+
+	if(first_byte_time < 0)
+		first_byte_time = exec_timer.nsecsElapsed() / 1000;
+
+	if(!PQconsumeInput(pg_conn))
+	{
+		failCommand(Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+													.arg(PQerrorMessage(pg_conn)),
+													ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__));
+		return;
+	}
+
+	while(!fetch_paused && !PQisBusy(pg_conn))
+	{
+		res = PQgetResult(pg_conn);
+
+		// A null result indicates that all the results of the command were received
+		if(!res)
+		{
+			finishCommand();
+			return;
+		}
+
+		res_status = PQresultStatus(res);
+
+		// In streaming mode the rows are delivered as they arrive instead of being stored
+		if(res_status == PGRES_SINGLE_TUPLE
+#ifdef LIBPQ_HAS_CHUNK_MODE
+			 || res_status == PGRES_TUPLES_CHUNK
+#endif
+			 )
+		{
+			if(!appendRows(res))
+				return;
+
+			continue;
+		}
+
+		// The last result of a streamed query holds no rows, so the remaining ones are delivered before it
+		deliverRows();
+		storeResult(res);
+
+		// Like PQexec() the COPY results are returned right away leaving the connection in COPY state
+		if(res_status == PGRES_COPY_IN || res_status == PGRES_COPY_OUT || res_status == PGRES_COPY_BOTH)
+		{
+			finishCommand();
+			return;
+		}
+	}
+}
+
+void AsyncCommand::handleTimeout()
+{
+	if(status != Running)
+		return;
+
+	timed_out = true;
+	cancel();
+}
+
+void AsyncCommand::cancel()
+{
+	if(status != Running || cancel_requested)
+		return;
+
+	cancel_requested = true;
+
+	// The error generated by the cancellation is only received if the rows are being read
+	resumeFetching();
+
+	try
+	{
+		connection->requestCancel();
+	}
+	catch(Exception &e)
+	{
+		failCommand(Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e));
+	}
+}
+
+bool AsyncCommand::appendRows(PGresult *res)
+{
+	int row_cnt = PQntuples(res), col_cnt = PQnfields(res), batch_row = 0;
+
+	received_bytes += getResultSize(res);
+
+	// Chunks that already fill a batch are delivered as they are, without copying their rows
+	if(!rows_batch && static_cast<unsigned>(row_cnt) >= rows_batch_size)
+	{
+		rows_batch = res;
+		deliverRows();
+		return true;
+	}
+
+	if(!rows_batch)
+		rows_batch = PQcopyResult(res, PG_COPYRES_ATTRS);
+
+	batch_row = PQntuples(rows_batch);
+
+	for(int row = 0; row < row_cnt; row++, batch_row++)
+	{
+		for(int col = 0; col < col_cnt; col++)
+		{
+			if(!PQsetvalue(rows_batch, batch_row, col,
+										 PQgetisnull(res, row, col) ? nullptr : PQgetvalue(res, row, col),
+										 PQgetisnull(res, row, col) ? -1 : PQgetlength(res, row, col)))
+			{
+				PQclear(res);
+				failCommand(Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+															.arg(PQerrorMessage(connection->connection)),
+															ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__));
+				return false;
+			}
+		}
+	}
+
+	PQclear(res);
+
+	if(static_cast<unsigned>(batch_row) >= rows_batch_size)
+		deliverRows();
+
+	return true;
+}
+
+void AsyncCommand::deliverRows()
+{
+	if(!rows_batch)
+		return;
+
+	// The result set takes the ownership of the batch destroying it after the signal emission
+	ResultSet rows(rows_batch);
+
+	rows_batch = nullptr;
+	fetched_rows += rows.getTupleCount();
+	emit s_rowsFetched(rows);
+}
+
+void AsyncCommand::storeResult(PGresult *res)
+{
+	received_bytes += getResultSize(res);
+
+	if(last_result && PQresultStatus(last_result) == PGRES_FATAL_ERROR)
+	{
+		PQclear(res);
+		return;
+	}
+
+	if(last_result)
+		PQclear(last_result);
+
+	last_result = res;
+}
+
+void AsyncCommand::stopWatching()
+{
+	timeout_timer.stop();
+
+	if(read_notifier)
+	{
+		read_notifier->setEnabled(false);
+		read_notifier->deleteLater();
+		read_notifier = nullptr;
+	}
+
+	if(write_notifier)
+	{
+		write_notifier->setEnabled(false);
+		write_notifier->deleteLater();
+		write_notifier = nullptr;
+	}
+
+	if(connection->connection)
+		PQsetnonblocking(connection->connection, 0);
+}
+
+void AsyncCommand::finishCommand()
+{
+	stopWatching();
+	last_byte_time = exec_timer.nsecsElapsed() / 1000;
+
+	if(first_byte_time < 0)
+		first_byte_time = last_byte_time;
+	connection->last_cmd_execution = QDateTime::currentDateTime();
+
+	//Prints the SQL to stdout when the flag is active
+	if(Connection::print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\n") << command << Qt::endl;
+	}
+
+	ExecStatusType res_status = last_result ? PQresultStatus(last_result) : PGRES_EMPTY_QUERY;
+	bool failed = (res_status == PGRES_FATAL_ERROR || res_status == PGRES_BAD_RESPONSE);
+
+	/* If the command finished before the cancel request reached the server
+	 * its result is delivered normally instead of being discarded */
+	if(cancel_requested && (failed || !last_result))
+	{
+		status = timed_out ? TimedOut : Cancelled;
+
+		if(timed_out)
+			error = Exception(Exception::getErrorMessage(ErrorCode::CommandExecTimeout).arg(timeout),
+												ErrorCode::CommandExecTimeout, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+		else
+			error = Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+												.arg(last_result ? PQresultErrorMessage(last_result) : ""),
+												ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+		emit s_commandFinished();
+		return;
+	}
+
+	//Raise an error in case the command sql execution is not sucessful
+	if(failed)
+	{
+		status = Failed;
+		error = Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+											.arg(PQresultErrorMessage(last_result)),
+											ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr,
+											QString(PQresultErrorField(last_result, PG_DIAG_SQLSTATE)));
+		emit s_commandFinished();
+		return;
+	}
+
+	// Commands that produce no result (e.g. empty strings) finish with an invalid result set
+	if(!last_result)
+	{
+		status = Finished;
+		emit s_commandFinished();
+		return;
+	}
+
+	try
+	{
+		if(!connection->replay_conn && Connection::recorder.getMode() == CatalogRecorder::RecordResults)
+			Connection::recorder.storeResult(connection->connection_params[Connection::ParamDbName], command, last_result);
+
+		//Generates the resultset based on the sql result descriptor
+		ResultSet new_res(last_result);
+
+		//Copy the new resultset to the command's result set
+		result = new_res;
+		status = Finished;
+	}
+	catch(Exception &e)
+	{
+		status = Failed;
+		error = Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+	}
+
+	PQclear(last_result);
+	last_result = nullptr;
+	emit s_commandFinished();
+}
+
+void AsyncCommand::failCommand(const Exception &e)
+{
+	stopWatching();
+	last_byte_time = exec_timer.nsecsElapsed() / 1000;
+
+	/* Discarding the pending results so the connection can be used again. At this point
+	 * the connection is in blocking mode and there's no more data expected from the server
+	 * in most of the cases (broken connection or a failure while sending the command) */
+	if(connection->connection && PQstatus(connection->connection) == CONNECTION_OK)
+	{
+		PGresult *res = nullptr;
+
+		while((res = PQgetResult(connection->connection)))
+			PQclear(res);
+	}
+
+	status = Failed;
+	error = e;
+	emit s_commandFinished();
+}
+
+bool AsyncCommand::isRunning()
+{
+	return status == Running;
+}
+
+AsyncCommand::CommandStatus AsyncCommand::getStatus()
+{
+	return status;
+}
+
+QString AsyncCommand::getCommand()
+{
+	return command;
+}
+
+ResultSet &AsyncCommand::getResult()
+{
+	return result;
+}
+
+Exception AsyncCommand::getError()
+{
+	return error;
+}
+
+void AsyncCommand::setRowsBatchSize(unsigned batch_size)
+{
+	rows_batch_size = batch_size;
+}
+
+void AsyncCommand::pauseFetching()
+{
+	if(status != Running || rows_batch_size == 0 || cancel_requested || fetch_paused)
+		return;
+
+	fetch_paused = true;
+
+	if(read_notifier)
+		read_notifier->setEnabled(false);
+}
+
+void AsyncCommand::resumeFetching()
+{
+	if(!fetch_paused)
+		return;
+
+	fetch_paused = false;
+
+	if(status != Running)
+		return;
+
+	if(read_notifier)
+		read_notifier->setEnabled(true);
+
+	/* Rows already buffered by libpq don't make the socket readable again,
+	 * so they are processed in the next event loop iteration */
+	QTimer::singleShot(0, this, &AsyncCommand::readResults);
+}
+
+bool AsyncCommand::isFetchPaused()
+{
+	return fetch_paused;
+}
+
+unsigned AsyncCommand::getFetchedRowCount()
+{
+	return fetched_rows;
+}
+
+qint64 AsyncCommand::getSendTime()
+{
+	return send_time;
+}
+
+qint64 AsyncCommand::getFirstByteTime()
+{
+	return first_byte_time;
+}
+
+qint64 AsyncCommand::getLastByteTime()
+{
+	return last_byte_time;
+}
+
+qint64 AsyncCommand::getReceivedBytes()
+{
+	return received_bytes;
+}
+
+qint64 AsyncCommand::getResultSize(PGresult *res)
+{
+	qint64 size = 0;
+	int row_cnt = res ? PQntuples(res) : 0, col_cnt = res ? PQnfields(res) : 0;
+
+	for(int row = 0; row < row_cnt; row++)
+	{
+		for(int col = 0; col < col_cnt; col++)
+			size += PQgetlength(res, row, col);
+	}
+
+	return size;
+}
+
+AsyncCommand *AsyncCommand::execute(Connection &conn, const QString &sql, std::function<void(AsyncCommand &)> callback, unsigned timeout_ms, QObject *parent)
+{
+	AsyncCommand *cmd = new AsyncCommand(conn, parent);
+
+	connect(cmd, &AsyncCommand::s_commandFinished, cmd, [cmd, callback](){
+		if(callback)
+			callback(*cmd);
+
+		cmd->deleteLater();
+	});
+
+	try
+	{
+		cmd->start(sql, timeout_ms);
+		return cmd;
+	}
+	catch(Exception &e)
+	{
+		delete cmd;
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+	}
+}
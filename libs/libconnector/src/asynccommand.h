@@ -0,0 +1,227 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libconnector
+\class AsyncCommand
+\brief Executes a command in a connection without blocking the calling thread. The command is sent through the libpq
+non-blocking API and the results are collected when the connection socket becomes readable, so the thread that owns the
+object must run an event loop. Since no thread is blocked, several commands in different connections can be multiplexed
+in the same event loop. The command can be cancelled at any moment and an optional timeout cancels it automatically.
+*/
+
+#ifndef ASYNC_COMMAND_H
+#define ASYNC_COMMAND_H
+
+#include "connection.h"
+#include "resultset.h"
+#include <QObject>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <functional>
+
+class __libconnector AsyncCommand: public QObject {
+	private:
+		Q_OBJECT
+
+	public:
+		enum CommandStatus: unsigned {
+			NotStarted,
+			Running,
+			Finished,
+			Failed,
+			Cancelled,
+			TimedOut
+		};
+
+	private:
+		//! \brief Connection in which the command is executed. It must outlive the command execution
+		Connection *connection;
+
+		//! \brief Command being executed
+		QString command;
+
+		CommandStatus status;
+
+		//! \brief Notifies when the connection socket has data to be read
+		QSocketNotifier *read_notifier,
+
+		//! \brief Notifies when the connection socket is ready to receive the remaining command data
+		*write_notifier;
+
+		//! \brief Cancels the command when the timeout configured in start() expires
+		QTimer timeout_timer;
+
+		//! \brief Timeout in milliseconds of the current execution. Zero means no timeout
+		unsigned timeout;
+
+		//! \brief Indicates that a cancel request was sent to the server (by the user or due to timeout)
+		bool cancel_requested,
+
+		//! \brief Indicates that the cancel request was caused by the timeout
+		timed_out;
+
+		/*! \brief Last result returned by the server. Like PQexec() does, if one of the commands fails
+		 * its error result is kept and the results of the following commands are discarded */
+		PGresult *last_result;
+
+		//! \brief Result set generated by the command when it finishes successfully
+		ResultSet result;
+
+		//! \brief Error raised by the command when it fails, is cancelled or times out
+		Exception error;
+
+		//! \brief Amount of rows delivered at once in streaming mode. Zero means that the streaming mode is disabled
+		unsigned rows_batch_size,
+
+		//! \brief Amount of rows delivered in streaming mode by the current execution
+		fetched_rows;
+
+		//! \brief Indicates that the reading of the rows is paused (streaming mode only)
+		bool fetch_paused;
+
+		//! \brief Rows received in streaming mode that weren't delivered yet
+		PGresult *rows_batch;
+
+		//! \brief Measures the time elapsed since the start of the current execution
+		QElapsedTimer exec_timer;
+
+		/*! \brief Moments (in microseconds since the start of the execution) in which the command was completely sent,
+		 * the first data of its results was available to be read and the last result was received. -1 when not reached */
+		qint64 send_time,
+
+		first_byte_time,
+
+		last_byte_time,
+
+		//! \brief Size of the values of all the rows received by the current execution
+		received_bytes;
+
+		//! \brief Returns the size of the values of all the rows in the provided result
+		static qint64 getResultSize(PGresult *res);
+
+		/*! \brief Appends the rows of a single row (or chunk) result to the current batch delivering it when full.
+		 * The provided result is destroyed. Returns false if the rows could not be stored */
+		bool appendRows(PGresult *res);
+
+		//! \brief Delivers the current batch of rows via s_rowsFetched()
+		void deliverRows();
+
+		//! \brief Stops watching the connection socket and restores the blocking mode of the connection
+		void stopWatching();
+
+		//! \brief Finishes the execution using the last result received and emits s_commandFinished()
+		void finishCommand();
+
+		//! \brief Finishes the execution with the provided error and emits s_commandFinished()
+		void failCommand(const Exception &e);
+
+		//! \brief Stores the provided result as the last one following the PQexec() rules
+		void storeResult(PGresult *res);
+
+	private slots:
+		//! \brief Reads the available data from the connection and collects the results that are complete
+		void readResults();
+
+		//! \brief Sends the data of the command that could not be sent in a single shot
+		void flushCommand();
+
+		//! \brief Cancels the command due to the timeout expiration
+		void handleTimeout();
+
+	public:
+		AsyncCommand(Connection &conn, QObject *parent = nullptr);
+
+		//! \brief Cancels the command if it's still running and waits for the connection to be released
+		virtual ~AsyncCommand();
+
+		/*! \brief Sends the command to the server and returns immediately. When timeout_ms is greater than zero
+		 * the command is cancelled if it doesn't finish in the provided time. The signal s_commandFinished() is emitted
+		 * when the command finishes, fails, is cancelled or times out. Raises an error if the command could not be sent */
+		void start(const QString &sql, unsigned timeout_ms = 0);
+
+		/*! \brief Requests the cancellation of the running command. The server aborts the command and
+		 * the signal s_commandFinished() is emitted as soon as the connection is released */
+		void cancel();
+
+		//! \brief Returns if the command is still running
+		bool isRunning();
+
+		CommandStatus getStatus();
+
+		//! \brief Returns the command being executed (or the last one executed)
+		QString getCommand();
+
+		//! \brief Returns the result set generated by the command. Valid only when the status is Finished
+		ResultSet &getResult();
+
+		//! \brief Returns the error raised by the command. Valid only when the status is Failed, Cancelled or TimedOut
+		Exception getError();
+
+		/*! \brief Configures the streaming mode for the next executions. In this mode the rows returned by the command are
+		 * delivered in batches of the provided size through s_rowsFetched() as soon as they are received, instead of being
+		 * held in a single result. The chunked rows mode is used when available (libpq 17+) or the single row mode otherwise.
+		 * The final result (see getResult()) carries the columns of the query but no tuples. Zero disables the streaming mode */
+		void setRowsBatchSize(unsigned batch_size);
+
+		/*! \brief Stops reading the rows of the running command (streaming mode only). Since the rows are not consumed
+		 * the server stops sending them when the connection buffers are full, so the memory usage is bounded
+		 * while the command is kept running. Cancelling the command resumes the reading automatically */
+		void pauseFetching();
+
+		//! \brief Resumes the reading of the rows paused by pauseFetching()
+		void resumeFetching();
+
+		//! \brief Returns if the reading of the rows is currently paused
+		bool isFetchPaused();
+
+		//! \brief Returns the amount of rows delivered in streaming mode by the current execution
+		unsigned getFetchedRowCount();
+
+		/*! \brief Returns the time (in microseconds since the command was started) taken to send the whole command to the server.
+		 * Returns -1 if the command was not completely sent yet */
+		qint64 getSendTime();
+
+		/*! \brief Returns the time (in microseconds since the command was started) in which the first data of the results became
+		 * available to be read. Returns -1 if nothing was received yet */
+		qint64 getFirstByteTime();
+
+		/*! \brief Returns the time (in microseconds since the command was started) in which the command finished, including the
+		 * periods in which the reading of the rows was paused. Returns -1 if the command is still running */
+		qint64 getLastByteTime();
+
+		/*! \brief Returns the size of the values of the rows received by the current execution (including the rows delivered in
+		 * streaming mode). The overhead of the protocol (row headers, column descriptions, etc) is not considered */
+		qint64 getReceivedBytes();
+
+		/*! \brief Creates a command object, starts it and calls the provided function when it finishes in any status.
+		 * The command object is deleted after the function returns so it must not be referenced afterwards */
+		static AsyncCommand *execute(Connection &conn, const QString &sql, std::function<void(AsyncCommand &)> callback,
+																 unsigned timeout_ms = 0, QObject *parent = nullptr);
+
+	signals:
+		//! \brief Signal emitted when the command finishes, fails, is cancelled or times out (see getStatus())
+		void s_commandFinished();
+
+		/*! \brief Signal emitted in streaming mode for each batch of rows received. The result set is destroyed
+		 * after the emission, so this signal must be handled through direct connections only */
+		void s_rowsFetched(ResultSet &rows);
+};
+
+#endif
@@ -18,6 +18,7 @@
 #include "catalog.h"
 #include "coreutilsns.h"
 #include "utilsns.h"
+#include <QCryptographicHash>
 
 const QString Catalog::QueryList("list");
 const QString Catalog::QueryAttribs("attribs");
@@ -29,11 +30,27 @@ const QString Catalog::PgModelerTempDbObj("__pgmodeler_tmp");
 const QString Catalog::InvFilterPattern("__invalid__pattern__");
 const QString Catalog::AliasPlaceholder("$alias$");
 const QString Catalog::EscapedNullChar("\\000");
+const QString Catalog::ParamPlaceholder("__pgmodeler_param_%1__");
+const QStringList Catalog::ScalarParamAttribs={ Attributes::Schema, Attributes::Table, Attributes::Name };
+const QStringList Catalog::ArrayParamAttribs={ Attributes::FilterOids, Attributes::FilterTables };
 const QString Catalog::GetExtensionObjsSql("SELECT d.objid AS oid, e.extname AS name FROM pg_depend AS d \
 																					 LEFT JOIN pg_extension AS e ON e.oid = d.refobjid \
 																					 WHERE objid > 0 AND refobjid > 0 AND deptype='e'\
 																					 ORDER BY extname;");
+const QString Catalog::GetTypeNamesSql("SELECT tp.oid, replace(replace(tp.oid::regtype::text,'\"', ''), ns.nspname || '.', '') AS name \
+																			 FROM pg_type AS tp LEFT JOIN pg_namespace AS ns ON tp.typnamespace = ns.oid \
+																			 WHERE tp.oid = ANY($1::oid[])");
+const QString Catalog::GetCatalogRowsSummarySql("SELECT '%1:' || count(*) || ':' || coalesce(sum(xmin::text::bigint), 0) FROM pg_catalog.%1 %2");
 attribs_map Catalog::catalog_queries;
+QMutex Catalog::catalog_queries_mtx;
+std::map<QByteArray, Catalog::CompiledQuery> Catalog::compiled_queries;
+QMutex Catalog::compiled_queries_mtx;
+std::map<QString, std::map<unsigned, QString>> Catalog::type_names;
+std::map<QString, unsigned> Catalog::type_names_gen;
+QMutex Catalog::type_names_mtx;
+std::map<QString, std::map<std::tuple<QString, QString, ObjectType, QString>, std::vector<attribs_map>>> Catalog::objects_names;
+std::map<QString, unsigned> Catalog::objects_names_gen;
+QMutex Catalog::objects_names_mtx;
 
 std::map<ObjectType, QString> Catalog::oid_fields=
 { {ObjectType::Database, "oid"}, {ObjectType::Role, "oid"}, {ObjectType::Schema,"oid"},
@@ -82,6 +99,7 @@ std::map<ObjectType, QString> Catalog::name_fields=
 Catalog::Catalog()
 {
 	match_signature = true;
+	cache_objs_names = false;
 	last_sys_oid=0;
 	setQueryFilter(ExclExtensionObjs | ExclSystemObjs);
 }
@@ -96,7 +114,7 @@ void Catalog::setConnection(Connection &conn)
 	try
 	{
 		ResultSet res;
-		QStringList obj_oids;
+		std::map<QString, std::vector<unsigned>> ext_oids;
 
 		connection.close();
 		connection.setConnectionParams(conn.getConnectionParams());
@@ -114,19 +132,23 @@ void Catalog::setConnection(Connection &conn)
 
 		//Retrieving the list of objects created by extensions
 		ext_objects.clear();
+		all_ext_objects.clear();
 		ext_objs_oids = "";
+		cached_subqueries.clear();
 		this->connection.executeDMLCommand(GetExtensionObjsSql, res);
 
-		if(res.accessTuple(ResultSet::FirstTuple))
+		if(res.getTupleCount() > 0)
 		{
-			do
-			{
-				obj_oids.append(res.getColumnValue(Attributes::Oid));
-				ext_objects[res.getColumnValue(Attributes::Name)].append(res.getColumnValue(Attributes::Oid));
-			}
-			while(res.accessTuple(ResultSet::NextTuple));
+			int oid_col = res.getColumnIndex(Attributes::Oid),
+					name_col = res.getColumnIndex(Attributes::Name);
+
+			all_ext_objects.reserve(res.getTupleCount());
 
-			ext_objs_oids = obj_oids.join(',');
+			for(auto tuple : res)
+				ext_oids[tuple.getText(name_col)].push_back(tuple.getOid(oid_col));
+
+			for(auto &itr : ext_oids)
+				addExtensionObjects(itr.first, itr.second);
 		}
 	}
 	catch(Exception &e)
@@ -140,6 +162,59 @@ void Catalog::closeConnection()
 	connection.close();
 }
 
+QString Catalog::exportSnapshot()
+{
+	try
+	{
+		ResultSet res;
+
+		connection.executeDDLCommand("BEGIN TRANSACTION ISOLATION LEVEL REPEATABLE READ");
+		connection.executeDMLCommand("SELECT pg_export_snapshot()", res);
+
+		if(!res.accessTuple(ResultSet::FirstTuple))
+			return "";
+
+		return res.getColumnValue(0);
+	}
+	catch(Exception &e)
+	{
+		/* Aborting the transaction so the connection can still be used by the
+		 * caller in case it decides to read the catalog without a shared snapshot */
+		try { connection.executeDDLCommand("ROLLBACK"); } catch(Exception &){}
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Catalog::importSnapshot(const QString &snapshot_id)
+{
+	try
+	{
+		if(!connection.isStablished())
+			connection.connect();
+
+		connection.executeDDLCommand("BEGIN TRANSACTION ISOLATION LEVEL REPEATABLE READ");
+		connection.executeDDLCommand(QString("SET TRANSACTION SNAPSHOT '%1'").arg(snapshot_id));
+	}
+	catch(Exception &e)
+	{
+		try { connection.executeDDLCommand("ROLLBACK"); } catch(Exception &){}
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Catalog::releaseSnapshot()
+{
+	try
+	{
+		if(connection.isStablished())
+			connection.executeDDLCommand("COMMIT");
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
 void Catalog::setQueryFilter(QueryFilter filter)
 {
 	bool list_all=(ListAllObjects & filter) == ListAllObjects;
@@ -345,6 +420,116 @@ unsigned Catalog::getLastSysObjectOID()
 	return last_sys_oid;
 }
 
+QString Catalog::getCatalogChangeMarker()
+{
+	try
+	{
+		ResultSet res;
+		QStringList queries;
+
+		/* The catalogs below hold the rows read by the catalog queries. Since UPDATE creates new row versions
+		 * the sum of the xmin of each catalog changes whenever an object is created, altered or commented,
+		 * and the rows count detects the dropped ones. VACUUM FREEZE doesn't change the values as the
+		 * original xmin is still displayed for frozen rows */
+		static const QStringList catalogs = {
+			"pg_database", "pg_tablespace", "pg_namespace", "pg_class", "pg_attribute", "pg_attrdef",
+			"pg_constraint", "pg_index", "pg_inherits", "pg_partitioned_table", "pg_trigger", "pg_rewrite",
+			"pg_policy", "pg_sequence", "pg_proc", "pg_aggregate", "pg_type", "pg_operator", "pg_opclass",
+			"pg_opfamily", "pg_amop", "pg_amproc", "pg_cast", "pg_collation", "pg_conversion", "pg_language",
+			"pg_extension", "pg_event_trigger", "pg_foreign_data_wrapper", "pg_foreign_server",
+			"pg_foreign_table", "pg_transform", "pg_description", "pg_shdescription",
+			"pg_auth_members", "pg_default_acl", "pg_enum", "pg_range", "pg_depend"
+		};
+
+		/* The temporary schemas and the objects in them are created on demand by any session (including the catalog
+		 * reading one, see sequence.sch) and are never part of the imported objects, so they're not considered as a
+		 * catalog change. The conditions below exclude the rows of those objects (%1 is replaced by the oids of the temporary schemas) */
+		static const QString temp_rels = "SELECT oid FROM pg_catalog.pg_class WHERE relnamespace IN (%1)",
+				temp_types = "SELECT oid FROM pg_catalog.pg_type WHERE typnamespace IN (%1)";
+		static const std::map<QString, QString> temp_filters = {
+			{ "pg_namespace", "oid NOT IN (%1)" },
+			{ "pg_class", "relnamespace NOT IN (%1)" },
+			{ "pg_attribute", "attrelid NOT IN (" + temp_rels + ")" },
+			{ "pg_attrdef", "adrelid NOT IN (" + temp_rels + ")" },
+			{ "pg_constraint", "connamespace NOT IN (%1)" },
+			{ "pg_index", "indrelid NOT IN (" + temp_rels + ")" },
+			{ "pg_inherits", "inhrelid NOT IN (" + temp_rels + ")" },
+			{ "pg_partitioned_table", "partrelid NOT IN (" + temp_rels + ")" },
+			{ "pg_trigger", "tgrelid NOT IN (" + temp_rels + ")" },
+			{ "pg_rewrite", "ev_class NOT IN (" + temp_rels + ")" },
+			{ "pg_policy", "polrelid NOT IN (" + temp_rels + ")" },
+			{ "pg_sequence", "seqrelid NOT IN (" + temp_rels + ")" },
+			{ "pg_proc", "pronamespace NOT IN (%1)" },
+			{ "pg_aggregate", "aggfnoid NOT IN (SELECT oid FROM pg_catalog.pg_proc WHERE pronamespace IN (%1))" },
+			{ "pg_type", "typnamespace NOT IN (%1)" },
+			{ "pg_operator", "oprnamespace NOT IN (%1)" },
+			{ "pg_opclass", "opcnamespace NOT IN (%1)" },
+			{ "pg_opfamily", "opfnamespace NOT IN (%1)" },
+			{ "pg_amop", "amopfamily NOT IN (SELECT oid FROM pg_catalog.pg_opfamily WHERE opfnamespace IN (%1))" },
+			{ "pg_amproc", "amprocfamily NOT IN (SELECT oid FROM pg_catalog.pg_opfamily WHERE opfnamespace IN (%1))" },
+			{ "pg_collation", "collnamespace NOT IN (%1)" },
+			{ "pg_conversion", "connamespace NOT IN (%1)" },
+			{ "pg_description", "NOT (classoid = 'pg_catalog.pg_class'::regclass AND objoid IN (" + temp_rels + "))" },
+			{ "pg_enum", "enumtypid NOT IN (" + temp_types + ")" },
+			{ "pg_range", "rngtypid NOT IN (" + temp_types + ")" },
+			{ "pg_depend", "NOT ((classid = 'pg_catalog.pg_class'::regclass AND objid IN (" + temp_rels + ")) OR "
+										 "(classid = 'pg_catalog.pg_type'::regclass AND objid IN (" + temp_types + ")) OR "
+										 "(classid = 'pg_catalog.pg_proc'::regclass AND objid IN (SELECT oid FROM pg_catalog.pg_proc WHERE pronamespace IN (%1))) OR "
+										 "(classid = 'pg_catalog.pg_constraint'::regclass AND objid IN (SELECT oid FROM pg_catalog.pg_constraint WHERE connamespace IN (%1))) OR "
+										 "(classid = 'pg_catalog.pg_attrdef'::regclass AND objid IN (SELECT oid FROM pg_catalog.pg_attrdef WHERE adrelid IN (" + temp_rels + "))))" }
+		};
+		QString filter;
+		bool read_authid = false, read_user_mapping = false;
+
+		for(auto &catalog : catalogs)
+		{
+			filter.clear();
+
+			if(temp_filters.count(catalog))
+				filter = "WHERE " + temp_filters.at(catalog).arg("SELECT oid FROM pg_catalog.pg_namespace WHERE nspname ~ '^pg_(toast_)?temp_'");
+
+			queries.append(GetCatalogRowsSummarySql.arg(catalog, filter));
+		}
+
+		/* pg_authid and pg_user_mapping are usually readable only by superusers. The privileges are checked beforehand
+		 * since a query that references an unreadable catalog fails even if the reference is never evaluated */
+		connection.executeDMLCommand("SELECT has_table_privilege('pg_catalog.pg_authid', 'SELECT') AS authid, "
+																 "has_table_privilege('pg_catalog.pg_user_mapping', 'SELECT') AS user_mapping", res);
+
+		if(res.accessTuple(ResultSet::FirstTuple))
+		{
+			read_authid = res.getColumnValue(QString("authid")) == PgSqlTrue;
+			read_user_mapping = res.getColumnValue(QString("user_mapping")) == PgSqlTrue;
+		}
+
+		// When the catalogs can't be read the roles and user mappings are summarized through their full rows in the publicly readable views
+		if(read_authid)
+			queries.append(GetCatalogRowsSummarySql.arg("pg_authid", ""));
+		else
+			queries.append("SELECT 'pg_roles:' || md5(coalesce(string_agg(rl::text, ',' ORDER BY rl.oid), '')) FROM pg_catalog.pg_roles AS rl");
+
+		if(read_user_mapping)
+			queries.append(GetCatalogRowsSummarySql.arg("pg_user_mapping", ""));
+		else
+			queries.append("SELECT 'pg_user_mappings:' || md5(coalesce(string_agg(um::text, ',' ORDER BY um.umid), '')) FROM pg_catalog.pg_user_mappings AS um");
+
+		// Server upgrades may change the way objects are read so the server version is part of the marker too
+		queries.append("SELECT 'version:' || version()");
+
+		connection.executeDMLCommand(QString("SELECT md5(string_agg(marker, ',' ORDER BY marker)) AS marker FROM (%1) AS summary(marker)")
+																 .arg(queries.join(" UNION ALL ")), res);
+
+		if(res.accessTuple(ResultSet::FirstTuple))
+			return res.getColumnValue(QString("marker"));
+
+		return "";
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
 bool Catalog::isSystemObject(unsigned oid)
 {
 	return (oid <= last_sys_oid);
@@ -352,34 +537,67 @@ bool Catalog::isSystemObject(unsigned oid)
 
 bool Catalog::isExtensionObject(unsigned oid, const QString &ext_name)
 {
-	if(!ext_name.isEmpty() && ext_objects.count(ext_name) == 0)
-		return false;
-
 	if(ext_name.isEmpty())
+		return all_ext_objects.count(oid) != 0;
+
+	auto itr = ext_objects.find(ext_name);
+	return itr != ext_objects.end() && itr->second.count(oid) != 0;
+}
+
+void Catalog::addExtensionObjects(const QString &ext_name, const std::vector<unsigned> &oids)
+{
+	std::unordered_set<unsigned> &ext_oids = ext_objects[ext_name];
+	QStringList new_oids;
+
+	ext_oids.reserve(ext_oids.size() + oids.size());
+	all_ext_objects.reserve(all_ext_objects.size() + oids.size());
+
+	for(auto &oid : oids)
 	{
-		for(auto &itr : ext_objects)
-		{
-			if(itr.second.contains(QString::number(oid)))
-				return true;
-		}
+		ext_oids.insert(oid);
 
-		return false;
+		if(all_ext_objects.insert(oid).second)
+			new_oids.append(QString::number(oid));
 	}
 
-	return ext_objects[ext_name].contains(QString::number(oid));
+	if(new_oids.isEmpty())
+		return;
+
+	if(!ext_objs_oids.isEmpty())
+		ext_objs_oids.append(',');
+
+	ext_objs_oids.append(new_oids.join(','));
+
+	// The not extension object subqueries embed the list of oids so they need to be generated again
+	cached_subqueries.clear();
 }
 
 void Catalog::loadCatalogQuery(const QString &qry_id)
 {
+	QMutexLocker locker(&catalog_queries_mtx);
+
 	if(catalog_queries.count(qry_id)==0)
 		catalog_queries[qry_id] = UtilsNs::loadFile(GlobalAttributes::getSchemaFilePath(GlobalAttributes::CatalogSchemasDir, qry_id));
 
 	schparser.loadBuffer(catalog_queries[qry_id]);
 }
 
-QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, bool single_result, attribs_map attribs)
+QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, bool single_result, attribs_map attribs, QStringList *params)
 {
-	QString sql, custom_filter;
+	QString custom_filter;
+	attribs_map param_values;
+
+	if(params)
+	{
+		params->clear();
+
+		// Storing the raw values of the attributes that will be sent as query parameters
+		for(auto &attr : ScalarParamAttribs + ArrayParamAttribs)
+		{
+			if(attribs.count(attr) && !attribs[attr].isEmpty())
+				param_values[attr] = attribs[attr];
+		}
+	}
 
 	/* Escaping apostrophe (') in the attributes values to avoid SQL errors
 	 * due to support to this char in the middle of objects' names */
@@ -392,6 +610,7 @@ QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, b
 	schparser.__setPgSQLVersion(connection.getPgSQLVersion(true),
 															Connection::isDbVersionIgnored());
 	attribs[qry_type]=Attributes::True;
+	attribs[Attributes::PgSqlVersion]=schparser.getPgSQLVersion();
 
 	if(exclude_sys_objs || list_only_sys_objs)
 		attribs[Attributes::LastSysOid]=QString::number(last_sys_oid);
@@ -430,15 +649,83 @@ QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, b
 			attribs[Attributes::NotExtObject]=getNotExtObjectQuery(ext_oid_fields[obj_type]);
 	}
 
+	if(!param_values.empty())
+	{
+		attribs_map shape_attribs = attribs, placeholders;
+		QCryptographicHash hash(QCryptographicHash::Sha1);
+		CompiledQuery cmp_query;
+		QByteArray shape_key;
+		bool compiled = false;
+		unsigned param_id = 0;
+
+		/* The values of the parameterized attributes are replaced by placeholders so the queries that differ only
+		 * by those values share the same shape. Other attributes (filters, server version, etc) are part of the shape */
+		for(auto &itr : param_values)
+		{
+			placeholders[itr.first] = ParamPlaceholder.arg(param_id++);
+			shape_attribs[itr.first] = placeholders[itr.first];
+		}
+
+		hash.addData(BaseObject::getSchemaName(obj_type).toUtf8());
+		hash.addData(QByteArray::number(single_result));
+		hash.addData(custom_filter.toUtf8());
+
+		for(auto &itr : shape_attribs)
+		{
+			hash.addData(QByteArray(1, '\0'));
+			hash.addData(itr.first.toUtf8());
+			hash.addData(QByteArray(1, '='));
+			hash.addData(itr.second.toUtf8());
+		}
+
+		shape_key = hash.result();
+		compiled_queries_mtx.lock();
+
+		if(compiled_queries.count(shape_key))
+		{
+			cmp_query = compiled_queries[shape_key];
+			compiled = true;
+		}
+
+		compiled_queries_mtx.unlock();
+
+		if(!compiled)
+		{
+			cmp_query = compileQueryParameters(generateCatalogQuery(obj_type, single_result, shape_attribs, custom_filter), placeholders);
+
+			QMutexLocker locker(&compiled_queries_mtx);
+			compiled_queries[shape_key] = cmp_query;
+		}
+
+		if(cmp_query.parameterized)
+		{
+			for(auto &attr : cmp_query.param_attribs)
+			{
+				// Oid lists are sent as array literals which are compared via = ANY($n)
+				if(ArrayParamAttribs.contains(attr))
+					params->append(QString("{%1}").arg(param_values[attr]));
+				else
+					params->append(param_values[attr]);
+			}
+
+			return cmp_query.sql;
+		}
+	}
+
+	return generateCatalogQuery(obj_type, single_result, attribs, custom_filter);
+}
+
+QString Catalog::generateCatalogQuery(ObjectType obj_type, bool single_result, attribs_map &attribs, const QString &custom_filter)
+{
+	QString sql, filter = custom_filter;
+
 	loadCatalogQuery(BaseObject::getSchemaName(obj_type));
 	schparser.ignoreUnkownAttributes(true);
 	schparser.ignoreEmptyAttributes(true);
-
-	attribs[Attributes::PgSqlVersion]=schparser.getPgSQLVersion();
 	sql=schparser.getSourceCode(attribs).simplified();
 
 	//Appeding the custom filter to the whole catalog query
-	if(!custom_filter.isEmpty())
+	if(!filter.isEmpty())
 	{
 		int order_by_idx = sql.lastIndexOf("ORDER BY", -1, Qt::CaseInsensitive),
 				where_idx = sql.lastIndexOf("WHERE", -1, Qt::CaseInsensitive),
@@ -448,7 +735,7 @@ QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, b
 		if(where_idx < 0)
 		{
 			// Adding the custom filter with a WHERE statement
-			custom_filter.prepend("WHERE ");
+			filter.prepend("WHERE ");
 
 			/* If we have and order by then the where statement will
 			 * be placed before the order by */
@@ -461,7 +748,7 @@ QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, b
 		// If we have an order by and a where
 		else if(where_idx > 0)
 		{
-			custom_filter = QString(" AND (%1) ").arg(custom_filter);
+			filter = QString(" AND (%1) ").arg(filter);
 
 			// If the order by at left of the where (inside a subquery for example)
 			if(order_by_idx < 0 || order_by_idx < where_idx)
@@ -472,7 +759,7 @@ QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, b
 				pos = order_by_idx;
 		}
 
-		sql.insert(pos, custom_filter);
+		sql.insert(pos, filter);
 	}
 
 	//Append a LIMIT clause when the single_result is set
@@ -485,11 +772,48 @@ QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, b
 	return sql;
 }
 
+Catalog::CompiledQuery Catalog::compileQueryParameters(const QString &sql, const attribs_map &placeholders)
+{
+	CompiledQuery cmp_query;
+	QString placeholder;
+
+	cmp_query.sql = sql;
+
+	for(auto &itr : placeholders)
+	{
+		placeholder = itr.second;
+
+		// The attribute is used only in conditions of the catalog query so it doesn't become a parameter
+		if(!cmp_query.sql.contains(placeholder))
+			continue;
+
+		if(ArrayParamAttribs.contains(itr.first))
+		{
+			cmp_query.sql.replace(QRegularExpression(QString("IN\\s*\\(\\s*%1\\s*\\)").arg(placeholder),
+																							 QRegularExpression::CaseInsensitiveOption),
+														QString("= ANY($%1)").arg(cmp_query.param_attribs.size() + 1));
+		}
+		else
+			cmp_query.sql.replace(QString("'%1'").arg(placeholder), QString("$%1").arg(cmp_query.param_attribs.size() + 1));
+
+		if(cmp_query.sql.contains(placeholder))
+			return CompiledQuery();
+
+		cmp_query.param_attribs.append(itr.first);
+	}
+
+	cmp_query.parameterized = true;
+	return cmp_query;
+}
+
 void Catalog::executeCatalogQuery(const QString &qry_type, ObjectType obj_type, ResultSet &result, bool single_result, attribs_map attribs)
 {
 	try
 	{
-		connection.executeDMLCommand(getCatalogQuery(qry_type, obj_type, single_result, attribs), result);
+		QStringList params;
+		QString sql = getCatalogQuery(qry_type, obj_type, single_result, attribs, &params);
+
+		connection.executeDMLCommand(sql, params, result);
 	}
 	catch(Exception &e)
 	{
@@ -606,13 +930,13 @@ attribs_map Catalog::getObjectsNames(ObjectType obj_type, const QString &sch_nam
 		extra_attribs[Attributes::Table]=tab_name;
 		executeCatalogQuery(QueryList, obj_type, res, false, extra_attribs);
 
-		if(res.accessTuple(ResultSet::FirstTuple))
+		if(res.getTupleCount() > 0)
 		{
-			do
-			{
-				objects[res.getColumnValue(Attributes::Oid)]=res.getColumnValue(Attributes::Name);
-			}
-			while(res.accessTuple(ResultSet::NextTuple));
+			int oid_col = res.getColumnIndex(Attributes::Oid),
+					name_col = res.getColumnIndex(Attributes::Name);
+
+			for(auto tuple : res)
+				objects[tuple.getText(oid_col)]=tuple.getText(name_col);
 		}
 
 		return objects;
@@ -629,14 +953,38 @@ std::vector<attribs_map> Catalog::getObjectsNames(std::vector<ObjectType> obj_ty
 	{
 		ResultSet res;
 		std::vector<attribs_map> objects;
-		QString sql, select_kw=QString("SELECT");
+		std::map<ObjectType, std::vector<attribs_map>> type_objects;
+		std::vector<ObjectType> missing_types;
+		QString sql, select_kw=QString("SELECT"), conn_id;
 		QStringList queries;
 		attribs_map attribs;
+		unsigned cache_gen = 0;
 
 		extra_attribs[Attributes::Schema]=sch_name;
 		extra_attribs[Attributes::Table]=tab_name;
 
-		for(auto &obj_type : obj_types)
+		//Retrieving the cached lists so only the missing types are queried
+		if(cache_objs_names)
+		{
+			conn_id = connection.getConnectionId(true, true);
+			QMutexLocker locker(&objects_names_mtx);
+
+			cache_gen = objects_names_gen[conn_id];
+
+			for(auto &obj_type : obj_types)
+			{
+				auto itr = objects_names[conn_id].find(getObjectsNamesKey(obj_type, sch_name, tab_name, extra_attribs));
+
+				if(itr != objects_names[conn_id].end())
+					type_objects[obj_type] = itr->second;
+				else
+					missing_types.push_back(obj_type);
+			}
+		}
+		else
+			missing_types = obj_types;
+
+		for(auto &obj_type : missing_types)
 		{	
 			//Build the catalog query for the specified object type
 			sql=getCatalogQuery(QueryList, obj_type, false, extra_attribs);
@@ -653,32 +1001,63 @@ std::vector<attribs_map> Catalog::getObjectsNames(std::vector<ObjectType> obj_ty
 				sql+=QChar('\n');
 				queries.push_back(sql);
 			}
+
+			type_objects[obj_type];
 		}
 
-		//Joining the generated queries by using union in order to retrieve all results at once
-		sql = QChar('(') +  queries.join(QString(") UNION (")) + QChar(')');
+		if(!queries.isEmpty())
+		{
+			//Joining the generated queries by using union in order to retrieve all results at once
+			sql = QChar('(') +  queries.join(QString(") UNION (")) + QChar(')');
+			connection.executeDMLCommand(sql, res);
+		}
 
-		if(sort_results)
-			sql += QString(" ORDER BY oid, object_type");
+		if(res.getTupleCount() > 0)
+		{
+			int oid_col = res.getColumnIndex(Attributes::Oid),
+					name_col = res.getColumnIndex(Attributes::Name),
+					obj_type_col = res.getColumnIndex(QString(Attributes::ObjectType).replace('-', '_')),
+					parent_col = res.getColumnIndex(Attributes::Parent),
+					parent_type_col = res.getColumnIndex(QString(Attributes::ParentType).replace('-', '_'));
 
-		connection.executeDMLCommand(sql, res);
+			for(auto tuple : res)
+			{
+				attribs[Attributes::Oid]=tuple.getText(oid_col);
+				attribs[Attributes::Name]=tuple.getText(name_col);
+				attribs[Attributes::ObjectType]=tuple.getText(obj_type_col);
+				attribs[Attributes::Parent]=tuple.getText(parent_col);
+				attribs[Attributes::ParentType]=tuple.getText(parent_type_col);
+				type_objects[static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt())].push_back(attribs);
+			}
+		}
 
-		if(res.accessTuple(ResultSet::FirstTuple))
+		if(cache_objs_names && !missing_types.empty())
 		{
-			QString obj_type_attr = QString(Attributes::ObjectType).replace('-', '_'),
-					parent_type_attr = QString(Attributes::ParentType).replace('-', '_');
+			QMutexLocker locker(&objects_names_mtx);
 
-			do
+			// The lists retrieved before an invalidation of the cache (e.g. in another thread) may be stale so they're not stored
+			if(objects_names_gen[conn_id] == cache_gen)
 			{
-				attribs[Attributes::Oid]=res.getColumnValue(Attributes::Oid);
-				attribs[Attributes::Name]=res.getColumnValue(Attributes::Name);
-				attribs[Attributes::ObjectType]=res.getColumnValue(obj_type_attr);
-				attribs[Attributes::Parent]=res.getColumnValue(Attributes::Parent);
-				attribs[Attributes::ParentType]=res.getColumnValue(parent_type_attr);
-				objects.push_back(attribs);
-				attribs.clear();
+				for(auto &obj_type : missing_types)
+					objects_names[conn_id][getObjectsNamesKey(obj_type, sch_name, tab_name, extra_attribs)] = type_objects[obj_type];
 			}
-			while(res.accessTuple(ResultSet::NextTuple));
+		}
+
+		objects.reserve(res.getTupleCount());
+
+		for(auto &obj_type : obj_types)
+			objects.insert(objects.end(), type_objects[obj_type].begin(), type_objects[obj_type].end());
+
+		if(sort_results)
+		{
+			std::stable_sort(objects.begin(), objects.end(), [](const attribs_map &obj1, const attribs_map &obj2) {
+				unsigned oid1 = obj1.at(Attributes::Oid).toUInt(), oid2 = obj2.at(Attributes::Oid).toUInt();
+
+				if(oid1 == oid2)
+					return obj1.at(Attributes::ObjectType).toUInt() < obj2.at(Attributes::ObjectType).toUInt();
+
+				return oid1 < oid2;
+			});
 		}
 
 		return objects;
@@ -689,6 +1068,77 @@ std::vector<attribs_map> Catalog::getObjectsNames(std::vector<ObjectType> obj_ty
 	}
 }
 
+std::tuple<QString, QString, ObjectType, QString> Catalog::getObjectsNamesKey(ObjectType obj_type, const QString &sch_name, const QString &tab_name, const attribs_map &extra_attribs)
+{
+	QStringList signature = { QString::number(filter), QString::number(match_signature) };
+
+	//The name filters of the type and the extra attributes change the listing so they are part of the key
+	if(obj_filters.count(obj_type))
+		signature.append(obj_filters.at(obj_type));
+
+	if(extra_filter_conds.count(obj_type))
+		signature.append(extra_filter_conds.at(obj_type));
+
+	for(auto &[attr, value] : extra_attribs)
+	{
+		if(attr != Attributes::Schema && attr != Attributes::Table)
+			signature.append(attr + QChar('=') + value);
+	}
+
+	return std::make_tuple(sch_name, tab_name, obj_type, signature.join(QChar('\n')));
+}
+
+void Catalog::setObjectsNamesCached(bool value)
+{
+	cache_objs_names = value;
+}
+
+bool Catalog::isObjectsNamesCached(const std::vector<ObjectType> &obj_types, const QString &sch_name, const QString &tab_name, attribs_map extra_attribs)
+{
+	if(!cache_objs_names)
+		return false;
+
+	QString conn_id = connection.getConnectionId(true, true);
+	QMutexLocker locker(&objects_names_mtx);
+
+	extra_attribs[Attributes::Schema]=sch_name;
+	extra_attribs[Attributes::Table]=tab_name;
+
+	for(auto &obj_type : obj_types)
+	{
+		if(objects_names[conn_id].count(getObjectsNamesKey(obj_type, sch_name, tab_name, extra_attribs)) == 0)
+			return false;
+	}
+
+	return true;
+}
+
+void Catalog::invalidateObjectsNames(Connection &conn, const QString &sch_name, const QString &tab_name)
+{
+	QMutexLocker locker(&objects_names_mtx);
+	QString conn_id = conn.getConnectionId(true, true);
+
+	// Listings running at this moment will not store their results (see getObjectsNames())
+	objects_names_gen[conn_id]++;
+
+	if(sch_name.isEmpty())
+	{
+		objects_names.erase(conn_id);
+		return;
+	}
+
+	auto &names = objects_names[conn_id];
+
+	for(auto itr = names.begin(); itr != names.end();)
+	{
+		if(std::get<0>(itr->first) == sch_name &&
+			 (tab_name.isEmpty() || std::get<1>(itr->first) == tab_name))
+			itr = names.erase(itr);
+		else
+			itr++;
+	}
+}
+
 attribs_map Catalog::getAttributes(const QString &obj_name, ObjectType obj_type, attribs_map extra_attribs)
 {
 	try
@@ -720,27 +1170,12 @@ std::vector<attribs_map> Catalog::getMultipleAttributes(ObjectType obj_type, att
 	try
 	{
 		ResultSet res;
-		attribs_map tuple;
-		std::vector<attribs_map> obj_attribs;
 
 		executeCatalogQuery(QueryAttribs, obj_type, res, false, extra_attribs);
-		if(res.accessTuple(ResultSet::FirstTuple))
-		{
-			do
-			{
-				tuple=changeAttributeNames(res.getTupleValues());
-
-				/* Insert the object type as an attribute of the query result to facilitate the
-				import process on the classes that uses the Catalog */
-				tuple[Attributes::ObjectType]=QString("%1").arg(enum_t(obj_type));
 
-				obj_attribs.push_back(tuple);
-				tuple.clear();
-			}
-			while(res.accessTuple(ResultSet::NextTuple));
-		}
-
-		return obj_attribs;
+		/* Insert the object type as an attribute of the query result to facilitate the
+		import process on the classes that uses the Catalog */
+		return getResultAttributes(res, {{ Attributes::ObjectType, QString("%1").arg(enum_t(obj_type)) }});
 	}
 	catch(Exception &e)
 	{
@@ -753,8 +1188,6 @@ std::vector<attribs_map> Catalog::getMultipleAttributes(const QString &catalog_s
 	try
 	{
 		ResultSet res;
-		attribs_map tuple;
-		std::vector<attribs_map> obj_attribs;
 
 		loadCatalogQuery(catalog_sch);
 		schparser.ignoreUnkownAttributes(true);
@@ -763,18 +1196,7 @@ std::vector<attribs_map> Catalog::getMultipleAttributes(const QString &catalog_s
 		attribs[Attributes::PgSqlVersion]=schparser.getPgSQLVersion();
 		connection.executeDMLCommand(schparser.getSourceCode(attribs).simplified(), res);
 
-		if(res.accessTuple(ResultSet::FirstTuple))
-		{
-			do
-			{
-				tuple=changeAttributeNames(res.getTupleValues());
-				obj_attribs.push_back(tuple);
-				tuple.clear();
-			}
-			while(res.accessTuple(ResultSet::NextTuple));
-		}
-
-		return obj_attribs;
+		return getResultAttributes(res);
 	}
 	catch(Exception &e)
 	{
@@ -790,9 +1212,15 @@ QString Catalog::getCommentQuery(const QString &oid_field, bool is_shared_obj)
 	{
 		attribs_map attribs={{Attributes::Oid, oid_field},
 												 {Attributes::SharedObj, (is_shared_obj ? Attributes::True : "")}};
+		QString key = QString("%1:%2:%3").arg(query_id, oid_field, attribs[Attributes::SharedObj]);
+
+		if(cached_subqueries.count(key) == 0)
+		{
+			loadCatalogQuery(query_id);
+			cached_subqueries[key] = schparser.getSourceCode(attribs).simplified();
+		}
 
-		loadCatalogQuery(query_id);
-		return schparser.getSourceCode(attribs).simplified();
+		return cached_subqueries[key];
 	}
 	catch(Exception &e)
 	{
@@ -809,10 +1237,16 @@ QString Catalog::getNotExtObjectQuery(const QString &oid_field)
 	{
 		attribs_map attribs={{Attributes::Oid, oid_field},
 												 {Attributes::ExtObjOids, ext_objs_oids}};
+		QString key = QString("%1:%2").arg(query_id, oid_field);
 
+		// The extension objects oids only change when the connection changes (see setConnection())
+		if(cached_subqueries.count(key) == 0)
+		{
+			loadCatalogQuery(query_id);
+			cached_subqueries[key] = schparser.getSourceCode(attribs).simplified();
+		}
 
-		loadCatalogQuery(query_id);
-		return schparser.getSourceCode(attribs).simplified();
+		return cached_subqueries[key];
 	}
 	catch(Exception &e)
 	{
@@ -847,6 +1281,53 @@ attribs_map Catalog::changeAttributeNames(const attribs_map &attribs)
 	return new_attribs;
 }
 
+std::vector<attribs_map> Catalog::getResultAttributes(ResultSet &res, const attribs_map &extra_attribs)
+{
+	std::vector<attribs_map> attribs;
+	std::vector<QString> attr_names;
+	std::vector<bool> bool_cols;
+	QString attr_name;
+	int col_count = res.getColumnCount();
+
+	if(res.getTupleCount() == 0)
+		return attribs;
+
+	/* The attributes names and the boolean columns are resolved only once for the whole
+	 * result instead of once per tuple (see changeAttributeNames()) */
+	for(int col = 0; col < col_count; col++)
+	{
+		attr_name = res.getColumnName(col);
+		bool_cols.push_back(attr_name.endsWith(BoolField));
+
+		if(bool_cols.back())
+			attr_name.remove(BoolField);
+
+		attr_names.push_back(attr_name.replace('_','-'));
+	}
+
+	attribs.reserve(res.getTupleCount());
+
+	for(auto tuple : res)
+	{
+		attribs_map tup_attribs;
+
+		for(int col = 0; col < col_count; col++)
+		{
+			if(!bool_cols[col])
+				tup_attribs[attr_names[col]] = tuple.getText(col);
+			else
+				tup_attribs[attr_names[col]] = (PgSqlFalse == tuple.getValue(col) ? QString() : Attributes::True);
+		}
+
+		for(auto &itr : extra_attribs)
+			tup_attribs[itr.first] = itr.second;
+
+		attribs.push_back(std::move(tup_attribs));
+	}
+
+	return attribs;
+}
+
 QString Catalog::createOidFilter(const std::vector<unsigned> &oids)
 {
 	QString filter;
@@ -887,6 +1368,38 @@ std::vector<attribs_map> Catalog::getObjectsAttributes(ObjectType obj_type, cons
 	}
 }
 
+std::vector<attribs_map> Catalog::getTablesColumnsAttributes(const std::vector<unsigned> &tab_oids, attribs_map extra_attribs)
+{
+	try
+	{
+		std::vector<unsigned> oids = tab_oids, chunk;
+		std::vector<attribs_map> cols, chunk_cols;
+
+		// Sorting the oids so the chunks (and thus the whole result) keep the table oid ordering
+		std::sort(oids.begin(), oids.end());
+		oids.erase(std::unique(oids.begin(), oids.end()), oids.end());
+
+		for(size_t pos = 0; pos < oids.size(); pos += MaxTablesPerQuery)
+		{
+			chunk.assign(oids.begin() + pos, oids.begin() + std::min<size_t>(pos + MaxTablesPerQuery, oids.size()));
+			extra_attribs[Attributes::FilterTables] = createOidFilter(chunk);
+			chunk_cols = getMultipleAttributes(ObjectType::Column, extra_attribs);
+
+			if(cols.empty())
+				cols = std::move(chunk_cols);
+			else
+				cols.insert(cols.end(), std::make_move_iterator(chunk_cols.begin()), std::make_move_iterator(chunk_cols.end()));
+		}
+
+		return cols;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e,
+						QString("catalog: %1").arg(BaseObject::getSchemaName(ObjectType::Column)));
+	}
+}
+
 attribs_map Catalog::getObjectAttributes(ObjectType obj_type, unsigned oid, const QString sch_name, const QString tab_name, attribs_map extra_attribs)
 {
 	try
@@ -1237,12 +1750,98 @@ QStringList Catalog::getFilterableObjectNames()
 	return names;
 }
 
+std::map<unsigned, QString> Catalog::getTypeNames(Connection &conn, const std::vector<unsigned> &type_ids, bool cached_only)
+{
+	std::map<unsigned, QString> names;
+	QStringList missing_ids;
+	QString conn_id = conn.getConnectionId(true, true);
+	unsigned cache_gen = 0;
+
+	type_names_mtx.lock();
+	cache_gen = type_names_gen[conn_id];
+
+	for(auto &type_id : type_ids)
+	{
+		auto itr = type_names[conn_id].find(type_id);
+
+		if(itr != type_names[conn_id].end())
+			names[type_id] = itr->second;
+		else if(!missing_ids.contains(QString::number(type_id)))
+			missing_ids.append(QString::number(type_id));
+	}
+
+	type_names_mtx.unlock();
+
+	if(cached_only || missing_ids.isEmpty())
+		return names;
+
+	try
+	{
+		ResultSet res;
+
+		// The lock isn't held while querying the server so other connections can use the cache meanwhile
+		conn.executeDMLCommand(GetTypeNamesSql, { QString("{%1}").arg(missing_ids.join(',')) }, res);
+
+		int oid_col = res.getColumnIndex(Attributes::Oid),
+				name_col = res.getColumnIndex(Attributes::Name);
+
+		QMutexLocker locker(&type_names_mtx);
+
+		// The names retrieved before an invalidation of the cache (e.g. in another thread) may be stale so they're not stored
+		bool store = type_names_gen[conn_id] == cache_gen;
+
+		for(auto tuple : res)
+		{
+			names[tuple.getOid(oid_col)] = tuple.getText(name_col);
+
+			if(store)
+				type_names[conn_id][tuple.getOid(oid_col)] = tuple.getText(name_col);
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+
+	return names;
+}
+
+std::map<unsigned, QString> Catalog::getTypeNames(const std::vector<unsigned> &type_ids)
+{
+	try
+	{
+		return getTypeNames(connection, type_ids);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Catalog::invalidateTypeNames(Connection &conn, const QString &sql)
+{
+	static const QRegularExpression type_ddl_regexp("\\b(CREATE|ALTER|DROP)\\b[^;]*\\b(TYPE|DOMAIN|TABLE|VIEW|SEQUENCE|EXTENSION|SCHEMA)\\b",
+																									QRegularExpression::CaseInsensitiveOption);
+
+	if(!sql.isEmpty() && !sql.contains(type_ddl_regexp))
+		return;
+
+	QMutexLocker locker(&type_names_mtx);
+	QString conn_id = conn.getConnectionId(true, true);
+
+	// Lookups running at this moment will not store their results (see getTypeNames())
+	type_names_gen[conn_id]++;
+	type_names.erase(conn_id);
+}
+
 void Catalog::operator = (const Catalog &catalog)
 {
 	try
 	{
 		this->ext_objects=catalog.ext_objects;
+		this->all_ext_objects=catalog.all_ext_objects;
 		this->ext_objs_oids=catalog.ext_objs_oids;
+		this->cached_subqueries=catalog.cached_subqueries;
 		this->connection.setConnectionParams(catalog.connection.getConnectionParams());
 		this->last_sys_oid=catalog.last_sys_oid;
 		this->filter=catalog.filter;
@@ -1252,6 +1851,8 @@ void Catalog::operator = (const Catalog &catalog)
 		this->list_only_sys_objs=catalog.list_only_sys_objs;
 		this->obj_filters=catalog.obj_filters;
 		this->extra_filter_conds=catalog.extra_filter_conds;
+		this->match_signature=catalog.match_signature;
+		this->cache_objs_names=catalog.cache_objs_names;
 		this->connection.connect();
 	}
 	catch(Exception &e)
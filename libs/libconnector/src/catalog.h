@@ -31,6 +31,9 @@ This class is the basis for the reverse engineering feature.
 #include "tableobject.h"
 #include <QTextStream>
 #include <QApplication>
+#include <QMutex>
+#include <unordered_set>
+#include <tuple>
 
 class __libconnector Catalog {
 	public:
@@ -52,6 +55,17 @@ class __libconnector Catalog {
 			ListAllObjects=16
 		};
 
+		//! \brief Stores a catalog query in which the values of the parameterized attributes are replaced by $n parameters
+		struct CompiledQuery {
+			//! \brief Indicates that the attributes values are used in the query in a way that can't be parameterized
+			bool parameterized = false;
+
+			QString sql;
+
+			//! \brief Attributes which values are bound to the parameters $1, $2, ..., $n in that order
+			QStringList param_attribs;
+		};
+
 	private:
 		SchemaParser schparser;
 
@@ -64,19 +78,35 @@ class __libconnector Catalog {
 		//! \brief Query used to retrieve extension objects.
 		GetExtensionObjsSql,
 
+		//! \brief Query used to summarize the row versions of a single system catalog (see getCatalogChangeMarker())
+		GetCatalogRowsSummarySql,
+
+		//! \brief Query used to retrieve the names of the data types which oids are provided as an array parameter (see getTypeNames())
+		GetTypeNamesSql,
+
 		//! \brief This pattern matches the PostgreSQL array values in format [n:n]={a,b,c,d,...} or {a,b,c,d,...}
 		ArrayPattern,
 
 		//! \brief Holds a constant string used to mark invalid filter patterns
 		InvFilterPattern,
 
-		AliasPlaceholder;
+		AliasPlaceholder,
+
+		//! \brief Placeholder used in place of the values of the parameterized attributes while compiling catalog queries
+		ParamPlaceholder;
+
+		/*! \brief Attributes which values are sent as query parameters instead of inline values. The scalar ones are
+		 * used as quoted literals in the catalog queries and the array ones as oid lists in IN (...) expressions */
+		static const QStringList ScalarParamAttribs, ArrayParamAttribs;
 
 		/*! \brief Stores the oid of objects that are created by extension.
 		 * The keys of this map are the names of the extensions that hold objects in the database,
-		 * The values of this map are the list of objects oids. This is used to speed up the checking
+		 * The values of this map are the sets of objects oids. This is used to speed up the checking
 		 * if an certain object is owned by a certain extension (see isExtensionObject()) */
-		std::map<QString, QStringList> ext_objects;
+		std::map<QString, std::unordered_set<unsigned>> ext_objects;
+
+		//! \brief Stores the oids of the objects created by any extension so the checking doesn't need to visit each extension
+		std::unordered_set<unsigned> all_ext_objects;
 
 		/*! \brief Stores in comma seperated way the oids of all objects created by extensions. This
 		 * 	attribute is use to create the catalog query that filters objects that are created or not
@@ -110,6 +140,42 @@ class __libconnector Catalog {
 		//! \brief Store the cached catalog queries
 		static attribs_map catalog_queries;
 
+		//! \brief Guards the catalog queries cache since catalog instances can be used in different threads
+		static QMutex catalog_queries_mtx;
+
+		/*! \brief Stores the compiled catalog queries by the key of their shapes: the query id and type, the server version and
+		 * all the attributes but the values of the parameterized ones (see getCatalogQuery()) */
+		static std::map<QByteArray, CompiledQuery> compiled_queries;
+
+		//! \brief Guards the compiled catalog queries since catalog instances can be used in different threads
+		static QMutex compiled_queries_mtx;
+
+		/*! \brief Caches the names of the data types by their oids for each database. The keys are the
+		 * connection ids (database, host and port) so the cache is shared by all connections to the same database */
+		static std::map<QString, std::map<unsigned, QString>> type_names;
+
+		/*! \brief Generation of the type names cache of each database (connection id), incremented by invalidateTypeNames().
+		 * Names retrieved before an invalidation are not stored in the cache, since they may be outdated */
+		static std::map<QString, unsigned> type_names_gen;
+
+		//! \brief Guards the type names cache since it's shared by connections used in different threads
+		static QMutex type_names_mtx;
+
+		/*! \brief Caches the objects listed by getObjectsNames() for each database (connection id). The lists are keyed
+		 * by the schema and table names, the object type and a signature of the filtering options that affect the listing */
+		static std::map<QString, std::map<std::tuple<QString, QString, ObjectType, QString>, std::vector<attribs_map>>> objects_names;
+
+		/*! \brief Generation of the objects names cache of each database (connection id), incremented by invalidateObjectsNames().
+		 * A listing started before an invalidation is not stored in the cache, since it may hold objects already changed */
+		static std::map<QString, unsigned> objects_names_gen;
+
+		//! \brief Guards the objects names cache since it's shared by catalogs used in different threads
+		static QMutex objects_names_mtx;
+
+		/*! \brief Caches the comment and not extension object subqueries (values) by their ids and oid fields (keys).
+		 * These subqueries are embedded in the catalog queries of almost every object */
+		attribs_map cached_subqueries;
+
 		//! \brief Connection used to query the pg_catalog
 		Connection connection;
 
@@ -131,7 +197,10 @@ class __libconnector Catalog {
 		list_only_sys_objs,
 
 		//! \brief Indicates that the name filtering should occur in the objects' signature instead of their names
-		match_signature;
+		match_signature,
+
+		//! \brief Indicates that the objects listed by getObjectsNames() must be cached (see setObjectsNamesCached())
+		cache_objs_names;
 
 		/*! \brief Load the schema parser buffer with the catalog query using identified by qry_id.
 		The method will cache the catalog query if it's not cached yet (only when use_cached_queries=true) */
@@ -143,8 +212,13 @@ class __libconnector Catalog {
 		ParsersAttributes::CUSTOM_FILTER that will be appended to the current filter expression */
 		void executeCatalogQuery(const QString &qry_type, ObjectType obj_type, ResultSet &result, bool single_result=false, attribs_map attribs=attribs_map());
 
-		//! \brief Returns the catalog query according to the type of the object type provided
-		QString getCatalogQuery(const QString &qry_type, ObjectType obj_type, bool single_result=false, attribs_map attribs=attribs_map());
+		/*! \brief Returns the catalog query according to the type of the object type provided. When the params list is provided
+		 * the values of the parameterized attributes (schema, table and oid filters) are returned in it and the returned query refers
+		 * to them as $1, $2, ..., $n. In that case the query is compiled only once per shape and reused in the next calls */
+		QString getCatalogQuery(const QString &qry_type, ObjectType obj_type, bool single_result=false, attribs_map attribs=attribs_map(), QStringList *params=nullptr);
+
+		//! \brief Runs the schema parser over the catalog query of the object type using the provided attributes
+		QString generateCatalogQuery(ObjectType obj_type, bool single_result, attribs_map &attribs, const QString &custom_filter);
 
 		/*! \brief Recreates the attribute map in such way that attribute names that have
 		underscores have this char replaced by dashes. Another special operation made is to replace
@@ -152,6 +226,11 @@ class __libconnector Catalog {
 		the resultant attribs_map will be passed to XMLParser/SchemaParser which understands bool values as 1 (one) or '' (empty) */
 		attribs_map changeAttributeNames(const attribs_map &attribs);
 
+		/*! \brief Converts all the tuples of the result into attributes maps in the same way changeAttributeNames() does,
+		 * but resolving the attributes names and the boolean columns only once per result. The extra attributes are
+		 * copied to each map */
+		std::vector<attribs_map> getResultAttributes(ResultSet &res, const attribs_map &extra_attribs = attribs_map());
+
 		//! \brief Returns a attribute set for the specified object type and name
 		attribs_map getAttributes(const QString &obj_name, ObjectType obj_type, attribs_map extra_attribs=attribs_map());
 
@@ -166,6 +245,9 @@ class __libconnector Catalog {
 		//! \brief Creates a comma separated string containing all the oids to be filtered
 		QString createOidFilter(const std::vector<unsigned> &oids);
 
+		//! \brief Returns the key of the cached objects names of the provided type, schema and table (see objects_names)
+		std::tuple<QString, QString, ObjectType, QString> getObjectsNamesKey(ObjectType obj_type, const QString &sch_name, const QString &tab_name, const attribs_map &extra_attribs);
+
 	public:
 		Catalog();
 		Catalog(const Catalog &catalog);
@@ -176,6 +258,9 @@ class __libconnector Catalog {
 		//! \brief Stores the null char escaped in format \000
 		static const QString EscapedNullChar;		
 
+		//! \brief Maximum amount of table oids sent in a single query by getTablesColumnsAttributes()
+		static constexpr unsigned MaxTablesPerQuery = 1000;
+
 		//! \brief Changes the current connection used by the catalog
 		void setConnection(Connection &conn);
 
@@ -184,6 +269,19 @@ class __libconnector Catalog {
 	catalog queries will fail */
 		void closeConnection();
 
+		/*! \brief Starts a repeatable read transaction in the catalog connection and exports its snapshot
+		 * so other catalog instances can read the database in the very same state (see importSnapshot()).
+		 * Returns the identifier of the exported snapshot. The snapshot remains valid until releaseSnapshot() is called */
+		QString exportSnapshot();
+
+		/*! \brief Connects the catalog (if needed) and starts a repeatable read transaction that uses
+		 * the snapshot exported by another catalog instance (see exportSnapshot()). This method is meant
+		 * to be used in copies of a catalog already configured via setConnection() */
+		void importSnapshot(const QString &snapshot_id);
+
+		//! \brief Finishes the transaction started by exportSnapshot() or importSnapshot()
+		void releaseSnapshot();
+
 		//! \brief Configures the catalog query filter
 		void setQueryFilter(QueryFilter filter);
 
@@ -204,6 +302,21 @@ class __libconnector Catalog {
 		//! \brief Returns the last system object oid registered on the database
 		unsigned getLastSysObjectOID();
 
+		/*! \brief Replaces the placeholders (values) of the parameterized attributes (keys) in the provided query by $n parameters.
+		 * The returned query is flagged as not parameterized if any placeholder is used in an unexpected way */
+		static CompiledQuery compileQueryParameters(const QString &sql, const attribs_map &placeholders);
+
+		/*! \brief Returns a hash that summarizes the row versions (xmin) and the row counts of the system catalogs
+		 * read by the reverse engineering. Any DDL or ALTER/COMMENT/GRANT command executed on the database changes the
+		 * returned value, as well as a server upgrade, so it can be used to determine if a previously imported model is still up to date.
+		 * The temporary objects created by any session are not taken into account. The value is database-wide, i.e.,
+		 * it doesn't tell which objects changed, so any change invalidates the whole import that relies on it */
+		QString getCatalogChangeMarker();
+
+		/*! \brief Registers the provided oids as objects created by the named extension. The objects of the extensions installed
+		 * in the database are registered by setConnection(), this method is meant to complement that information */
+		void addExtensionObjects(const QString &ext_name, const std::vector<unsigned> &oids);
+
 		//! \brief Returns if the specified oid is amongst the system objects' oids
 		bool isSystemObject(unsigned oid);
 
@@ -237,6 +350,19 @@ class __libconnector Catalog {
 		the specified list of types.	A schema name can be specified in order to filter only objects of the specifed schema */
 		std::vector<attribs_map> getObjectsNames(std::vector<ObjectType> obj_types, const QString &sch_name="", const QString &tab_name="", attribs_map extra_attribs=attribs_map(), bool sort_results=false);
 
+		/*! \brief Enables the caching of the lists retrieved by the vector version of getObjectsNames(). The lists are shared by all
+		 * the catalogs connected to the same database with the caching enabled, so only the types not cached yet are queried.
+		 * Since the cache isn't aware of the changes made in the database, it must be discarded via invalidateObjectsNames() */
+		void setObjectsNamesCached(bool value);
+
+		//! \brief Returns if all the objects of the provided types are cached (see setObjectsNamesCached())
+		bool isObjectsNamesCached(const std::vector<ObjectType> &obj_types, const QString &sch_name="", const QString &tab_name="", attribs_map extra_attribs=attribs_map());
+
+		/*! \brief Discards the objects names cached for the database of the provided connection. When a schema name is provided only
+		 * the lists of that schema (including the ones of its tables) are discarded. When a table name is provided as well only the lists of
+		 * the table's children are discarded */
+		static void invalidateObjectsNames(Connection &conn, const QString &sch_name = "", const QString &tab_name = "");
+
 		//! \brief Returns a set of multiple attributes (several tuples) for the specified object type
 		std::vector<attribs_map> getMultipleAttributes(ObjectType obj_type, attribs_map extra_attribs=attribs_map());
 
@@ -251,6 +377,11 @@ class __libconnector Catalog {
 		and by table name (only when retriving child objects for a specific table) */
 		std::vector<attribs_map> getObjectsAttributes(ObjectType obj_type, const QString &schema="", const QString &table="", const std::vector<unsigned> &filter_oids={}, attribs_map extra_attribs=attribs_map());
 
+		/*! \brief Retrieve the attributes of the columns of several tables at once. The table oids are split in chunks of
+		MaxTablesPerQuery elements and one query is issued per chunk instead of one per table. The resulting
+		list is ordered by table oid and column id (attnum) so the columns of the same table are contiguous */
+		std::vector<attribs_map> getTablesColumnsAttributes(const std::vector<unsigned> &tab_oids, attribs_map extra_attribs=attribs_map());
+
 		//! \brief Returns the attributes for the object specified by its type and OID
 		attribs_map getObjectAttributes(ObjectType obj_type, unsigned oid, const QString sch_name="", const QString tab_name="", attribs_map extra_attribs=attribs_map());
 
@@ -294,6 +425,19 @@ class __libconnector Catalog {
 		//! \brief Returns the object schema names that are able to be filtered
 		static QStringList getFilterableObjectNames();
 
+		/*! \brief Returns the names of the data types with the provided oids. The names are cached per database, so only the
+		 * oids not cached yet are queried using the provided connection, which must be established and idle. When cached_only
+		 * is true no query is executed and only the cached names are returned (useful while the connection is busy) */
+		static std::map<unsigned, QString> getTypeNames(Connection &conn, const std::vector<unsigned> &type_ids, bool cached_only = false);
+
+		//! \brief Returns the names of the data types with the provided oids using the catalog's connection (see the static version)
+		std::map<unsigned, QString> getTypeNames(const std::vector<unsigned> &type_ids);
+
+		/*! \brief Discards the type names cached for the database of the provided connection. When a SQL command is
+		 * provided the cache is discarded only if the command may create, rename or drop data types (DDL on types,
+		 * domains, tables, views, sequences, extensions or schemas) */
+		static void invalidateTypeNames(Connection &conn, const QString &sql = "");
+
 		//! \brief Performs the copy between two catalogs
 		void operator = (const Catalog &catalog);
 };
@@ -0,0 +1,291 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "catalogrecorder.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QFile>
+
+CatalogRecorder::CatalogRecorder()
+{
+	mode = NoRecording;
+	server_version = 0;
+}
+
+QByteArray CatalogRecorder::getQueryKey(const QString &dbname, const QString &sql)
+{
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+
+	hash.addData(dbname.toUtf8());
+	hash.addData(QByteArray(1, '\0'));
+	hash.addData(sql.toUtf8());
+
+	return hash.result();
+}
+
+void CatalogRecorder::startRecording(const QString &filename)
+{
+	stop();
+
+	QMutexLocker locker(&results_mtx);
+
+	this->filename = filename;
+	results.clear();
+	server_version = 0;
+	mode = RecordResults;
+}
+
+void CatalogRecorder::startReplay(const QString &filename)
+{
+	stop();
+
+	QMutexLocker locker(&results_mtx);
+
+	try
+	{
+		this->filename = filename;
+		loadRecording();
+		mode = ReplayResults;
+	}
+	catch(Exception &e)
+	{
+		results.clear();
+		this->filename.clear();
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void CatalogRecorder::stop()
+{
+	QMutexLocker locker(&results_mtx);
+
+	try
+	{
+		if(mode == RecordResults)
+			saveRecording();
+
+		mode = NoRecording;
+		results.clear();
+		filename.clear();
+	}
+	catch(Exception &e)
+	{
+		mode = NoRecording;
+		results.clear();
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+CatalogRecorder::RecorderMode CatalogRecorder::getMode()
+{
+	return mode;
+}
+
+QString CatalogRecorder::getFilename()
+{
+	return filename;
+}
+
+void CatalogRecorder::setServerVersion(int version)
+{
+	server_version = version;
+}
+
+int CatalogRecorder::getServerVersion()
+{
+	return server_version;
+}
+
+void CatalogRecorder::storeResult(const QString &dbname, const QString &sql, const PGresult *result)
+{
+	if(mode != RecordResults || !result)
+		return;
+
+	RecordedResult rec_res;
+	int col_cnt = PQnfields(result), col = 0, tup = 0;
+
+	rec_res.tuple_count = PQntuples(result);
+	rec_res.col_names.reserve(col_cnt);
+	rec_res.col_types.reserve(col_cnt);
+	rec_res.col_formats.reserve(col_cnt);
+	rec_res.values.reserve(static_cast<size_t>(col_cnt) * rec_res.tuple_count);
+
+	for(col = 0; col < col_cnt; col++)
+	{
+		rec_res.col_names.push_back(QByteArray(PQfname(result, col)));
+		rec_res.col_types.push_back(PQftype(result, col));
+		rec_res.col_formats.push_back(PQfformat(result, col));
+	}
+
+	for(tup = 0; tup < rec_res.tuple_count; tup++)
+	{
+		for(col = 0; col < col_cnt; col++)
+		{
+			if(PQgetisnull(result, tup, col))
+				rec_res.values.push_back(QByteArray());
+			else
+				rec_res.values.push_back(QByteArray(PQgetvalue(result, tup, col), PQgetlength(result, tup, col)));
+		}
+	}
+
+	QMutexLocker locker(&results_mtx);
+	results[getQueryKey(dbname, sql)] = std::move(rec_res);
+}
+
+PGresult *CatalogRecorder::createResult(const QString &dbname, const QString &sql)
+{
+	QMutexLocker locker(&results_mtx);
+	auto itr = results.find(getQueryKey(dbname, sql));
+
+	if(itr == results.end())
+		throw Exception(Exception::getErrorMessage(ErrorCode::QueryNotRecorded).arg(filename),
+										ErrorCode::QueryNotRecorded, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, sql);
+
+	RecordedResult &rec_res = itr->second;
+	int col_cnt = rec_res.col_names.size(), col = 0, tup = 0;
+	std::vector<PGresAttDesc> attribs(col_cnt);
+	PGresult *result = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+	bool success = (result != nullptr);
+
+	for(col = 0; col < col_cnt; col++)
+	{
+		attribs[col].name = rec_res.col_names[col].data();
+		attribs[col].tableid = 0;
+		attribs[col].columnid = 0;
+		attribs[col].format = rec_res.col_formats[col];
+		attribs[col].typid = rec_res.col_types[col];
+		attribs[col].typlen = -1;
+		attribs[col].atttypmod = -1;
+	}
+
+	// The attributes and values are copied by libpq to the result's own storage
+	if(success)
+		success = PQsetResultAttrs(result, col_cnt, attribs.data());
+
+	for(tup = 0; success && tup < rec_res.tuple_count; tup++)
+	{
+		for(col = 0; success && col < col_cnt; col++)
+		{
+			QByteArray &value = rec_res.values[(static_cast<size_t>(tup) * col_cnt) + col];
+			success = PQsetvalue(result, tup, col, value.isNull() ? nullptr : value.data(), value.isNull() ? -1 : value.size());
+		}
+	}
+
+	if(!success)
+	{
+		PQclear(result);
+		throw Exception(ErrorCode::AsgNotAllocatedSQLResult, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	}
+
+	return result;
+}
+
+void CatalogRecorder::saveRecording()
+{
+	QSaveFile output(filename);
+	QByteArray buffer;
+	QDataStream data(&buffer, QIODevice::WriteOnly);
+
+	data << static_cast<qint32>(server_version) << static_cast<quint32>(results.size());
+
+	for(auto &itr : results)
+	{
+		RecordedResult &rec_res = itr.second;
+
+		data << itr.first << static_cast<quint32>(rec_res.col_names.size()) << static_cast<qint32>(rec_res.tuple_count);
+
+		for(size_t col = 0; col < rec_res.col_names.size(); col++)
+			data << rec_res.col_names[col] << static_cast<quint32>(rec_res.col_types[col]) << static_cast<qint8>(rec_res.col_formats[col]);
+
+		for(auto &value : rec_res.values)
+			data << value;
+	}
+
+	if(!output.open(QFile::WriteOnly))
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(filename),
+										ErrorCode::FileDirectoryNotWritten, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, output.errorString());
+
+	QDataStream file_data(&output);
+
+	// Catalog results are highly redundant (names, types, booleans) so the payload is compressed
+	file_data << FileSignature << FileVersion << qCompress(buffer);
+
+	if(file_data.status() != QDataStream::Ok || !output.commit())
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(filename),
+										ErrorCode::FileDirectoryNotWritten, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, output.errorString());
+}
+
+void CatalogRecorder::loadRecording()
+{
+	QFile input(filename);
+	QByteArray buffer, key;
+	quint32 signature = 0, res_cnt = 0, col_cnt = 0, type_id = 0;
+	quint16 version = 0;
+	qint32 srv_version = 0, tup_cnt = 0;
+	qint8 format = 0;
+
+	results.clear();
+
+	if(!input.open(QFile::ReadOnly))
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotAccessed).arg(filename),
+										ErrorCode::FileDirectoryNotAccessed, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, input.errorString());
+
+	QDataStream file_data(&input);
+	file_data >> signature >> version >> buffer;
+
+	if(signature != FileSignature || version != FileVersion || file_data.status() != QDataStream::Ok)
+		throw Exception(Exception::getErrorMessage(ErrorCode::InvCatalogRecordingFile).arg(filename),
+										ErrorCode::InvCatalogRecordingFile, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	buffer = qUncompress(buffer);
+	QDataStream data(buffer);
+	data >> srv_version >> res_cnt;
+
+	for(quint32 res_idx = 0; res_idx < res_cnt && data.status() == QDataStream::Ok; res_idx++)
+	{
+		RecordedResult rec_res;
+
+		data >> key >> col_cnt >> tup_cnt;
+		rec_res.tuple_count = tup_cnt;
+
+		for(quint32 col = 0; col < col_cnt && data.status() == QDataStream::Ok; col++)
+		{
+			rec_res.col_names.push_back(QByteArray());
+			data >> rec_res.col_names.back() >> type_id >> format;
+			rec_res.col_types.push_back(type_id);
+			rec_res.col_formats.push_back(format);
+		}
+
+		rec_res.values.resize(static_cast<size_t>(col_cnt) * tup_cnt);
+
+		for(auto &value : rec_res.values)
+			data >> value;
+
+		results[key] = std::move(rec_res);
+	}
+
+	if(buffer.isEmpty() || data.status() != QDataStream::Ok)
+	{
+		results.clear();
+		throw Exception(Exception::getErrorMessage(ErrorCode::InvCatalogRecordingFile).arg(filename),
+										ErrorCode::InvCatalogRecordingFile, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	}
+
+	server_version = srv_version;
+}
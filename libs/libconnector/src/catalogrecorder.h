@@ -0,0 +1,125 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libconnector
+\class CatalogRecorder
+\brief Implements the storage used to record the results of the queries executed by the connections (mainly catalog queries)
+in a compact binary file and to replay them later without a running server. While recording, each result set is
+stored under a key built from the database name and the query text. While replaying, the connections don't reach
+any server and the results are recreated from the file using the same keys (see Connection::startReplay()).
+*/
+
+#ifndef CATALOG_RECORDER_H
+#define CATALOG_RECORDER_H
+
+#include "connectorglobal.h"
+#include "exception.h"
+#include <libpq-fe.h>
+#include <QMutex>
+#include <map>
+#include <vector>
+
+class __libconnector CatalogRecorder {
+	public:
+		enum RecorderMode: unsigned {
+			//! \brief The queries are executed normally in the server and nothing is recorded
+			NoRecording,
+
+			//! \brief The results of the queries executed in the server are stored in the recording
+			RecordResults,
+
+			//! \brief The queries are not sent to any server, their results are retrieved from the recording
+			ReplayResults
+		};
+
+	private:
+		//! \brief Signature written in the beginning of the recording files
+		static constexpr quint32 FileSignature = 0x50474d52;
+
+		//! \brief Version of the recording file format
+		static constexpr quint16 FileVersion = 1;
+
+		//! \brief Stores the data of a single recorded result set
+		struct RecordedResult {
+			std::vector<QByteArray> col_names;
+			std::vector<unsigned> col_types;
+			std::vector<int> col_formats;
+			int tuple_count = 0;
+
+			//! \brief Values of all the tuples stored row by row. Null values are stored as null byte arrays
+			std::vector<QByteArray> values;
+		};
+
+		RecorderMode mode;
+
+		//! \brief Recording file currently in use
+		QString filename;
+
+		//! \brief Version of the recorded server in the same format returned by PQserverVersion()
+		int server_version;
+
+		//! \brief Recorded results (value) by the key of the query that generated them (key)
+		std::map<QByteArray, RecordedResult> results;
+
+		//! \brief Guards the recorded results since connections can be used in different threads
+		QMutex results_mtx;
+
+		//! \brief Returns the key used to store the result of the query executed in the provided database
+		static QByteArray getQueryKey(const QString &dbname, const QString &sql);
+
+		//! \brief Writes the recorded results to the current recording file
+		void saveRecording();
+
+		//! \brief Reads the recorded results from the current recording file
+		void loadRecording();
+
+	public:
+		CatalogRecorder();
+
+		/*! \brief Starts recording the results of the queries in the provided file. The file is
+		 * only written when stop() is called. Any previous recording or replay is stopped */
+		void startRecording(const QString &filename);
+
+		/*! \brief Loads the recording stored in the provided file and starts serving the results
+		 * from it. Any previous recording or replay is stopped. Raises an error if the file is invalid */
+		void startReplay(const QString &filename);
+
+		//! \brief Stops the current recording (saving it to the file) or replay
+		void stop();
+
+		RecorderMode getMode();
+
+		QString getFilename();
+
+		//! \brief Stores the version of the server being recorded (see PQserverVersion())
+		void setServerVersion(int version);
+
+		//! \brief Returns the version of the recorded server
+		int getServerVersion();
+
+		/*! \brief Stores a copy of the provided result under the key of the database name and query.
+		 * This method has no effect if the recorder isn't in recording mode */
+		void storeResult(const QString &dbname, const QString &sql, const PGresult *result);
+
+		/*! \brief Creates a new result from the recorded data of the database name and query. The caller
+		 * is responsible to free the returned result. Raises an error if the query wasn't recorded */
+		PGresult *createResult(const QString &dbname, const QString &sql);
+};
+
+#endif
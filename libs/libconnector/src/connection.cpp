@@ -17,11 +17,13 @@
 */
 
 #include "connection.h"
+#include "connectionpool.h"
 #include <QTextStream>
 #include <iostream>
 #include "attributes.h"
 #include "globalattributes.h"
 #include "pgsqlversions.h"
+#include "sqlstatementsplitter.h"
 
 const QString Connection::SslDisable=QString("disable");
 const QString Connection::SslAllow=QString("allow");
@@ -58,10 +60,14 @@ bool Connection::silence_conn_err=true;
 bool Connection::ignore_db_version=false;
 
 QStringList Connection::notices;
+QMutex Connection::notices_mtx;
+CatalogRecorder Connection::recorder;
 
 Connection::Connection()
 {
 	connection=nullptr;
+	replay_conn=false;
+	prepared_count=0;
 	auto_browse_db=false;	
 	cmd_exec_timeout=0;
 
@@ -85,7 +91,9 @@ Connection::~Connection()
 {
 	if(connection)
 	{
-		PQfinish(connection);
+		if(!ConnectionPool::release(connection, connection_str))
+			PQfinish(connection);
+
 		connection=nullptr;
 	}
 }
@@ -168,11 +176,39 @@ void Connection::generateConnectionString()
 		connection_str.clear();
 }
 
+void Connection::clearNotices()
+{
+	QMutexLocker locker(&notices_mtx);
+	notices.clear();
+}
+
 void Connection::noticeProcessor(void *, const char *message)
 {
+	QMutexLocker locker(&notices_mtx);
 	notices.push_back(QString(message));
 }
 
+void Connection::noticeReceiver(void *, const PGresult *result)
+{
+	noticeProcessor(nullptr, PQresultErrorMessage(result));
+}
+
+void Connection::configureNoticeOutput(PGconn *connection)
+{
+	if(!connection)
+		return;
+
+	/* The receiver is always replaced (instead of the notice processor) since a custom receiver
+	 * prevents libpq from calling any processor, so a receiver that discards the notices installed
+	 * by a previous user of a pooled connection would hide them from the next one */
+	if(!notice_enabled)
+		//Completely disable notice/warnings in the connection
+		PQsetNoticeReceiver(connection, disableNoticeOutput, nullptr);
+	else
+		//Enable the notice/warnings in the connection by pushing them into the list of generated notices
+		PQsetNoticeReceiver(connection, noticeReceiver, nullptr);
+}
+
 void Connection::validateConnectionStatus()
 {
 	if(cmd_exec_timeout > 0)
@@ -187,7 +223,7 @@ void Connection::validateConnectionStatus()
 		}
 	}
 
-	if(PQstatus(connection)==CONNECTION_BAD)
+	if(!replay_conn && PQstatus(connection)==CONNECTION_BAD)
 		throw Exception(Exception::getErrorMessage(ErrorCode::ConnectionBroken)
 										.arg(connection_params[ParamServerFqdn].isEmpty() ? connection_params[ParamServerIp] : connection_params[ParamServerFqdn])
 										.arg(connection_params[ParamPort]),
@@ -224,6 +260,40 @@ bool Connection::isConnErrorSilenced()
 	return silence_conn_err;
 }
 
+void Connection::startRecording(const QString &filename)
+{
+	recorder.startRecording(filename);
+}
+
+void Connection::startReplay(const QString &filename)
+{
+	try
+	{
+		recorder.startReplay(filename);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Connection::stopRecording()
+{
+	try
+	{
+		recorder.stop();
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+bool Connection::isReplayEnabled()
+{
+	return recorder.getMode() == CatalogRecorder::ReplayResults;
+}
+
 void Connection::setIgnoreDbVersion(bool ignore)
 {
 	ignore_db_version = ignore;
@@ -241,7 +311,7 @@ void Connection::connect()
 		thus an error is raised */
 	if(connection_str.isEmpty())
 		throw Exception(ErrorCode::ConnectionNotConfigured, __PRETTY_FUNCTION__, __FILE__, __LINE__);
-	else if(connection)
+	else if(connection || replay_conn)
 	{
 		if(!silence_conn_err)
 			throw Exception(ErrorCode::ConnectionAlreadyStablished, __PRETTY_FUNCTION__, __FILE__, __LINE__);
@@ -254,8 +324,27 @@ void Connection::connect()
 		}
 	}
 
+	// When replaying a recording there's no server to connect to
+	if(isReplayEnabled())
+	{
+		replay_conn=true;
+		last_cmd_execution=QDateTime::currentDateTime();
+		clearNotices();
+		return;
+	}
+
+	//Reuses an idle connection opened with the same parameters, if any, avoiding the connection handshake
+	connection=ConnectionPool::acquire(connection_str);
+
 	//Try to connect to the database
-	connection=PQconnectdb(connection_str.toStdString().c_str());
+	if(!connection)
+	{
+		connection=PQconnectdb(connection_str.toStdString().c_str());
+
+		if(connection && PQstatus(connection)==CONNECTION_OK)
+			ConnectionPool::add(connection, getConnectionId(true));
+	}
+
 	last_cmd_execution=QDateTime::currentDateTime();
 
 	/* If the connection descriptor has not been allocated or if the connection state
@@ -268,14 +357,11 @@ void Connection::connect()
 						__PRETTY_FUNCTION__, __FILE__, __LINE__);
 	}
 
-	notices.clear();
+	clearNotices();
+	configureNoticeOutput(connection);
 
-	if(!notice_enabled)
-		//Completely disable notice/warnings in the connection
-		PQsetNoticeReceiver(connection, disableNoticeOutput, nullptr);
-	else
-		//Enable the notice/warnings in the connection by pushing them into the list of generated notices
-		PQsetNoticeProcessor(connection, noticeProcessor, nullptr);
+	if(recorder.getMode() == CatalogRecorder::RecordResults)
+		recorder.setServerVersion(PQserverVersion(connection));
 
 	// Aborts the connection is PostgreSQL 9x is detected
 	QString pgver = getPgSQLVersion(true);
@@ -290,10 +376,14 @@ void Connection::connect()
 
 void Connection::close()
 {
+	replay_conn=false;
+	prepared_stmts.clear();
+	prepared_count=0;
+
 	if(connection)
 	{
-		//Finalizes the connection if the status is OK
-		if(PQstatus(connection) == CONNECTION_OK)
+		//Finalizes the connection if it can't be returned to the pool
+		if(!ConnectionPool::release(connection, connection_str))
 			PQfinish(connection);
 
 		connection=nullptr;
@@ -303,12 +393,19 @@ void Connection::close()
 
 void Connection::reset()
 {
+	if(replay_conn)
+		return;
+
 	//Raise an erro in case the user try to reset a not opened connection
 	if(!connection)
 		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
 
 	//Reinicia a conexão
 	PQreset(connection);
+
+	//The statements prepared in the previous session don't exist in the new one
+	prepared_stmts.clear();
+	prepared_count=0;
 }
 
 QString Connection::getConnectionParam(const QString &param)
@@ -325,12 +422,12 @@ attribs_map Connection::getServerInfo()
 {
 	attribs_map info;
 
-	if(!connection)
+	if(!connection && !replay_conn)
 		throw Exception(ErrorCode::OprNotAllocatedConnection,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	info[ServerPid]=QString::number(PQbackendPID(connection));
+	info[ServerPid]=QString::number(replay_conn ? 0 : PQbackendPID(connection));
 	info[ServerVersion]=getPgSQLVersion();
-	info[ServerProtocol]=QString::number(PQprotocolVersion(connection));
+	info[ServerProtocol]=QString::number(replay_conn ? 3 : PQprotocolVersion(connection));
 
 	return info;
 }
@@ -375,7 +472,7 @@ QString Connection::getConnectionId(bool host_port_only, bool incl_db_name, bool
 
 bool Connection::isStablished()
 {
-	return (connection != nullptr);
+	return (connection != nullptr || replay_conn);
 }
 
 bool Connection::isConfigured()
@@ -392,10 +489,10 @@ QString  Connection::getPgSQLVersion(bool major_only)
 {
 	QString raw_ver, fmt_ver;
 
-	if(!connection)
+	if(!connection && !replay_conn)
 		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
 
-	raw_ver=QString("%1").arg(PQserverVersion(connection));
+	raw_ver=QString("%1").arg(replay_conn ? recorder.getServerVersion() : PQserverVersion(connection));
 
 	//If the version is 10+
 	if(raw_ver.contains(QRegularExpression("^((1)[0-9])(.)+")))
@@ -424,40 +521,130 @@ QString  Connection::getPgSQLVersion(bool major_only)
 
 QStringList Connection::getNotices()
 {
+	QMutexLocker locker(&notices_mtx);
 	return notices;
 }
 
 void Connection::executeDMLCommand(const QString &sql, ResultSet &result)
+{
+	executeDMLCommand(sql, QStringList(), result);
+}
+
+void Connection::executeDMLCommand(const QString &sql, const QStringList &params, ResultSet &result)
 {
 	ResultSet *new_res=nullptr;
 	PGresult *sql_res=nullptr;
+	QString rec_sql=sql;
+	QByteArray stmt_name;
+	bool prepare_stmt=false;
 
 	//Raise an error in case the user try to close a not opened connection
-	if(!connection)
+	if(!connection && !replay_conn)
 		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
 
 	validateConnectionStatus();
-	notices.clear();
+	clearNotices();
+	releaseDatabaseSessions(sql);
+
+	if(!params.isEmpty())
+	{
+		// The parameters values are part of the key of the recorded results
+		rec_sql += QChar('\0') + params.join(QChar('\0'));
+
+		/* Commands executed only once don't pay the extra round trip of the statement preparation,
+		 * so the statement is prepared only in the second execution and reused from there on. The
+		 * replayed connections follow the same steps, only without reaching the server */
+		if(prepared_stmts.count(sql) == 0)
+			prepared_stmts[sql]=QByteArray();
+		else
+		{
+			stmt_name=prepared_stmts[sql];
+
+			if(stmt_name.isEmpty())
+			{
+				stmt_name=QByteArray("pgmodeler_stmt_") + QByteArray::number(prepared_count);
+				prepare_stmt=true;
+			}
+		}
+	}
 
 	//Alocates a new result to receive the resultset returned by the sql command
-	sql_res=PQexec(connection, sql.toStdString().c_str());
+	if(replay_conn)
+		sql_res=recorder.createResult(connection_params[ParamDbName], rec_sql);
+	else if(params.isEmpty())
+		sql_res=PQexec(connection, sql.toStdString().c_str());
+	else
+	{
+		std::vector<QByteArray> values;
+		std::vector<const char *> values_ptrs;
+
+		for(auto &param : params)
+			values.push_back(param.toUtf8());
+
+		/* The pointers are retrieved only after filling the values vector
+		 * since it may be reallocated while new values are inserted */
+		for(auto &value : values)
+			values_ptrs.push_back(value.constData());
+
+		if(stmt_name.isEmpty())
+		{
+			sql_res=PQexecParams(connection, sql.toStdString().c_str(), values_ptrs.size(),
+													 nullptr, values_ptrs.data(), nullptr, nullptr, 0);
+		}
+		else
+		{
+			if(prepare_stmt)
+			{
+				sql_res=PQprepare(connection, stmt_name.constData(), sql.toStdString().c_str(), values_ptrs.size(), nullptr);
+
+				if(PQresultStatus(sql_res) != PGRES_COMMAND_OK)
+				{
+					QString field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+
+					PQclear(sql_res);
+					throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+													.arg(PQerrorMessage(connection)),
+													ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+				}
+
+				PQclear(sql_res);
+			}
+
+			sql_res=PQexecPrepared(connection, stmt_name.constData(), values_ptrs.size(),
+														 values_ptrs.data(), nullptr, nullptr, 0);
+		}
+	}
+
+	if(prepare_stmt)
+	{
+		prepared_stmts[sql]=stmt_name;
+		prepared_count++;
+	}
 
 	//Prints the SQL to stdout when the flag is active
 	if(print_sql)
 	{
 		QTextStream out(stdout);
 		out << QString("\n---\n") << sql << Qt::endl;
+
+		for(int idx=0; idx < params.size(); idx++)
+			out << QString("-- $%1 = %2").arg(idx + 1).arg(params[idx]) << Qt::endl;
 	}
 
 	//Raise an error in case the command sql execution is not sucessful
-	if(strlen(PQerrorMessage(connection))>0)
+	if(!replay_conn && strlen(PQerrorMessage(connection))>0)
 	{
+		QString field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+
+		PQclear(sql_res);
 		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
 						.arg(PQerrorMessage(connection)),
-						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr,
-						QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE)));
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
 	}
 
+	if(!replay_conn && recorder.getMode() == CatalogRecorder::RecordResults)
+		recorder.storeResult(connection_params[ParamDbName], rec_sql, sql_res);
+
 	//Generates the resultset based on the sql result descriptor
 	new_res=new ResultSet(sql_res);
 
@@ -469,16 +656,37 @@ void Connection::executeDMLCommand(const QString &sql, ResultSet &result)
 	PQclear(sql_res);
 }
 
+QByteArray Connection::getPreparedStatement(const QString &sql)
+{
+	auto itr = prepared_stmts.find(sql);
+	return itr != prepared_stmts.end() ? itr->second : QByteArray();
+}
+
 void Connection::executeDDLCommand(const QString &sql)
 {
 	PGresult *sql_res=nullptr;
 
 	//Raise an error in case the user try to close a not opened connection
-	if(!connection)
+	if(!connection && !replay_conn)
 		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
 
 	validateConnectionStatus();
-	notices.clear();
+	clearNotices();
+
+	/* DDL commands don't produce results to be replayed (e.g. transaction control and
+	 * temporary objects used by catalog queries) so they are just skipped */
+	if(replay_conn)
+	{
+		if(print_sql)
+		{
+			QTextStream out(stdout);
+			out << QString("\n---\n") << sql << Qt::endl;
+		}
+
+		return;
+	}
+
+	releaseDatabaseSessions(sql);
 	sql_res=PQexec(connection, sql.toStdString().c_str());
 
 	//Prints the SQL to stdout when the flag is active
@@ -503,6 +711,406 @@ void Connection::executeDDLCommand(const QString &sql)
 	PQclear(sql_res);
 }
 
+void Connection::releaseDatabaseSessions(const QString &sql)
+{
+	static const QRegularExpression db_cmd_regexp("\\b(CREATE|ALTER|DROP)\\s+DATABASE\\b", QRegularExpression::CaseInsensitiveOption);
+
+	/* The idle sessions kept by the pool would prevent databases from being dropped, renamed or used as template
+	 * (the server refuses it while other sessions are connected), so they're closed before database level commands */
+	if(!replay_conn && sql.contains(db_cmd_regexp))
+		ConnectionPool::clear(getConnectionId(true));
+}
+
+void Connection::executeDDLCommands(const QStringList &sql_cmds, const std::function<void(int, Exception *)> &cmd_handler)
+{
+	std::function<bool(const QStringList &)> exec_batch;
+
+	if(!connection && !replay_conn)
+		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	if(!replay_conn)
+	{
+		for(auto &sql : sql_cmds)
+			releaseDatabaseSessions(sql);
+
+#ifdef LIBPQ_HAS_PIPELINING
+		exec_batch = [&](const QStringList &cmds) {
+			return executeDDLPipeline(cmds);
+		};
+#endif
+	}
+
+	try
+	{
+		runDDLCommands(sql_cmds, exec_batch, [&](const QString &sql) {
+			executeDDLCommand(sql);
+		}, cmd_handler);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e, e.getExtraInfo());
+	}
+}
+
+void Connection::runDDLCommands(const QStringList &sql_cmds, const std::function<bool(const QStringList &)> &exec_batch,
+																const std::function<void(const QString &)> &exec_cmd, const std::function<void(int, Exception *)> &cmd_handler)
+{
+	int idx = 0, end_idx = 0, cmd_cnt = sql_cmds.size();
+	bool use_batch = exec_batch != nullptr;
+
+	//Executes a single command forwarding the error raised by it (if any) to the handler
+	auto exec_single = [&](int cmd_idx) {
+		try
+		{
+			exec_cmd(sql_cmds[cmd_idx]);
+		}
+		catch(Exception &e)
+		{
+			//Commands that don't reach the server are not forwarded to the handler
+			if(e.getErrorCode() != ErrorCode::SQLCommandNotExecuted)
+				throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+
+			cmd_handler(cmd_idx, &e);
+			return;
+		}
+
+		cmd_handler(cmd_idx, nullptr);
+	};
+
+	while(idx < cmd_cnt)
+	{
+		end_idx = idx;
+
+		//Gathering the sequence of commands that can be sent in the same batch
+		while(use_batch && end_idx < cmd_cnt &&
+					isSingleStatement(sql_cmds[end_idx]) && isTransactionBlockAllowed(sql_cmds[end_idx]))
+			end_idx++;
+
+		if(end_idx - idx > 1)
+		{
+			try
+			{
+				use_batch = exec_batch(sql_cmds.mid(idx, end_idx - idx));
+			}
+			catch(Exception &e)
+			{
+				if(e.getErrorCode() != ErrorCode::SQLCommandNotExecuted)
+					throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+
+				/* The batch was rolled back as a whole, so its commands are executed again one by one
+				 * in order to determine the failed one and let the handler decide if the remaining ones
+				 * must be executed, exactly as if the batch was never sent */
+				for(; idx < end_idx; idx++)
+					exec_single(idx);
+
+				continue;
+			}
+
+			if(use_batch)
+			{
+				for(; idx < end_idx; idx++)
+					cmd_handler(idx, nullptr);
+
+				continue;
+			}
+		}
+
+		exec_single(idx);
+		idx++;
+	}
+}
+
+bool Connection::executeDDLPipeline(const QStringList &sql_cmds)
+{
+#ifdef LIBPQ_HAS_PIPELINING
+	PGresult *sql_res = nullptr;
+	int sent_cnt = 0;
+	QString err_code, err_msg;
+	bool sync_ok = false;
+
+	validateConnectionStatus();
+	clearNotices();
+
+	//The server or the connection state doesn't allow pipelining, the commands will be executed one by one
+	if(PQenterPipelineMode(connection) != 1)
+		return false;
+
+	/* All the commands are followed by a single sync point so they run in the same implicit transaction.
+	 * If one of them fails the server rolls back the ones already executed and skips the remaining ones */
+	for(auto &sql : sql_cmds)
+	{
+		if(PQsendQueryParams(connection, sql.toStdString().c_str(),
+												 0, nullptr, nullptr, nullptr, nullptr, 0) != 1)
+			break;
+
+		sent_cnt++;
+
+		if(print_sql)
+		{
+			QTextStream out(stdout);
+			out << QString("\n---\n") << sql << Qt::endl;
+		}
+	}
+
+	//Some command could not be sent so the sync point is not sent either, the transaction is never committed
+	if(sent_cnt < sql_cmds.size() || PQpipelineSync(connection) != 1)
+	{
+		err_msg = PQerrorMessage(connection);
+		PQexitPipelineMode(connection);
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted).arg(err_msg),
+										ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	}
+
+	//Reading the results of each command (commands after a failed one return PGRES_PIPELINE_ABORTED)
+	for(int idx = 0; idx < sent_cnt; idx++)
+	{
+		while((sql_res = PQgetResult(connection)))
+		{
+			if(PQresultStatus(sql_res) == PGRES_FATAL_ERROR && err_msg.isEmpty())
+			{
+				err_code = PQresultErrorField(sql_res, PG_DIAG_SQLSTATE);
+				err_msg = PQresultErrorMessage(sql_res);
+			}
+
+			PQclear(sql_res);
+		}
+	}
+
+	sql_res = PQgetResult(connection);
+	sync_ok = sql_res && PQresultStatus(sql_res) == PGRES_PIPELINE_SYNC;
+	PQclear(sql_res);
+	PQexitPipelineMode(connection);
+
+	if(!err_msg.isEmpty())
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted).arg(err_msg),
+										ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, err_code);
+
+	/* Without the result of the sync point it's not possible to know if the transaction was
+	 * committed, so the commands can't be safely executed again one by one */
+	if(!sync_ok)
+		throw Exception(Exception::getErrorMessage(ErrorCode::ConnectionBroken)
+										.arg(connection_params[ParamServerFqdn].isEmpty() ? connection_params[ParamServerIp] : connection_params[ParamServerFqdn])
+										.arg(connection_params[ParamPort]),
+										ErrorCode::ConnectionBroken, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	return true;
+#else
+	Q_UNUSED(sql_cmds)
+	return false;
+#endif
+}
+
+bool Connection::isTransactionBlockAllowed(const QString &sql)
+{
+	/* Commands that can't run inside a transaction block, or whose effects can't be used by
+	 * the further commands of the same transaction (the values added to an enum). Procedures
+	 * may commit or roll back the current transaction so CALL is never batched, as well as the
+	 * DO blocks that do the same */
+	static const QRegularExpression no_tx_regexp(QString("^(CREATE|DROP)\\s+(DATABASE|TABLESPACE)\\b|"
+																											 "^ALTER\\s+DATABASE\\b.+\\bSET\\s+TABLESPACE\\b|"
+																											 "^(CREATE\\s+(UNIQUE\\s+)?INDEX|DROP\\s+INDEX)\\s+.*\\bCONCURRENTLY\\b|"
+																											 "^REINDEX\\b.*\\bCONCURRENTLY\\b|"
+																											 "^REINDEX\\s*(\\(.*?\\)\\s*)?(DATABASE|SYSTEM)\\b|"
+																											 "^CALL\\b|"
+																											 "^DO\\b.*\\b(COMMIT|ROLLBACK)\\b|"
+																											 "^ALTER\\s+TABLE\\b.+\\bDETACH\\s+PARTITION\\b.+\\bCONCURRENTLY\\b|"
+																											 "^ALTER\\s+TYPE\\b.+\\bADD\\s+VALUE\\b|"
+																											 "^((CREATE|ALTER|DROP)\\s+SUBSCRIPTION|ALTER\\s+SYSTEM|VACUUM|"
+																											 "BEGIN|START\\s+TRANSACTION|COMMIT|END|ROLLBACK|ABORT|SAVEPOINT|RELEASE|PREPARE\\s+TRANSACTION)\\b"),
+																							 QRegularExpression::CaseInsensitiveOption | QRegularExpression::DotMatchesEverythingOption);
+	static const QRegularExpression leading_regexp(QString("^(\\s+|--[^\\n]*(\\n|$)|/\\*.*?\\*/)+"),
+																								 QRegularExpression::DotMatchesEverythingOption);
+	QString cmd = sql;
+
+	//Removing the leading whitespaces and comments so the command keywords can be checked
+	cmd.remove(leading_regexp);
+	return !no_tx_regexp.match(cmd).hasMatch();
+}
+
+bool Connection::isSingleStatement(const QString &sql)
+{
+	SQLStatementSplitter splitter;
+	SQLStatementSplitter::Span span;
+	int stmt_cnt = 0;
+
+	splitter.setBuffer(sql.toUtf8());
+
+	while(stmt_cnt < 2 && splitter.nextSpan(span))
+		stmt_cnt++;
+
+	return stmt_cnt <= 1;
+}
+
+void Connection::executeCopyFrom(const QString &copy_cmd, const std::function<bool(QByteArray &)> &data_provider)
+{
+	PGresult *sql_res=nullptr;
+	QByteArray buffer;
+	QString error, field;
+	bool more_data=true;
+
+	//Raise an error in case the user try to close a not opened connection
+	if(!connection && !replay_conn)
+		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	validateConnectionStatus();
+	clearNotices();
+
+	// There's no server to receive the data when replaying a recording
+	if(replay_conn)
+		return;
+
+	sql_res=PQexec(connection, copy_cmd.toStdString().c_str());
+
+	//Prints the SQL to stdout when the flag is active
+	if(print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\n") << copy_cmd << Qt::endl;
+	}
+
+	if(PQresultStatus(sql_res) != PGRES_COPY_IN)
+	{
+		field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+		error = PQerrorMessage(connection);
+
+		PQclear(sql_res);
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted).arg(error),
+										ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+	}
+
+	PQclear(sql_res);
+
+	try
+	{
+		while(more_data)
+		{
+			buffer.clear();
+			more_data=data_provider(buffer);
+
+			if(!buffer.isEmpty() && PQputCopyData(connection, buffer.constData(), buffer.size()) != 1)
+				throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+												.arg(PQerrorMessage(connection)),
+												ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+		}
+	}
+	catch(Exception &e)
+	{
+		// Aborting the copy makes the server discard the data sent so far and leaves the connection ready for new commands
+		PQputCopyEnd(connection, e.getErrorMessage().toUtf8().constData());
+
+		while((sql_res=PQgetResult(connection)))
+			PQclear(sql_res);
+
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+	}
+
+	PQputCopyEnd(connection, nullptr);
+
+	// The rows sent are validated only when the copy ends, so the final result tells if they were accepted
+	while((sql_res=PQgetResult(connection)))
+	{
+		if(PQresultStatus(sql_res) != PGRES_COMMAND_OK && error.isEmpty())
+		{
+			error = PQresultErrorMessage(sql_res);
+			field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+		}
+
+		PQclear(sql_res);
+	}
+
+	if(!error.isEmpty())
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted).arg(error),
+										ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+}
+
+void Connection::executeCopyTo(const QString &copy_cmd, const std::function<bool(const char *, int)> &data_consumer)
+{
+	PGresult *sql_res=nullptr;
+	QString error, field;
+	char *data=nullptr;
+	int size=0;
+	bool cancelled=false;
+
+	//Raise an error in case the user try to close a not opened connection
+	if(!connection && !replay_conn)
+		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	validateConnectionStatus();
+	clearNotices();
+
+	// There's no server to send the data when replaying a recording
+	if(replay_conn)
+		return;
+
+	sql_res=PQexec(connection, copy_cmd.toStdString().c_str());
+
+	//Prints the SQL to stdout when the flag is active
+	if(print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\n") << copy_cmd << Qt::endl;
+	}
+
+	if(PQresultStatus(sql_res) != PGRES_COPY_OUT)
+	{
+		field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+		error = PQerrorMessage(connection);
+
+		PQclear(sql_res);
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted).arg(error),
+										ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+	}
+
+	PQclear(sql_res);
+
+	try
+	{
+		// PQgetCopyData returns -1 when the copy is done and -2 on errors (reported by the final result)
+		while((size=PQgetCopyData(connection, &data, 0)) > 0)
+		{
+			if(!cancelled && !data_consumer(data, size))
+			{
+				/* Once cancelled, the server stops sending rows soon. The ones already
+				 * transmitted still need to be read so the connection can be reused */
+				cancelled=true;
+				requestCancel();
+			}
+
+			PQfreemem(data);
+			data=nullptr;
+		}
+	}
+	catch(Exception &e)
+	{
+		PQfreemem(data);
+		requestCancel();
+
+		while(PQgetCopyData(connection, &data, 0) > 0)
+			PQfreemem(data);
+
+		while((sql_res=PQgetResult(connection)))
+			PQclear(sql_res);
+
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+	}
+
+	while((sql_res=PQgetResult(connection)))
+	{
+		// The error caused by the cancel request is expected and thus ignored
+		if(!cancelled && PQresultStatus(sql_res) != PGRES_COMMAND_OK && error.isEmpty())
+		{
+			error = PQresultErrorMessage(sql_res);
+			field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+		}
+
+		PQclear(sql_res);
+	}
+
+	if(!error.isEmpty())
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted).arg(error),
+										ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+}
+
 void Connection::setDefaultForOperation(ConnOperation op_id, bool value)
 {
 	if(op_id > OpNone)
@@ -558,6 +1166,9 @@ void Connection::operator = (const Connection &conn)
 	this->connection_params=conn.connection_params;
 	this->connection_str=conn.connection_str;
 	this->connection=nullptr;
+	this->replay_conn=false;
+	this->prepared_stmts.clear();
+	this->prepared_count=0;
 
 	for(unsigned idx=OpValidation; idx <= OpDiff; idx++)
 		default_for_oper[idx]=conn.default_for_oper[idx];
@@ -565,6 +1176,9 @@ void Connection::operator = (const Connection &conn)
 
 void Connection::requestCancel()
 {
+	if(replay_conn)
+		return;
+
 	if(!connection)
 		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
 
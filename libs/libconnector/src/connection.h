@@ -28,14 +28,24 @@
 
 #include "resultset.h"
 #include "attribsmap.h"
+#include "catalogrecorder.h"
 #include <QRegularExpression>
 #include <QDateTime>
+#include <QMutex>
+#include <functional>
 
 class __libconnector Connection {
 	private:
 		//! \brief Database connection descriptor
 		PGconn *connection;
 
+		/*! \brief Indicates that the connection was opened while the catalog replay was active.
+		 * In that case no server is reached and the results are retrieved from the recording */
+		bool replay_conn;
+
+		//! \brief Records or replays the results of the queries executed by all connections (see startRecording())
+		static CatalogRecorder recorder;
+
 		//! \brief Parameters map used to generate the connection string
 		attribs_map connection_params;
 
@@ -52,13 +62,33 @@ class __libconnector Connection {
 		errors related to the exceeded timeout */
 		unsigned cmd_exec_timeout;
 
+		/*! \brief Stores the names of the statements prepared in the server (value) for each parameterized
+		 * command (key) executed in the current session. An empty name means that the command was executed only
+		 * once so far and is not prepared yet (see executeDMLCommand(const QString &, const QStringList &, ResultSet &)) */
+		std::map<QString, QByteArray> prepared_stmts;
+
+		//! \brief Number of statements prepared in the current session, used to generate unique statement names
+		unsigned prepared_count;
+
 		/*! \brief List of notices generated during the command execution
 		The list is filled only if notice_enabled is true */
 		static QStringList notices;
 
+		//! \brief Guards the notices list since connections can be used concurrently in different threads
+		static QMutex notices_mtx;
+
+		/*! \brief Sends the commands through the libpq pipeline mode followed by a single sync point, so they run in the same
+		 * implicit transaction and are all rolled back if one of them fails (in that case an exception is raised carrying the error).
+		 * Returns false, without executing any command, when the pipeline mode can't be used */
+		bool executeDDLPipeline(const QStringList &sql_cmds);
+
 		//! \brief Generates the connection string based on the parameter map
 		void generateConnectionString();
 
+		/*! \brief Closes the idle pooled connections to the server when the command creates, alters or drops databases (see ConnectionPool).
+		 * Must be called by all the methods that send commands to the server, otherwise the idle sessions keep the databases busy */
+		void releaseDatabaseSessions(const QString &sql);
+
 		/*! \brief This static method disable the notice messages when executing commands.
 		By default all connections are created with notice disabled. To enable it the user
 		must call Connection::setNoticeEnabled(). Note: connections already stablished
@@ -71,6 +101,12 @@ class __libconnector Connection {
 		for later usage */
 		static void noticeProcessor(void *, const char *message);
 
+		//! \brief Notice receiver that forwards the messages of the notices to noticeProcessor()
+		static void noticeReceiver(void *, const PGresult *result);
+
+		//! \brief Clears the list of notices generated by the last command execution
+		static void clearNotices();
+
 		//! \brief Indicates if notices are enabled
 		static bool notice_enabled,
 
@@ -166,6 +202,21 @@ class __libconnector Connection {
 		//! \brief Returns the current state for silence connection errors
 		static bool isConnErrorSilenced();
 
+		/*! \brief Starts recording the results of the queries executed by all connections in the provided file.
+		 * This is mainly used to capture the catalog queries of import and diff processes so they can be reproduced
+		 * later without a running server (see startReplay()). The file is written when stopRecording() is called */
+		static void startRecording(const QString &filename);
+
+		/*! \brief Makes all connections opened from now on serve the queries results from the provided recording
+		 * instead of reaching the server. DDL commands are ignored and any query not present in the recording raises an error */
+		static void startReplay(const QString &filename);
+
+		//! \brief Stops the current recording (saving its file) or replay
+		static void stopRecording();
+
+		//! \brief Returns if the connections are replaying a catalog recording
+		static bool isReplayEnabled();
+
 		/*! \brief Ignores the PostgreSQL version checking during connection.
 		 *  When false (the default behavior), when connecting to a server which version is < 10, an error
 		 *  is raised. When true, the error is not raised, but the overall usage of the tool may be affected
@@ -223,6 +274,11 @@ class __libconnector Connection {
 		This method will return an empty list if notices/warnings are disabled in the connections */
 		static QStringList getNotices();
 
+		/*! \brief Installs in the provided connection the notice receiver according to the current notice settings (see setNoticeEnabled()).
+		 * This is done every time a connection is opened or reused from the pool, since the pooled connections keep the receiver installed by
+		 * their previous user */
+		static void configureNoticeOutput(PGconn *connection);
+
 		/*! \brief Change the current database to the specified db name using the parameters from the current
 		stablished connection causing the connection to be reset and moved to the new database.
 		The effect of this is the same by type \c dbname on psql console. In case of errors the method will
@@ -242,11 +298,55 @@ class __libconnector Connection {
 		 Its mandatory to specify the object to receive the returned resultset. */
 		void executeDMLCommand(const QString &sql, ResultSet &result);
 
+		/*! \brief Executes a DML command which positional parameters ($1, $2, ...) are bound to the provided values (in text format).
+		 * The first time the command is executed in the session it is sent as an unnamed statement, from the second execution on the
+		 * command is prepared in the server so the further executions only send the statement name and the parameters values.
+		 * When no parameter is provided the command is executed exactly as executeDMLCommand(const QString &, ResultSet &) */
+		void executeDMLCommand(const QString &sql, const QStringList &params, ResultSet &result);
+
+		/*! \brief Returns the name of the statement prepared in the current session for the parameterized command.
+		 * An empty name is returned when the command was executed less than twice (see executeDMLCommand()) */
+		QByteArray getPreparedStatement(const QString &sql);
+
+		/*! \brief Returns if the provided SQL holds a single statement (see SQLStatementSplitter). Used to determine which
+		 * commands can be pipelined or streamed, since those modes don't accept several statements in the same command */
+		static bool isSingleStatement(const QString &sql);
+
 		/*! \brief Executes a DDL command on the server using the opened connection.
 		 The user don't need to specify the resultset since the commando executed is intended
 		 to be an data definition one  */
 		void executeDDLCommand(const QString &sql);
 
+		/*! \brief Executes a list of DDL commands calling the handler once per command, in the provided order, passing the command index
+		 * and the error raised by it (nullptr when the command succeeded). When libpq supports it (14+) the consecutive commands that can
+		 * run in a transaction block are sent in a single pipeline as one implicit transaction, so the server doesn't wait for a round trip
+		 * between them. If any of them fails the transaction is rolled back and the commands are executed again one by one via
+		 * executeDDLCommand(), so the handler can ignore the error or stop the execution by raising an exception as usual (see runDDLCommands()).
+		 * When pipelining is unavailable (older libpq or catalog replay active) the commands are executed one by one via executeDDLCommand() */
+		void executeDDLCommands(const QStringList &sql_cmds, const std::function<void(int, Exception *)> &cmd_handler);
+
+		/*! \brief Runs the commands as described in executeDDLCommands() using the provided functions to execute a batch of commands
+		 * (returns false when batches can't be used, may be null) and a single command. The error raised by a single command is passed to
+		 * the handler and if it raises an exception the remaining commands are not executed */
+		static void runDDLCommands(const QStringList &sql_cmds, const std::function<bool(const QStringList &)> &exec_batch,
+															 const std::function<void(const QString &)> &exec_cmd, const std::function<void(int, Exception *)> &cmd_handler);
+
+		/*! \brief Returns if the provided command can be executed inside a transaction block together with other commands.
+		 * Commands like CREATE DATABASE, CREATE INDEX CONCURRENTLY, REINDEX DATABASE, ALTER TYPE ... ADD VALUE, VACUUM, CALL
+		 * and transaction control ones (including DO blocks that commit or roll back) can't */
+		static bool isTransactionBlockAllowed(const QString &sql);
+
+		/*! \brief Executes a COPY ... FROM STDIN command sending to the server the data produced by the provider, in the format
+		 * expected by the command. The provider is called repeatedly to fill the buffer with the next chunk of data until it returns false.
+		 * If the provider raises an exception the copy is aborted in the server (no rows are inserted) and the exception is redirected */
+		void executeCopyFrom(const QString &copy_cmd, const std::function<bool(QByteArray &)> &data_provider);
+
+		/*! \brief Executes a COPY ... TO STDOUT command handing each chunk of data (usually a row) received from the server
+		 * to the consumer as soon as it arrives, so the complete output is never held in memory. If the consumer returns false
+		 * the command is cancelled in the server and the remaining data is discarded. If the consumer raises an exception
+		 * the command is cancelled as well and the exception is redirected */
+		void executeCopyTo(const QString &copy_cmd, const std::function<bool(const char *, int)> &data_consumer);
+
 		//! \brief Toggles the default status for the connect in the specified operation (OP_??? constants).
 		void setDefaultForOperation(ConnOperation op_id, bool value);
 
@@ -255,6 +355,8 @@ class __libconnector Connection {
 
 		//! \brief Makes an copy between two connections
 		void operator = (const Connection &conn);
+
+		friend class AsyncCommand;
 };
 
 #endif
@@ -0,0 +1,258 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "connectionpool.h"
+
+std::vector<ConnectionPool::IdleConnection> ConnectionPool::idle_conns;
+std::map<PGconn *, QString> ConnectionPool::pooled_conns;
+QMutex ConnectionPool::pool_mtx;
+unsigned ConnectionPool::idle_timeout = ConnectionPool::DefaultIdleTimeout;
+unsigned ConnectionPool::max_server_conns = ConnectionPool::DefaultMaxServerConnections;
+std::function<bool(PGconn *)> ConnectionPool::reset_session = ConnectionPool::resetSession;
+std::function<bool(PGconn *)> ConnectionPool::validate_session = ConnectionPool::validateIdleConnection;
+
+unsigned ConnectionPool::getServerConnectionCount(const QString &server_id)
+{
+	unsigned count = 0;
+
+	for(auto &itr : pooled_conns)
+	{
+		if(itr.second == server_id)
+			count++;
+	}
+
+	return count;
+}
+
+void ConnectionPool::purgeIdleConnections(const QString &server_id)
+{
+	QDateTime now = QDateTime::currentDateTime();
+
+	for(unsigned idx = 0; idx < idle_conns.size();)
+	{
+		if(idle_conns[idx].idle_since.secsTo(now) >= static_cast<qint64>(idle_timeout))
+			finishIdleConnection(idx);
+		else
+			idx++;
+	}
+
+	if(server_id.isEmpty() || getServerConnectionCount(server_id) < max_server_conns)
+		return;
+
+	// The idle connections are stored in the order they were released so the first one of the server is the oldest
+	for(unsigned idx = 0; idx < idle_conns.size(); idx++)
+	{
+		if(pooled_conns[idle_conns[idx].connection] == server_id)
+		{
+			finishIdleConnection(idx);
+			break;
+		}
+	}
+}
+
+void ConnectionPool::finishIdleConnection(unsigned idx)
+{
+	PGconn *connection = idle_conns[idx].connection;
+
+	pooled_conns.erase(connection);
+	idle_conns.erase(idle_conns.begin() + idx);
+	PQfinish(connection);
+}
+
+bool ConnectionPool::resetSession(PGconn *connection)
+{
+	PGresult *res = nullptr;
+	bool valid = false;
+
+	// Only connections ready for new commands are reused
+	if(PQstatus(connection) != CONNECTION_OK || PQtransactionStatus(connection) != PQTRANS_IDLE)
+		return false;
+
+	res = PQexec(connection, "DISCARD ALL");
+	valid = PQresultStatus(res) == PGRES_COMMAND_OK;
+	PQclear(res);
+
+	return valid && PQstatus(connection) == CONNECTION_OK && PQtransactionStatus(connection) == PQTRANS_IDLE;
+}
+
+bool ConnectionPool::validateIdleConnection(PGconn *connection)
+{
+	/* A connection closed by the server (e.g. idle session timeout or restart) is detected only when its socket is read,
+	 * so any pending input is consumed to update the connection status without sending a command */
+	if(PQstatus(connection) != CONNECTION_OK || !PQconsumeInput(connection))
+		return false;
+
+	return PQstatus(connection) == CONNECTION_OK && PQtransactionStatus(connection) == PQTRANS_IDLE;
+}
+
+PGconn *ConnectionPool::acquire(const QString &conn_str)
+{
+	PGconn *connection = nullptr;
+	std::function<bool(PGconn *)> validate_func;
+
+	while(true)
+	{
+		pool_mtx.lock();
+		purgeIdleConnections();
+		connection = nullptr;
+		validate_func = validate_session;
+
+		// The most recently released connection is preferred since it's the less likely to have been closed by the server
+		for(int idx = static_cast<int>(idle_conns.size()) - 1; idx >= 0; idx--)
+		{
+			if(idle_conns[idx].conn_str == conn_str)
+			{
+				connection = idle_conns[idx].connection;
+				idle_conns.erase(idle_conns.begin() + idx);
+				break;
+			}
+		}
+
+		pool_mtx.unlock();
+
+		if(!connection || validate_func(connection))
+			return connection;
+
+		pool_mtx.lock();
+		pooled_conns.erase(connection);
+		pool_mtx.unlock();
+		PQfinish(connection);
+	}
+}
+
+bool ConnectionPool::add(PGconn *connection, const QString &server_id)
+{
+	QMutexLocker locker(&pool_mtx);
+
+	if(!connection || max_server_conns == 0)
+		return false;
+
+	// Makes room for the new connection closing the oldest idle one to the server if the limit was reached
+	purgeIdleConnections(server_id);
+
+	pooled_conns[connection] = server_id;
+	return true;
+}
+
+bool ConnectionPool::release(PGconn *connection, const QString &conn_str)
+{
+	std::function<bool(PGconn *)> reset_func;
+	bool reset = false;
+
+	pool_mtx.lock();
+
+	if(!connection || pooled_conns.count(connection) == 0)
+	{
+		pool_mtx.unlock();
+		return false;
+	}
+
+	/* The connections opened while all the allowed ones were leased are closed when released,
+	 * so the amount of connections open to the server is brought back to the limit */
+	if(max_server_conns == 0 || getServerConnectionCount(pooled_conns[connection]) > max_server_conns)
+	{
+		pooled_conns.erase(connection);
+		pool_mtx.unlock();
+		return false;
+	}
+
+	reset_func = reset_session;
+	pool_mtx.unlock();
+
+	// The session is reset without holding the lock since it waits for the server
+	reset = reset_func(connection);
+
+	QMutexLocker locker(&pool_mtx);
+
+	if(!reset)
+	{
+		pooled_conns.erase(connection);
+		return false;
+	}
+
+	idle_conns.push_back({ connection, conn_str, QDateTime::currentDateTime() });
+	return true;
+}
+
+void ConnectionPool::clear(const QString &server_id)
+{
+	QMutexLocker locker(&pool_mtx);
+
+	for(unsigned idx = 0; idx < idle_conns.size();)
+	{
+		if(server_id.isEmpty() || pooled_conns[idle_conns[idx].connection] == server_id)
+			finishIdleConnection(idx);
+		else
+			idx++;
+	}
+}
+
+void ConnectionPool::setLimits(unsigned idle_timeout_secs, unsigned max_conns_per_server)
+{
+	QMutexLocker locker(&pool_mtx);
+
+	idle_timeout = idle_timeout_secs;
+	max_server_conns = max_conns_per_server;
+
+	// Reducing the limits closes the idle connections that exceed them right away
+	for(unsigned idx = 0; idx < idle_conns.size();)
+	{
+		QString server_id = pooled_conns[idle_conns[idx].connection];
+
+		if(max_server_conns == 0 || getServerConnectionCount(server_id) > max_server_conns)
+			finishIdleConnection(idx);
+		else
+			idx++;
+	}
+
+	purgeIdleConnections();
+}
+
+void ConnectionPool::setSessionHandlers(const std::function<bool(PGconn *)> &reset_func, const std::function<bool(PGconn *)> &validate_func)
+{
+	QMutexLocker locker(&pool_mtx);
+
+	reset_session = resetSession;
+	validate_session = validateIdleConnection;
+
+	if(reset_func)
+		reset_session = reset_func;
+
+	if(validate_func)
+		validate_session = validate_func;
+}
+
+unsigned ConnectionPool::getConnectionCount(const QString &server_id)
+{
+	QMutexLocker locker(&pool_mtx);
+	return getServerConnectionCount(server_id);
+}
+
+unsigned ConnectionPool::getIdleConnectionCount(const QString &server_id)
+{
+	QMutexLocker locker(&pool_mtx);
+	unsigned count = 0;
+
+	for(auto &idle_conn : idle_conns)
+	{
+		if(pooled_conns[idle_conn.connection] == server_id)
+			count++;
+	}
+
+	return count;
+}
@@ -0,0 +1,126 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libconnector
+\class ConnectionPool
+\brief Implements a process-wide pool of server connections shared by all instances of Connection. When a connection
+is closed its session is reset (DISCARD ALL) and kept idle in the pool, so the next connection to the same database using
+the same parameters reuses it instead of paying the connection handshake (TCP, TLS and authentication) again.
+Idle connections are closed after a configurable timeout. The pool also limits the total amount of connections open to each server:
+a connection released while the limit is exceeded is closed instead of being kept idle.
+*/
+
+#ifndef CONNECTION_POOL_H
+#define CONNECTION_POOL_H
+
+#include "connectorglobal.h"
+#include <libpq-fe.h>
+#include <QDateTime>
+#include <QMutex>
+#include <functional>
+#include <map>
+#include <vector>
+
+class __libconnector ConnectionPool {
+	private:
+		//! \brief Stores a connection kept idle in the pool
+		struct IdleConnection {
+			PGconn *connection;
+
+			//! \brief Connection string used to open the connection (the key used to reuse it)
+			QString conn_str;
+
+			//! \brief Moment the connection was returned to the pool
+			QDateTime idle_since;
+		};
+
+		//! \brief Default amount of seconds an unused connection is kept in the pool
+		static constexpr unsigned DefaultIdleTimeout = 60;
+
+		//! \brief Default amount of connections kept by the pool per server
+		static constexpr unsigned DefaultMaxServerConnections = 8;
+
+		//! \brief Idle connections in the order they were returned to the pool
+		static std::vector<IdleConnection> idle_conns;
+
+		//! \brief Connections open through the pool (leased or idle) and the servers (host:port) they belong to
+		static std::map<PGconn *, QString> pooled_conns;
+
+		//! \brief Functions that reset the session of a released connection and validate an idle one before reusing it (see setSessionHandlers())
+		static std::function<bool(PGconn *)> reset_session, validate_session;
+
+		//! \brief Guards the pool since connections are opened and closed in different threads
+		static QMutex pool_mtx;
+
+		static unsigned idle_timeout, max_server_conns;
+
+		//! \brief Returns the amount of connections to the provided server managed by the pool. Must be called with the pool locked
+		static unsigned getServerConnectionCount(const QString &server_id);
+
+		/*! \brief Closes the idle connections that exceeded the idle timeout and, if the server id is provided, the oldest
+		 * idle connection to that server when its amount of connections reached the limit. Must be called with the pool locked */
+		static void purgeIdleConnections(const QString &server_id = "");
+
+		//! \brief Closes an idle connection removing it from the pool. Must be called with the pool locked
+		static void finishIdleConnection(unsigned idx);
+
+		/*! \brief Resets the session of the connection (DISCARD ALL) waiting for the result. Returns false when the connection
+		 * is not ready for new commands (broken or in the middle of a transaction or command) or the reset fails */
+		static bool resetSession(PGconn *connection);
+
+		/*! \brief Checks if an idle connection is still usable, since it may have been closed by the server
+		 * (e.g. idle session timeout or restart) while kept in the pool. Returns false if the connection is broken */
+		static bool validateIdleConnection(PGconn *connection);
+
+	public:
+		ConnectionPool() = delete;
+
+		/*! \brief Returns an idle connection opened with the provided connection string, removing it from the idle list,
+		 * or nullptr if there's none. Broken idle connections are discarded and the next one is tried */
+		static PGconn *acquire(const QString &conn_str);
+
+		/*! \brief Adds a newly opened connection to the server (host:port) to the pool so it can be reused after being released.
+		 * If the connection limit of the server was reached the oldest idle connection to it is closed. Returns false only when
+		 * the pooling is disabled, in that case the connection is not managed by the pool */
+		static bool add(PGconn *connection, const QString &server_id);
+
+		/*! \brief Returns a connection managed by the pool to the idle list resetting its session. Returns false when the
+		 * connection is not managed by the pool, when the connection limit of its server is exceeded or when it can't be reused
+		 * (see resetSession()), in that case the caller must close it (the connection is no longer managed by the pool) */
+		static bool release(PGconn *connection, const QString &conn_str);
+
+		//! \brief Closes all the idle connections to the provided server (host:port) or to all servers if no id is provided
+		static void clear(const QString &server_id = "");
+
+		/*! \brief Defines the amount of seconds an unused connection is kept in the pool and the maximum amount of connections
+		 * per server managed by the pool. A zero limit disables the pooling (the connections are closed when released) */
+		static void setLimits(unsigned idle_timeout_secs, unsigned max_conns_per_server);
+
+		/*! \brief Replaces the functions used to reset the session of the released connections and to validate the idle connections
+		 * before reusing them. Null functions restore the default ones (see resetSession() and validateIdleConnection()) */
+		static void setSessionHandlers(const std::function<bool(PGconn *)> &reset_func, const std::function<bool(PGconn *)> &validate_func);
+
+		//! \brief Returns the amount of connections to the provided server (host:port) managed by the pool, leased or idle
+		static unsigned getConnectionCount(const QString &server_id);
+
+		//! \brief Returns the amount of idle connections to the provided server (host:port)
+		static unsigned getIdleConnectionCount(const QString &server_id);
+};
+
+#endif
@@ -57,7 +57,11 @@ ResultSet::ResultSet(PGresult *sql_result)
 		case PGRES_COPY_OUT:
 		case PGRES_COPY_IN:
 		default:
-			empty_result = (res_state!=PGRES_TUPLES_OK && res_state!=PGRES_SINGLE_TUPLE && res_state!=PGRES_EMPTY_QUERY);
+			empty_result = (res_state!=PGRES_TUPLES_OK && res_state!=PGRES_SINGLE_TUPLE &&
+#ifdef LIBPQ_HAS_CHUNK_MODE
+											res_state!=PGRES_TUPLES_CHUNK &&
+#endif
+											res_state!=PGRES_EMPTY_QUERY);
 			current_tuple = -1;
 			is_res_copied = false;
 		break;
@@ -337,3 +341,147 @@ void ResultSet::operator = (ResultSet &res)
 	this->is_res_copied=false;
 }
 
+ResultSet::Tuple::Tuple(PGresult *sql_result, int tuple_idx)
+{
+	this->sql_result = sql_result;
+	this->tuple_idx = tuple_idx;
+}
+
+int ResultSet::Tuple::getIndex() const
+{
+	return tuple_idx;
+}
+
+bool ResultSet::Tuple::isNull(int column_idx) const
+{
+	return PQgetisnull(sql_result, tuple_idx, column_idx);
+}
+
+const char *ResultSet::Tuple::getValue(int column_idx) const
+{
+	return PQgetvalue(sql_result, tuple_idx, column_idx);
+}
+
+int ResultSet::Tuple::getLength(int column_idx) const
+{
+	return PQgetlength(sql_result, tuple_idx, column_idx);
+}
+
+QString ResultSet::Tuple::getText(int column_idx) const
+{
+	return QString::fromUtf8(PQgetvalue(sql_result, tuple_idx, column_idx),
+													 PQgetlength(sql_result, tuple_idx, column_idx));
+}
+
+unsigned ResultSet::Tuple::getOid(int column_idx) const
+{
+	return static_cast<unsigned>(strtoul(PQgetvalue(sql_result, tuple_idx, column_idx), nullptr, 10));
+}
+
+int ResultSet::Tuple::getInt(int column_idx) const
+{
+	return static_cast<int>(strtol(PQgetvalue(sql_result, tuple_idx, column_idx), nullptr, 10));
+}
+
+bool ResultSet::Tuple::getBool(int column_idx) const
+{
+	return PQgetvalue(sql_result, tuple_idx, column_idx)[0] == 't';
+}
+
+QStringList ResultSet::Tuple::getTextArray(int column_idx) const
+{
+	const char *value = PQgetvalue(sql_result, tuple_idx, column_idx),
+			*end = value + PQgetlength(sql_result, tuple_idx, column_idx);
+	QStringList elems;
+	QByteArray elem;
+	bool quoted = false, has_quotes = false;
+
+	// Skipping the dimensions decoration [n:n]= if present
+	if(*value == '[')
+	{
+		while(value < end && *value != '{')
+			value++;
+	}
+
+	if(value >= end || *value != '{')
+		return elems;
+
+	for(value++; value < end; value++)
+	{
+		if(quoted)
+		{
+			if(*value == '\\' && (value + 1) < end)
+				elem.append(*(++value));
+			else if(*value == '"')
+				quoted = false;
+			else
+				elem.append(*value);
+		}
+		else if(*value == '"')
+			quoted = has_quotes = true;
+		else if(*value == ',' || *value == '}')
+		{
+			// An unquoted NULL is a null element which is returned as an empty string
+			if(!has_quotes && elem == "NULL")
+				elem.clear();
+
+			if(*value == ',' || !elems.isEmpty() || !elem.isEmpty() || has_quotes)
+				elems.append(QString::fromUtf8(elem));
+
+			elem.clear();
+			has_quotes = false;
+
+			if(*value == '}')
+				break;
+		}
+		else if(*value != '{' && *value != ' ')
+			elem.append(*value);
+	}
+
+	return elems;
+}
+
+ResultSet::TupleIterator::TupleIterator(PGresult *sql_result, int tuple_idx)
+{
+	this->sql_result = sql_result;
+	this->tuple_idx = tuple_idx;
+}
+
+ResultSet::Tuple ResultSet::TupleIterator::operator * () const
+{
+	return Tuple(sql_result, tuple_idx);
+}
+
+ResultSet::TupleIterator &ResultSet::TupleIterator::operator ++ ()
+{
+	tuple_idx++;
+	return *this;
+}
+
+bool ResultSet::TupleIterator::operator == (const TupleIterator &itr) const
+{
+	return sql_result == itr.sql_result && tuple_idx == itr.tuple_idx;
+}
+
+bool ResultSet::TupleIterator::operator != (const TupleIterator &itr) const
+{
+	return !(*this == itr);
+}
+
+ResultSet::TupleIterator ResultSet::begin()
+{
+	return TupleIterator(sql_result, 0);
+}
+
+ResultSet::TupleIterator ResultSet::end()
+{
+	return TupleIterator(sql_result, (!sql_result || empty_result) ? 0 : PQntuples(sql_result));
+}
+
+ResultSet::Tuple ResultSet::getTuple(int tuple_idx)
+{
+	if(!sql_result || empty_result || tuple_idx < 0 || tuple_idx >= PQntuples(sql_result))
+		throw Exception(ErrorCode::RefInvalidTuple, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	return Tuple(sql_result, tuple_idx);
+}
@@ -75,9 +75,81 @@ class __libconnector ResultSet {
 			NextTuple = 3
 		};
 
+		/*! \brief Lightweight read-only view of a single tuple of the result set. The values are read straight from the
+		 * libpq result so nothing is copied or allocated unless a QString or QStringList is requested. The column indexes
+		 * are expected to be resolved once per result (see getColumnIndex()) and aren't validated for performance reasons.
+		 * A tuple is valid while the result set that created it is neither cleared nor destroyed */
+		class __libconnector Tuple {
+			private:
+				PGresult *sql_result;
+
+				int tuple_idx;
+
+			public:
+				Tuple(PGresult *sql_result, int tuple_idx);
+
+				//! \brief Returns the index of the tuple in the result set
+				int getIndex() const;
+
+				//! \brief Returns if the column has a null value
+				bool isNull(int column_idx) const;
+
+				//! \brief Returns the raw value of the column. Null values are returned as empty strings
+				const char *getValue(int column_idx) const;
+
+				//! \brief Returns the length in bytes of the column value
+				int getLength(int column_idx) const;
+
+				//! \brief Returns the column value as a string
+				QString getText(int column_idx) const;
+
+				//! \brief Returns the column value (oid or any other unsigned integer) without converting it to string first
+				unsigned getOid(int column_idx) const;
+
+				//! \brief Returns the column value (integer) without converting it to string first
+				int getInt(int column_idx) const;
+
+				//! \brief Returns if the column value is a true boolean (t)
+				bool getBool(int column_idx) const;
+
+				/*! \brief Returns the elements of a one dimension array value in format [n:n]={a,b,"c d",...}. Quoted elements
+				 * are unescaped and NULL elements are returned as empty strings */
+				QStringList getTextArray(int column_idx) const;
+		};
+
+		//! \brief Forward iterator over the tuples of the result set (see begin() and end())
+		class __libconnector TupleIterator {
+			private:
+				PGresult *sql_result;
+
+				int tuple_idx;
+
+			public:
+				TupleIterator(PGresult *sql_result, int tuple_idx);
+
+				Tuple operator * () const;
+
+				TupleIterator &operator ++ ();
+
+				bool operator == (const TupleIterator &itr) const;
+
+				bool operator != (const TupleIterator &itr) const;
+		};
+
 		ResultSet();
 		~ResultSet();
 
+		/*! \brief Returns the iterator to the first tuple of the result set. Iterating over the tuples doesn't change
+		 * the current tuple used by the navigation methods (see accessTuple()). The result sets generated by commands
+		 * that return no tuples (INSERT, DELETE, UPDATE, etc) are iterated as empty ones */
+		TupleIterator begin();
+
+		//! \brief Returns the iterator past the last tuple of the result set
+		TupleIterator end();
+
+		//! \brief Returns the tuple in the provided index raising an error if the index is invalid
+		Tuple getTuple(int tuple_idx);
+
 		//! \brief Returns the value of a column (searching by name or index)
 		char *getColumnValue(const QString &column_name);
 		char *getColumnValue(int column_idx);
@@ -132,6 +204,7 @@ class __libconnector ResultSet {
 		void operator = (ResultSet &res);
 
 		friend class Connection;
+		friend class AsyncCommand;
 };
 
 #endif
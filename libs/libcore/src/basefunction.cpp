@@ -438,3 +438,21 @@ attribs_map BaseFunction::getAlterCodeAttributes(BaseFunction *func)
 
 	return attribs;
 }
+
+attribs_map BaseFunction::getAlterableAttributes()
+{
+	attribs_map attribs = BaseObject::getAlterableAttributes();
+	QStringList cfg_params;
+
+	attribs[Attributes::SecurityType] = ~security_type;
+	attribs[Attributes::Definition] = func_source.simplified();
+	attribs[Attributes::Library] = library;
+	attribs[Attributes::Symbol] = symbol;
+
+	for(auto &cfg : config_params)
+		cfg_params.append(cfg.first + "=" + cfg.second);
+
+	attribs[Attributes::ConfigParams] = cfg_params.join(',');
+
+	return attribs;
+}
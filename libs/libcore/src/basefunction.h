@@ -170,6 +170,8 @@ class __libcore BaseFunction: public BaseObject {
 		virtual QString getSourceCode(SchemaParser::CodeType def_type, bool) = 0;
 		virtual QString getSourceCode(SchemaParser::CodeType def_type) = 0;
 		virtual QString getAlterCode(BaseObject *object) = 0;
+
+		virtual attribs_map getAlterableAttributes();
 };
 
 #endif
@@ -1190,8 +1190,8 @@ bool BaseObject::isCodeDiffersFrom(BaseObject *object, const QStringList &ignore
 
 	try
 	{
-		return BaseObject::isCodeDiffersFrom(this->getSourceCode(SchemaParser::XmlCode),
-											 object->getSourceCode(SchemaParser::XmlCode),
+		return BaseObject::isCodeDiffersFrom(this->getComparisonCode(),
+											 object->getComparisonCode(),
 											 ignored_attribs, ignored_tags);
 	}
 	catch(Exception &e)
@@ -1200,6 +1200,11 @@ bool BaseObject::isCodeDiffersFrom(BaseObject *object, const QStringList &ignore
 	}
 }
 
+QString BaseObject::getComparisonCode()
+{
+	return this->getSourceCode(SchemaParser::XmlCode);
+}
+
 QString BaseObject::getCachedCode(unsigned def_type, bool reduced_form)
 {
 	if(use_cached_code && def_type==SchemaParser::SqlCode && schparser.getPgSQLVersion()!=BaseObject::pgsql_ver)
@@ -1298,6 +1303,11 @@ QString BaseObject::getAlterCode(BaseObject *object, bool ignore_name_diff)
 
 	setBasicAttributes(true);
 
+	/* If the basic attributes are the same there's no need to run the rename, owner,
+	 * schema, tablespace and comment templates since all of them would return empty code */
+	if(BaseObject::getAlterableAttributes() == object->BaseObject::getAlterableAttributes())
+		return alter;
+
 	try
 	{
 		QStringList attribs={ Attributes::Owner, Attributes::Schema, Attributes::Tablespace };
@@ -1333,6 +1343,26 @@ QString BaseObject::getAlterCode(BaseObject *object, bool ignore_name_diff)
 	return alter;
 }
 
+attribs_map BaseObject::getAlterableAttributes()
+{
+	attribs_map attribs;
+	BaseObject *owner = getOwner(), *schema = getSchema(), *tablespace = getTablespace();
+
+	attribs[Attributes::Name] = getName();
+	attribs[Attributes::Comment] = comment;
+
+	if(acceptsOwner() && owner)
+		attribs[Attributes::Owner] = owner->getName(true);
+
+	if(acceptsSchema() && schema)
+		attribs[Attributes::Schema] = schema->getName(true);
+
+	if(acceptsTablespace() && tablespace)
+		attribs[Attributes::Tablespace] = tablespace->getName(true);
+
+	return attribs;
+}
+
 QString BaseObject::getAlterCommentDefinition(BaseObject *object, attribs_map attributes)
 {
 	try
@@ -234,10 +234,6 @@ class __libcore BaseObject {
 		ALTER, COMMENT and DROP commands must be generated. Refer to schema files for comments, drop and alter. */
 		void setBasicAttributes(bool format_name);
 
-		/*! \brief Compares two xml buffers and returns if they differs from each other. The user can specify which attributes
-	and tags must be ignored when makin the comparison. NOTE: only the name for attributes and tags must be informed */
-		bool isCodeDiffersFrom(const QString &xml_def1, const QString &xml_def2, const QStringList &ignored_attribs, const QStringList &ignored_tags);
-
 		/*! \brief Copies the non-empty attributes on the map at parameter to the own object attributes map. This method is used
 		as an auxiliary when generating alter definition for some objects. When one or more attributes are copied an especial
 		attribute is inserted (HAS_CHANGES) in order to help the atler generatin process to identify which attributes are
@@ -425,6 +421,12 @@ class __libcore BaseObject {
 		objects differs. */
 		virtual QString getAlterCode(BaseObject *object, bool ignore_name_diff);
 
+		/*! \brief Returns a snapshot of the attributes that can be changed via ALTER commands. The values are taken
+		directly from the object's members (no schema file is parsed) so two snapshots can be cheaply compared in order to
+		determine if the ALTER code generation is needed at all. Derived classes that generate ALTER commands for their
+		own attributes must append them to the snapshot */
+		virtual attribs_map getAlterableAttributes();
+
 		//!brief Returns the DROP statement for the object
 		virtual QString getDropCode(bool cascade);
 
@@ -491,6 +493,15 @@ class __libcore BaseObject {
 		and tags must be ignored when makin the comparison. NOTE: only the name for attributes and tags must be informed */
 		virtual bool isCodeDiffersFrom(BaseObject *object, const QStringList &ignored_attribs={}, const QStringList &ignored_tags={});
 
+		/*! \brief Compares two xml buffers and returns if they differs from each other. The user can specify which attributes
+		and tags must be ignored when makin the comparison. NOTE: only the name for attributes and tags must be informed.
+		This method doesn't touch the object's attributes so it can be called from multiple threads at once */
+		bool isCodeDiffersFrom(const QString &xml_def1, const QString &xml_def2, const QStringList &ignored_attribs, const QStringList &ignored_tags);
+
+		/*! \brief Returns the xml code used by isCodeDiffersFrom() to compare the "this" object and another one.
+		By default it's the object's complete xml code */
+		virtual QString getComparisonCode();
+
 		/*! \brief Enable/disable the use of cached sql/xml code. When enabled the code generation speed is hugely increased
 				but the downward is an increasing on memory usage. Make sure to every time when an attribute of any instance derivated
 				of this class changes you need to call setCodeInvalidated() in order to force the update of the code cache.
@@ -307,6 +307,11 @@ QString Column::getAlterCode(BaseObject *object)
 		QString def_val, alter_def;
 		bool ident_seq_changed = false;
 
+		/* The early return is only possible when the current column doesn't use a sequence since
+		 * in that case its raw default value is compared against the other column's sequence call */
+		if(!this->sequence && getAlterableAttributes() == col->getAlterableAttributes())
+			return alter_def;
+
 		BaseObject::setBasicAttributes(true);
 
 		if(getParentTable())
@@ -404,6 +409,28 @@ QString Column::getAlterCode(BaseObject *object)
 	}
 }
 
+attribs_map Column::getAlterableAttributes()
+{
+	attribs_map attribs = BaseObject::getAlterableAttributes();
+
+	attribs[Attributes::Type] = *type;
+	attribs[Attributes::Length] = QString::number(type.getLength());
+	attribs[Attributes::Precision] = QString::number(type.getPrecision());
+	attribs[Attributes::Dimension] = QString::number(type.getDimension());
+	attribs[Attributes::DefaultValue] = (sequence ? NextValFuncTmpl.arg(sequence->getSignature()) : default_value);
+	attribs[Attributes::Generated] = (generated ? Attributes::True : "");
+	attribs[Attributes::NotNull] = (not_null ? Attributes::True : "");
+	attribs[Attributes::IdentityType] = ~identity_type;
+	attribs[Attributes::MinValue] = seq_min_value;
+	attribs[Attributes::MaxValue] = seq_max_value;
+	attribs[Attributes::Start] = seq_start;
+	attribs[Attributes::Increment] = seq_increment;
+	attribs[Attributes::Cache] = seq_cache;
+	attribs[Attributes::Cycle] = (seq_cycle ? Attributes::True : "");
+
+	return attribs;
+}
+
 void Column::configureSearchAttributes()
 {
 	BaseObject::configureSearchAttributes();
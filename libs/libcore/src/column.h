@@ -134,6 +134,8 @@ class __libcore Column: public TableObject{
 
 		virtual QString getAlterCode(BaseObject *object);
 
+		virtual attribs_map getAlterableAttributes();
+
 		/*! \brief Returns the old column name. The parameter 'format' indicates
 		 whether the name must be formatted or not */
 		QString getOldName(bool format=false);
@@ -817,21 +817,7 @@ QString Constraint::getDataDictionary(const attribs_map &extra_attribs)
 	}
 }
 
-bool Constraint::isCodeDiffersFrom(BaseObject *object, const QStringList &ignored_attribs, const QStringList &ignored_tags)
+QString Constraint::getComparisonCode()
 {
-	if(!object)
-		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-	else if(object->getObjectType()!=this->getObjectType())
-		throw Exception(ErrorCode::OprObjectInvalidType,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-
-	try
-	{
-		return BaseObject::isCodeDiffersFrom(this->getSourceCode(SchemaParser::XmlCode, true),
-											 object->getSourceCode(SchemaParser::XmlCode, true),
-											 ignored_attribs, ignored_tags);
-	}
-	catch(Exception &e)
-	{
-		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
-	}
+	return this->getSourceCode(SchemaParser::XmlCode, true);
 }
@@ -277,9 +277,9 @@ class __libcore Constraint: public TableObject{
 
 		QString getDataDictionary(const attribs_map &extra_attribs);
 
-		/*! \brief Compares two constratins XML definition and returns if they differs. This methods varies a little from
-		BaseObject::isCodeDiffersFrom() because here we need to generate xml code including relationship added columns */
-		virtual bool isCodeDiffersFrom(BaseObject *object, const QStringList &ignored_attribs={}, const QStringList &ignored_tags={});
+		/*! \brief Returns the XML definition used to compare two constraints. This methods varies a little from
+		BaseObject::getComparisonCode() because here we need to generate xml code including relationship added columns */
+		virtual QString getComparisonCode();
 };
 
 #endif
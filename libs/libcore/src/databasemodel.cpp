@@ -3492,49 +3492,30 @@ BaseObject *DatabaseModel::createObject(ObjectType obj_type)
 
 void DatabaseModel::setBasicAttributes(BaseObject *object)
 {
-	attribs_map attribs, attribs_aux;
+	attribs_map attribs, attribs_aux, basic_attribs;
 	QString elem_name;
-	BaseObject *tabspc=nullptr, *owner=nullptr, *collation=nullptr;
-	Schema *schema=nullptr;
-	ObjectType obj_type=ObjectType::BaseObject, obj_type_aux;
-	bool has_error=false, protected_obj=false, sql_disabled=false;
-	ForeignObject *frn_object = dynamic_cast<ForeignObject *>(object);
+	std::map<QString, QString> ref_elems = {
+		{ Attributes::Schema, Attributes::Schema },
+		{ Attributes::Tablespace, Attributes::Tablespace },
+		{ Attributes::Role, Attributes::Owner },
+		{ Attributes::Collation, Attributes::Collation }
+	};
 
 	if(!object)
 		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	xmlparser.getElementAttributes(attribs);
-	obj_type_aux=object->getObjectType();
-
-	if(obj_type_aux!=ObjectType::Cast && obj_type_aux != ObjectType::UserMapping)
-		object->setName(attribs[Attributes::Name]);
-
-	if(BaseGraphicObject::isGraphicObject(obj_type_aux) && !attribs[Attributes::ZValue].isEmpty())
-		dynamic_cast<BaseGraphicObject *>(object)->setZValue(attribs[Attributes::ZValue].toInt());
-
-	if(BaseObject::acceptsAlias(obj_type_aux))
-		object->setAlias(attribs[Attributes::Alias]);
-
-	protected_obj=attribs[Attributes::Protected]==Attributes::True;
-	sql_disabled=attribs[Attributes::SqlDisabled]==Attributes::True;
-
-	if(frn_object)
-	{
-		QStringList opt_val;
-
-		for(auto &option : attribs[Attributes::Options].split(ForeignObject::OptionsSeparator))
-		{
-			opt_val = option.split(UserMapping::OptionValueSeparator);
-
-			if(opt_val.size() < 2)
-				continue;
 
-			frn_object->setOption(opt_val[0], opt_val[1]);
-		}
-	}
+	basic_attribs[Attributes::Name]=attribs[Attributes::Name];
+	basic_attribs[Attributes::Alias]=attribs[Attributes::Alias];
+	basic_attribs[Attributes::ZValue]=attribs[Attributes::ZValue];
+	basic_attribs[Attributes::Protected]=attribs[Attributes::Protected];
+	basic_attribs[Attributes::SqlDisabled]=attribs[Attributes::SqlDisabled];
+	basic_attribs[Attributes::Options]=attribs[Attributes::Options];
 
 	xmlparser.savePosition();
 
+	//Gathering the basic attributes stored in the child elements
 	if(xmlparser.accessElement(XmlParser::ChildElement))
 	{
 		do
@@ -3543,99 +3524,128 @@ void DatabaseModel::setBasicAttributes(BaseObject *object)
 			{
 				elem_name=xmlparser.getElementName();
 
-				//Defines the object's comment
-				if(elem_name==Attributes::Comment)
+				//Comment, appended and prepended SQL are stored as the element content
+				if(elem_name==Attributes::Comment ||
+					 elem_name==Attributes::AppendedSql ||
+					 elem_name==Attributes::PrependedSql)
 				{
 					xmlparser.savePosition();
 					xmlparser.accessElement(XmlParser::ChildElement);
-					object->setComment(xmlparser.getElementContent());
+					basic_attribs[elem_name]=xmlparser.getElementContent();
 					xmlparser.restorePosition();
 				}
-				//Defines the object's schema
-				else if(elem_name==Attributes::Schema)
-				{
-					obj_type=ObjectType::Schema;
-					xmlparser.getElementAttributes(attribs_aux);
-					schema=dynamic_cast<Schema *>(getObject(attribs_aux[Attributes::Name], obj_type));
-					object->setSchema(schema);
-					has_error=(!schema && !attribs_aux[Attributes::Name].isEmpty());
-				}
-				//Defines the object's tablespace
-				else if(elem_name==Attributes::Tablespace)
-				{
-					obj_type=ObjectType::Tablespace;
-					xmlparser.getElementAttributes(attribs_aux);
-					tabspc=getObject(attribs_aux[Attributes::Name], obj_type);
-					object->setTablespace(tabspc);
-					has_error=(!tabspc && !attribs_aux[Attributes::Name].isEmpty());
-				}
-				//Defines the object's owner
-				else if(elem_name==Attributes::Role)
+				//Schema, tablespace, owner and collation are referenced by name
+				else if(ref_elems.count(elem_name))
 				{
-					obj_type=ObjectType::Role;
 					xmlparser.getElementAttributes(attribs_aux);
-					owner=getObject(attribs_aux[Attributes::Name], obj_type);
-					object->setOwner(owner);
-					has_error=(!owner && !attribs_aux[Attributes::Name].isEmpty());
+					basic_attribs[ref_elems[elem_name]]=attribs_aux[Attributes::Name];
 				}
-				//Defines the object's schema
-				else if(elem_name==Attributes::Collation)
+				else if(elem_name==Attributes::Position)
 				{
-					obj_type=ObjectType::Collation;
 					xmlparser.getElementAttributes(attribs_aux);
-					collation=getObject(attribs_aux[Attributes::Name], obj_type);
-					object->setCollation(collation);
-					has_error=(!collation && !attribs_aux[Attributes::Name].isEmpty());
-				}
-				else if(elem_name==Attributes::AppendedSql)
-				{
-					xmlparser.savePosition();
-					xmlparser.accessElement(XmlParser::ChildElement);
-					object->setAppendedSQL(xmlparser.getElementContent());
-					xmlparser.restorePosition();
+					basic_attribs[Attributes::XPos]=attribs_aux[Attributes::XPos];
+					basic_attribs[Attributes::YPos]=attribs_aux[Attributes::YPos];
 				}
-				else if(elem_name==Attributes::PrependedSql)
-				{
-					xmlparser.savePosition();
-					xmlparser.accessElement(XmlParser::ChildElement);
-					object->setPrependedSQL(xmlparser.getElementContent());
-					xmlparser.restorePosition();
-				}
-				//Defines the object's position (only for graphical objects)
-				else if(elem_name==Attributes::Position)
-				{
-					xmlparser.getElementAttributes(attribs);
+			}
+		}
+		while(xmlparser.accessElement(XmlParser::NextElement));
+	}
 
-					if(elem_name==Attributes::Position &&
-							(obj_type_aux!=ObjectType::Relationship &&
-							 obj_type_aux!=ObjectType::BaseRelationship))
-					{
-						dynamic_cast<BaseGraphicObject *>(object)->setPosition(QPointF(attribs[Attributes::XPos].toDouble(),
-																				 attribs[Attributes::YPos].toDouble()));
+	xmlparser.restorePosition();
+	setBasicAttributes(object, basic_attribs);
+}
 
+void DatabaseModel::setBasicAttributes(BaseObject *object, attribs_map &attribs)
+{
+	BaseObject *ref_obj=nullptr;
+	ObjectType obj_type=ObjectType::BaseObject;
+	ForeignObject *frn_object = dynamic_cast<ForeignObject *>(object);
+	std::vector<std::pair<QString, ObjectType>> ref_attribs = {
+		{ Attributes::Schema, ObjectType::Schema },
+		{ Attributes::Tablespace, ObjectType::Tablespace },
+		{ Attributes::Owner, ObjectType::Role },
+		{ Attributes::Collation, ObjectType::Collation }
+	};
 
-					}
-				}
-			}
+	if(!object)
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	obj_type=object->getObjectType();
+
+	if(obj_type!=ObjectType::Cast && obj_type != ObjectType::UserMapping)
+		object->setName(attribs[Attributes::Name]);
+
+	if(BaseGraphicObject::isGraphicObject(obj_type) && !attribs[Attributes::ZValue].isEmpty())
+		dynamic_cast<BaseGraphicObject *>(object)->setZValue(attribs[Attributes::ZValue].toInt());
+
+	if(BaseObject::acceptsAlias(obj_type))
+		object->setAlias(attribs[Attributes::Alias]);
+
+	if(frn_object)
+	{
+		QStringList opt_val;
+
+		for(auto &option : attribs[Attributes::Options].split(ForeignObject::OptionsSeparator))
+		{
+			opt_val = option.split(UserMapping::OptionValueSeparator);
+
+			if(opt_val.size() < 2)
+				continue;
+
+			frn_object->setOption(opt_val[0], opt_val[1]);
 		}
-		while(!has_error && xmlparser.accessElement(XmlParser::NextElement));
 	}
 
-	xmlparser.restorePosition();
-	object->setProtected(protected_obj);
-	object->setSQLDisabled(sql_disabled);
+	if(!attribs[Attributes::Comment].isEmpty())
+		object->setComment(attribs[Attributes::Comment]);
 
-	if(has_error)
+	//Resolving the objects referenced by name (schema, tablespace, owner and collation)
+	for(auto &ref : ref_attribs)
 	{
-		throw Exception(Exception::getErrorMessage(ErrorCode::RefObjectInexistsModel)
-						.arg(object->getName())
-						.arg(object->getTypeName())
-						.arg(attribs_aux[Attributes::Name])
-				.arg(BaseObject::getTypeName(obj_type)),
-				ErrorCode::RefObjectInexistsModel,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+		if(attribs[ref.first].isEmpty())
+			continue;
+
+		ref_obj=getObject(attribs[ref.first], ref.second);
+
+		if(!ref_obj)
+		{
+			throw Exception(Exception::getErrorMessage(ErrorCode::RefObjectInexistsModel)
+							.arg(object->getName())
+							.arg(object->getTypeName())
+							.arg(attribs[ref.first])
+							.arg(BaseObject::getTypeName(ref.second)),
+							ErrorCode::RefObjectInexistsModel,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+		}
+
+		if(ref.second==ObjectType::Schema)
+			object->setSchema(ref_obj);
+		else if(ref.second==ObjectType::Tablespace)
+			object->setTablespace(ref_obj);
+		else if(ref.second==ObjectType::Role)
+			object->setOwner(ref_obj);
+		else
+			object->setCollation(ref_obj);
+	}
+
+	if(!attribs[Attributes::AppendedSql].isEmpty())
+		object->setAppendedSQL(attribs[Attributes::AppendedSql]);
+
+	if(!attribs[Attributes::PrependedSql].isEmpty())
+		object->setPrependedSQL(attribs[Attributes::PrependedSql]);
+
+	//Defines the object's position (only for graphical objects)
+	if(!attribs[Attributes::XPos].isEmpty() && BaseGraphicObject::isGraphicObject(obj_type) &&
+		 obj_type!=ObjectType::Relationship && obj_type!=ObjectType::BaseRelationship)
+	{
+		dynamic_cast<BaseGraphicObject *>(object)->setPosition(QPointF(attribs[Attributes::XPos].toDouble(),
+																																	 attribs[Attributes::YPos].toDouble()));
 	}
+
+	object->setProtected(attribs[Attributes::Protected]==Attributes::True);
+	object->setSQLDisabled(attribs[Attributes::SqlDisabled]==Attributes::True);
+
 	//Schema on extensions are optional
-	else if(!object->getSchema() && (BaseObject::acceptsSchema(obj_type_aux) && obj_type_aux != ObjectType::Extension))
+	if(!object->getSchema() && (BaseObject::acceptsSchema(obj_type) && obj_type != ObjectType::Extension))
 	{
 		throw Exception(Exception::getErrorMessage(ErrorCode::InvObjectAllocationNoSchema)
 						.arg(object->getName())
@@ -3725,22 +3735,8 @@ double DatabaseModel::getLastZoomFactor()
 Role *DatabaseModel::createRole()
 {
 	attribs_map attribs, attribs_aux;
-	Role *role=nullptr, *ref_role=nullptr;
-	int i, len;
-	bool marked;
-	QStringList list;
+	Role *role=nullptr;
 	QString elem_name;
-	Role::RoleType role_type;
-
-	QString op_attribs[]={ Attributes::Superuser, Attributes::CreateDb,
-												 Attributes::CreateRole, Attributes::Inherit,
-												 Attributes::Login, Attributes::Replication,
-												 Attributes::BypassRls };
-
-	Role::RoleOpts op_vect[]={ Role::OpSuperuser, Role::OpCreateDb,
-														 Role::OpCreateRole, Role::OpInherit,
-														 Role::OpLogin, Role::OpReplication,
-														 Role::OpBypassRls };
 
 	try
 	{
@@ -3750,19 +3746,6 @@ Role *DatabaseModel::createRole()
 		//Gets all the attributes values from the XML
 		xmlparser.getElementAttributes(attribs);
 
-		role->setPassword(attribs[Attributes::Password]);
-		role->setValidity(attribs[Attributes::Validity]);
-
-		if(!attribs[Attributes::ConnLimit].isEmpty())
-			role->setConnectionLimit(attribs[Attributes::ConnLimit].toInt());
-
-		//Setting up the role options according to the configured on the XML
-		for(i=0; i < 7; i++)
-		{
-			marked=attribs[op_attribs[i]]==Attributes::True;
-			role->setOption(op_vect[i], marked);
-		}
-
 		if(xmlparser.accessElement(XmlParser::ChildElement))
 		{
 			do
@@ -3771,45 +3754,22 @@ Role *DatabaseModel::createRole()
 				{
 					elem_name=xmlparser.getElementName();
 
-					//Getting the member roles
+					//Getting the member roles names
 					if(elem_name==Attributes::Roles)
 					{
-						//Gets the member roles attributes
 						xmlparser.getElementAttributes(attribs_aux);
 
-						//The member roles names are separated by comma, so it is needed to split them
-						list=attribs_aux[Attributes::Names].split(',');
-						len=list.size();
-
-						//Identifying the member role type
 						if(attribs_aux[Attributes::RoleType]==Attributes::Member)
-							role_type=Role::MemberRole;
+							attribs[Attributes::MemberRoles]=attribs_aux[Attributes::Names];
 						else
-							role_type=Role::AdminRole;
-
-						for(i=0; i < len; i++)
-						{
-							//Gets the role using the name from the model using the name from the list
-							ref_role=dynamic_cast<Role *>(getObject(list[i].trimmed(),ObjectType::Role));
-
-							//Raises an error if the roles doesn't exists
-							if(!ref_role)
-							{
-								throw Exception(Exception::getErrorMessage(ErrorCode::RefObjectInexistsModel)
-												.arg(role->getName())
-												.arg(BaseObject::getTypeName(ObjectType::Role))
-												.arg(list[i])
-												.arg(BaseObject::getTypeName(ObjectType::Role)),
-												ErrorCode::RefObjectInexistsModel,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-							}
-
-							role->addRole(role_type, ref_role);
-						}
+							attribs[Attributes::AdminRoles]=attribs_aux[Attributes::Names];
 					}
 				}
 			}
 			while(xmlparser.accessElement(XmlParser::NextElement));
 		}
+
+		configureRole(role, attribs);
 	}
 	catch(Exception &e)
 	{
@@ -3820,6 +3780,67 @@ Role *DatabaseModel::createRole()
 	return role;
 }
 
+void DatabaseModel::configureRole(Role *role, attribs_map &attribs)
+{
+	Role *ref_role=nullptr;
+	QStringList list;
+	std::vector<std::pair<QString, Role::RoleType>> role_lists = {
+		{ Attributes::MemberRoles, Role::MemberRole },
+		{ Attributes::AdminRoles, Role::AdminRole }
+	};
+
+	QString op_attribs[]={ Attributes::Superuser, Attributes::CreateDb,
+												 Attributes::CreateRole, Attributes::Inherit,
+												 Attributes::Login, Attributes::Replication,
+												 Attributes::BypassRls };
+
+	Role::RoleOpts op_vect[]={ Role::OpSuperuser, Role::OpCreateDb,
+														 Role::OpCreateRole, Role::OpInherit,
+														 Role::OpLogin, Role::OpReplication,
+														 Role::OpBypassRls };
+
+	if(!role)
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	role->setPassword(attribs[Attributes::Password]);
+	role->setValidity(attribs[Attributes::Validity]);
+
+	if(!attribs[Attributes::ConnLimit].isEmpty())
+		role->setConnectionLimit(attribs[Attributes::ConnLimit].toInt());
+
+	//Setting up the role options according to the configured in the attributes
+	for(unsigned i=0; i < 7; i++)
+		role->setOption(op_vect[i], attribs[op_attribs[i]]==Attributes::True);
+
+	//The member roles names are separated by comma, so it is needed to split them
+	for(auto &rl_list : role_lists)
+	{
+		if(attribs[rl_list.first].isEmpty())
+			continue;
+
+		list=attribs[rl_list.first].split(',');
+
+		for(auto &rl_name : list)
+		{
+			//Gets the role using the name from the model using the name from the list
+			ref_role=dynamic_cast<Role *>(getObject(rl_name.trimmed(), ObjectType::Role));
+
+			//Raises an error if the roles doesn't exists
+			if(!ref_role)
+			{
+				throw Exception(Exception::getErrorMessage(ErrorCode::RefObjectInexistsModel)
+								.arg(role->getName())
+								.arg(BaseObject::getTypeName(ObjectType::Role))
+								.arg(rl_name)
+								.arg(BaseObject::getTypeName(ObjectType::Role)),
+								ErrorCode::RefObjectInexistsModel,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+			}
+
+			role->addRole(rl_list.second, ref_role);
+		}
+	}
+}
+
 Tablespace *DatabaseModel::createTablespace()
 {
 	attribs_map attribs;
@@ -3830,7 +3851,7 @@ Tablespace *DatabaseModel::createTablespace()
 		tabspc=new Tablespace;
 		setBasicAttributes(tabspc);
 		xmlparser.getElementAttributes(attribs);
-		tabspc->setDirectory(attribs[Attributes::Directory]);
+		configureTablespace(tabspc, attribs);
 	}
 	catch(Exception &e)
 	{
@@ -3841,6 +3862,14 @@ Tablespace *DatabaseModel::createTablespace()
 	return tabspc;
 }
 
+void DatabaseModel::configureTablespace(Tablespace *tabspc, attribs_map &attribs)
+{
+	if(!tabspc)
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	tabspc->setDirectory(attribs[Attributes::Directory]);
+}
+
 Schema *DatabaseModel::createSchema()
 {
 	Schema *schema=nullptr;
@@ -3851,10 +3880,7 @@ Schema *DatabaseModel::createSchema()
 		schema=new Schema;
 		xmlparser.getElementAttributes(attribs);
 		setBasicAttributes(schema);
-		schema->setFillColor(QColor(attribs[Attributes::FillColor]));
-		schema->setRectVisible(attribs[Attributes::RectVisible]==Attributes::True);
-		schema->setFadedOut(attribs[Attributes::FadedOut]==Attributes::True);
-		schema->setLayers(attribs[Attributes::Layers].split(','));
+		configureSchema(schema, attribs);
 	}
 	catch(Exception &e)
 	{
@@ -3865,6 +3891,17 @@ Schema *DatabaseModel::createSchema()
 	return schema;
 }
 
+void DatabaseModel::configureSchema(Schema *schema, attribs_map &attribs)
+{
+	if(!schema)
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	schema->setFillColor(QColor(attribs[Attributes::FillColor]));
+	schema->setRectVisible(attribs[Attributes::RectVisible]==Attributes::True);
+	schema->setFadedOut(attribs[Attributes::FadedOut]==Attributes::True);
+	schema->setLayers(attribs[Attributes::Layers].split(','));
+}
+
 Language *DatabaseModel::createLanguage()
 {
 	attribs_map attribs;
@@ -4993,10 +5030,7 @@ Table *DatabaseModel::createTable()
 
 		xmlparser.getElementAttributes(attribs);
 		table = createPhysicalTable<Table>();
-		table->setUnlogged(attribs[Attributes::Unlogged]==Attributes::True);
-		table->setRLSEnabled(attribs[Attributes::RlsEnabled]==Attributes::True);
-		table->setRLSForced(attribs[Attributes::RlsForced]==Attributes::True);
-		table->setWithOIDs(attribs[Attributes::Oids]==Attributes::True);
+		configureTable(table, attribs);
 
 		return table;
 	}
@@ -5006,6 +5040,17 @@ Table *DatabaseModel::createTable()
 	}
 }
 
+void DatabaseModel::configureTable(Table *table, attribs_map &attribs)
+{
+	if(!table)
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	table->setUnlogged(attribs[Attributes::Unlogged]==Attributes::True);
+	table->setRLSEnabled(attribs[Attributes::RlsEnabled]==Attributes::True);
+	table->setRLSForced(attribs[Attributes::RlsForced]==Attributes::True);
+	table->setWithOIDs(attribs[Attributes::Oids]==Attributes::True);
+}
+
 Column *DatabaseModel::createColumn()
 {
 	attribs_map attribs;
@@ -5079,8 +5124,7 @@ Constraint *DatabaseModel::createConstraint(BaseObject *parent_obj)
 	Column *column=nullptr;
 	Relationship *rel=nullptr;
 	QString elem, str_aux;
-	bool deferrable, ins_constr_table=false;
-	ConstraintType constr_type;
+	bool ins_constr_table=false;
 	QStringList col_list;
 	int count, i;
 	Constraint::ColumnsId cols_id;
@@ -5127,76 +5171,16 @@ Constraint *DatabaseModel::createConstraint(BaseObject *parent_obj)
 
 		constr=new Constraint;
 		constr->setParentTable(table);
-
-		//Configuring the constraint type
-		if(attribs[Attributes::Type]==Attributes::CkConstr)
-			constr_type=ConstraintType::Check;
-		else if(attribs[Attributes::Type]==Attributes::PkConstr)
-			constr_type=ConstraintType::PrimaryKey;
-		else if(attribs[Attributes::Type]==Attributes::FkConstr)
-			constr_type=ConstraintType::ForeignKey;
-		else if(attribs[Attributes::Type]==Attributes::UqConstr)
-			constr_type=ConstraintType::Unique;
-		else
-			constr_type=ConstraintType::Exclude;
-
-		constr->setConstraintType(constr_type);
-
-		if(!attribs[Attributes::Factor].isEmpty())
-			constr->setFillFactor(attribs[Attributes::Factor].toUInt());
-
+		configureConstraint(constr, attribs);
 		setBasicAttributes(constr);
 
 		//Raises an error if the constraint is a primary key and no parent object is specified
-		if(!parent_obj && constr_type==ConstraintType::PrimaryKey)
+		if(!parent_obj && constr->getConstraintType()==ConstraintType::PrimaryKey)
 			throw Exception(Exception::getErrorMessage(ErrorCode::InvPrimaryKeyAllocation)
 							.arg(constr->getName()),
 							ErrorCode::InvPrimaryKeyAllocation,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-		deferrable=(attribs[Attributes::Deferrable]==Attributes::True);
-		constr->setDeferrable(deferrable);
-
-		if(deferrable && !attribs[Attributes::DeferType].isEmpty())
-			constr->setDeferralType(attribs[Attributes::DeferType]);
-
-		if(constr_type==ConstraintType::ForeignKey)
-		{
-			if(!attribs[Attributes::ComparisonType].isEmpty())
-				constr->setMatchType(attribs[Attributes::ComparisonType]);
-
-			if(!attribs[Attributes::DelAction].isEmpty())
-				constr->setActionType(attribs[Attributes::DelAction], Constraint::DeleteAction);
-
-			if(!attribs[Attributes::UpdAction].isEmpty())
-				constr->setActionType(attribs[Attributes::UpdAction], Constraint::UpdateAction);
-
-			ref_table=getObject(attribs[Attributes::RefTable], ObjectType::Table);
-
-			if(!ref_table && table->getName(true)==attribs[Attributes::RefTable])
-				ref_table=table;
-
-			//Raises an error if the referenced table doesn't exists
-			if(!ref_table)
-			{
-				str_aux=Exception::getErrorMessage(ErrorCode::RefObjectInexistsModel)
-						.arg(constr->getName())
-						.arg(constr->getTypeName())
-						.arg(attribs[Attributes::RefTable])
-						.arg(BaseObject::getTypeName(ObjectType::Table));
-
-				throw Exception(str_aux,ErrorCode::RefObjectInexistsModel,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-			}
-
-			constr->setReferencedTable(dynamic_cast<BaseTable *>(ref_table));
-		}
-		else if(constr_type==ConstraintType::Check)
-		{
-			constr->setNoInherit(attribs[Attributes::NoInherit]==Attributes::True);
-		}
-		else if(constr_type==ConstraintType::Exclude &&	!attribs[Attributes::IndexType].isEmpty())
-		{
-			constr->setIndexType(attribs[Attributes::IndexType]);
-		}
+		ref_table=constr->getReferencedTable();
 
 		if(xmlparser.accessElement(XmlParser::ChildElement))
 		{
@@ -5285,6 +5269,108 @@ Constraint *DatabaseModel::createConstraint(BaseObject *parent_obj)
 	return constr;
 }
 
+void DatabaseModel::configureConstraint(Constraint *constr, attribs_map &attribs)
+{
+	BaseTable *table=nullptr;
+	BaseObject *ref_table=nullptr;
+	PhysicalTable *aux_table=nullptr;
+	Column *column=nullptr;
+	ConstraintType constr_type;
+	bool deferrable;
+
+	if(!constr)
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	table=constr->getParentTable();
+
+	//Configuring the constraint type
+	if(attribs[Attributes::Type]==Attributes::CkConstr)
+		constr_type=ConstraintType::Check;
+	else if(attribs[Attributes::Type]==Attributes::PkConstr)
+		constr_type=ConstraintType::PrimaryKey;
+	else if(attribs[Attributes::Type]==Attributes::FkConstr)
+		constr_type=ConstraintType::ForeignKey;
+	else if(attribs[Attributes::Type]==Attributes::UqConstr)
+		constr_type=ConstraintType::Unique;
+	else
+		constr_type=ConstraintType::Exclude;
+
+	constr->setConstraintType(constr_type);
+
+	if(!attribs[Attributes::Factor].isEmpty())
+		constr->setFillFactor(attribs[Attributes::Factor].toUInt());
+
+	deferrable=(attribs[Attributes::Deferrable]==Attributes::True);
+	constr->setDeferrable(deferrable);
+
+	if(deferrable && !attribs[Attributes::DeferType].isEmpty())
+		constr->setDeferralType(attribs[Attributes::DeferType]);
+
+	if(constr_type==ConstraintType::ForeignKey)
+	{
+		if(!attribs[Attributes::ComparisonType].isEmpty())
+			constr->setMatchType(attribs[Attributes::ComparisonType]);
+
+		if(!attribs[Attributes::DelAction].isEmpty())
+			constr->setActionType(attribs[Attributes::DelAction], Constraint::DeleteAction);
+
+		if(!attribs[Attributes::UpdAction].isEmpty())
+			constr->setActionType(attribs[Attributes::UpdAction], Constraint::UpdateAction);
+
+		ref_table=getObject(attribs[Attributes::RefTable], ObjectType::Table);
+
+		if(!ref_table && table && table->getName(true)==attribs[Attributes::RefTable])
+			ref_table=table;
+
+		//Raises an error if the referenced table doesn't exists
+		if(!ref_table)
+		{
+			throw Exception(Exception::getErrorMessage(ErrorCode::RefObjectInexistsModel)
+											.arg(attribs[Attributes::Name])
+											.arg(BaseObject::getTypeName(ObjectType::Constraint))
+											.arg(attribs[Attributes::RefTable])
+											.arg(BaseObject::getTypeName(ObjectType::Table)),
+											ErrorCode::RefObjectInexistsModel,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+		}
+
+		constr->setReferencedTable(dynamic_cast<BaseTable *>(ref_table));
+	}
+	else if(constr_type==ConstraintType::Check)
+	{
+		constr->setNoInherit(attribs[Attributes::NoInherit]==Attributes::True);
+	}
+	else if(constr_type==ConstraintType::Exclude &&	!attribs[Attributes::IndexType].isEmpty())
+	{
+		constr->setIndexType(attribs[Attributes::IndexType]);
+	}
+
+	if((constr_type==ConstraintType::Check || constr_type==ConstraintType::Exclude) &&
+		 !attribs[Attributes::Expression].isEmpty())
+		constr->setExpression(attribs[Attributes::Expression]);
+
+	/* The source and referenced columns are provided as lists of names only when the constraint
+	 * is configured from the catalog attributes, the XML loader reads them from the <columns> elements */
+	for(auto &cols : { std::make_pair(Attributes::SrcColumns, Constraint::SourceCols),
+										 std::make_pair(Attributes::DstColumns, Constraint::ReferencedCols) })
+	{
+		aux_table=dynamic_cast<PhysicalTable *>(cols.second==Constraint::SourceCols ? table : constr->getReferencedTable());
+
+		if(!aux_table || attribs[cols.first].isEmpty())
+			continue;
+
+		for(auto &col_name : attribs[cols.first].split(','))
+		{
+			column=aux_table->getColumn(col_name);
+
+			//If the column doesn't exists tries to get it searching by the old name
+			if(!column)
+				column=aux_table->getColumn(col_name, true);
+
+			constr->addColumn(column, cols.second);
+		}
+	}
+}
+
 void DatabaseModel::createElement(Element &elem, TableObject *tab_obj, BaseObject *parent_obj)
 {
 	attribs_map attribs;
@@ -6438,78 +6524,86 @@ Sequence *DatabaseModel::createSequence(bool ignore_onwer)
 {
 	attribs_map attribs;
 	Sequence *sequence=nullptr;
-	BaseObject *table=nullptr;
-	Column *column=nullptr;
-	QString str_aux, tab_name, col_name;
-	QStringList elem_list;
-	int count;
 
 	try
 	{
 		sequence=new Sequence;
 		setBasicAttributes(sequence);
 		xmlparser.getElementAttributes(attribs);
+		configureSequence(sequence, attribs, ignore_onwer);
+	}
+	catch(Exception &e)
+	{
+		if(sequence) delete sequence;
+		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, getErrorExtraInfo());
+	}
 
-		sequence->setValues(attribs[Attributes::MinValue],
-				attribs[Attributes::MaxValue],
-				attribs[Attributes::Increment],
-				attribs[Attributes::Start],
-				attribs[Attributes::Cache]);
-
-		sequence->setCycle(attribs[Attributes::Cycle]==Attributes::True);
+	return sequence;
+}
 
-		//Getting the sequence's owner column
-		if(!attribs[Attributes::OwnerColumn].isEmpty())
-		{
-			elem_list=attribs[Attributes::OwnerColumn].split('.');
-			count=elem_list.count();
+void DatabaseModel::configureSequence(Sequence *sequence, attribs_map &attribs, bool ignore_onwer)
+{
+	BaseObject *table=nullptr;
+	Column *column=nullptr;
+	QString str_aux, tab_name, col_name;
+	QStringList elem_list;
+	int count;
 
-			if(count==3)
-			{
-				tab_name=elem_list[0] + QString(".") + elem_list[1];
-				col_name=elem_list[2];
-			}
-			else if(count==2)
-			{
-				tab_name=elem_list[0];
-				col_name=elem_list[1];
-			}
+	if(!sequence)
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-			table=getObject(tab_name, {ObjectType::Table, ObjectType::ForeignTable});
+	sequence->setValues(attribs[Attributes::MinValue],
+			attribs[Attributes::MaxValue],
+			attribs[Attributes::Increment],
+			attribs[Attributes::Start],
+			attribs[Attributes::Cache]);
 
-			//Raises an error if the column parent table doesn't exists
-			if(!table)
-			{
-				str_aux=Exception::getErrorMessage(ErrorCode::RefObjectInexistsModel)
-						.arg(sequence->getName())
-						.arg(BaseObject::getTypeName(ObjectType::Sequence))
-						.arg(tab_name)
-						.arg(BaseObject::getTypeName(ObjectType::Table));
+	sequence->setCycle(attribs[Attributes::Cycle]==Attributes::True);
 
-				throw Exception(str_aux,ErrorCode::RefObjectInexistsModel,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-			}
+	//Getting the sequence's owner column
+	if(!attribs[Attributes::OwnerColumn].isEmpty())
+	{
+		elem_list=attribs[Attributes::OwnerColumn].split('.');
+		count=elem_list.count();
 
-			column=dynamic_cast<PhysicalTable *>(table)->getColumn(col_name);
+		if(count==3)
+		{
+			tab_name=elem_list[0] + QString(".") + elem_list[1];
+			col_name=elem_list[2];
+		}
+		else if(count==2)
+		{
+			tab_name=elem_list[0];
+			col_name=elem_list[1];
+		}
 
-			if(!column)
-				column=dynamic_cast<PhysicalTable *>(table)->getColumn(col_name, true);
+		table=getObject(tab_name, {ObjectType::Table, ObjectType::ForeignTable});
 
-			//Raises an error if the column doesn't exists
-			if(!column && !ignore_onwer)
-				throw Exception(Exception::getErrorMessage(ErrorCode::AsgInexistentSeqOwnerColumn)
-								.arg(sequence->getName(true)),
-								ErrorCode::AsgInexistentSeqOwnerColumn,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+		//Raises an error if the column parent table doesn't exists
+		if(!table)
+		{
+			str_aux=Exception::getErrorMessage(ErrorCode::RefObjectInexistsModel)
+					.arg(sequence->getName())
+					.arg(BaseObject::getTypeName(ObjectType::Sequence))
+					.arg(tab_name)
+					.arg(BaseObject::getTypeName(ObjectType::Table));
 
-			sequence->setOwnerColumn(column);
+			throw Exception(str_aux,ErrorCode::RefObjectInexistsModel,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 		}
-	}
-	catch(Exception &e)
-	{
-		if(sequence) delete sequence;
-		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, getErrorExtraInfo());
-	}
 
-	return sequence;
+		column=dynamic_cast<PhysicalTable *>(table)->getColumn(col_name);
+
+		if(!column)
+			column=dynamic_cast<PhysicalTable *>(table)->getColumn(col_name, true);
+
+		//Raises an error if the column doesn't exists
+		if(!column && !ignore_onwer)
+			throw Exception(Exception::getErrorMessage(ErrorCode::AsgInexistentSeqOwnerColumn)
+							.arg(sequence->getName(true)),
+							ErrorCode::AsgInexistentSeqOwnerColumn,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		sequence->setOwnerColumn(column);
+	}
 }
 
 View *DatabaseModel::createView()
@@ -11787,15 +11881,7 @@ TableClass *DatabaseModel::createPhysicalTable()
 		table = new TableClass;
 		setBasicAttributes(table);
 		xmlparser.getElementAttributes(attribs);
-
-		table->setObjectListsCapacity(attribs[Attributes::MaxObjCount].toUInt());
-		table->setGenerateAlterCmds(attribs[Attributes::GenAlterCmds]==Attributes::True);
-		table->setCollapseMode(attribs[Attributes::CollapseMode].isEmpty() ? BaseTable::NotCollapsed : static_cast<BaseTable::CollapseMode>(attribs[Attributes::CollapseMode].toUInt()));
-		table->setPaginationEnabled(attribs[Attributes::Pagination]==Attributes::True);
-		table->setCurrentPage(BaseTable::AttribsSection, attribs[Attributes::AttribsPage].toUInt());
-		table->setCurrentPage(BaseTable::ExtAttribsSection, attribs[Attributes::ExtAttribsPage].toUInt());
-		table->setFadedOut(attribs[Attributes::FadedOut]==Attributes::True);
-		table->setLayers(attribs[Attributes::Layers].split(','));
+		configurePhysicalTable(table, attribs);
 
 		if(xmlparser.accessElement(XmlParser::ChildElement))
 		{
@@ -11918,6 +12004,21 @@ TableClass *DatabaseModel::createPhysicalTable()
 	return table;
 }
 
+void DatabaseModel::configurePhysicalTable(PhysicalTable *table, attribs_map &attribs)
+{
+	if(!table)
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	table->setObjectListsCapacity(attribs[Attributes::MaxObjCount].toUInt());
+	table->setGenerateAlterCmds(attribs[Attributes::GenAlterCmds]==Attributes::True);
+	table->setCollapseMode(attribs[Attributes::CollapseMode].isEmpty() ? BaseTable::NotCollapsed : static_cast<BaseTable::CollapseMode>(attribs[Attributes::CollapseMode].toUInt()));
+	table->setPaginationEnabled(attribs[Attributes::Pagination]==Attributes::True);
+	table->setCurrentPage(BaseTable::AttribsSection, attribs[Attributes::AttribsPage].toUInt());
+	table->setCurrentPage(BaseTable::ExtAttribsSection, attribs[Attributes::ExtAttribsPage].toUInt());
+	table->setFadedOut(attribs[Attributes::FadedOut]==Attributes::True);
+	table->setLayers(attribs[Attributes::Layers].split(','));
+}
+
 void DatabaseModel::getDataDictionary(attribs_map &datadict, bool browsable, bool split)
 {
 	int idx = 0;
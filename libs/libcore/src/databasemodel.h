@@ -719,6 +719,28 @@ class __libcore DatabaseModel:  public QObject, public BaseObject {
 		BaseObject *getObject(const QString &name, ObjectType obj_type);
 
 		void configureDatabase(attribs_map &attribs);
+
+		/*! \brief Configures the basic attributes, common between all children of BaseObject, from a plain attributes map.
+		 * The schema, tablespace, owner and collation are referenced by their names. This method is used by the XML
+		 * loader as well as by the objects builders that create objects without parsing any XML code (e.g. reverse engineering) */
+		void setBasicAttributes(BaseObject *object, attribs_map &attribs);
+
+		/*! \brief Objects builders that configure the attributes specific of each object type from a plain attributes map.
+		 * They are shared by the XML loading methods (createRole(), createSchema(), etc) and the reverse engineering process,
+		 * which uses them to create objects straight from the catalog attributes */
+		void configureRole(Role *role, attribs_map &attribs);
+		void configureTablespace(Tablespace *tabspc, attribs_map &attribs);
+		void configureSchema(Schema *schema, attribs_map &attribs);
+		void configureSequence(Sequence *sequence, attribs_map &attribs, bool ignore_onwer=false);
+		void configureTable(Table *table, attribs_map &attribs);
+
+		//! \brief Configures the attributes common to tables and foreign tables (objects capacity, collapse mode, layers, etc)
+		void configurePhysicalTable(PhysicalTable *table, attribs_map &attribs);
+
+		/*! \brief Configures the constraint from a plain attributes map. The parent table must be assigned to the constraint
+		 * beforehand. The referenced table and the source/referenced columns (comma separated lists) are referenced by name */
+		void configureConstraint(Constraint *constr, attribs_map &attribs);
+
 		PgSqlType createPgSQLType();
 		BaseObject *createObject(ObjectType obj_type);
 		Role *createRole();
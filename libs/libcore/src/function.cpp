@@ -275,6 +275,9 @@ QString Function::getAlterCode(BaseObject *object)
 
 	try
 	{
+		if(getAlterableAttributes() == func->getAlterableAttributes())
+			return "";
+
 		attribs_map attribs;
 		attribs = BaseFunction::getAlterCodeAttributes(func);
 
@@ -292,7 +295,7 @@ QString Function::getAlterCode(BaseObject *object)
 			if(this->returns_setof && func->returns_setof && this->row_amount!=func->row_amount)
 			{
 				attribs[Attributes::ReturnsSetOf]=Attributes::True;
-				attribs[Attributes::RowAmount]=QString::number(row_amount);
+				attribs[Attributes::RowAmount]=QString::number(func->row_amount);
 			}
 
 			if(this->function_type!=func->function_type)
@@ -321,6 +324,21 @@ QString Function::getAlterCode(BaseObject *object)
 	}
 }
 
+attribs_map Function::getAlterableAttributes()
+{
+	attribs_map attribs = BaseFunction::getAlterableAttributes();
+
+	attribs[Attributes::ExecutionCost] = QString::number(execution_cost);
+	attribs[Attributes::ReturnsSetOf] = (returns_setof ? Attributes::True : "");
+	attribs[Attributes::RowAmount] = QString::number(row_amount);
+	attribs[Attributes::FunctionType] = ~function_type;
+	attribs[Attributes::LeakProof] = (is_leakproof ? Attributes::True : "");
+	attribs[Attributes::BehaviorType] = ~behavior_type;
+	attribs[Attributes::ParallelType] = ~parallel_type;
+
+	return attribs;
+}
+
 void Function::configureSearchAttributes()
 {
 	BaseFunction::configureSearchAttributes();
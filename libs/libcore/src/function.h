@@ -151,6 +151,8 @@ class __libcore Function: public BaseFunction {
 		virtual QString getSourceCode(SchemaParser::CodeType def_type) final;
 
 		virtual QString getAlterCode(BaseObject *object) final;
+
+		virtual attribs_map getAlterableAttributes() final;
 };
 
 #endif
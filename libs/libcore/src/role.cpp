@@ -323,6 +323,9 @@ QString Role::getAlterCode(BaseObject *object)
 
 	try
 	{
+		if(getAlterableAttributes() == role->getAlterableAttributes())
+			return "";
+
 		attribs_map attribs;
 		QString op_attribs[]={ Attributes::Superuser, Attributes::CreateDb,
 							   Attributes::CreateRole, Attributes::Inherit,
@@ -358,3 +361,34 @@ QString Role::getAlterCode(BaseObject *object)
 		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
 	}
 }
+
+attribs_map Role::getAlterableAttributes()
+{
+	attribs_map attribs = BaseObject::getAlterableAttributes();
+	QString op_attribs[]={ Attributes::Superuser, Attributes::CreateDb,
+												 Attributes::CreateRole, Attributes::Inherit,
+												 Attributes::Login, Attributes::Replication,
+												 Attributes::BypassRls };
+	QStringList rl_names;
+
+	for(unsigned i=0; i <= OpBypassRls; i++)
+		attribs[op_attribs[i]] = (options[i] ? Attributes::True : "");
+
+	attribs[Attributes::Password] = password;
+	attribs[Attributes::Validity] = validity;
+
+	for(auto &rl : member_roles)
+		rl_names.append(rl->getName());
+
+	rl_names.sort();
+	attribs[Attributes::MemberRoles] = rl_names.join(',');
+	rl_names.clear();
+
+	for(auto &rl : admin_roles)
+		rl_names.append(rl->getName());
+
+	rl_names.sort();
+	attribs[Attributes::AdminRoles] = rl_names.join(',');
+
+	return attribs;
+}
@@ -129,6 +129,8 @@ class __libcore Role: public BaseObject {
 		virtual QString getSourceCode(SchemaParser::CodeType def_type, bool reduced_form) final;
 
 		virtual QString getAlterCode(BaseObject *object) final;
+
+		virtual attribs_map getAlterableAttributes() final;
 };
 
 #endif
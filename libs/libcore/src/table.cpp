@@ -466,6 +466,9 @@ QString Table::getAlterCode(BaseObject *object)
 		QString alter_def;
 		attribs_map attribs;
 
+		if(getAlterableAttributes() == tab->getAlterableAttributes())
+			return alter_def;
+
 		attribs[Attributes::Oids]="";
 		attribs[Attributes::AlterCmds]=BaseObject::getAlterCode(object, true);
 
@@ -496,3 +499,15 @@ QString Table::getAlterCode(BaseObject *object)
 		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
 	}
 }
+
+attribs_map Table::getAlterableAttributes()
+{
+	attribs_map attribs = BaseObject::getAlterableAttributes();
+
+	attribs[Attributes::Oids] = (with_oid ? Attributes::True : "");
+	attribs[Attributes::Unlogged] = (unlogged ? Attributes::True : "");
+	attribs[Attributes::RlsEnabled] = (rls_enabled ? Attributes::True : "");
+	attribs[Attributes::RlsForced] = (rls_forced ? Attributes::True : "");
+
+	return attribs;
+}
@@ -171,6 +171,8 @@ class __libcore Table: public PhysicalTable {
 		//! \brief Returns the alter definition comparing the this table against the one provided via parameter
 		virtual QString getAlterCode(BaseObject *object) final;
 
+		virtual attribs_map getAlterableAttributes() final;
+
 		//! \brief Returns the truncate definition for this table
 		QString getTruncateDefinition(bool cascade);
 
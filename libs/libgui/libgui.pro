@@ -71,6 +71,7 @@ src/tools/databaseimporthelper.cpp \
 src/tools/modeldatabasediffform.cpp \
 src/tools/modelfixform.cpp \
 src/tools/objectsdiffinfo.cpp \
+src/tools/objectsdiffinfolist.cpp \
 src/tools/sqltoolwidget.cpp \
 src/tools/databaseexplorerwidget.cpp \
 src/tools/datamanipulationform.cpp \
@@ -86,6 +87,7 @@ src/tools/validationinfo.cpp \
 src/tools/modelvalidationhelper.cpp \
 src/tools/swapobjectsidswidget.cpp \
 src/tools/modelvalidationwidget.cpp \
+src/utils/datagridmodel.cpp \
 src/utils/deletableitemdelegate.cpp \
 src/utils/htmlitemdelegate.cpp \
 src/utils/plaintextitemdelegate.cpp \
@@ -189,6 +191,7 @@ src/tools/databaseimporthelper.h \
 src/tools/modeldatabasediffform.h \
 src/tools/modelfixform.h \
 src/tools/objectsdiffinfo.h \
+src/tools/objectsdiffinfolist.h \
 src/tools/sqltoolwidget.h \
 src/tools/databaseexplorerwidget.h \
 src/tools/datamanipulationform.h \
@@ -204,6 +207,7 @@ src/tools/validationinfo.h \
 src/tools/modelvalidationhelper.h \
 src/tools/swapobjectsidswidget.h \
 src/tools/modelvalidationwidget.h \
+src/utils/datagridmodel.h \
 src/utils/deletableitemdelegate.h \
 src/utils/htmlitemdelegate.h \
 src/utils/plaintextitemdelegate.h \
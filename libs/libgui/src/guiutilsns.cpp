@@ -393,6 +393,27 @@ namespace GuiUtilsNs {
 		}
 	}
 
+	void bulkDataEdit(QTableView *results_tbw)
+	{
+		if(!results_tbw || !results_tbw->model() || !results_tbw->selectionModel())
+			return;
+
+		BaseForm base_frm;
+		BulkDataEditWidget *bulkedit_wgt = new BulkDataEditWidget;
+
+		base_frm.setMainWidget(bulkedit_wgt);
+		base_frm.setButtonConfiguration(Messagebox::OkCancelButtons);
+		base_frm.apply_ok_btn->setShortcut(QKeySequence("Ctrl+Return"));
+
+		if(base_frm.exec() == QDialog::Accepted)
+		{
+			QString value = bulkedit_wgt->value_edt->toPlainText();
+
+			for(auto &index : results_tbw->selectionModel()->selectedIndexes())
+				results_tbw->model()->setData(index, value);
+		}
+	}
+
 	void createDropShadow(QWidget *wgt, int x_offset, int y_offset, int radius, const QColor &color)
 	{
 		QGraphicsDropShadowEffect *shadow=nullptr;
@@ -88,6 +88,9 @@ namespace GuiUtilsNs {
 	//! brief Changes the values of the grid selection at once
 	extern __libgui void bulkDataEdit(QTableWidget *results_tbw);
 
+	//! brief Changes the values of the grid selection at once writing them directly in the view's model
+	extern __libgui void bulkDataEdit(QTableView *results_tbw);
+
 	//! \brief Creates drop shadown on a widget
 	extern __libgui void createDropShadow(QWidget *wgt, int x_offset = 2, int y_offset = 2, int radius = 5, const QColor &color = QColor(0, 0, 0, 100));
 
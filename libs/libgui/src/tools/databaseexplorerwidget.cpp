@@ -149,6 +149,10 @@ DatabaseExplorerWidget::DatabaseExplorerWidget(QWidget *parent): QWidget(parent)
 
 	properties_tbw->setItemDelegate(new PlainTextItemDelegate(this, true));
 	rename_item=nullptr;
+	load_id = running_loads = 0;
+
+	//The objects listed by the explorer are cached so the items can be recreated without querying the database again
+	import_helper.setObjectsCached(true);
 
 	data_grid_tb->setToolTip(data_grid_tb->toolTip() + QString(" (%1)").arg(data_grid_tb->shortcut().toString()));
 	runsql_tb->setToolTip(runsql_tb->toolTip() + QString(" (%1)").arg(runsql_tb->shortcut().toString()));
@@ -240,7 +244,7 @@ DatabaseExplorerWidget::DatabaseExplorerWidget(QWidget *parent): QWidget(parent)
 
 		if((obj_type==ObjectType::Schema || BaseTable::isBaseTable(obj_type)) && oid > 0 && item->childCount() <= 1)
 		{
-			updateItem(item, false);
+			loadItemChildren(item);
 		}
 	});
 
@@ -993,6 +997,13 @@ QString DatabaseExplorerWidget::getObjectName(ObjectType obj_type, const QString
 	}
 }
 
+DatabaseExplorerWidget::~DatabaseExplorerWidget()
+{
+	//Waiting the running loads since they use the explorer when finished
+	load_pool.clear();
+	load_pool.waitForDone();
+}
+
 void DatabaseExplorerWidget::setConnection(Connection conn, const QString &default_db)
 {
 	this->connection=conn;
@@ -1037,8 +1048,12 @@ void DatabaseExplorerWidget::listObjects()
 		saveTreeState();
 		clearObjectProperties();
 
+		/* The quick refresh reuses the objects already listed since the changes made by the explorer and the SQL execution
+		 * discard the affected ones. The full refresh discards all of them in order to read the whole database again */
 		if(quick_refresh)
 			QApplication::setOverrideCursor(Qt::WaitCursor);
+		else
+			Catalog::invalidateObjectsNames(connection);
 
 		DatabaseImportForm::listObjects(import_helper, objects_trw, false, false, true, quick_refresh, sort_column);
 
@@ -1090,7 +1105,16 @@ void DatabaseExplorerWidget::handleObject(QTreeWidgetItem *item, int)
 {
 	if(item->data(DatabaseImportForm::ObjectOtherData, Qt::UserRole).toInt() < 0)
 	{
-		updateItem(item->parent(), true);
+		QTreeWidgetItem *parent = item->parent();
+
+		/* Clicking the placeholder of a load in progress has no effect. Since the clicked dummy item is
+		 * destroyed when the children are loaded, the loading is performed after the press is handled */
+		if(item->data(DatabaseImportForm::ObjectOtherData, Qt::UserRole).toInt() != LoadingItemId)
+		{
+			QMetaObject::invokeMethod(this, [this, parent](){
+				loadItemChildren(parent);
+			}, Qt::QueuedConnection);
+		}
 	}
 	else if(QApplication::mouseButtons()==Qt::MiddleButton && item->data(DatabaseImportForm::ObjectId, Qt::UserRole).toInt() >= 0)
 	{
@@ -1359,6 +1383,11 @@ void DatabaseExplorerWidget::dropObject(QTreeWidgetItem *item, bool cascade)
 				conn=connection;
 				conn.connect();
 				conn.executeDDLCommand(drop_cmd);
+				Catalog::invalidateTypeNames(conn, drop_cmd);
+
+				/* Discarding the cached objects of the parent schema or table. Dropping a cluster level object
+				 * or dropping in cascade mode (which can reach any other object) discards all of them */
+				Catalog::invalidateObjectsNames(conn, cascade ? "" : parent_sch, parent_tab);
 
 				//Updates the object count on the parent item
 				parent=item->parent();
@@ -1446,7 +1475,7 @@ void DatabaseExplorerWidget::saveTreeState()
 		item = *itr;
 		oid = item->data(DatabaseImportForm::ObjectId, Qt::UserRole).toInt();
 		grp_id = item->data(DatabaseImportForm::ObjectGroupId, Qt::UserRole).toInt();
-		items_state.append(QString("%1:%2").arg(oid > 0 ? oid : grp_id).arg(item->isExpanded()));
+		items_state[oid > 0 ? oid : grp_id] = item->isExpanded();
 		++itr;
 	}
 
@@ -1455,39 +1484,45 @@ void DatabaseExplorerWidget::saveTreeState()
 
 void DatabaseExplorerWidget::restoreTreeState()
 {
-	if(items_state.isEmpty())
+	if(items_state.empty())
 		return;
 
-	QTreeWidgetItemIterator itr(objects_trw);
-	QTreeWidgetItem *item = nullptr;	
-	QStringList st_info;
-	int oid = 0, grp_id = 0, idx = 0;
-
 	objects_trw->setUpdatesEnabled(false);
 
-	while(*itr)
-	{
-		item = *itr;
-		oid = item->data(DatabaseImportForm::ObjectId, Qt::UserRole).toInt();
-		grp_id = item->data(DatabaseImportForm::ObjectGroupId, Qt::UserRole).toInt();
+	for(int idx = 0; idx < objects_trw->topLevelItemCount(); idx++)
+		restoreItemsState(objects_trw->topLevelItem(idx));
 
-		if(grp_id < 0)
-			idx = items_state.indexOf(QRegularExpression(QString("(%1)(\\:)(.)+").arg(grp_id)));
-		else
-			idx = items_state.indexOf(QRegularExpression(QString("(%1)(\\:)(.)+").arg(oid)));
+	objects_trw->setUpdatesEnabled(true);
+	objects_trw->verticalScrollBar()->setValue(curr_scroll_value);
 
-		if(idx >= 0)
-		{
-			st_info = items_state.at(idx).split(':');
-			item->setExpanded(st_info[1].toInt() == 1);
-		}
+	/* Expanding the items may have started loads of their children, so the saved state
+	 * is kept in order to be applied to the children as well when the loads finish */
+	if(running_loads == 0)
+		items_state.clear();
+}
 
-		++itr;
+void DatabaseExplorerWidget::restoreItemsState(QTreeWidgetItem *item)
+{
+	if(!item)
+		return;
+
+	int oid = item->data(DatabaseImportForm::ObjectId, Qt::UserRole).toInt(),
+			grp_id = item->data(DatabaseImportForm::ObjectGroupId, Qt::UserRole).toInt();
+	auto itr = items_state.find(grp_id < 0 ? grp_id : oid);
+
+	if(itr != items_state.end())
+	{
+		item->setExpanded(itr->second);
+
+		/* The tree signals can be blocked during the restoring, so the children
+		 * of the expanded items that weren't loaded yet are loaded explicitly */
+		if(itr->second && item->childCount() == 1 &&
+			 item->child(0)->data(DatabaseImportForm::ObjectOtherData, Qt::UserRole).toInt() == -1)
+			loadItemChildren(item);
 	}
 
-	objects_trw->setUpdatesEnabled(true);
-	items_state.clear();	
-	objects_trw->verticalScrollBar()->setValue(curr_scroll_value);
+	for(int idx = 0; idx < item->childCount(); idx++)
+		restoreItemsState(item->child(idx));
 }
 
 void DatabaseExplorerWidget::truncateTable(QTreeWidgetItem *item, bool cascade)
@@ -1499,7 +1534,9 @@ void DatabaseExplorerWidget::truncateTable(QTreeWidgetItem *item, bool cascade)
 			QString obj_name, sch_name;
 			obj_name=item->data(DatabaseImportForm::ObjectName, Qt::UserRole).toString();
 			sch_name=BaseObject::formatName(item->data(DatabaseImportForm::ObjectSchema, Qt::UserRole).toString());
-			truncateTable(sch_name, obj_name, cascade, connection);
+
+			if(truncateTable(sch_name, obj_name, cascade, connection))
+				Catalog::invalidateObjectsNames(connection, item->data(DatabaseImportForm::ObjectSchema, Qt::UserRole).toString(), obj_name);
 		}
 	}
 	catch(Exception &e)
@@ -1516,7 +1553,7 @@ void DatabaseExplorerWidget::updateItem(QTreeWidgetItem *item, bool restore_tree
 
 	try
 	{
-		QTreeWidgetItem *root=nullptr, *parent=nullptr, *aux_item=nullptr;
+		QTreeWidgetItem *root=nullptr, *parent=nullptr;
 		ObjectType obj_type=static_cast<ObjectType>(item->data(DatabaseImportForm::ObjectTypeId, Qt::UserRole).toUInt());
 		unsigned obj_id=item->data(DatabaseImportForm::ObjectId, Qt::UserRole).toUInt();
 		QString sch_name, tab_name;
@@ -1548,7 +1585,7 @@ void DatabaseExplorerWidget::updateItem(QTreeWidgetItem *item, bool restore_tree
 					if(obj_type==ObjectType::Schema || BaseTable::isBaseTable(obj_type))
 					{
 						root=item;
-						root->takeChildren();
+						qDeleteAll(root->takeChildren());
 
 						if(obj_type == ObjectType::Schema)
 							sch_name=item->text(0);
@@ -1563,6 +1600,8 @@ void DatabaseExplorerWidget::updateItem(QTreeWidgetItem *item, bool restore_tree
 				}
 			}
 
+			//Discarding the cached objects of the item being updated so they are retrieved again
+			Catalog::invalidateObjectsNames(connection, sch_name, tab_name);
 			configureImportHelper();
 
 			//Updates the group type only
@@ -1574,15 +1613,8 @@ void DatabaseExplorerWidget::updateItem(QTreeWidgetItem *item, bool restore_tree
 																BaseObject::getChildObjectTypes(obj_type), false, false, root, sch_name, tab_name);
 
 			//Creating dummy items for schemas and tables
-			if(obj_type==ObjectType::Schema || BaseTable::isBaseTable(obj_type))
-			{
-				for(auto &item : gen_items)
-				{
-					aux_item=new QTreeWidgetItem(item);
-					aux_item->setText(0, QString("..."));
-					aux_item->setData(DatabaseImportForm::ObjectOtherData, Qt::UserRole, QVariant::fromValue<int>(-1));
-				}
-			}
+			for(auto &gen_item : gen_items)
+				createDummyItem(gen_item);
 
 			import_helper.closeConnection();
 			objects_trw->sortItems(sort_column, Qt::AscendingOrder);
@@ -1612,6 +1644,164 @@ void DatabaseExplorerWidget::updateItem(QTreeWidgetItem *item, bool restore_tree
 	}
 }
 
+void DatabaseExplorerWidget::loadItemChildren(QTreeWidgetItem *item)
+{
+	if(!item)
+		return;
+
+	//The children of the item are already being loaded
+	if(item->childCount() == 1 &&
+		 item->child(0)->data(DatabaseImportForm::ObjectOtherData, Qt::UserRole).toInt() == LoadingItemId)
+		return;
+
+	ObjectType obj_type=static_cast<ObjectType>(item->data(DatabaseImportForm::ObjectTypeId, Qt::UserRole).toUInt());
+	std::vector<ObjectType> types = BaseObject::getChildObjectTypes(obj_type);
+	QString sch_name = item->data(DatabaseImportForm::ObjectSchema, Qt::UserRole).toString(),
+			tab_name = item->data(DatabaseImportForm::ObjectTable, Qt::UserRole).toString();
+	QTreeWidgetItem *loading_item = nullptr;
+	bool show_sys = show_sys_objs->isChecked(), show_ext = show_ext_objs->isChecked();
+	QFont fnt = objects_trw->font();
+
+	if(obj_type == ObjectType::Schema)
+		sch_name = item->text(0);
+	else
+		tab_name = item->text(0);
+
+	qDeleteAll(item->takeChildren());
+
+	try
+	{
+		//Cached children are created right away since no query is needed
+		if(import_helper.isObjectsCached(types, sch_name, tab_name, DatabaseImportForm::ObjectsTreeAttribs))
+		{
+			std::vector<attribs_map> objects = import_helper.getObjects(types, sch_name, tab_name, DatabaseImportForm::ObjectsTreeAttribs);
+			createItemChildren(item, objects);
+			return;
+		}
+	}
+	catch(Exception &e)
+	{
+		createDummyItem(item);
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+
+	fnt.setItalic(true);
+	loading_item = new QTreeWidgetItem(item);
+	loading_item->setText(0, tr("Loading..."));
+	loading_item->setFont(0, fnt);
+	loading_item->setData(DatabaseImportForm::ObjectOtherData, Qt::UserRole, QVariant::fromValue<int>(LoadingItemId));
+	loading_item->setData(DatabaseImportForm::ObjectCount, Qt::UserRole, QVariant::fromValue<unsigned>(++load_id));
+	running_loads++;
+
+	/* The objects are retrieved by a dedicated import helper and connection since the ones of the
+	 * explorer are used in the GUI thread. The items are created back in the GUI thread by finishItemLoad() */
+	load_pool.start(QRunnable::create([this, conn_params = connection.getConnectionParams(), types, sch_name, tab_name, show_sys, show_ext, id = load_id](){
+		try
+		{
+			DatabaseImportHelper load_helper;
+			Connection conn(conn_params);
+			std::vector<attribs_map> objects;
+
+			load_helper.setConnection(conn);
+			load_helper.setImportOptions(show_sys, show_ext, false, false, false, false, false);
+			load_helper.setObjectsCached(true);
+			objects = load_helper.getObjects(types, sch_name, tab_name, DatabaseImportForm::ObjectsTreeAttribs);
+			load_helper.closeConnection();
+
+			QMetaObject::invokeMethod(this, [this, id, objects]() mutable {
+				finishItemLoad(id, objects);
+			}, Qt::QueuedConnection);
+		}
+		catch(Exception &e)
+		{
+			Exception error(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+
+			QMetaObject::invokeMethod(this, [this, id, error]() mutable {
+				std::vector<attribs_map> objects;
+				finishItemLoad(id, objects, &error);
+			}, Qt::QueuedConnection);
+		}
+	}));
+}
+
+void DatabaseExplorerWidget::finishItemLoad(unsigned load_id, std::vector<attribs_map> &objects, Exception *error)
+{
+	QTreeWidgetItemIterator itr(objects_trw);
+	QTreeWidgetItem *item = nullptr;
+
+	running_loads--;
+
+	/* Searching for the placeholder of the load. If it's not found the tree (or the
+	 * item that was waiting for the load) was recreated meanwhile so the objects are discarded */
+	while(*itr && !item)
+	{
+		if((*itr)->data(DatabaseImportForm::ObjectOtherData, Qt::UserRole).toInt() == LoadingItemId &&
+			 (*itr)->data(DatabaseImportForm::ObjectCount, Qt::UserRole).toUInt() == load_id)
+			item = (*itr)->parent();
+
+		++itr;
+	}
+
+	if(item)
+	{
+		qDeleteAll(item->takeChildren());
+
+		if(error)
+			createDummyItem(item);
+		else
+		{
+			createItemChildren(item, objects);
+
+			//Applying the state saved before a refresh to the loaded children
+			for(int idx = 0; idx < item->childCount() && !items_state.empty(); idx++)
+				restoreItemsState(item->child(idx));
+		}
+	}
+
+	if(running_loads == 0 && !items_state.empty())
+	{
+		items_state.clear();
+		objects_trw->verticalScrollBar()->setValue(curr_scroll_value);
+	}
+
+	if(error)
+	{
+		Messagebox msg_box;
+		msg_box.show(*error);
+	}
+}
+
+void DatabaseExplorerWidget::createItemChildren(QTreeWidgetItem *item, std::vector<attribs_map> &objects)
+{
+	if(!item)
+		return;
+
+	ObjectType obj_type=static_cast<ObjectType>(item->data(DatabaseImportForm::ObjectTypeId, Qt::UserRole).toUInt());
+	QString sch_name = item->data(DatabaseImportForm::ObjectSchema, Qt::UserRole).toString(),
+			tab_name = item->data(DatabaseImportForm::ObjectTable, Qt::UserRole).toString();
+	std::vector<QTreeWidgetItem *> gen_items;
+
+	if(obj_type == ObjectType::Schema)
+		sch_name = item->text(0);
+	else
+		tab_name = item->text(0);
+
+	gen_items = DatabaseImportForm::updateObjectsTree(import_helper, objects_trw, objects, BaseObject::getChildObjectTypes(obj_type),
+																										false, false, item, sch_name, tab_name);
+
+	for(auto &gen_item : gen_items)
+		createDummyItem(gen_item);
+
+	item->sortChildren(sort_column, Qt::AscendingOrder);
+}
+
+void DatabaseExplorerWidget::createDummyItem(QTreeWidgetItem *parent)
+{
+	QTreeWidgetItem *item = new QTreeWidgetItem(parent);
+	item->setText(0, QString("..."));
+	item->setData(DatabaseImportForm::ObjectOtherData, Qt::UserRole, QVariant::fromValue<int>(-1));
+}
+
 void DatabaseExplorerWidget::loadObjectProperties(bool force_reload)
 {
 	try
@@ -1894,6 +2084,12 @@ void DatabaseExplorerWidget::finishObjectRename()
 			//Executes the rename cmd
 			conn.connect();
 			conn.executeDDLCommand(rename_cmd);
+			Catalog::invalidateTypeNames(conn, rename_cmd);
+
+			/* Renaming a schema or a table changes the key of their children cached objects, so the cached objects
+			 * of the whole parent of the renamed object are discarded (all of them in case of cluster level objects) */
+			Catalog::invalidateObjectsNames(conn, rename_item->data(DatabaseImportForm::ObjectSchema, Qt::UserRole).toString(),
+																			rename_item->data(DatabaseImportForm::ObjectTable, Qt::UserRole).toString());
 
 			rename_item->setFlags(rename_item->flags() ^ Qt::ItemIsEditable);
 			rename_item->setData(DatabaseImportForm::ObjectName, Qt::UserRole, rename_item->text(0));
@@ -28,6 +28,7 @@
 #include "ui_databaseexplorerwidget.h"
 #include "databaseimporthelper.h"
 #include "schemaparser.h"
+#include <QThreadPool>
 
 class __libgui DatabaseExplorerWidget: public QWidget, public Ui::DatabaseExplorerWidget {
 	private:
@@ -37,12 +38,9 @@ class __libgui DatabaseExplorerWidget: public QWidget, public Ui::DatabaseExplor
 		 * When the tree state is restored this value is used to return the scrollbar value to its original */
 		int curr_scroll_value;
 
-		/*! \brief Stores the expanded status of all items in the tree.
-		 * The elements in this list have the form (oid|groupid):(0|1).
-		 * The first part is the id/group id of the tree item and the second (after :)
-		 * is the expanded status (0->false, 1->true).
+		/*! \brief Stores the expanded status of all items in the tree by their ids or group ids.
 		 * This attribute is used by saveTreeState() and restoreTreeState() */
-		QStringList items_state;
+		std::map<int, bool> items_state;
 
 		static const QString DepNotDefined,
 		DepNotFound,
@@ -62,6 +60,15 @@ class __libgui DatabaseExplorerWidget: public QWidget, public Ui::DatabaseExplor
 		
 		//! \brief Catalog instance used to retrieve object's attributes
 		Catalog catalog;
+
+		//! \brief Runs the retrieval of the children of the expanded items (see loadItemChildren())
+		QThreadPool load_pool;
+
+		//! \brief Sequential id of the children loads, used to find the placeholder item waiting for each one of them
+		unsigned load_id;
+
+		//! \brief Amount of children loads not finished yet
+		unsigned running_loads;
 		
 		SchemaParser schparser;
 		
@@ -151,12 +158,33 @@ class __libgui DatabaseExplorerWidget: public QWidget, public Ui::DatabaseExplor
 
 		//! \brief Updates the selected tree item
 		void updateItem(QTreeWidgetItem *item, bool restore_tree_state);
+
+		/*! \brief Lists the children of the provided schema or table item. The children cached by the import helper are listed
+		 * right away, otherwise a placeholder item is displayed while they are retrieved in a separated thread (see finishItemLoad()) */
+		void loadItemChildren(QTreeWidgetItem *item);
+
+		/*! \brief Creates the children of the item waiting for the load identified by load_id from the retrieved objects.
+		 * If the load failed the error is shown and the item is restored to its not loaded state */
+		void finishItemLoad(unsigned load_id, std::vector<attribs_map> &objects, Exception *error = nullptr);
+
+		//! \brief Creates the children of the provided schema or table item from the retrieved objects
+		void createItemChildren(QTreeWidgetItem *item, std::vector<attribs_map> &objects);
+
+		//! \brief Creates the item that indicates that the children of a schema or table item were not loaded yet
+		void createDummyItem(QTreeWidgetItem *parent);
+
+		//! \brief Restores the saved expanded status of the provided item and its children
+		void restoreItemsState(QTreeWidgetItem *item);
 		
 		//! \brief Generate the SQL code for the specified object appending the permissions code for it as well
 		QString getObjectSource(BaseObject *object, DatabaseModel *dbmodel);
 
 	public:
+		//! \brief Value of the field DatabaseImportForm::ObjectOtherData of the item displayed while the children of its parent are loaded
+		static constexpr int LoadingItemId = -2;
+
 		DatabaseExplorerWidget(QWidget * parent = nullptr);
+		virtual ~DatabaseExplorerWidget();
 		
 		//! \brief Configures the connection used to retrieve and manipulate objects on database
 		void setConnection(Connection conn, const QString &default_db);
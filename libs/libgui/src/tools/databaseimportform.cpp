@@ -25,6 +25,7 @@
 #include "defaultlanguages.h"
 
 bool DatabaseImportForm::low_verbosity = false;
+const attribs_map DatabaseImportForm::ObjectsTreeAttribs = {{ Attributes::FilterTableTypes, Attributes::True }};
 
 DatabaseImportForm::DatabaseImportForm(QWidget *parent, Qt::WindowFlags f) : QDialog(parent, f)
 {
@@ -45,6 +46,7 @@ DatabaseImportForm::DatabaseImportForm(QWidget *parent, Qt::WindowFlags f) : QDi
 	objs_parent_wgt->setEnabled(false);
 	buttons_wgt->setEnabled(false);
 	connection_gb->setFocusProxy(connections_cmb);
+	catalog_conns_spb->setMaximum(DatabaseImportHelper::MaxCatalogConnections);
 
 	connect(close_btn, &QPushButton::clicked, this, &DatabaseImportForm::close);
 	connect(connections_cmb, &QComboBox::activated, this, qOverload<>(&DatabaseImportForm::listDatabases));
@@ -52,6 +54,7 @@ DatabaseImportForm::DatabaseImportForm(QWidget *parent, Qt::WindowFlags f) : QDi
 	connect(import_sys_objs_chk, &QCheckBox::clicked, this, qOverload<>(&DatabaseImportForm::listObjects));
 	connect(import_ext_objs_chk, &QCheckBox::clicked, this, qOverload<>(&DatabaseImportForm::listObjects));
 	connect(by_oid_chk,  &QCheckBox::toggled, this, qOverload<>(&DatabaseImportForm::filterObjects));
+	connect(debug_mode_chk, &QCheckBox::toggled, catalog_conns_spb, &QSpinBox::setDisabled);
 	connect(expand_all_tb, &QToolButton::clicked, db_objects_tw, &QTreeWidget::expandAll);
 	connect(collapse_all_tb, &QToolButton::clicked, db_objects_tw, &QTreeWidget::collapseAll);
 	connect(db_objects_tw, &QTreeWidget::itemChanged, this, qOverload<QTreeWidgetItem *, int>(&DatabaseImportForm::setItemCheckState));
@@ -315,6 +318,7 @@ void DatabaseImportForm::importDatabase()
 																		resolve_deps_chk->isChecked(), ignore_errors_chk->isChecked(),
 																		debug_mode_chk->isChecked(), rand_rel_color_chk->isChecked(), true);
 
+		import_helper->setCatalogConnections(catalog_conns_spb->value());
 		import_helper->setSelectedOIDs(model_wgt->getDatabaseModel(), obj_oids, col_oids);
 		import_thread->start();
 		cancel_btn->setEnabled(true);
@@ -913,6 +917,24 @@ void DatabaseImportForm::listObjects(DatabaseImportHelper &import_helper, QTreeW
 
 std::vector<QTreeWidgetItem *> DatabaseImportForm::updateObjectsTree(DatabaseImportHelper &import_helper, QTreeWidget *tree_wgt, std::vector<ObjectType> types, bool checkable_items,
 																																bool disable_empty_grps, QTreeWidgetItem *root, const QString &schema, const QString &table)
+{
+	if(!tree_wgt)
+		return {};
+
+	try
+	{
+		std::vector<attribs_map> objects_vect = import_helper.getObjects(types, schema, table, ObjectsTreeAttribs);
+		return updateObjectsTree(import_helper, tree_wgt, objects_vect, types, checkable_items, disable_empty_grps, root, schema, table);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+std::vector<QTreeWidgetItem *> DatabaseImportForm::updateObjectsTree(DatabaseImportHelper &import_helper, QTreeWidget *tree_wgt, std::vector<attribs_map> &objects_vect,
+																																std::vector<ObjectType> types, bool checkable_items, bool disable_empty_grps,
+																																QTreeWidgetItem *root, const QString &schema, const QString &table)
 {
 	std::vector<QTreeWidgetItem *> items_vect;
 
@@ -920,10 +942,9 @@ std::vector<QTreeWidgetItem *> DatabaseImportForm::updateObjectsTree(DatabaseImp
 	{
 		QTreeWidgetItem *group=nullptr, *item=nullptr;
 		QFont grp_fnt=tree_wgt->font();
-		attribs_map extra_attribs={{Attributes::FilterTableTypes, Attributes::True}};
+		static const QRegularExpression tz_regexp("( )(without)( time zone)");
 		QString tooltip=QString("OID: %1"), name, label;
 		bool child_checked=false;
-		std::vector<attribs_map> objects_vect;
 		std::map<ObjectType, QTreeWidgetItem *> gen_groups;
 		ObjectType obj_type;
 		QList<QTreeWidgetItem*> groups_list;
@@ -956,8 +977,6 @@ std::vector<QTreeWidgetItem *> DatabaseImportForm::updateObjectsTree(DatabaseImp
 				groups_list.push_back(group);
 			}
 
-			objects_vect = import_helper.getObjects(types, schema, table, extra_attribs);
-
 			for(attribs_map &attribs : objects_vect)
 			{
 				obj_type=static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt());
@@ -968,7 +987,7 @@ std::vector<QTreeWidgetItem *> DatabaseImportForm::updateObjectsTree(DatabaseImp
 				//Creates individual items for each object of the current type
 				oid=attribs[Attributes::Oid].toUInt();
 
-				attribs[Attributes::Name].remove(QRegularExpression(QString("( )(without)( time zone)")));
+				attribs[Attributes::Name].remove(tz_regexp);
 				label=name=attribs[Attributes::Name];
 
 				//Removing the trailing type string from op. families or op. classes names
@@ -106,6 +106,9 @@ class __libgui DatabaseImportForm: public QDialog, public Ui::DatabaseImportForm
 		 * which will not generate an alert message about the possible slowdowns in the process
 		 * if all objects are imported without using filters */
 		static constexpr unsigned ObjectCountThreshould=2000;
+
+		//! \brief Extra attributes used to retrieve the objects listed by updateObjectsTree()
+		static const attribs_map ObjectsTreeAttribs;
 		
 		DatabaseImportForm(QWidget * parent = nullptr, Qt::WindowFlags f = Qt::Widget);
 		virtual ~DatabaseImportForm();
@@ -146,6 +149,13 @@ class __libgui DatabaseImportForm: public QDialog, public Ui::DatabaseImportForm
 																											 bool checkable_items=false, bool disable_empty_grps=true, QTreeWidgetItem *root=nullptr,
 																											 const QString &schema="", const QString &table="");
 
+		/*! \brief Inserts onto the tree view the objects previously retrieved via DatabaseImportHelper::getObjects() using the attributes
+		 * ObjectsTreeAttribs. This allows the retrieval to run in a separated thread while the items are created in the GUI thread.
+		 * The other parameters and the returned list are the same as the other version of this method */
+		static std::vector<QTreeWidgetItem *> updateObjectsTree(DatabaseImportHelper &import_helper, QTreeWidget *tree_wgt, std::vector<attribs_map> &objects_vect,
+																											 std::vector<ObjectType> types, bool checkable_items=false, bool disable_empty_grps=true,
+																											 QTreeWidgetItem *root=nullptr, const QString &schema="", const QString &table="");
+
 	private slots:
 		void importDatabase();
 		void listObjects();
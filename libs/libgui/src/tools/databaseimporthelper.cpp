@@ -20,21 +20,32 @@
 #include "defaultlanguages.h"
 #include "utilsns.h"
 #include "coreutilsns.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QThreadPool>
+#include <atomic>
 
 const QString DatabaseImportHelper::UnkownObjectOidXml("\t<!--[ unknown object OID=%1 ]-->\n");
+const QString DatabaseImportHelper::SnapshotsDir("snapshots");
 
 DatabaseImportHelper::DatabaseImportHelper(QObject *parent) : QObject(parent)
 {
 	std::random_device rand_seed;
 	rand_num_engine.seed(rand_seed());
 
-	import_canceled=ignore_errors=import_sys_objs=import_ext_objs=rand_rel_colors=update_fk_rels=false;
+	import_canceled=ignore_errors=import_sys_objs=import_ext_objs=rand_rel_colors=update_fk_rels=use_snapshot=false;
 	auto_resolve_deps=true;
 	import_filter=Catalog::ListAllObjects | Catalog::ExclExtensionObjs | Catalog::ExclSystemObjs;
+	catalog_conns=1;
 	xmlparser=nullptr;
 	dbmodel=nullptr;
 }
 
+DatabaseImportHelper::~DatabaseImportHelper()
+{
+	closeWorkerCatalogs();
+}
+
 void DatabaseImportHelper::setConnection(Connection &conn)
 {
 	try
@@ -112,6 +123,16 @@ void DatabaseImportHelper::setImportOptions(bool import_sys_objs, bool import_ex
 		import_filter=Catalog::ListAllObjects | Catalog::ExclBuiltinArrayTypes | Catalog::ExclExtensionObjs | Catalog::ExclSystemObjs;
 }
 
+void DatabaseImportHelper::setUseSnapshot(bool value)
+{
+	use_snapshot=value;
+}
+
+void DatabaseImportHelper::setCatalogConnections(unsigned count)
+{
+	catalog_conns=std::max<unsigned>(1, std::min(count, MaxCatalogConnections));
+}
+
 unsigned DatabaseImportHelper::getLastSystemOID()
 {
 	return catalog.getLastSysObjectOID();
@@ -122,6 +143,17 @@ QString DatabaseImportHelper::getCurrentDatabase()
 	return connection.getConnectionParam(Connection::ParamDbName);
 }
 
+void DatabaseImportHelper::setObjectsCached(bool value)
+{
+	catalog.setObjectsNamesCached(value);
+}
+
+bool DatabaseImportHelper::isObjectsCached(const std::vector<ObjectType> &obj_types, const QString &schema, const QString &table, attribs_map extra_attribs)
+{
+	catalog.setQueryFilter(import_filter);
+	return catalog.isObjectsNamesCached(obj_types, schema, table, extra_attribs);
+}
+
 Catalog DatabaseImportHelper::getCatalog()
 {
 	return catalog;
@@ -170,106 +202,195 @@ void DatabaseImportHelper::swapSequencesTablesIds()
 	}
 }
 
-void DatabaseImportHelper::retrieveSystemObjects()
+void DatabaseImportHelper::openWorkerCatalogs()
 {
-	int progress=0;
-	std::vector<attribs_map>::iterator itr;
-	std::map<unsigned, attribs_map> *obj_map=nullptr;
-	std::vector<attribs_map> objects;
-	std::vector<ObjectType> sys_objs={ ObjectType::Schema, ObjectType::Role, ObjectType::Tablespace,
-																ObjectType::Language, ObjectType::Type };
-	unsigned i = 0, oid = 0, cnt = sys_objs.size();
+	QString snapshot_id;
+	Catalog *worker_cat=nullptr;
+
+	/* In debug mode the objects are retrieved by the main catalog only
+	 * so the printed catalog queries keep the order they were executed */
+	if(catalog_conns <= 1 || debug_mode || !worker_catalogs.empty())
+		return;
 
-	for(i=0; i < cnt && !import_canceled; i++)
+	try
 	{
-		emit s_progressUpdated(progress,
-								 tr("Retrieving system objects... `%1'").arg(BaseObject::getTypeName(sys_objs[i])),
-							   sys_objs[i]);
+		snapshot_id=catalog.exportSnapshot();
+	}
+	catch(Exception &)
+	{
+		/* If the server doesn't allow exporting snapshots (e.g. in some standby configurations)
+		 * the objects are retrieved by the main catalog as usual */
+		return;
+	}
 
-		if(sys_objs[i] != ObjectType::Type)
-		{
-			obj_map=&system_objs;
+	for(unsigned i=1; i < catalog_conns && !snapshot_id.isEmpty(); i++)
+	{
+		worker_cat=new Catalog(catalog);
 
-			if(sys_objs[i] != ObjectType::Language)
-				catalog.setQueryFilter(Catalog::ListOnlySystemObjs);
-			else
-				catalog.setQueryFilter(Catalog::ListAllObjects);
+		try
+		{
+			worker_cat->importSnapshot(snapshot_id);
+			worker_catalogs.push_back(worker_cat);
 		}
-		else
+		catch(Exception &)
 		{
-			obj_map = &types;
-
-			/* Only system built in types are loaded initially.
-			 * User defined types attributes are retrived only on demand (see getType()) */
-			catalog.setQueryFilter(Catalog::ListOnlySystemObjs);
+			/* The server may have reached the maximum amount of connections,
+			 * in that case we use only the catalogs already opened */
+			delete worker_cat;
+			break;
 		}
+	}
 
-		//Query the objects on the catalog and put them on the map
-		objects=catalog.getObjectsAttributes(sys_objs[i]);
-		itr=objects.begin();
+	if(worker_catalogs.empty())
+		catalog.releaseSnapshot();
+}
 
-		while(itr!=objects.end() && !import_canceled)
-		{
-			oid=itr->at(Attributes::Oid).toUInt();
-			(*obj_map)[oid]=(*itr);
-			itr++;
-		}
+void DatabaseImportHelper::closeWorkerCatalogs()
+{
+	if(worker_catalogs.empty())
+		return;
 
-		progress=(i/static_cast<double>(cnt))*10;
+	/* Errors when finishing the transactions are ignored since the objects were already
+	 * retrieved and nothing was changed in the database */
+	for(auto &worker_cat : worker_catalogs)
+	{
+		try { worker_cat->releaseSnapshot(); } catch(Exception &){}
+		delete worker_cat;
 	}
+
+	worker_catalogs.clear();
+
+	try { catalog.releaseSnapshot(); } catch(Exception &){}
 }
 
-void DatabaseImportHelper::retrieveUserObjects()
+void DatabaseImportHelper::runObjectsQueries(std::vector<ObjectsQuery> &queries, const QString &msg, int max_progress)
 {
 	int progress=0;
-	std::map<ObjectType, std::vector<unsigned>>::iterator oid_itr=object_oids.begin();
-	std::vector<attribs_map>::iterator itr;
-	std::vector<attribs_map> objects;
-	unsigned i=0, oid=0;
-	std::map<unsigned, std::vector<unsigned>>::iterator col_itr;
-	QStringList names;
+	unsigned idx=0, cnt=queries.size();
 
-	i=0;
-	catalog.setQueryFilter(import_filter);
+	if(worker_catalogs.empty() || cnt <= 1)
+	{
+		for(idx=0; idx < cnt && !import_canceled; idx++)
+		{
+			emit s_progressUpdated(progress,
+									 msg.arg(BaseObject::getTypeName(queries[idx].obj_type)),
+									 queries[idx].obj_type);
 
-	//Retrieving selected database level objects and table children objects (except columns)
-	while(oid_itr!=object_oids.end() && !import_canceled)
+			catalog.setQueryFilter(queries[idx].filter);
+			queries[idx].objects=catalog.getObjectsAttributes(queries[idx].obj_type, "", "", queries[idx].oids);
+			progress=(idx/static_cast<double>(cnt))*max_progress;
+		}
+	}
+	else
 	{
-		emit s_progressUpdated(progress,
-								 tr("Retrieving objects... `%1'").arg(BaseObject::getTypeName(oid_itr->first)),
-							   oid_itr->first);
+		QThreadPool pool;
+		QMutex errors_mtx;
+		std::atomic<unsigned> next_qry(0), done_cnt(0);
+		std::vector<Exception> worker_errors;
+		std::vector<Catalog *> catalogs=worker_catalogs;
+
+		// The main catalog takes part in the retrieval too since it holds the exported snapshot
+		catalogs.push_back(&catalog);
+		pool.setMaxThreadCount(catalogs.size());
+
+		/* Each catalog picks the next pending query until there's no query left. Since each query
+		 * writes only to its own results no lock is needed, except for the errors list */
+		for(auto &cat : catalogs)
+		{
+			pool.start(QRunnable::create([this, cat, &queries, &next_qry, &done_cnt, &worker_errors, &errors_mtx](){
+				unsigned qry_idx=0;
 
-		objects=catalog.getObjectsAttributes(oid_itr->first, "", "", oid_itr->second);
-		itr=objects.begin();
+				try
+				{
+					while(!import_canceled && (qry_idx=next_qry++) < queries.size())
+					{
+						cat->setQueryFilter(queries[qry_idx].filter);
+						queries[qry_idx].objects=cat->getObjectsAttributes(queries[qry_idx].obj_type, "", "", queries[qry_idx].oids);
+						done_cnt++;
+					}
+				}
+				catch(Exception &e)
+				{
+					QMutexLocker locker(&errors_mtx);
+					worker_errors.push_back(e);
+				}
+			}));
+		}
 
-		while(itr!=objects.end() && !import_canceled)
+		// Reporting the progress from the current thread while the queries are running
+		while(!pool.waitForDone(100))
 		{
-			oid=itr->at(Attributes::Oid).toUInt();
-			user_objs[oid]=(*itr);
-			itr++;
+			idx=std::min(done_cnt.load(), cnt - 1);
+			progress=(done_cnt.load()/static_cast<double>(cnt))*max_progress;
+
+			emit s_progressUpdated(progress,
+									 msg.arg(BaseObject::getTypeName(queries[idx].obj_type)),
+									 queries[idx].obj_type);
 		}
 
-		objects.clear();
-		progress=(i/static_cast<double>(object_oids.size()))*100;
-		oid_itr++; i++;
+		if(!worker_errors.empty())
+			throw Exception(worker_errors[0].getErrorMessage(), worker_errors[0].getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &worker_errors[0]);
 	}
 
-	//Retrieving all selected table columns
-	i=0;
-	col_itr=column_oids.begin();
-	while(col_itr!=column_oids.end())
+	// The objects are stored following the queries order so the result is the same regardless the amount of connections
+	for(auto &qry : queries)
 	{
-		names=getObjectName(QString::number(col_itr->first)).split(".");
+		for(auto &attribs : qry.objects)
+		{
+			if(import_canceled)
+				break;
+
+			(*qry.obj_map)[attribs.at(Attributes::Oid).toUInt()]=attribs;
+		}
+
+		qry.objects.clear();
+	}
+}
+
+void DatabaseImportHelper::retrieveSystemObjects()
+{
+	std::vector<ObjectsQuery> queries;
+
+	for(auto &obj_type : { ObjectType::Schema, ObjectType::Role, ObjectType::Tablespace, ObjectType::Language, ObjectType::Type })
+	{
+		/* Only system built in types are loaded initially.
+		 * User defined types attributes are retrived only on demand (see getType()) */
+		queries.push_back({ obj_type,
+												obj_type == ObjectType::Language ? Catalog::ListAllObjects : Catalog::ListOnlySystemObjs,
+												{}, obj_type == ObjectType::Type ? &types : &system_objs, {} });
+	}
+
+	runObjectsQueries(queries, tr("Retrieving system objects... `%1'"), 10);
+}
+
+void DatabaseImportHelper::retrieveUserObjects()
+{
+	std::vector<ObjectsQuery> queries;
+
+	//Retrieving selected database level objects and table children objects (except columns)
+	for(auto &itr : object_oids)
+		queries.push_back({ itr.first, import_filter, itr.second, &user_objs, {} });
+
+	runObjectsQueries(queries, tr("Retrieving objects... `%1'"), 100);
+	catalog.setQueryFilter(import_filter);
+
+	//Retrieving all selected table columns using one catalog query per batch of tables instead of one per table
+	if(!column_oids.empty())
+	{
+		std::vector<unsigned> tab_oids;
+		std::vector<attribs_map> cols;
 
-		emit s_progressUpdated(progress,
-								 tr("Retrieving columns of table `%1.%2', oid `%3'...").arg(names[0]).arg(names[1]).arg(col_itr->first),
-							   ObjectType::Column);
+		tab_oids.reserve(column_oids.size());
 
-		if(names.size() > 1)
-			retrieveTableColumns(names[0], names[1], col_itr->second);
+		for(auto &itr : column_oids)
+			tab_oids.push_back(itr.first);
 
-		progress=(i/static_cast<double>(column_oids.size()))*100;
-		col_itr++; i++;
+		emit s_progressUpdated(100,
+								 tr("Retrieving columns of `%1' table(s)...").arg(tab_oids.size()),
+								 ObjectType::Column);
+
+		cols = catalog.getTablesColumnsAttributes(tab_oids);
+		storeTablesColumns(cols, column_oids);
 	}
 }
 
@@ -278,16 +399,9 @@ void DatabaseImportHelper::retrieveTableColumns(const QString &sch_name, const Q
 	try
 	{
 		std::vector<attribs_map> cols;
-		unsigned tab_oid=0, col_oid;
 
 		cols=catalog.getObjectsAttributes(ObjectType::Column, sch_name, tab_name, col_ids);
-
-		for(auto &itr : cols)
-		{
-			col_oid=itr.at(Attributes::Oid).toUInt();
-			tab_oid=itr.at(Attributes::Table).toUInt();
-			columns[tab_oid][col_oid]=itr;
-		}
+		storeTablesColumns(cols);
 	}
 	catch(Exception &e)
 	{
@@ -295,6 +409,64 @@ void DatabaseImportHelper::retrieveTableColumns(const QString &sch_name, const Q
 	}
 }
 
+void DatabaseImportHelper::storeTablesColumns(std::vector<attribs_map> &cols, const std::map<unsigned, std::vector<unsigned>> &col_filter)
+{
+	unsigned tab_oid=0, prev_tab_oid=0;
+	std::pair<unsigned, unsigned> *tab_range=nullptr;
+	std::map<unsigned, std::vector<unsigned>>::const_iterator filter_itr;
+	bool filter_cols=false;
+
+	// Preallocating the list on the first (batched) retrieval, further on demand retrievals just append to it
+	if(columns.empty())
+		columns.reserve(cols.size());
+
+	for(auto &col : cols)
+	{
+		tab_oid=col.at(Attributes::Table).toUInt();
+
+		if(!tab_range || tab_oid != prev_tab_oid)
+		{
+			filter_itr=col_filter.find(tab_oid);
+			filter_cols=(filter_itr != col_filter.end() && !filter_itr->second.empty());
+
+			/* If the table columns were already retrieved the table range is replaced by the new one
+			 * and the previous entries remain in the list unreferenced */
+			tab_range=&tab_columns[tab_oid];
+			*tab_range={ static_cast<unsigned>(columns.size()), 0 };
+			prev_tab_oid=tab_oid;
+		}
+
+		if(filter_cols &&
+			 std::find(filter_itr->second.begin(), filter_itr->second.end(),
+								 col.at(Attributes::Oid).toUInt()) == filter_itr->second.end())
+			continue;
+
+		columns.push_back(std::move(col));
+		tab_range->second++;
+	}
+}
+
+int DatabaseImportHelper::getColumnIndex(unsigned tab_oid, unsigned col_id)
+{
+	auto tab_itr=tab_columns.find(tab_oid);
+
+	if(tab_itr == tab_columns.end())
+		return -1;
+
+	std::vector<attribs_map>::iterator begin=columns.begin() + tab_itr->second.first,
+			end=begin + tab_itr->second.second, itr;
+
+	// The columns of a table are ordered by id so we can use a binary search here
+	itr=std::lower_bound(begin, end, col_id, [](const attribs_map &col, unsigned id){
+		return col.at(Attributes::Oid).toUInt() < id;
+	});
+
+	if(itr == end || itr->at(Attributes::Oid).toUInt() != col_id)
+		return -1;
+
+	return static_cast<int>(itr - columns.begin());
+}
+
 void DatabaseImportHelper::createObjects()
 {
 	int progress=0;
@@ -470,6 +642,7 @@ void DatabaseImportHelper::createPermissions()
 	try
 	{
 		unsigned i=0, progress=0;
+		int col_idx=-1;
 		std::vector<unsigned>::iterator itr, itr_obj=obj_perms.begin();
 		std::map<unsigned, std::vector<unsigned>>::iterator itr_cols=col_perms.begin();
 		QString msg=tr("Creating permissions of `%1' (%2)...");
@@ -501,7 +674,15 @@ void DatabaseImportHelper::createPermissions()
 
 			while(itr!=itr_cols->second.end())
 			{
-				attribs=columns[itr_cols->first][*itr];
+				col_idx=getColumnIndex(itr_cols->first, *itr);
+
+				if(col_idx < 0)
+				{
+					itr++;
+					continue;
+				}
+
+				attribs=columns[col_idx];
 				obj_type=static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt());
 				emit s_progressUpdated(progress,
 									   msg.arg(getObjectName(attribs[Attributes::Oid]))
@@ -564,14 +745,34 @@ void DatabaseImportHelper::importDatabase()
 {
 	try
 	{
+		QString snapshot_file;
+
 		if(!dbmodel)
 			throw Exception(ErrorCode::OprNotAllocatedObject ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+		if(use_snapshot)
+		{
+			snapshot_file=getSnapshotFilename();
+
+			/* If the database didn't change since the last import of the same objects
+			 * the snapshot is loaded and the catalog reading is skipped entirely */
+			if(restoreSnapshot(snapshot_file))
+			{
+				emit s_importFinished();
+				resetImportParameters();
+				return;
+			}
+		}
+
 		dbmodel->setLoadingModel(true);
 		dbmodel->setObjectListsCapacity(creation_order.size());
 
+		/* The system and user objects are retrieved (concurrently if more than one connection is configured)
+		 * under the same transaction snapshot, the remaining catalog queries use the main catalog only */
+		openWorkerCatalogs();
 		retrieveSystemObjects();
 		retrieveUserObjects();
+		closeWorkerCatalogs();
 		createObjects();
 		createTableInheritances();
 		createTablePartitionings();
@@ -614,6 +815,10 @@ void DatabaseImportHelper::importDatabase()
 				emit s_importFinished(Exception(tr("The database import ended but some errors were generated and saved into the log file `%1'. This file will last until pgModeler quit.").arg(log_name),
 												__PRETTY_FUNCTION__,__FILE__,__LINE__));
 			}
+			/* Incomplete imports are never stored as snapshots. Also, the snapshot must be saved before
+			 * notifying the end of the import since the model may be used by another thread right after */
+			else if(use_snapshot)
+				saveSnapshot(snapshot_file);
 		}
 		else
 			emit s_importCanceled();
@@ -698,21 +903,27 @@ void DatabaseImportHelper::createObject(attribs_map &attribs)
 			if(TableObject::isTableObject(obj_type))
 				attribs[Attributes::DeclInTable]="";
 
+			bool gen_xml=isCreatedFromXML(obj_type);
+
 			//System objects will have the sql disabled by default
 			attribs[Attributes::SqlDisabled]=(catalog.isSystemObject(oid) || catalog.isExtensionObject(oid) ? Attributes::True : "");
-			attribs[Attributes::Comment]=getComment(attribs);
+
+			/* When the object is created without XML the comment is kept as is and the dependencies
+			 * are referenced by name instead of XML code */
+			if(gen_xml)
+				attribs[Attributes::Comment]=getComment(attribs);
 
 			if(attribs.count(Attributes::Owner))
-				attribs[Attributes::Owner]=getDependencyObject(attribs[Attributes::Owner], ObjectType::Role, false, auto_resolve_deps);
+				attribs[Attributes::Owner]=getDependencyObject(attribs[Attributes::Owner], ObjectType::Role, false, auto_resolve_deps, gen_xml);
 
 			if(attribs.count(Attributes::Tablespace))
-				attribs[Attributes::Tablespace]=getDependencyObject(attribs[Attributes::Tablespace], ObjectType::Tablespace, false, auto_resolve_deps);
+				attribs[Attributes::Tablespace]=getDependencyObject(attribs[Attributes::Tablespace], ObjectType::Tablespace, false, auto_resolve_deps, gen_xml);
 
 			if(attribs.count(Attributes::Schema))
 			{
 				//Here we preserve the schema oid for latter usage in certain methods
 				attribs[Attributes::SchemaOid]=attribs[Attributes::Schema];
-				attribs[Attributes::Schema]=getDependencyObject(attribs[Attributes::Schema], ObjectType::Schema, false, auto_resolve_deps);
+				attribs[Attributes::Schema]=getDependencyObject(attribs[Attributes::Schema], ObjectType::Schema, false, auto_resolve_deps, gen_xml);
 			}
 
 			/* Due to the object recreation mechanism there are some situations when pgModeler fails to recreate
@@ -909,8 +1120,42 @@ void DatabaseImportHelper::loadObjectXML(ObjectType obj_type, attribs_map &attri
 	}
 }
 
+bool DatabaseImportHelper::isCreatedFromXML(ObjectType obj_type)
+{
+	static const std::vector<ObjectType> direct_types = {
+		ObjectType::Tablespace, ObjectType::Schema,
+		ObjectType::Role, ObjectType::Sequence,
+		ObjectType::Table, ObjectType::Constraint
+	};
+
+	return debug_mode || std::find(direct_types.begin(), direct_types.end(), obj_type) == direct_types.end();
+}
+
+attribs_map DatabaseImportHelper::getBasicAttributes(attribs_map &attribs)
+{
+	attribs_map basic_attribs;
+
+	for(auto &attr : { Attributes::Name, Attributes::Comment, Attributes::Schema,
+										 Attributes::Owner, Attributes::Tablespace, Attributes::SqlDisabled })
+	{
+		if(attribs.count(attr))
+			basic_attribs[attr]=attribs[attr];
+	}
+
+	/* Unresolved dependencies are referenced as an XML comment containing the unknown oid.
+	 * In that case the reference is discarded just like the XML parser does with comments */
+	for(auto &attr : { Attributes::Schema, Attributes::Owner, Attributes::Tablespace })
+	{
+		if(basic_attribs[attr].trimmed().startsWith("<!--"))
+			basic_attribs[attr].clear();
+	}
+
+	return basic_attribs;
+}
+
 void DatabaseImportHelper::resetImportParameters()
 {
+	closeWorkerCatalogs();
 	Connection::setPrintSQL(false);
 	import_canceled=false;
 	dbmodel=nullptr;
@@ -921,6 +1166,7 @@ void DatabaseImportHelper::resetImportParameters()
 	creation_order.clear();
 	seq_tab_swap.clear();
 	columns.clear();
+	tab_columns.clear();
 	system_objs.clear();
 	errors.clear();
 	constraints.clear();
@@ -933,6 +1179,104 @@ void DatabaseImportHelper::resetImportParameters()
 	created_objs.clear();
 }
 
+QString DatabaseImportHelper::getSnapshotFilename()
+{
+	QCryptographicHash hash(QCryptographicHash::Md5);
+	QStringList values = { GlobalAttributes::PgModelerVersion,
+												 connection.getConnectionParam(Connection::ParamServerFqdn),
+												 connection.getConnectionParam(Connection::ParamServerIp),
+												 connection.getConnectionParam(Connection::ParamPort),
+												 connection.getConnectionParam(Connection::ParamUser),
+												 connection.getConnectionParam(Connection::ParamDbName),
+												 QString::number(import_sys_objs),
+												 QString::number(import_ext_objs),
+												 QString::number(auto_resolve_deps) };
+
+	// Different object filters produce different models so the selected oids are part of the snapshot id
+	for(auto &oid : creation_order)
+		values.append(QString::number(oid));
+
+	for(auto &itr : column_oids)
+	{
+		for(auto &col_id : itr.second)
+			values.append(QString("%1:%2").arg(itr.first).arg(col_id));
+	}
+
+	hash.addData(values.join(',').toUtf8());
+
+	return GlobalAttributes::getTemporaryFilePath(SnapshotsDir) + GlobalAttributes::DirSeparator +
+				 QString("%1_%2%3").arg(QString(hash.result().toHex()),
+																catalog.getCatalogChangeMarker(),
+																GlobalAttributes::DbModelExt);
+}
+
+bool DatabaseImportHelper::restoreSnapshot(const QString &filename)
+{
+	if(!QFileInfo::exists(filename))
+		return false;
+
+	QMetaObject::Connection load_conn;
+
+	emit s_progressUpdated(0, tr("The database didn't change since the last import. Loading the snapshot `%1'...").arg(filename),
+												 ObjectType::Database);
+
+	load_conn = connect(dbmodel, &DatabaseModel::s_objectLoaded, this, [this](int progress, QString object_id, unsigned obj_type) {
+		emit s_progressUpdated(progress, object_id, static_cast<ObjectType>(obj_type));
+	});
+
+	try
+	{
+		// The snapshot contains the public schema so the model is reset before loading it
+		dbmodel->destroyObjects();
+		dbmodel->createSystemObjects(false);
+		dbmodel->loadModel(filename);
+		disconnect(load_conn);
+
+		return true;
+	}
+	catch(Exception &)
+	{
+		/* A snapshot that can't be loaded (e.g. saved by an interrupted process) is discarded
+		 * and the model is restored to its initial state so the database can be imported as usual */
+		disconnect(load_conn);
+		QFile::remove(filename);
+
+		dbmodel->destroyObjects();
+		dbmodel->createSystemObjects(true);
+
+		emit s_progressUpdated(0, tr("The snapshot `%1' is invalid and was discarded!").arg(filename), ObjectType::Database);
+		return false;
+	}
+}
+
+void DatabaseImportHelper::saveSnapshot(const QString &filename)
+{
+	try
+	{
+		QFileInfo fi(filename);
+		QDir snapshots_dir(fi.absolutePath());
+		QString snapshot_id = fi.fileName().left(fi.fileName().indexOf('_'));
+
+		emit s_progressUpdated(100, tr("Saving the snapshot of the imported database..."), ObjectType::Database);
+
+		if(!snapshots_dir.exists() && !snapshots_dir.mkpath("."))
+		{
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(snapshots_dir.absolutePath()),
+											ErrorCode::FileDirectoryNotWritten, __PRETTY_FUNCTION__,__FILE__,__LINE__);
+		}
+
+		// Removing the outdated snapshots of the same set of objects
+		for(auto &file : snapshots_dir.entryList({ snapshot_id + "_*" + GlobalAttributes::DbModelExt }, QDir::Files))
+			snapshots_dir.remove(file);
+
+		dbmodel->saveModel(filename, SchemaParser::XmlCode);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
 QString DatabaseImportHelper::dumpObjectAttributes(attribs_map &attribs)
 {
 	QString dump_str;
@@ -955,8 +1299,20 @@ void DatabaseImportHelper::createTablespace(attribs_map &attribs)
 
 	try
 	{
-		loadObjectXML(ObjectType::Tablespace, attribs);
-		tabspc=dbmodel->createTablespace();
+		if(isCreatedFromXML(ObjectType::Tablespace))
+		{
+			loadObjectXML(ObjectType::Tablespace, attribs);
+			tabspc=dbmodel->createTablespace();
+		}
+		else
+		{
+			attribs_map basic_attribs=getBasicAttributes(attribs);
+
+			tabspc=new Tablespace;
+			dbmodel->setBasicAttributes(tabspc, basic_attribs);
+			dbmodel->configureTablespace(tabspc, attribs);
+		}
+
 		dbmodel->addObject(tabspc);
 	}
 	catch(Exception &e)
@@ -984,16 +1340,29 @@ void DatabaseImportHelper::createSchema(attribs_map &attribs)
 		attribs[Attributes::FillColor]=QColor(dist(rand_num_engine),
 																					dist(rand_num_engine),
 																					dist(rand_num_engine)).name();
-		loadObjectXML(ObjectType::Schema, attribs);
 
-		schema=dbmodel->createSchema();
+		if(isCreatedFromXML(ObjectType::Schema))
+		{
+			loadObjectXML(ObjectType::Schema, attribs);
+			schema=dbmodel->createSchema();
+		}
+		else
+		{
+			attribs_map basic_attribs=getBasicAttributes(attribs);
+
+			schema=new Schema;
+			dbmodel->setBasicAttributes(schema, basic_attribs);
+			dbmodel->configureSchema(schema, attribs);
+		}
+
 		dbmodel->addObject(schema);
 	}
 	catch(Exception &e)
 	{
 		if(schema) delete schema;
 		throw Exception(e.getErrorMessage(), e.getErrorCode(),
-						__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, xmlparser->getXMLBuffer());
+						__PRETTY_FUNCTION__,__FILE__,__LINE__, &e,
+						isCreatedFromXML(ObjectType::Schema) ? xmlparser->getXMLBuffer() : "");
 	}
 }
 
@@ -1017,15 +1386,28 @@ void DatabaseImportHelper::createRole(attribs_map &attribs)
 			rl_names.clear();
 		}
 
-		loadObjectXML(ObjectType::Role, attribs);
-		role=dbmodel->createRole();
+		if(isCreatedFromXML(ObjectType::Role))
+		{
+			loadObjectXML(ObjectType::Role, attribs);
+			role=dbmodel->createRole();
+		}
+		else
+		{
+			attribs_map basic_attribs=getBasicAttributes(attribs);
+
+			role=new Role;
+			dbmodel->setBasicAttributes(role, basic_attribs);
+			dbmodel->configureRole(role, attribs);
+		}
+
 		dbmodel->addObject(role);
 	}
 	catch(Exception &e)
 	{
 		if(role) delete role;
 		throw Exception(e.getErrorMessage(), e.getErrorCode(),
-						__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, xmlparser->getXMLBuffer());
+						__PRETTY_FUNCTION__,__FILE__,__LINE__, &e,
+						isCreatedFromXML(ObjectType::Role) ? xmlparser->getXMLBuffer() : "");
 	}
 }
 
@@ -1582,8 +1964,22 @@ void DatabaseImportHelper::createSequence(attribs_map &attribs)
 		for(int i=0; i < seq_attribs.size(); i++)
 			attribs[attr[i]]=seq_attribs[i];
 
-		loadObjectXML(ObjectType::Sequence, attribs);
-		seq=dbmodel->createSequence();
+		if(isCreatedFromXML(ObjectType::Sequence))
+		{
+			loadObjectXML(ObjectType::Sequence, attribs);
+			seq=dbmodel->createSequence();
+		}
+		else
+		{
+			attribs_map basic_attribs=getBasicAttributes(attribs);
+
+			//Any non-empty value in the catalog means a cyclic sequence (the same rule of the XML code)
+			attribs[Attributes::Cycle]=(!attribs[Attributes::Cycle].isEmpty() ? Attributes::True : "");
+			seq=new Sequence;
+			dbmodel->setBasicAttributes(seq, basic_attribs);
+			dbmodel->configureSequence(seq, attribs);
+		}
+
 		dbmodel->addSequence(seq);
 
 		//Disable the sequence's SQL when the owner column is identity
@@ -1598,7 +1994,8 @@ void DatabaseImportHelper::createSequence(attribs_map &attribs)
 	{
 		if(seq) delete seq;
 		throw Exception(e.getErrorMessage(), e.getErrorCode(),
-						__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, xmlparser->getXMLBuffer());
+						__PRETTY_FUNCTION__,__FILE__,__LINE__, &e,
+						isCreatedFromXML(ObjectType::Sequence) ? xmlparser->getXMLBuffer() : "");
 	}
 }
 
@@ -1750,11 +2147,24 @@ void DatabaseImportHelper::createTable(attribs_map &attribs)
 			{ Attributes::YPos, QString("0") }};
 
 		attribs[Attributes::Columns]="";
-		attribs[Attributes::Position]=schparser.getSourceCode(Attributes::Position, pos_attrib, SchemaParser::XmlCode);
 
-		createColumns(attribs, inh_cols);
-		loadObjectXML(ObjectType::Table, attribs);
-		table=dbmodel->createTable();
+		if(isCreatedFromXML(ObjectType::Table))
+		{
+			attribs[Attributes::Position]=schparser.getSourceCode(Attributes::Position, pos_attrib, SchemaParser::XmlCode);
+			createColumns(attribs, inh_cols);
+			loadObjectXML(ObjectType::Table, attribs);
+			table=dbmodel->createTable();
+		}
+		else
+		{
+			attribs_map basic_attribs=getBasicAttributes(attribs);
+
+			table=new Table;
+			dbmodel->setBasicAttributes(table, basic_attribs);
+			createColumns(attribs, inh_cols, table);
+			dbmodel->configurePhysicalTable(table, attribs);
+			dbmodel->configureTable(table, attribs);
+		}
 
 		for(unsigned col_idx : inh_cols)
 			inherited_cols.push_back(table->getColumn(col_idx));
@@ -1849,7 +2259,8 @@ void DatabaseImportHelper::createTable(attribs_map &attribs)
 	{
 		if(table) delete table;
 		throw Exception(e.getErrorMessage(), e.getErrorCode(),
-						__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, xmlparser->getXMLBuffer());
+						__PRETTY_FUNCTION__,__FILE__,__LINE__, &e,
+						isCreatedFromXML(ObjectType::Table) ? xmlparser->getXMLBuffer() : "");
 	}
 }
 
@@ -1878,10 +2289,20 @@ void DatabaseImportHelper::createView(attribs_map &attribs)
 		retrieveTableColumns(sch_name, attribs[Attributes::Name]);
 
 		//Creating columns
-		for(auto &itr : columns[attribs[Attributes::Oid].toUInt()])
+		std::pair<unsigned, unsigned> tab_range;
+		auto tab_itr=tab_columns.find(attribs[Attributes::Oid].toUInt());
+
+		if(tab_itr != tab_columns.end())
+			tab_range=tab_itr->second;
+
+		for(unsigned idx=tab_range.first; idx < tab_range.first + tab_range.second; idx++)
 		{
-			col.setName(itr.second[Attributes::Name]);
-			type_oid=itr.second[Attributes::TypeOid].toUInt();
+			/* Copying the column attributes since the columns list can be reallocated when
+			 * retrieving the columns of dependency objects created in the loop below */
+			attribs_map col_attribs=columns[idx];
+
+			col.setName(col_attribs[Attributes::Name]);
+			type_oid=col_attribs[Attributes::TypeOid].toUInt();
 
 			/* If the type has an entry on the types map and its OID is greater than system object oids,
 			 * means that it's a user defined type, thus, there is the need to check if the type
@@ -1907,7 +2328,7 @@ void DatabaseImportHelper::createView(attribs_map &attribs)
 			}
 			else
 			{
-				type_name = itr.second[Attributes::Type];
+				type_name = col_attribs[Attributes::Type];
 				is_type_registered=(types.count(type_oid)!=0 && PgSqlType::isRegistered(type_name, dbmodel));
 			}
 
@@ -1917,7 +2338,7 @@ void DatabaseImportHelper::createView(attribs_map &attribs)
 			 * the non-array type, this way, if the original type is created there is no need to create the array form */
 			if(auto_resolve_deps && !is_type_registered && !type_name.contains(QString("[]")))
 				// Try to create the missing data type
-				getType(itr.second[Attributes::TypeOid], false);
+				getType(col_attribs[Attributes::TypeOid], false);
 
 			col.setType(PgSqlType::parseString(type_name));
 			ref.addColumn(&col);
@@ -2137,6 +2558,7 @@ void DatabaseImportHelper::createConstraint(attribs_map &attribs)
 				ref_tab_oid=attribs[Attributes::RefTable],
 				tab_name;
 		PhysicalTable *table=nullptr;
+		std::vector<ExcludeElement> exc_elems;
 
 		//If the table oid is 0 indicates that the constraint is part of a data type like domains
 		if(!table_oid.isEmpty() && table_oid!=QString("0"))
@@ -2219,6 +2641,7 @@ void DatabaseImportHelper::createConstraint(attribs_map &attribs)
 						elem.setSortingAttribute(ExcludeElement::NullsFirst, nulls_first);
 					}
 
+					exc_elems.push_back(elem);
 					attribs[Attributes::Elements]+=elem.getSourceCode(SchemaParser::XmlCode);
 				}
 			}
@@ -2242,12 +2665,48 @@ void DatabaseImportHelper::createConstraint(attribs_map &attribs)
 			attribs[Attributes::DstColumns]=getColumnNames(ref_tab_oid, attribs[Attributes::DstColumns]).join(',');
 			attribs[Attributes::Table]=tab_name;
 
-			loadObjectXML(ObjectType::Constraint, attribs);
-			constr=dbmodel->createConstraint(nullptr);
-			constr->setSQLDisabled(table->isSQLDisabled());
+			if(isCreatedFromXML(ObjectType::Constraint))
+			{
+				loadObjectXML(ObjectType::Constraint, attribs);
+				constr=dbmodel->createConstraint(nullptr);
 
-			if(table &&  constr->getConstraintType()==ConstraintType::PrimaryKey)
-				table->addConstraint(constr);
+				if(table &&  constr->getConstraintType()==ConstraintType::PrimaryKey)
+					table->addConstraint(constr);
+			}
+			else
+			{
+				attribs_map basic_attribs=getBasicAttributes(attribs);
+
+				//Raises an error if the parent table doesn't exists
+				if(!table)
+				{
+					throw Exception(Exception::getErrorMessage(ErrorCode::RefObjectInexistsModel)
+													.arg(attribs[Attributes::Name]).arg(BaseObject::getTypeName(ObjectType::Constraint))
+													.arg(tab_name).arg(BaseObject::getTypeName(ObjectType::Table)),
+													ErrorCode::RefObjectInexistsModel,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+				}
+
+				constr=new Constraint;
+
+				try
+				{
+					constr->setParentTable(table);
+					dbmodel->configureConstraint(constr, attribs);
+					dbmodel->setBasicAttributes(constr, basic_attribs);
+
+					for(auto &elem : exc_elems)
+						constr->addExcludeElement(elem);
+
+					table->addConstraint(constr);
+				}
+				catch(Exception &e)
+				{
+					delete constr;
+					throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+				}
+			}
+
+			constr->setSQLDisabled(table->isSQLDisabled());
 
 			table->setModified(true);
 		}
@@ -2255,7 +2714,8 @@ void DatabaseImportHelper::createConstraint(attribs_map &attribs)
 	catch(Exception &e)
 	{
 		throw Exception(e.getErrorMessage(), e.getErrorCode(),
-						__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, xmlparser->getXMLBuffer());
+						__PRETTY_FUNCTION__,__FILE__,__LINE__, &e,
+						isCreatedFromXML(ObjectType::Constraint) ? xmlparser->getXMLBuffer() : "");
 	}
 }
 
@@ -2659,41 +3119,50 @@ void DatabaseImportHelper::destroyDetachedColumns()
 	dbmodel->validateRelationships();
 }
 
-void DatabaseImportHelper::createColumns(attribs_map &attribs, std::vector<unsigned> &inh_cols)
+void DatabaseImportHelper::createColumns(attribs_map &attribs, std::vector<unsigned> &inh_cols, PhysicalTable *table)
 {
 	unsigned tab_oid=attribs[Attributes::Oid].toUInt(), type_oid=0, col_idx=0;
 	bool is_type_registered=false;
 	Column col;
 	QString type_def, unknown_obj_xml, type_name, def_val;
-	std::map<unsigned, attribs_map>::iterator itr, itr1, itr_end;
+	std::pair<unsigned, unsigned> tab_range;
+	attribs_map col_attribs;
 	static QStringList sp_types = SpatialType::getTypes();
 
 	if(tab_oid == 0)
 		return;
 
+	auto tab_itr=tab_columns.find(tab_oid);
+
 	//Retrieving columns if they were not retrieved yet
-	if(columns[attribs[Attributes::Oid].toUInt()].empty() && auto_resolve_deps)
+	if((tab_itr == tab_columns.end() || tab_itr->second.second == 0) && auto_resolve_deps)
 	{
 		QString sch_name = getDependencyObject(attribs[Attributes::SchemaOid], ObjectType::Schema, true, auto_resolve_deps, false);
 		retrieveTableColumns(sch_name, attribs[Attributes::Name]);
+		tab_itr=tab_columns.find(tab_oid);
 	}
 
-	itr=itr1=columns[attribs[Attributes::Oid].toUInt()].begin();
-	itr_end=columns[attribs[Attributes::Oid].toUInt()].end();
-	attribs[Attributes::MaxObjCount]=QString::number(columns[attribs[Attributes::Oid].toUInt()].size());
+	// Tables without retrieved columns are not inserted in the map
+	if(tab_itr != tab_columns.end())
+		tab_range=tab_itr->second;
+	attribs[Attributes::MaxObjCount]=QString::number(tab_range.second);
 
 	//Creating columns
-	while(itr!=itr_end)
+	while(col_idx < tab_range.second)
 	{
-		if(itr->second.count(Attributes::Permission) &&
-				!itr->second.at(Attributes::Permission).isEmpty())
-			col_perms[tab_oid].push_back(itr->second[Attributes::Oid].toUInt());
+		/* Copying the column attributes since the columns list can be reallocated when
+		 * retrieving the columns of dependency objects created in the loop below */
+		col_attribs=columns[tab_range.first + col_idx];
 
-		if(itr->second[Attributes::Inherited]==Attributes::True)
+		if(col_attribs.count(Attributes::Permission) &&
+				!col_attribs.at(Attributes::Permission).isEmpty())
+			col_perms[tab_oid].push_back(col_attribs[Attributes::Oid].toUInt());
+
+		if(col_attribs[Attributes::Inherited]==Attributes::True)
 			inh_cols.push_back(col_idx);
 
-		col.setName(itr->second[Attributes::Name]);
-		type_oid=itr->second[Attributes::TypeOid].toUInt();
+		col.setName(col_attribs[Attributes::Name]);
+		type_oid=col_attribs[Attributes::TypeOid].toUInt();
 
 		/* If the type has an entry on the types map and its OID is greater than system object oids,
 	 means that it's a user defined type, thus, there is the need to check if the type
@@ -2714,7 +3183,7 @@ void DatabaseImportHelper::createColumns(attribs_map &attribs, std::vector<unsig
 				 types[type_oid][Attributes::Configuration] == Attributes::BaseType &&
 				 types[type_oid][Attributes::Category] == ~CategoryType(CategoryType::UserDefined))
 			{
-				type_name = itr->second[Attributes::Type];
+				type_name = col_attribs[Attributes::Type];
 				type_name.remove(sch_name);
 				is_type_registered = true;
 			}
@@ -2736,7 +3205,7 @@ void DatabaseImportHelper::createColumns(attribs_map &attribs, std::vector<unsig
 		}
 		else
 		{
-			type_name = itr->second[Attributes::Type];
+			type_name = col_attribs[Attributes::Type];
 			is_type_registered=(types.count(type_oid)!=0 && PgSqlType::isRegistered(type_name, dbmodel));
 		}
 
@@ -2746,21 +3215,21 @@ void DatabaseImportHelper::createColumns(attribs_map &attribs, std::vector<unsig
 	 the non-array type, this way, if the original type is created there is no need to create the array form */
 		if(auto_resolve_deps && !is_type_registered && !type_name.contains(QString("[]")))
 			// Try to create the missing data type
-			getType(itr->second[Attributes::TypeOid], false);
+			getType(col_attribs[Attributes::TypeOid], false);
 
 		col.setIdentityType(IdentityType::Null);
 		col.setGenerated(false);
 		col.setType(PgSqlType::parseString(type_name));
-		col.setNotNull(!itr->second[Attributes::NotNull].isEmpty());
-		col.setComment(itr->second[Attributes::Comment]);
+		col.setNotNull(!col_attribs[Attributes::NotNull].isEmpty());
+		col.setComment(col_attribs[Attributes::Comment]);
 
 		//Overriding the default value if the column is identity
-		if(!itr->second[Attributes::IdentityType].isEmpty())
-			col.setIdentityType(itr->second[Attributes::IdentityType]);
-		else if(itr->second[Attributes::Generated] == Attributes::True)
+		if(!col_attribs[Attributes::IdentityType].isEmpty())
+			col.setIdentityType(col_attribs[Attributes::IdentityType]);
+		else if(col_attribs[Attributes::Generated] == Attributes::True)
 		{
 			col.setGenerated(true);
-			def_val = itr->second[Attributes::DefaultValue];
+			def_val = col_attribs[Attributes::DefaultValue];
 
 			if(def_val.startsWith('(') && def_val.endsWith(')'))
 			{
@@ -2784,7 +3253,7 @@ void DatabaseImportHelper::createColumns(attribs_map &attribs, std::vector<unsig
 			 Since the extra chars in the default value of the imported column are redundant (casting
 			 varchar to character varying) we remove the '::character varying'. The idea here is to eliminate
 			 the cast if the casting is equivalent to the column type. */
-			def_val = itr->second[Attributes::DefaultValue];
+			def_val = col_attribs[Attributes::DefaultValue];
 
 			if(!def_val.startsWith(QString("nextval(")) && def_val.contains(QString("::")))
 			{
@@ -2801,12 +3270,32 @@ void DatabaseImportHelper::createColumns(attribs_map &attribs, std::vector<unsig
 		}
 
 		//Checking if the collation used by the column exists, if not it'll be created when auto_resolve_deps is checked
-		if(auto_resolve_deps && !itr->second[Attributes::Collation].isEmpty())
-			getDependencyObject(itr->second[Attributes::Collation], ObjectType::Collation);
+		if(auto_resolve_deps && !col_attribs[Attributes::Collation].isEmpty())
+			getDependencyObject(col_attribs[Attributes::Collation], ObjectType::Collation);
+
+		col.setCollation(dbmodel->getObject(getObjectName(col_attribs[Attributes::Collation]),ObjectType::Collation));
+
+		if(table)
+		{
+			Column *column=new Column;
+
+			//The collation is not copied by the assignment operator
+			*column=col;
+			column->setCollation(col.getCollation());
+
+			try
+			{
+				table->addColumn(column);
+			}
+			catch(Exception &e)
+			{
+				delete column;
+				throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+			}
+		}
+		else
+			attribs[Attributes::Columns]+=col.getSourceCode(SchemaParser::XmlCode);
 
-		col.setCollation(dbmodel->getObject(getObjectName(itr->second[Attributes::Collation]),ObjectType::Collation));
-		attribs[Attributes::Columns]+=col.getSourceCode(SchemaParser::XmlCode);
-		itr++;
 		col_idx++;
 	}
 }
@@ -3107,12 +3596,14 @@ QString DatabaseImportHelper::getColumnName(const QString &tab_oid_str, const QS
 	QString col_name;
 	unsigned tab_oid=tab_oid_str.toUInt(), col_id=col_id_str.toUInt();
 
-	if(columns.count(tab_oid) && columns[tab_oid].count(col_id))
+	int col_idx=getColumnIndex(tab_oid, col_id);
+
+	if(col_idx >= 0)
 	{
 		if(prepend_tab_name)
 			col_name=getObjectName(tab_oid_str) + QString(".");
 
-		col_name+=columns[tab_oid][col_id].at(Attributes::Name);
+		col_name+=columns[col_idx].at(Attributes::Name);
 	}
 
 	return col_name;
@@ -3122,9 +3613,10 @@ QStringList DatabaseImportHelper::getColumnNames(const QString &tab_oid_str, con
 {
 	QStringList col_names, col_ids;
 	QString tab_name;
-	unsigned tab_oid=tab_oid_str.toUInt(), col_id=0;
+	unsigned tab_oid=tab_oid_str.toUInt();
+	int col_idx=-1;
 
-	if(columns.count(tab_oid))
+	if(tab_columns.count(tab_oid))
 	{
 		if(prepend_tab_name)
 			tab_name=getObjectName(tab_oid_str) + QString(".");
@@ -3133,10 +3625,10 @@ QStringList DatabaseImportHelper::getColumnNames(const QString &tab_oid_str, con
 
 		for(int i=0; i < col_ids.size(); i++)
 		{
-			col_id=col_ids[i].toUInt();
+			col_idx=getColumnIndex(tab_oid, col_ids[i].toUInt());
 
-			if(columns[tab_oid].count(col_id))
-				col_names.push_back(tab_name + columns[tab_oid][col_id].at(Attributes::Name));
+			if(col_idx >= 0)
+				col_names.push_back(tab_name + columns[col_idx].at(Attributes::Name));
 		}
 	}
 
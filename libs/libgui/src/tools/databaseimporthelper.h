@@ -39,6 +39,9 @@ class __libgui DatabaseImportHelper: public QObject {
 		std::default_random_engine rand_num_engine;
 		
 		static const QString UnkownObjectOidXml;
+
+		//! \brief Name of the folder (under the temporary files folder) where the imported databases snapshots are stored
+		static const QString SnapshotsDir;
 		
 		/*! \brief File handle to log the import process. This file is opened for writing only when
 		the 'ignore_errors' is true */
@@ -55,6 +58,26 @@ class __libgui DatabaseImportHelper: public QObject {
 		
 		//! \brief Stores the current configured catalog filter
 		Catalog::QueryFilter import_filter;
+
+		/*! \brief Holds the parameters and the results of a single catalog query issued while
+		 * retrieving system and user objects (see runObjectsQueries()) */
+		struct ObjectsQuery {
+			ObjectType obj_type;
+			Catalog::QueryFilter filter;
+			std::vector<unsigned> oids;
+
+			//! \brief The map where the retrieved objects are stored (key is the object oid)
+			std::map<unsigned, attribs_map> *obj_map;
+
+			std::vector<attribs_map> objects;
+		};
+
+		//! \brief Amount of connections used to retrieve the objects from catalog (see setCatalogConnections())
+		unsigned catalog_conns;
+
+		/*! \brief Additional catalog instances that read the database concurrently with the main catalog.
+		 * All of them share the snapshot exported by the main catalog (see openWorkerCatalogs()) */
+		std::vector<Catalog *> worker_catalogs;
 		
 		//! \brief Indicates that import was canceled by user (only on thread mode)
 		bool import_canceled,
@@ -78,7 +101,11 @@ class __libgui DatabaseImportHelper: public QObject {
 		rand_rel_colors,
 		
 		//! \brief Indicates to the importer that the relationship update step must be executed
-		update_fk_rels;
+		update_fk_rels,
+
+		/*! \brief Indicates that the imported model must be saved as a snapshot and reused in the next imports
+		 * of the same set of objects while the catalog change marker of the database remains the same */
+		use_snapshot;
 		
 		//! \brief Stores the selected objects oids to be imported
 		std::map<ObjectType, std::vector<unsigned>> object_oids;
@@ -105,8 +132,12 @@ class __libgui DatabaseImportHelper: public QObject {
 		//! \brief Stores the OIDs of the objects successfully created
 		std::vector<unsigned> created_objs;
 
-		//! \brief Stores all selected columns attributes
-		std::map<unsigned, std::map<unsigned, attribs_map>> columns;
+		/*! \brief Stores all selected columns attributes. The columns of the same table are stored
+		 * contiguously and ordered by their ids (attnum) */
+		std::vector<attribs_map> columns;
+
+		//! \brief Stores the position of the first column of each table in the columns list and the amount of columns
+		std::map<unsigned, std::pair<unsigned, unsigned>> tab_columns;
 		
 		//! \brief Stores the oids of all objects that has permissions to be created
 		std::vector<unsigned> obj_perms;
@@ -173,8 +204,9 @@ class __libgui DatabaseImportHelper: public QObject {
 		void destroyDetachedColumns();
 
 		/*! \brief Create the columns of the table represented by the passed attributes.
-		 * The inh_cols is used to hold the id of inherited columns to be managed later */
-		void createColumns(attribs_map &attribs, std::vector<unsigned> &inh_cols);
+		 * The inh_cols is used to hold the id of inherited columns to be managed later.
+		 * When the table is provided the columns are added straight to it, otherwise their XML code is stored in the attributes */
+		void createColumns(attribs_map &attribs, std::vector<unsigned> &inh_cols, PhysicalTable *table=nullptr);
 
 		//! \brief Tries to assign imported sequences that are related to nextval() calls used in columns default values
 		void assignSequencesToColumns();
@@ -218,15 +250,57 @@ class __libgui DatabaseImportHelper: public QObject {
 		/*! \brief Loads the xml parser buffer with the xml schema file relative to the object type
 		using the specified set of attributes */
 		void loadObjectXML(ObjectType obj_type, attribs_map &attribs);
-		
+
+		/*! \brief Returns true when the objects of the provided type must be created from their XML code.
+		 * Some types are created straight from the catalog attributes via the DatabaseModel's objects builders,
+		 * skipping the XML generation and parsing. This is done only for the types that have an attributes based builder
+		 * (e.g. DatabaseModel::configureTable()): the loaders of the other types read their children elements (parameters,
+		 * columns of views, functions of operators, etc.) straight from the XML parser, so they're still created from XML.
+		 * In debug mode all objects are created from XML so their code can be inspected */
+		bool isCreatedFromXML(ObjectType obj_type);
+
+		/*! \brief Returns the basic attributes (name, comment, schema, owner, etc) of an object to be created without XML.
+		 * The provided attributes must hold the names of the referenced objects, not their XML code */
+		attribs_map getBasicAttributes(attribs_map &attribs);
+		
+		/*! \brief Exports the snapshot of the main catalog and opens the worker catalogs using that snapshot,
+		 * so all the connections read the database in the very same state. If the snapshot can't be exported
+		 * or shared no worker catalog is opened and the objects are retrieved by the main catalog only */
+		void openWorkerCatalogs();
+
+		//! \brief Finishes the transactions of the main and worker catalogs and destroys the latter ones
+		void closeWorkerCatalogs();
+
+		/*! \brief Runs the provided catalog queries and stores the retrieved objects in the maps of each query.
+		 * When worker catalogs are opened the queries are distributed among them and the main catalog, otherwise, they are executed
+		 * one after another by the main catalog. Either way, the objects are stored in the maps in the same order of the queries.
+		 * The msg is used to report the progress and must have a placeholder to the object type name */
+		void runObjectsQueries(std::vector<ObjectsQuery> &queries, const QString &msg, int max_progress);
+
 		//! \brief Clears the vectors and maps used in the import process
 		void resetImportParameters();
 		
 		//! \brief Return a string containing all attributes and their values in a formatted way
 		QString dumpObjectAttributes(attribs_map &attribs);
 
+		/*! \brief Returns the snapshot file name for the current connection, import options and selected objects.
+		 * The catalog change marker of the database is part of the file name so a snapshot is reused only
+		 * when no object was changed in the database since it was saved */
+		QString getSnapshotFilename();
+
+		/*! \brief Replaces the objects in the database model by the ones in the provided snapshot file.
+		 * Returns false if the snapshot doesn't exist or can't be loaded */
+		bool restoreSnapshot(const QString &filename);
+
+		//! \brief Saves the imported model to the snapshot file removing the outdated snapshots of the same objects
+		void saveSnapshot(const QString &filename);
+
 	public:
+		//! \brief Maximum amount of connections that can be used to retrieve the objects from catalog
+		static constexpr unsigned MaxCatalogConnections = 8;
+
 		DatabaseImportHelper(QObject *parent = nullptr);
+		~DatabaseImportHelper();
 		
 		//! \brief Set the connection used to access the PostgreSQL server
 		void setConnection(Connection &conn);
@@ -243,6 +317,24 @@ class __libgui DatabaseImportHelper: public QObject {
 		
 		//! \brief Configures the import parameters
 		void setImportOptions(bool import_sys_objs, bool import_ext_objs, bool auto_resolve_deps, bool ignore_errors, bool debug_mode, bool rand_rel_colors, bool update_fk_rels);
+
+		/*! \brief Enables the reuse of a previous import of the same objects (see getSnapshotFilename()).
+		 * This option is intended to be used when the resulting model is only read, e.g., the diff process,
+		 * since the objects positions, colors and other graphical settings are restored from the snapshot */
+		void setUseSnapshot(bool value);
+
+		/*! \brief Defines the amount of connections used to retrieve the objects from catalog. When greater than 1,
+		 * the queries of different object types run concurrently in separated connections sharing the same
+		 * transaction snapshot, so the retrieved objects are the same as the ones read via a single connection.
+		 * The value is truncated to the interval [1, MaxCatalogConnections] */
+		void setCatalogConnections(unsigned count);
+
+		/*! \brief Enables the caching of the objects listed by the vector version of getObjects() (see Catalog::setObjectsNamesCached()).
+		 * This option is intended to be used when browsing a database, since the import itself must always read the current state of the catalog */
+		void setObjectsCached(bool value);
+
+		//! \brief Returns if all the objects of the provided types are cached, so getObjects() will not query the database
+		bool isObjectsCached(const std::vector<ObjectType> &obj_types, const QString &schema="", const QString &table="", attribs_map extra_attribs=attribs_map());
 		
 		//! \brief Returns the last system OID value for the current database
 		unsigned getLastSystemOID();
@@ -276,6 +368,15 @@ class __libgui DatabaseImportHelper: public QObject {
 		void retrieveSystemObjects();
 		void retrieveUserObjects();
 		void retrieveTableColumns(const QString &sch_name, const QString &tab_name, std::vector<unsigned> col_ids={});
+
+		/*! \brief Stores the columns attributes retrieved from catalog in the columns list. The provided list must be
+		 * ordered by table and column id. When a table has an entry in col_filter (with at least one id) only the columns
+		 * in that list are stored, otherwise all the columns of the table are kept */
+		void storeTablesColumns(std::vector<attribs_map> &cols, const std::map<unsigned, std::vector<unsigned>> &col_filter={});
+
+		/*! \brief Returns the index of the column in the columns list or -1 if the column identified
+		 * by table oid and column id was not retrieved */
+		int getColumnIndex(unsigned tab_oid, unsigned col_id);
 		void createObjects();
 		void createConstraints();
 		void createPermissions();
@@ -27,6 +27,8 @@
 #include "databaseexplorerwidget.h"
 #include "settings/generalconfigwidget.h"
 
+const QString DataManipulationForm::PageCursorName("pgmodeler_data_cursor");
+
 DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f): QDialog(parent, f)
 {
 	QAction *act = nullptr;
@@ -48,6 +50,9 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 	}
 
 	table_oid=0;
+	grid_model=nullptr;
+	keyset_desc=false;
+	remaining_rows=-1;
 	filter_hl=new SyntaxHighlighter(filter_txt);
 	filter_hl->loadConfiguration(GlobalAttributes::getSQLHighlightConfPath());
 
@@ -55,6 +60,7 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 	code_compl_wgt->configureCompletion(nullptr, filter_hl);
 
 	results_tbw->setItemDelegate(new PlainTextItemDelegate(this, false));
+	results_tbw->verticalHeader()->setVisible(true);
 	browse_tabs_tb->setMenu(&fks_menu);
 
 	act = copy_menu.addAction(tr("Copy as text"));
@@ -174,7 +180,6 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 	connect(ord_columns_lst, &QListWidget::itemPressed, this, &DataManipulationForm::changeOrderMode);
 	connect(rem_ord_col_tb, &QToolButton::clicked, this, &DataManipulationForm::removeSortColumnFromList);
 	connect(clear_ord_cols_tb, &QToolButton::clicked, this, &DataManipulationForm::clearSortColumnList);
-	connect(results_tbw, &QTableWidget::itemChanged, this, &DataManipulationForm::markUpdateOnRow);
 	connect(undo_tb, &QToolButton::clicked, this, &DataManipulationForm::undoOperations);
 	connect(save_tb, &QToolButton::clicked, this, &DataManipulationForm::saveChanges);
 	connect(ord_columns_lst, &QListWidget::currentRowChanged, this, &DataManipulationForm::enableColumnControlButtons);
@@ -191,16 +196,12 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 			filter_txt->setFocus();
 	});
 
-	//Using the QueuedConnection here to avoid the "edit: editing failed" when editing and navigating through items using tab key
-	connect(results_tbw, &QTableWidget::currentCellChanged, this, &DataManipulationForm::insertRowOnTabPress, Qt::QueuedConnection);
-	connect(results_tbw, &QTableWidget::itemPressed, this, &DataManipulationForm::showPopupMenu);
+	connect(results_tbw, &QTableView::pressed, this, &DataManipulationForm::showPopupMenu);
 
 	connect(export_tb, &QToolButton::clicked, this, [this](){
-		SQLExecutionWidget::exportResults(results_tbw);
+		SQLExecutionWidget::exportResults(results_tbw, tmpl_conn_params, getExportQuery());
 	});
 
-	connect(results_tbw, &QTableWidget::itemSelectionChanged, this, &DataManipulationForm::enableRowControlButtons);
-
 	connect(csv_load_wgt, &CsvLoadWidget::s_csvFileLoaded, this, [this](){
 		loadDataFromCsv();
 	});
@@ -253,18 +254,22 @@ void DataManipulationForm::setAttributes(Connection conn, const QString curr_sch
 
 void DataManipulationForm::reject()
 {
+	closePageConnection();
   GeneralConfigWidget::saveWidgetGeometry(this);
 	QDialog::reject();
 }
 
 void DataManipulationForm::clearItemsText()
 {
-	for(auto &sel : results_tbw->selectedRanges())
+	if(!grid_model)
+		return;
+
+	for(auto &sel : getSelectedRanges())
 	{
-		for(int row = sel.topRow(); row <= sel.bottomRow(); row++)
+		for(int row = sel.top(); row <= sel.bottom(); row++)
 		{
-			for(int col = sel.leftColumn(); col <= sel.rightColumn(); col++)
-				results_tbw->item(row,col)->setText("");
+			for(int col = sel.left(); col <= sel.right(); col++)
+				grid_model->setData(grid_model->index(row, col, QModelIndex()), "");
 		}
 	}
 }
@@ -363,13 +368,10 @@ void DataManipulationForm::retrieveData()
 		return;
 
 	Messagebox msg_box;
-	Catalog catalog;
-	Connection conn_sql=Connection(tmpl_conn_params),
-			conn_cat=Connection(tmpl_conn_params);
 
 	try
 	{
-		if(!changed_rows.empty())
+		if(grid_model && !grid_model->getChangedRows().empty())
 		{
 			msg_box.show(tr("<strong>WARNING: </strong> There are some changed rows waiting the commit! Do you really want to discard them and retrieve the data now?"),
 						 Messagebox::AlertIcon, Messagebox::YesNoButtons);
@@ -378,14 +380,16 @@ void DataManipulationForm::retrieveData()
 				return;
 		}
 
-		QString query=QString("SELECT * FROM \"%1\".\"%2\"").arg(schema_cmb->currentText()).arg(table_cmb->currentText()),
-				prev_tab_name;
+		QString prev_tab_name;
+		QStringList ord_cols;
 		ResultSet res;
 		unsigned limit=limit_spb->value();
+		bool has_more_rows = false;
 		ObjectType obj_type = static_cast<ObjectType>(table_cmb->currentData(Qt::UserRole).toUInt());
 		std::vector<int> curr_hidden_cols;
+		std::vector<unsigned> type_ids;
 		int col_cnt = results_tbw->horizontalHeader()->count();
-		QDateTime start_dt = QDateTime::currentDateTime(), end_dt;
+		QDateTime start_dt = QDateTime::currentDateTime();
 
 		prev_tab_name = curr_table_name;
 		curr_table_name = QString("%1.%2").arg(schema_cmb->currentText()).arg(table_cmb->currentText());
@@ -398,57 +402,46 @@ void DataManipulationForm::retrieveData()
 				curr_hidden_cols.push_back(idx);
 		}
 
-		//Building the where clause
-		if(!filter_txt->toPlainText().trimmed().isEmpty())
-			query+=QString(" WHERE ") + filter_txt->toPlainText();
-
-		//Building the order by clause
-		if(ord_columns_lst->count() > 0)
-		{
-			QStringList ord_cols, col;
-
-			query+=QString("\n ORDER BY ");
-
-			for(int idx=0; idx < ord_columns_lst->count(); idx++)
-			{
-				col=ord_columns_lst->item(idx)->text().split(" ");
-				ord_cols.push_back(QString("\"") + col[0] + QString("\" ") + col[1]);
-			}
+		QApplication::setOverrideCursor(Qt::WaitCursor);
 
-			query+=ord_cols.join(QString(", "));
-		}
+		retrievePKColumns(schema_cmb->currentText(), table_cmb->currentText());
+		retrieveFKColumns(schema_cmb->currentText(), table_cmb->currentText());
 
-		//Building the limit clause
-		if(limit > 0)
-			query+=QString(" LIMIT %1").arg(limit);
+		for(int idx=0; idx < ord_columns_lst->count(); idx++)
+			ord_cols.push_back(ord_columns_lst->item(idx)->text());
 
-		QApplication::setOverrideCursor(Qt::WaitCursor);
+		/* The rows are fetched in pages (see the rows page size in general settings) as the grid is scrolled to its end,
+		 * until the limit is reached, so large tables can be browsed without retrieving all their rows at once */
+		remaining_rows = limit > 0 ? static_cast<int>(limit) : -1;
+		configurePagination(filter_txt->toPlainText().trimmed(), ord_cols);
+		has_more_rows = fetchPage(res, true);
 
-		catalog.setConnection(conn_cat);
-		conn_sql.connect();
-		conn_sql.executeDMLCommand(query, res);
+		/* The retrieved rows are held by a model in a compact form and the cells are rendered only when displayed.
+		 * The names of the columns types come from the cache shared by the connections to the same database */
+		for(int col = 0; col < res.getColumnCount(); col++)
+			type_ids.push_back(res.getColumnTypeId(col));
 
-		retrievePKColumns(schema_cmb->currentText(), table_cmb->currentText());
-		retrieveFKColumns(schema_cmb->currentText(), table_cmb->currentText());
-		SQLExecutionWidget::fillResultsTable(catalog, res, results_tbw, true);
+		setGridModel(new DataGridModel(res, Catalog::getTypeNames(page_conn, type_ids), this));
+		grid_model->setEditable(PhysicalTable::isPhysicalTable(obj_type));
+		results_tbw->resizeColumnsToContents();
 
-		end_dt = QDateTime::currentDateTime();
-		qint64 total_exec = end_dt.toMSecsSinceEpoch() - start_dt.toMSecsSinceEpoch();
-		QString exec_time_str = total_exec >= 1000 ? QString("%1 s").arg(total_exec/1000.0) : QString("%1 ms").arg(total_exec);
+		if(has_more_rows)
+		{
+			connect(grid_model, &DataGridModel::s_fetchMoreRequested, this, &DataManipulationForm::fetchNextPage, Qt::QueuedConnection);
+			grid_model->setFetchMoreEnabled(true);
+		}
+		else
+			closePageConnection();
 
 		edit_tb->setEnabled(true);
-		export_tb->setEnabled(results_tbw->rowCount() > 0);
-		result_info_wgt->setVisible(results_tbw->rowCount() > 0);
-		result_info_lbl->setText(QString("<em>[%1]</em> ").arg(end_dt.toString("hh:mm:ss.zzz")) +
-								 tr("Rows returned: <strong>%1</strong> in <em><strong>%2</strong></em> ").arg(results_tbw->rowCount()).arg(exec_time_str) +
-								 tr("<em>(Limit: <strong>%1</strong> rows)</em>").arg(limit_spb->value()==0 ? tr("none") : QString::number(limit_spb->value())));
+		export_tb->setEnabled(grid_model->rowCount() > 0);
+		result_info_wgt->setVisible(grid_model->rowCount() > 0);
+		updateResultInfo(start_dt.msecsTo(QDateTime::currentDateTime()));
 
-		//Reset the changed rows state
 		enableRowControlButtons();
-		clearChangedRows();
 
 		//If the table is empty automatically creates a new row
-		if(results_tbw->rowCount()==0 && PhysicalTable::isPhysicalTable(obj_type))
+		if(grid_model->rowCount()==0 && PhysicalTable::isPhysicalTable(obj_type))
 			addRow();
 		else
 			results_tbw->setFocus();
@@ -461,9 +454,6 @@ void DataManipulationForm::retrieveData()
 			csv_load_tb->setChecked(false);
 		}
 
-		conn_sql.close();
-		catalog.closeConnection();
-
 		QApplication::restoreOverrideCursor();
 
 		paste_tb->setEnabled(!qApp->clipboard()->text().isEmpty() &&
@@ -504,26 +494,217 @@ void DataManipulationForm::retrieveData()
 			results_tbw->horizontalHeader()->setSectionHidden(idx, true);
 		}
 
-		if(!curr_hidden_cols.empty())
-			results_tbw->resizeRowsToContents();
-
 		results_tbw->horizontalHeader()->blockSignals(false);
 		setWindowTitle(tmpl_window_title.arg(curr_table_name.isEmpty() ? "" : curr_table_name + " / "));
 	}
 	catch(Exception &e)
 	{
 		QApplication::restoreOverrideCursor();
-		conn_sql.close();
-		catalog.closeConnection();
+		closePageConnection();
 		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
 
+void DataManipulationForm::fetchNextPage()
+{
+	if(!grid_model || !page_conn.isStablished())
+		return;
+
+	try
+	{
+		ResultSet res;
+		QDateTime start_dt = QDateTime::currentDateTime();
+
+		QApplication::setOverrideCursor(Qt::WaitCursor);
+
+		if(fetchPage(res, false))
+			grid_model->setFetchMoreEnabled(true);
+		else
+			closePageConnection();
+
+		grid_model->appendRows(res);
+		export_tb->setEnabled(grid_model->rowCount() > 0);
+		updateResultInfo(start_dt.msecsTo(QDateTime::currentDateTime()));
+
+		QApplication::restoreOverrideCursor();
+	}
+	catch(Exception &e)
+	{
+		Messagebox msg_box;
+
+		QApplication::restoreOverrideCursor();
+		closePageConnection();
+		updateResultInfo(0);
+		msg_box.show(e);
+	}
+}
+
+void DataManipulationForm::configurePagination(const QString &filter, const QStringList &ord_cols)
+{
+	QStringList col, sort_exprs;
+	bool has_asc = false, has_desc = false, pk_cols_only = !pk_col_names.isEmpty();
+
+	closePageConnection();
+	keyset_cols.clear();
+	keyset_desc = false;
+
+	// An always true condition is used when there's no filter so the keyset condition can be appended via AND
+	page_query = QString("SELECT * FROM \"%1\".\"%2\" WHERE (%3\n)")
+							 .arg(schema_cmb->currentText(), table_cmb->currentText(), filter.isEmpty() ? "true" : filter);
+
+	for(auto &ord_col : ord_cols)
+	{
+		col = ord_col.split(" ");
+		pk_cols_only &= pk_col_names.contains(col[0]);
+
+		if(col[1] == "DESC")
+			has_desc = true;
+		else
+			has_asc = true;
+
+		sort_exprs.push_back(QString("\"%1\" %2").arg(col[0], col[1]));
+	}
+
+	/* Keyset pagination needs the rows sorted by an unique and non-null key in a single direction. So it's used only when the
+	 * rows are sorted by the primary key columns (in the same direction), the remaining pk columns are used as tie-breakers */
+	if(pk_cols_only && !(has_asc && has_desc))
+	{
+		keyset_desc = has_desc;
+
+		for(auto &ord_col : ord_cols)
+			keyset_cols.push_back(ord_col.split(" ").at(0));
+
+		for(auto &pk_col : pk_col_names)
+		{
+			if(!keyset_cols.contains(pk_col))
+				keyset_cols.push_back(pk_col);
+		}
+	}
+	else if(!sort_exprs.isEmpty())
+		page_query += QString("\n ORDER BY %1").arg(sort_exprs.join(", "));
+}
+
+bool DataManipulationForm::fetchPage(ResultSet &res, bool first_page)
+{
+	int page_size = SQLExecutionWidget::getRowsPageSize(), fetched_rows = 0;
+
+	if(remaining_rows >= 0)
+		page_size = std::min(page_size, remaining_rows);
+
+	if(first_page)
+	{
+		page_conn = Connection(tmpl_conn_params);
+		page_conn.connect();
+	}
+
+	if(keyset_cols.isEmpty())
+	{
+		/* The cursor lives in a read-only transaction that remains open while there are rows to be fetched,
+		 * so the rows are read from the same snapshot and the server doesn't need to rescan the skipped ones */
+		if(first_page)
+		{
+			page_conn.executeDDLCommand("START TRANSACTION READ ONLY");
+			page_conn.executeDDLCommand(QString("DECLARE %1 NO SCROLL CURSOR FOR %2").arg(PageCursorName, page_query));
+		}
+
+		page_conn.executeDMLCommand(QString("FETCH FORWARD %1 FROM %2").arg(page_size).arg(PageCursorName), res);
+	}
+	else
+	{
+		QStringList key_exprs, param_exprs, sort_exprs, params;
+		int last_row = first_page || !grid_model ? -1 : grid_model->getRetrievedRowCount() - 1, col_idx = -1;
+		QString sql = page_query;
+
+		for(auto &col : keyset_cols)
+		{
+			key_exprs.push_back(QString("\"%1\"").arg(col));
+			sort_exprs.push_back(QString("\"%1\" %2").arg(col, keyset_desc ? "DESC" : "ASC"));
+
+			/* The next page starts after the key (original values) of the last retrieved row. The parameters are not cast
+			 * since the server infers their types from the key columns they're compared to in the row comparison */
+			if(last_row >= 0)
+			{
+				col_idx = col_names.indexOf(col);
+				params.push_back(grid_model->getOriginalValue(last_row, col_idx));
+				param_exprs.push_back(QString("$%1").arg(params.size()));
+			}
+		}
+
+		if(last_row >= 0)
+			sql += QString(" AND (%1) %2 (%3)").arg(key_exprs.join(", "), keyset_desc ? "<" : ">", param_exprs.join(", "));
+
+		sql += QString("\n ORDER BY %1 LIMIT %2").arg(sort_exprs.join(", ")).arg(page_size);
+		page_conn.executeDMLCommand(sql, params, res);
+	}
+
+	fetched_rows = res.isValid() && !res.isEmpty() ? res.getTupleCount() : 0;
+
+	if(remaining_rows > 0)
+		remaining_rows -= fetched_rows;
+
+	return remaining_rows != 0 && fetched_rows == page_size;
+}
+
+QString DataManipulationForm::getExportQuery()
+{
+	QStringList cols, sort_exprs;
+	QString sql = page_query;
+
+	if(page_query.isEmpty() || !grid_model)
+		return "";
+
+	// Only the columns visible in the grid are exported
+	for(int col = 0; col < col_names.size() && col_names.size() == grid_model->columnCount(); col++)
+	{
+		if(!results_tbw->isColumnHidden(col))
+			cols.push_back(QString("\"%1\"").arg(col_names[col]));
+	}
+
+	// The page query always starts with SELECT * so the column list can be replaced
+	if(!cols.isEmpty())
+		sql.replace(0, QString("SELECT *").size(), QString("SELECT %1").arg(cols.join(", ")));
+
+	// The keyset pagination sorts the rows in each page fetch, so the same ordering is used here
+	for(auto &col : keyset_cols)
+		sort_exprs.push_back(QString("\"%1\" %2").arg(col, keyset_desc ? "DESC" : "ASC"));
+
+	if(!sort_exprs.isEmpty())
+		sql += QString("\n ORDER BY %1").arg(sort_exprs.join(", "));
+
+	// Respecting the user defined limit (the rows already retrieved plus the ones that could still be fetched)
+	if(remaining_rows >= 0)
+		sql += QString("\n LIMIT %1").arg(grid_model->getRetrievedRowCount() + remaining_rows);
+
+	return sql;
+}
+
+void DataManipulationForm::closePageConnection()
+{
+	// Closing the connection also discards the transaction and the cursor used to fetch the rows
+	page_conn.close();
+
+	if(grid_model)
+		grid_model->setFetchMoreEnabled(false);
+}
+
+void DataManipulationForm::updateResultInfo(qint64 exec_time)
+{
+	QString exec_time_str = exec_time >= 1000 ? QString("%1 s").arg(exec_time/1000.0) : QString("%1 ms").arg(exec_time);
+
+	if(!grid_model)
+		return;
+
+	result_info_lbl->setText(QString("<em>[%1]</em> ").arg(QDateTime::currentDateTime().toString("hh:mm:ss.zzz")) +
+							 tr("Rows returned: <strong>%1</strong> in <em><strong>%2</strong></em> ").arg(grid_model->getRetrievedRowCount()).arg(exec_time_str) +
+							 tr("<em>(Limit: <strong>%1</strong> rows)</em>").arg(limit_spb->value()==0 ? tr("none") : QString::number(limit_spb->value())) +
+							 (page_conn.isStablished() ? tr(" <em>More rows are fetched when the grid is scrolled to the end.</em>") : ""));
+}
+
 void DataManipulationForm::disableControlButtons()
 {
 	refresh_tb->setEnabled(schema_cmb->currentIndex() > 0 && table_cmb->currentIndex() > 0);
-	results_tbw->setRowCount(0);
-	results_tbw->setColumnCount(0);
+	closePageConnection();
+	setGridModel(nullptr);
 	warning_frm->setVisible(false);
 	hint_frm->setVisible(false);
 	edit_tb->setEnabled(false);
@@ -532,21 +713,22 @@ void DataManipulationForm::disableControlButtons()
 	truncate_tb->setEnabled(false);
 	csv_load_tb->setEnabled(false);
 	csv_load_tb->setChecked(false);
-	clearChangedRows();
 }
 
 void DataManipulationForm::enableRowControlButtons()
 {
-	QList<QTableWidgetSelectionRange> sel_ranges=results_tbw->selectedRanges();
+	QItemSelection sel_ranges=getSelectedRanges();
 	bool cols_selected, rows_selected;
 	ObjectType obj_type = static_cast<ObjectType>(table_cmb->currentData(Qt::UserRole).toUInt());
+	int col_cnt = grid_model ? grid_model->columnCount(QModelIndex()) : 0,
+			row_cnt = grid_model ? grid_model->rowCount() : 0;
 
 	cols_selected = rows_selected = !sel_ranges.isEmpty();
 
 	for(auto &sel_rng : sel_ranges)
 	{
-		cols_selected &= (sel_rng.columnCount() == results_tbw->columnCount());
-		rows_selected &= (sel_rng.rowCount() == results_tbw->rowCount());
+		cols_selected &= (sel_rng.width() == col_cnt);
+		rows_selected &= (sel_rng.height() == row_cnt);
 	}
 
 	action_delete->setEnabled(cols_selected);
@@ -558,7 +740,7 @@ void DataManipulationForm::enableRowControlButtons()
 	paste_tb->setEnabled(!qApp->clipboard()->text().isEmpty() &&
 											 PhysicalTable::isPhysicalTable(obj_type)  &&
 											 !col_names.isEmpty());
-	browse_tabs_tb->setEnabled((!fk_infos.empty() || !ref_fk_infos.empty()) && sel_ranges.count() == 1 && sel_ranges.at(0).rowCount() == 1);
+	browse_tabs_tb->setEnabled((!fk_infos.empty() || !ref_fk_infos.empty()) && sel_ranges.count() == 1 && sel_ranges.at(0).height() == 1);
 }
 
 void DataManipulationForm::resetAdvancedControls()
@@ -627,6 +809,9 @@ void DataManipulationForm::loadDataFromCsv(bool load_from_clipboard, bool force_
 	int row_id = 0, col_id = 0;
 	CsvDocument csv_doc;
 
+	if(!grid_model)
+		return;
+
 	QApplication::setOverrideCursor(Qt::WaitCursor);
 	results_tbw->setUpdatesEnabled(false);
 
@@ -661,13 +846,13 @@ void DataManipulationForm::loadDataFromCsv(bool load_from_clipboard, bool force_
 
 	/* If there is only one empty row in the grid, this one will
 	be removed prior the csv loading */
-	if(results_tbw->rowCount()==1)
+	if(grid_model->rowCount()==1 && grid_model->isNewRow(0))
 	{
 		bool is_empty=true;
 
-		for(int col=0; col < results_tbw->columnCount(); col++)
+		for(int col=0; col < grid_model->columnCount(QModelIndex()); col++)
 		{
-			if(!results_tbw->item(0, col)->text().isEmpty())
+			if(!grid_model->getCellValue(0, col).isEmpty())
 			{
 				is_empty=false;
 				break;
@@ -675,13 +860,12 @@ void DataManipulationForm::loadDataFromCsv(bool load_from_clipboard, bool force_
 		}
 
 		if(is_empty)
-			removeNewRows({0});
+			grid_model->removeNewRows({0});
 	}
 
 	for(int csv_row = 0; csv_row < csv_doc.getRowCount(); csv_row++)
 	{
-		addRow();
-		row_id = results_tbw->rowCount() - 1;
+		row_id = grid_model->addRow();
 
 		for(int csv_col = 0; csv_col < csv_doc.getColumnCount(); csv_col++)
 		{
@@ -698,18 +882,19 @@ void DataManipulationForm::loadDataFromCsv(bool load_from_clipboard, bool force_
 				if(col_id < 0)
 					col_id = csv_col;
 
-				if(col_id >= 0 && col_id < results_tbw->columnCount())
-					results_tbw->item(row_id, col_id)->setText(csv_doc.getValue(csv_row, csv_col));
+				if(col_id >= 0 && col_id < grid_model->columnCount(QModelIndex()))
+					grid_model->setData(grid_model->index(row_id, col_id, QModelIndex()), csv_doc.getValue(csv_row, csv_col));
 			}
-			else if(csv_col < results_tbw->columnCount())
+			else if(csv_col < grid_model->columnCount(QModelIndex()))
 			{
 				//Insert the value to the cell in order of appearance
-				results_tbw->item(row_id, csv_col)->setText(csv_doc.getValue(csv_row, csv_col));
+				grid_model->setData(grid_model->index(row_id, csv_col, QModelIndex()), csv_doc.getValue(csv_row, csv_col));
 			}
 		}
 	}
 
 	results_tbw->setUpdatesEnabled(true);
+	hint_frm->setVisible(true);
 	QApplication::restoreOverrideCursor();
 }
 
@@ -1013,249 +1198,114 @@ void DataManipulationForm::retrieveFKColumns(const QString &schema, const QStrin
 	}
 }
 
-void DataManipulationForm::markOperationOnRow(OperationId operation, int row)
+void DataManipulationForm::setGridModel(DataGridModel *model)
 {
-	if(row < results_tbw->rowCount() &&
-			(operation==NoOperation || results_tbw->verticalHeaderItem(row)->data(Qt::UserRole)!=OpInsert))
-	{
-		QTableWidgetItem *item=nullptr, *header_item=results_tbw->verticalHeaderItem(row);
-		QString tooltip=tr("This row is marked to be %1");
-		QFont fnt=results_tbw->font();
-		int marked_cols=0;
-		QColor item_fg_colors[3] = {
-			ObjectsTableWidget::getTableItemColor(ObjectsTableWidget::AddedItemFgColor),
-			ObjectsTableWidget::getTableItemColor(ObjectsTableWidget::UpdatedItemFgColor),
-			ObjectsTableWidget::getTableItemColor(ObjectsTableWidget::RemovedItemFgColor) },
-
-			item_bg_colors[3] = {
-						ObjectsTableWidget::getTableItemColor(ObjectsTableWidget::AddedItemBgColor),
-						ObjectsTableWidget::getTableItemColor(ObjectsTableWidget::UpdatedItemBgColor),
-						ObjectsTableWidget::getTableItemColor(ObjectsTableWidget::RemovedItemBgColor) };
-
-		if(operation==OpDelete)
-			tooltip=tooltip.arg(tr("deleted"));
-		else if(operation==OpUpdate)
-			tooltip=tooltip.arg(tr("updated"));
-		else if(operation==OpInsert)
-			tooltip=tooltip.arg(tr("inserted"));
-		else
-			tooltip.clear();
-
-		results_tbw->blockSignals(true);
-
-		for(int col=0; col < results_tbw->columnCount(); col++)
-		{
-			item=results_tbw->item(row, col);
-
-			if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)!=QString("bytea"))
-			{
-				item->setToolTip(tooltip);
-
-				//Restore the item's font and text when the operation is delete or none
-				if(operation==NoOperation || operation==OpDelete)
-				{
-					item->setFont(fnt);
-					item->setText(item->data(Qt::UserRole).toString());
-				}
+	DataGridModel *prev_model = grid_model;
+	QItemSelectionModel *prev_sel_model = results_tbw->selectionModel();
 
-				if(operation==NoOperation)
-					//Restore the item's background
-					item->setBackground(prev_row_colors[row]);
-				else
-				{
-					//Saves the item's background if it isn't already marked
-					if(header_item->data(Qt::UserRole)!=OpDelete &&
-							header_item->data(Qt::UserRole)!=OpUpdate)
-						prev_row_colors[row]=item->background();
-
-					//Changes the item's background and foreground colors according to the operation
-					item->setBackground(item_bg_colors[operation - 1]);
-					item->setForeground(item_fg_colors[operation - 1]);
-				}
+	grid_model = model;
+	results_tbw->setModel(model);
 
-				marked_cols++;
-			}
-		}
+	// The view creates a new selection model for each model and doesn't destroy the previous one
+	if(prev_sel_model)
+		prev_sel_model->deleteLater();
 
-		if(marked_cols > 0)
-		{
-			auto itr=std::find(changed_rows.begin(), changed_rows.end(), row);
-
-			if(operation==NoOperation && itr!=changed_rows.end())
-			{
-				changed_rows.erase(std::find(changed_rows.begin(), changed_rows.end(), row));
-				prev_row_colors.erase(row);
-			}
-			else if(operation!=NoOperation && itr==changed_rows.end())
-				changed_rows.push_back(row);
+	if(prev_model)
+		prev_model->deleteLater();
 
-			header_item->setData(Qt::UserRole, operation);
-			undo_tb->setEnabled(!changed_rows.empty());
-			save_tb->setEnabled(!changed_rows.empty());
-			std::sort(changed_rows.begin(), changed_rows.end());
-		}
+	if(model)
+	{
+		connect(model, &DataGridModel::s_operationsChanged, this, &DataManipulationForm::updateChangesButtons);
+		connect(results_tbw->selectionModel(), &QItemSelectionModel::selectionChanged, this, &DataManipulationForm::enableRowControlButtons);
 
-		results_tbw->blockSignals(false);
+		//Using the QueuedConnection here to avoid the "edit: editing failed" when editing and navigating through items using tab key
+		connect(results_tbw->selectionModel(), &QItemSelectionModel::currentChanged, this, [this](const QModelIndex &current, const QModelIndex &previous){
+			insertRowOnTabPress(current.row(), current.column(), previous.row(), previous.column());
+		}, Qt::QueuedConnection);
 	}
+
+	updateChangesButtons();
 }
 
-void DataManipulationForm::markUpdateOnRow(QTableWidgetItem *item)
+QItemSelection DataManipulationForm::getSelectedRanges()
 {
-	if(results_tbw->verticalHeaderItem(item->row())->data(Qt::UserRole)!=OpInsert)
-	{
-		bool items_changed=false;
-		QTableWidgetItem *aux_item=nullptr;
-		QFont fnt=item->font();
+	if(!results_tbw->selectionModel())
+		return QItemSelection();
 
-		//Before mark the row to update it's needed to check if some item was changed
-		for(int col=0; col < results_tbw->columnCount(); col++)
-		{
-			aux_item=results_tbw->item(item->row(), col);
-			if(!items_changed && aux_item->text()!=aux_item->data(Qt::UserRole))
-			{
-				items_changed=true;
-				break;
-			}
-		}
-
-		fnt.setBold(items_changed);
-		item->setFont(fnt);
-		markOperationOnRow((items_changed ? OpUpdate : NoOperation), item->row());
-	}
+	return results_tbw->selectionModel()->selection();
 }
 
 void DataManipulationForm::markDeleteOnRows()
 {
-	QList<QTableWidgetSelectionRange> sel_ranges=results_tbw->selectedRanges();
-	QTableWidgetItem *item=nullptr;
-	std::vector<int> ins_rows;
+	std::vector<int> ins_rows, del_rows;
 
-	for(auto &sel_rng : sel_ranges)
+	if(!grid_model)
+		return;
+
+	for(auto &sel_rng : getSelectedRanges())
 	{
-		for(int row=sel_rng.topRow(); row <= sel_rng.bottomRow(); row++)
+		for(int row=sel_rng.top(); row <= sel_rng.bottom(); row++)
 		{
-			item=results_tbw->verticalHeaderItem(row);
-
-			if(item->data(Qt::UserRole)==OpInsert)
+			if(grid_model->isNewRow(row))
 				ins_rows.push_back(row);
 			else
-				markOperationOnRow(OpDelete, row);
+				del_rows.push_back(row);
 		}
 	}
 
-	removeNewRows(ins_rows);
+	grid_model->markOperation(del_rows, DataGridModel::OpDelete);
+	grid_model->removeNewRows(ins_rows);
 	results_tbw->clearSelection();
 }
 
 void DataManipulationForm::addRow(bool focus_new_row)
 {
-	int row=results_tbw->rowCount();
-	QTableWidgetItem *item=nullptr;
-
-	results_tbw->blockSignals(true);
-	results_tbw->insertRow(row);
-
-	for(int col=0; col < results_tbw->columnCount(); col++)
-	{
-		item=new QTableWidgetItem;
-
-		//bytea (binary data) columns can't be handled this way the new item is disabled
-		if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)==QString("bytea"))
-		{
-			item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-			item->setText(tr("[binary data]"));
-		}
-		else
-			item->setFlags(Qt::ItemIsEditable | Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-
-		results_tbw->setItem(row, col, item);
-	}
+	if(!grid_model)
+		return;
 
-	results_tbw->setVerticalHeaderItem(row, new QTableWidgetItem(QString::number(row + 1)));
-	results_tbw->blockSignals(false);
+	int row = grid_model->addRow();
+	QModelIndex index = grid_model->index(row, 0, QModelIndex());
 
-	markOperationOnRow(OpInsert, row);
-	item=results_tbw->item(row, 0);
 	hint_frm->setVisible(true);
 
 	if(focus_new_row)
 	{
 		results_tbw->setFocus();
-		results_tbw->setCurrentCell(row, 0, QItemSelectionModel::ClearAndSelect);
-		results_tbw->editItem(item);
+		results_tbw->selectionModel()->setCurrentIndex(index, QItemSelectionModel::ClearAndSelect);
+		results_tbw->edit(index);
 	}
 }
 
 void DataManipulationForm::duplicateRows()
 {
-	QList<QTableWidgetSelectionRange> sel_ranges=results_tbw->selectedRanges();
+	QItemSelection sel_ranges=getSelectedRanges();
 
-	if(!sel_ranges.isEmpty())
+	if(grid_model && !sel_ranges.isEmpty())
 	{
+		int new_row = 0;
+
 		for(auto &sel_rng : sel_ranges)
 		{
-			for(int row=sel_rng.topRow(); row <= sel_rng.bottomRow(); row++)
+			for(int row=sel_rng.top(); row <= sel_rng.bottom(); row++)
 			{
-				addRow(false);
+				new_row = grid_model->addRow();
 
-				for(int col=0; col < results_tbw->columnCount(); col++)
-				{
-					results_tbw->item(results_tbw->rowCount() - 1, col)
-							->setText(results_tbw->item(row, col)->text());
-				}
+				for(int col=0; col < grid_model->columnCount(QModelIndex()); col++)
+					grid_model->setData(grid_model->index(new_row, col, QModelIndex()), grid_model->getCellValue(row, col));
 			}
 		}
 
-		results_tbw->setCurrentItem(results_tbw->item(results_tbw->rowCount() - 1, 0), QItemSelectionModel::ClearAndSelect);
+		hint_frm->setVisible(true);
+		results_tbw->selectionModel()->setCurrentIndex(grid_model->index(new_row, 0, QModelIndex()), QItemSelectionModel::ClearAndSelect);
 	}
 }
 
-void DataManipulationForm::removeNewRows(std::vector<int> ins_rows)
+void DataManipulationForm::updateChangesButtons()
 {
-	if(!ins_rows.empty())
-	{
-		unsigned idx=0, cnt=ins_rows.size();
-		int row_idx=0;
-		std::vector<int>::reverse_iterator itr, itr_end;
-
-		//Mark the rows as no-op to remove their indexes from changed rows set
-		for(idx=0; idx < cnt; idx++)
-			markOperationOnRow(NoOperation, ins_rows[idx]);
-
-		//Remove the rows
-		std::sort(ins_rows.begin(), ins_rows.end());
-		while(!ins_rows.empty())
-		{
-			results_tbw->removeRow(ins_rows.back());
-			ins_rows.pop_back();
-		}
-
-		//Reorganizing the changed rows vector to avoid row index out-of-bound errors
-		row_idx=results_tbw->rowCount() - 1;
-		itr=changed_rows.rbegin();
-		itr_end=changed_rows.rend();
-
-		while(itr!=itr_end)
-		{
-			if((*itr) > row_idx)
-			{
-				(*itr)=row_idx;
-				results_tbw->verticalHeaderItem(row_idx)->setText(QString::number(row_idx + 1));
-				row_idx--;
-			}
-			else break;
+	bool has_changes = grid_model && !grid_model->getChangedRows().empty();
 
-			itr++;
-		}
-	}
-}
-
-void DataManipulationForm::clearChangedRows()
-{
-	changed_rows.clear();
-	prev_row_colors.clear();
-	undo_tb->setEnabled(false);
-	save_tb->setEnabled(false);
+	undo_tb->setEnabled(has_changes);
+	save_tb->setEnabled(has_changes);
 }
 
 void DataManipulationForm::browseTable(const QString &fk_name, bool browse_ref_tab)
@@ -1282,7 +1332,7 @@ void DataManipulationForm::browseTable(const QString &fk_name, bool browse_ref_t
 
 	for(QString col_name : src_cols)
 	{
-		value = results_tbw->item(results_tbw->currentRow(), col_names.indexOf(col_name))->text();
+		value = grid_model->getCellValue(results_tbw->currentIndex().row(), col_names.indexOf(col_name));
 
 		if(value.isEmpty())
 			filter.push_back(QString("%1 IS NULL").arg(ref_cols.front()));
@@ -1312,64 +1362,39 @@ void DataManipulationForm::browseReferencedTable()
 
 void DataManipulationForm::undoOperations()
 {
-	QTableWidgetItem *item=nullptr;
 	std::vector<int> rows, ins_rows;
-	QList<QTableWidgetSelectionRange> sel_range=results_tbw->selectedRanges();
+	QItemSelection sel_range=getSelectedRanges();
+
+	if(!grid_model)
+		return;
 
 	if(!sel_range.isEmpty())
 	{
-		for(int row=sel_range[0].topRow(); row <= sel_range[0].bottomRow(); row++)
+		for(int row=sel_range[0].top(); row <= sel_range[0].bottom(); row++)
 		{
-			if(results_tbw->verticalHeaderItem(row)->data(Qt::UserRole).toUInt()==OpInsert)
+			if(grid_model->isNewRow(row))
 				ins_rows.push_back(row);
 			else
 				rows.push_back(row);
 		}
-	}
-	else
-	{
-		sel_range.clear();
-		rows=changed_rows;
-	}
-
-	//Marking rows to be deleted/updated as no-op
-	for(auto &row : rows)
-	{
-		item=results_tbw->verticalHeaderItem(row);
-		if(item->data(Qt::UserRole).toUInt()!=OpInsert)
-			markOperationOnRow(NoOperation, row);
-	}
-
-	//If there is no selection, remove all new rows
-	if(sel_range.isEmpty())
-	{
-		if(results_tbw->rowCount() > 0 &&
-				results_tbw->verticalHeaderItem(results_tbw->rowCount()-1)->data(Qt::UserRole)==OpInsert)
-		{
-			do
-			{
-				results_tbw->removeRow(results_tbw->rowCount()-1);
-				item=results_tbw->verticalHeaderItem(results_tbw->rowCount()-1);
-			}
-			while(item && item->data(Qt::UserRole)==OpInsert);
-		}
 
-		clearChangedRows();
+		//Restoring the selected rows and removing just the selected new rows
+		grid_model->markOperation(rows, DataGridModel::NoOperation);
+		grid_model->removeNewRows(ins_rows);
 	}
 	else
-		//Removing just the selected new rows
-		removeNewRows(ins_rows);
-
+		//If there is no selection, restore all rows and remove all new ones
+		grid_model->clearChanges();
 
 	results_tbw->clearSelection();
-	hint_frm->setVisible(results_tbw->rowCount() > 0);
+	hint_frm->setVisible(grid_model->rowCount() > 0);
 }
 
 void DataManipulationForm::insertRowOnTabPress(int curr_row, int curr_col, int prev_row, int prev_col)
 {
-	if(qApp->mouseButtons()==Qt::NoButton &&
+	if(grid_model && qApp->mouseButtons()==Qt::NoButton &&
 			curr_row==0 && curr_col==0 &&
-			prev_row==results_tbw->rowCount()-1 && prev_col==results_tbw->columnCount()-1)
+			prev_row==grid_model->rowCount()-1 && prev_col==grid_model->columnCount(QModelIndex())-1)
 		addRow();
 }
 
@@ -1384,6 +1409,7 @@ void DataManipulationForm::saveChanges()
 #else
 	int row=0;
 	Connection conn=Connection(tmpl_conn_params);
+	TaskProgressWidget task_prog_wgt(this);
 
 	try
 	{
@@ -1397,39 +1423,87 @@ void DataManipulationForm::saveChanges()
 		if(msg_box.result()==QDialog::Accepted)
 		{
 
-			//Forcing the cell editor to be closed by selecting an unexistent cell and clearing the selection
-			results_tbw->setCurrentCell(-1,-1, QItemSelectionModel::Clear);
+			std::vector<int> changed_rows, dml_rows;
+
+			//Forcing the cell editor to be closed (commiting its data) by selecting an unexistent cell and clearing the selection
+			results_tbw->selectionModel()->setCurrentIndex(QModelIndex(), QItemSelectionModel::Clear);
+			changed_rows = grid_model->getChangedRows();
+
+			task_prog_wgt.setWindowTitle(tr("Saving changes..."));
+			task_prog_wgt.setWindowModality(Qt::ApplicationModal);
+			task_prog_wgt.setCancelEnabled(true);
+			task_prog_wgt.show();
 
 			conn.connect();
 			conn.executeDDLCommand(QString("START TRANSACTION"));
 
-			for(unsigned idx=0; idx < changed_rows.size(); idx++)
+			try
+			{
+				dml_rows = applyChangesInBulk(conn, changed_rows, task_prog_wgt);
+			}
+			catch(Exception &)
+			{
+				if(task_prog_wgt.isCancelRequested())
+					throw;
+
+				/* A bulk operation doesn't tell which row caused the error, so all the changes are applied
+				 * again row by row in a new transaction in order to point out the offending row */
+				conn.executeDDLCommand(QString("ROLLBACK"));
+				conn.executeDDLCommand(QString("START TRANSACTION"));
+				dml_rows = changed_rows;
+			}
+
+			for(unsigned idx=0; idx < dml_rows.size(); idx++)
 			{
-				row=changed_rows[idx];
+				row=dml_rows[idx];
 				cmd=getDMLCommand(row);
 				conn.executeDDLCommand(cmd);
+
+				if(idx % 100 == 0)
+				{
+					task_prog_wgt.updateProgress(static_cast<int>(((idx + 1) * 100) / dml_rows.size()),
+																			 tr("Saving the changes of row `%1'...").arg(row + 1), enum_t(ObjectType::Table));
+					qApp->processEvents();
+
+					if(task_prog_wgt.isCancelRequested())
+						throw Exception(tr("The operation was canceled by the user!"), ErrorCode::Custom, __PRETTY_FUNCTION__,__FILE__,__LINE__);
+				}
 			}
 
 			conn.executeDDLCommand(QString("COMMIT"));
 			conn.close();
+			task_prog_wgt.close();
 
-			changed_rows.clear();
+			grid_model->clearChanges();
 			retrieveData();
-			undo_tb->setEnabled(false);
-			save_tb->setEnabled(false);
 		}
 	}
 	catch(Exception &e)
 	{
-		std::map<unsigned, QString> op_names={{ OpDelete, tr("delete") },
-										 { OpUpdate, tr("update") },
-										 { OpInsert, tr("insert") }};
+		// When the user cancels the saving the changes remain pending so they can be saved later
+		if(task_prog_wgt.isCancelRequested())
+		{
+			if(conn.isStablished())
+			{
+				conn.executeDDLCommand(QString("ROLLBACK"));
+				conn.close();
+			}
+
+			task_prog_wgt.close();
+			return;
+		}
+
+		task_prog_wgt.close();
+
+		std::map<unsigned, QString> op_names={{ DataGridModel::OpDelete, tr("delete") },
+										 { DataGridModel::OpUpdate, tr("update") },
+										 { DataGridModel::OpInsert, tr("insert") }};
 
 		QString tab_name=QString("%1.%2")
 						 .arg(schema_cmb->currentText())
 						 .arg(table_cmb->currentText());
 
-		unsigned op_type=results_tbw->verticalHeaderItem(row)->data(Qt::UserRole).toUInt();
+		unsigned op_type=grid_model->getOperation(row);
 
 		if(conn.isStablished())
 		{
@@ -1438,7 +1512,7 @@ void DataManipulationForm::saveChanges()
 		}
 
 		results_tbw->selectRow(row);
-		results_tbw->scrollToItem(results_tbw->item(row, 0));
+		results_tbw->scrollTo(grid_model->index(row, 0, QModelIndex()));
 
 		throw Exception(Exception::getErrorMessage(ErrorCode::RowDataNotManipulated)
 						.arg(op_names[op_type]).arg(tab_name).arg(row + 1).arg(e.getErrorMessage()),
@@ -1449,7 +1523,7 @@ void DataManipulationForm::saveChanges()
 
 QString DataManipulationForm::getDMLCommand(int row)
 {
-	if(row < 0 || row >= results_tbw->rowCount())
+	if(!grid_model || row < 0 || row >= grid_model->rowCount())
 		return "";
 
 	QString tab_name=QString("\"%1\".\"%2\"").arg(schema_cmb->currentText()).arg(table_cmb->currentText()),
@@ -1457,55 +1531,42 @@ QString DataManipulationForm::getDMLCommand(int row)
 			del_cmd=QString("DELETE FROM %1 WHERE %2"),
 			ins_cmd=QString("INSERT INTO %1(%2) VALUES (%3)"),
 			fmt_cmd;
-	QTableWidgetItem *item=nullptr;
-	unsigned op_type=results_tbw->verticalHeaderItem(row)->data(Qt::UserRole).toUInt();
+	unsigned op_type=grid_model->getOperation(row);
 	QStringList val_list, col_list, flt_list;
 	QString col_name, value;
-	QVariant data;
+	bool is_null = false;
 
-	if(op_type==OpDelete || op_type==OpUpdate)
+	if(op_type==DataGridModel::OpDelete || op_type==DataGridModel::OpUpdate)
 	{
-		if(pk_col_names.isEmpty())
-		{
-			//Considering all columns as pk when the tables doesn't has one (except bytea columns)
-			for(int col=0; col < results_tbw->columnCount(); col++)
-			{
-				if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)!=QString("bytea"))
-					pk_col_names.push_back(results_tbw->horizontalHeaderItem(col)->text());
-			}
-		}
-
 		//Creating the where clause with original column's values
-		for(QString pk_col : pk_col_names)
+		for(QString pk_col : getKeyColumns())
 		{
-			data = results_tbw->item(row,  col_names.indexOf(pk_col))->data(Qt::UserRole);
+			value = grid_model->getOriginalValue(row, col_names.indexOf(pk_col), &is_null);
 
-			if(data.toString() == SQLExecutionWidget::ColumnNullValue)
+			if(is_null)
 				flt_list.push_back(QString("\"%1\" IS NULL").arg(pk_col));
 			else
-				flt_list.push_back(QString("\"%1\"='%2'").arg(pk_col).arg(data.toString().replace("\'","''")));
+				flt_list.push_back(QString("\"%1\"='%2'").arg(pk_col).arg(value.replace("\'","''")));
 		}
 	}
 
-	if(op_type==OpDelete)
+	if(op_type==DataGridModel::OpDelete)
 	{
 		fmt_cmd=QString(del_cmd).arg(tab_name).arg(flt_list.join(QString(" AND ")));
 	}
-	else if(op_type==OpUpdate || op_type==OpInsert)
+	else if(op_type==DataGridModel::OpUpdate || op_type==DataGridModel::OpInsert)
 	{
-		fmt_cmd=(op_type==OpUpdate ? upd_cmd : ins_cmd);
+		fmt_cmd=(op_type==DataGridModel::OpUpdate ? upd_cmd : ins_cmd);
 
-		for(int col=0; col < results_tbw->columnCount(); col++)
+		for(int col=0; col < grid_model->columnCount(QModelIndex()); col++)
 		{
-			item=results_tbw->item(row, col);
-
 			//bytea columns are ignored
-			if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)!=QString("bytea"))
+			if(!grid_model->isReadOnlyColumn(col))
 			{
-				value=item->text();
-				col_name=results_tbw->horizontalHeaderItem(col)->text();
+				value=grid_model->getCellValue(row, col);
+				col_name=grid_model->headerData(col, Qt::Horizontal, Qt::DisplayRole).toString();
 
-				if(op_type==OpInsert || (op_type==OpUpdate && value!=item->data(Qt::UserRole)))
+				if(op_type==DataGridModel::OpInsert || (op_type==DataGridModel::OpUpdate && value!=grid_model->getOriginalValue(row, col)))
 				{
 					//Checking if the value is a malformed unescaped value, e.g., {value, value}, {value\}
 					if((value.startsWith(UtilsNs::UnescValueStart) && value.endsWith(QString("\\") + UtilsNs::UnescValueEnd)) ||
@@ -1537,7 +1598,7 @@ QString DataManipulationForm::getDMLCommand(int row)
 						value=QString("E'") + value + QString("'");
 					}
 
-					if(op_type==OpInsert)
+					if(op_type==DataGridModel::OpInsert)
 						val_list.push_back(value);
 					else
 						val_list.push_back(QString("\"%1\"=%2").arg(col_name).arg(value));
@@ -1549,7 +1610,7 @@ QString DataManipulationForm::getDMLCommand(int row)
 			return "";
 		else
 		{
-			if(op_type==OpUpdate)
+			if(op_type==DataGridModel::OpUpdate)
 				fmt_cmd=fmt_cmd.arg(tab_name).arg(val_list.join(QString(", "))).arg(flt_list.join(QString(" AND ")));
 			else
 				fmt_cmd=fmt_cmd.arg(tab_name).arg(col_list.join(QString(", "))).arg(val_list.join(QString(", ")));
@@ -1559,6 +1620,215 @@ QString DataManipulationForm::getDMLCommand(int row)
 	return fmt_cmd;
 }
 
+QStringList DataManipulationForm::getKeyColumns()
+{
+	if(!pk_col_names.isEmpty() || !grid_model)
+		return pk_col_names;
+
+	QStringList key_cols;
+
+	//Considering all columns as pk when the tables doesn't has one (except bytea columns)
+	for(int col=0; col < grid_model->columnCount(QModelIndex()); col++)
+	{
+		if(!grid_model->isReadOnlyColumn(col))
+			key_cols.push_back(grid_model->headerData(col, Qt::Horizontal, Qt::DisplayRole).toString());
+	}
+
+	return key_cols;
+}
+
+std::vector<int> DataManipulationForm::applyChangesInBulk(Connection &conn, const std::vector<int> &rows, TaskProgressWidget &task_prog_wgt)
+{
+	static const unsigned ChunkRows = 1000;
+
+	QString tab_name=QString("\"%1\".\"%2\"").arg(schema_cmb->currentText()).arg(table_cmb->currentText()),
+			value, tmp_tab_name;
+	QStringList key_cols = getKeyColumns(), key_conds, col_list;
+	std::vector<int> dml_rows, del_rows, key_col_ids;
+	std::map<std::vector<int>, std::vector<int>> upd_groups, ins_groups;
+	int col_cnt = grid_model->columnCount(QModelIndex()), tmp_tab_id = 0;
+	unsigned processed_rows = 0;
+	bool is_null = false;
+
+	// The rows can't be identified when the table has only bytea columns, so they're left to the individual commands
+	if(key_cols.isEmpty())
+		return rows;
+
+	auto col_name = [this](int col) {
+		return grid_model->headerData(col, Qt::Horizontal, Qt::DisplayRole).toString();
+	};
+
+	// The rows are sent in chunks, between them the progress is updated and the cancellation request is checked
+	auto copy_rows = [&](const QString &copy_cmd, const std::vector<int> &sel_rows, const std::function<void(int, QByteArray &)> &write_row) {
+		unsigned idx = 0;
+
+		conn.executeCopyFrom(copy_cmd, [&](QByteArray &buffer) {
+			for(unsigned count = 0; idx < sel_rows.size() && count < ChunkRows; idx++, count++)
+			{
+				write_row(sel_rows[idx], buffer);
+
+				// The separator of the last value is replaced by the end of the row
+				buffer[buffer.size() - 1] = '\n';
+				processed_rows++;
+			}
+
+			task_prog_wgt.updateProgress(static_cast<int>((processed_rows * 100) / rows.size()),
+																	 tr("Saving the changes on `%1' (%2 of %3 rows)...").arg(tab_name).arg(processed_rows).arg(rows.size()),
+																	 enum_t(ObjectType::Table));
+			qApp->processEvents();
+
+			if(task_prog_wgt.isCancelRequested())
+				throw Exception(tr("The operation was canceled by the user!"), ErrorCode::Custom, __PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+			return idx < sel_rows.size();
+		});
+	};
+
+	/* Creates a temporary table holding the keys of the rows (k0, k1, ...) and the values of the provided columns (v0, v1, ...)
+	 * with the same data types of the table's columns. The table is dropped at the end of the transaction */
+	auto create_tmp_table = [&](const std::vector<int> &val_cols) {
+		QStringList sel_list;
+
+		tmp_tab_name = QString("pgmodeler_dm_rows_%1").arg(tmp_tab_id++);
+
+		for(int idx = 0; idx < key_cols.size(); idx++)
+			sel_list.push_back(QString("\"%1\" AS k%2").arg(key_cols[idx]).arg(idx));
+
+		for(unsigned idx = 0; idx < val_cols.size(); idx++)
+			sel_list.push_back(QString("\"%1\" AS v%2").arg(col_name(val_cols[idx])).arg(idx));
+
+		conn.executeDDLCommand(QString("CREATE TEMPORARY TABLE %1 ON COMMIT DROP AS SELECT %2 FROM %3 WITH NO DATA")
+													 .arg(tmp_tab_name, sel_list.join(", "), tab_name));
+	};
+
+	auto write_keys = [&](int row, QByteArray &buffer) {
+		for(auto &col : key_col_ids)
+		{
+			value = grid_model->getOriginalValue(row, col, &is_null);
+			appendCopyValue(buffer, value, is_null, false);
+		}
+	};
+
+	for(auto &key_col : key_cols)
+	{
+		key_col_ids.push_back(col_names.indexOf(key_col));
+
+		// Tables without primary key may have null values in the columns used to identify the rows
+		key_conds.push_back(QString(pk_col_names.isEmpty() ? "tab.\"%1\" IS NOT DISTINCT FROM r.k%2" : "tab.\"%1\" = r.k%2")
+												.arg(key_col).arg(key_conds.size()));
+	}
+
+	// Separating the rows by operation, the updated and inserted ones are grouped by the columns they affect
+	for(auto &row : rows)
+	{
+		DataGridModel::OperationId op_type = grid_model->getOperation(row);
+		std::vector<int> cols;
+		bool copy_row = true;
+
+		if(op_type == DataGridModel::OpDelete)
+		{
+			del_rows.push_back(row);
+			continue;
+		}
+
+		for(int col = 0; col < col_cnt && copy_row; col++)
+		{
+			if(grid_model->isReadOnlyColumn(col))
+				continue;
+
+			value = grid_model->getCellValue(row, col);
+
+			// Unchanged values are not updated and empty values of inserted rows mean the column's default
+			if((op_type == DataGridModel::OpUpdate && value == grid_model->getOriginalValue(row, col)) ||
+				 (op_type == DataGridModel::OpInsert && value.isEmpty()))
+				continue;
+
+			/* Unescaped values (SQL expressions), values reset to default in updates and unicode escapes (not supported
+			 * by COPY) must be handled by individual commands */
+			copy_row = !value.isEmpty() &&
+								 !value.startsWith(UtilsNs::UnescValueStart) && !value.endsWith(UtilsNs::UnescValueEnd) &&
+								 !value.contains("\\u") && !value.contains("\\U");
+			cols.push_back(col);
+		}
+
+		if(!copy_row || cols.empty())
+			dml_rows.push_back(row);
+		else if(op_type == DataGridModel::OpUpdate)
+			upd_groups[cols].push_back(row);
+		else
+			ins_groups[cols].push_back(row);
+	}
+
+	if(!del_rows.empty())
+	{
+		create_tmp_table({});
+		copy_rows(QString("COPY %1 FROM STDIN").arg(tmp_tab_name), del_rows, write_keys);
+		conn.executeDDLCommand(QString("DELETE FROM %1 AS tab USING %2 AS r WHERE %3")
+													 .arg(tab_name, tmp_tab_name, key_conds.join(" AND ")));
+	}
+
+	for(auto &[cols, grp_rows] : upd_groups)
+	{
+		const std::vector<int> &upd_cols = cols;
+		QStringList set_list;
+
+		create_tmp_table(upd_cols);
+		copy_rows(QString("COPY %1 FROM STDIN").arg(tmp_tab_name), grp_rows, [&](int row, QByteArray &buffer) {
+			write_keys(row, buffer);
+
+			for(auto &col : upd_cols)
+				appendCopyValue(buffer, grid_model->getCellValue(row, col), false, true);
+		});
+
+		for(unsigned idx = 0; idx < upd_cols.size(); idx++)
+			set_list.push_back(QString("\"%1\" = r.v%2").arg(col_name(upd_cols[idx])).arg(idx));
+
+		conn.executeDDLCommand(QString("UPDATE %1 AS tab SET %2 FROM %3 AS r WHERE %4")
+													 .arg(tab_name, set_list.join(", "), tmp_tab_name, key_conds.join(" AND ")));
+	}
+
+	for(auto &[cols, grp_rows] : ins_groups)
+	{
+		const std::vector<int> &ins_cols = cols;
+
+		col_list.clear();
+
+		for(auto &col : ins_cols)
+			col_list.push_back(QString("\"%1\"").arg(col_name(col)));
+
+		copy_rows(QString("COPY %1 (%2) FROM STDIN").arg(tab_name, col_list.join(", ")), grp_rows, [&](int row, QByteArray &buffer) {
+			for(auto &col : ins_cols)
+				appendCopyValue(buffer, grid_model->getCellValue(row, col), false, true);
+		});
+	}
+
+	return dml_rows;
+}
+
+void DataManipulationForm::appendCopyValue(QByteArray &buffer, const QString &value, bool is_null, bool is_user_value)
+{
+	QString copy_value = value;
+
+	if(is_null)
+		copy_value = "\\N";
+	/* The backslash escapes of the values typed by the user are interpreted (as in E'' strings), so they're kept since
+	 * COPY interprets them the same way, except for \N and \. alone which would be taken as null and end of data */
+	else if(is_user_value)
+	{
+		if(copy_value == "\\N" || copy_value == "\\.")
+			copy_value.remove(0, 1);
+	}
+	else
+		copy_value.replace("\\", "\\\\");
+
+	copy_value.replace("\t", "\\t");
+	copy_value.replace("\n", "\\n");
+	copy_value.replace("\r", "\\r");
+
+	buffer.append(copy_value.toUtf8());
+	buffer.append('\t');
+}
+
 void DataManipulationForm::resizeEvent(QResizeEvent *event)
 {
 	Qt::ToolButtonStyle style = Qt::ToolButtonIconOnly;
@@ -1583,6 +1853,7 @@ void DataManipulationForm::resizeEvent(QResizeEvent *event)
 
 void DataManipulationForm::closeEvent(QCloseEvent *)
 {
+	closePageConnection();
   GeneralConfigWidget::saveWidgetGeometry(this);
 }
 
@@ -1618,6 +1889,9 @@ void DataManipulationForm::truncateTable()
 	{
 		QAction *act = dynamic_cast<QAction *>(sender());
 
+		// The transaction of the cursor used to browse the table would block the truncation
+		closePageConnection();
+
 		if(DatabaseExplorerWidget::truncateTable(schema_cmb->currentText(), table_cmb->currentText(),
 																						 act->data().toBool(), Connection(tmpl_conn_params)))
 			retrieveData();
@@ -1675,7 +1949,7 @@ void DataManipulationForm::showPopupMenu()
 		item_menu.addAction(act);
 
 		act = item_menu.addAction(QIcon(GuiUtilsNs::getIconPath("cleartext")), tr("Clear items"), this, &DataManipulationForm::clearItemsText);
-		act->setEnabled(!results_tbw->selectedRanges().isEmpty());
+		act->setEnabled(!getSelectedRanges().isEmpty());
 
 		if(obj_type == ObjectType::Table)
 		{
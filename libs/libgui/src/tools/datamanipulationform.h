@@ -30,21 +30,19 @@
 #include "utils/syntaxhighlighter.h"
 #include "widgets/codecompletionwidget.h"
 #include "widgets/csvloadwidget.h"
+#include "utils/datagridmodel.h"
+#include "widgets/taskprogresswidget.h"
 
 class __libgui DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 	private:
 		Q_OBJECT
-		
-		//! \brief Constants used to mark the type of operation performed on rows
-		enum OperationId: unsigned {
-			NoOperation,
-			OpInsert,
-			OpUpdate,
-			OpDelete
-		};
 
 		CsvLoadWidget *csv_load_wgt;
 
+		/*! \brief Model holding the retrieved rows and the changes made on them. The rows are kept in a compact form and
+		 * the cells are rendered only when visible, so large tables don't create an item per cell */
+		DataGridModel *grid_model;
+
 		SyntaxHighlighter *filter_hl;
 		
 		CodeCompletionWidget *code_compl_wgt;
@@ -72,17 +70,46 @@ class __libgui DataManipulationForm: public QDialog, public Ui::DataManipulation
 		and it is used to retrieve all foreign keys that references the current table */
 		unsigned table_oid;
 		
-		//! \brief Stores the ids of changed rows. These ids are handled on saveChanges() method
-		std::vector<int> changed_rows;
-		
-		//! \brief Stores the previous color of the rows before being marked with some operation
-		std::map<int, QBrush> prev_row_colors;
-
 		//! \brief Stores the fk informations about referenced tables
 		std::map<QString, attribs_map> fk_infos,
 
 		//! \brief Stores the fk informations about referencing tables
 		ref_fk_infos;
+
+		/*! \brief Connection kept open while the rows of the current table are fetched in pages. When browsing through
+		 * a server-side cursor it also holds the read-only transaction in which the cursor lives */
+		Connection page_conn;
+
+		//! \brief Query that selects the rows of the current table (including the user's filter) used to fetch the pages
+		QString page_query;
+
+		/*! \brief Columns (the primary key) used to fetch the page after the last retrieved row (keyset pagination).
+		 * When empty the pages are fetched from a server-side cursor declared from the page query */
+		QStringList keyset_cols;
+
+		//! \brief Indicates that the keyset is traversed in descending order
+		bool keyset_desc;
+
+		//! \brief Amount of rows that can still be fetched due to the user defined limit. A negative value means no limit
+		int remaining_rows;
+
+		/*! \brief Configures the pagination of the rows of the table. Keyset pagination is used when the table has a primary key and the
+		 * rows are sorted only by its columns (in the same direction), otherwise the rows are read from a server-side cursor */
+		void configurePagination(const QString &filter, const QStringList &ord_cols);
+
+		/*! \brief Fetches the next page of rows into the result set using the page connection, which is opened when fetching the
+		 * first page. Returns true when there are more rows to be fetched (the page was filled and the limit wasn't reached) */
+		bool fetchPage(ResultSet &res, bool first_page);
+
+		/*! \brief Returns the query that retrieves all the rows of the table, in the same order, filter and limit used to
+		 * fetch the pages, selecting only the columns visible in the grid. Used to export the rows directly from the server */
+		QString getExportQuery();
+
+		//! \brief Closes the page connection (and the cursor) discarding any pagination state
+		void closePageConnection();
+
+		//! \brief Updates the label that shows the amount of rows retrieved and the time spent
+		void updateResultInfo(qint64 exec_time);
 		
 		//! \brief Fills a combobox with the names of objects retrieved from catalog
 		void listObjects(QComboBox *combo, std::vector<ObjectType> obj_types, const QString &schema="");
@@ -94,18 +121,29 @@ class __libgui DataManipulationForm: public QDialog, public Ui::DataManipulation
 		 that the selected line holds */
 		void retrieveFKColumns(const QString &schema, const QString &table);
 		
-		/*! \brief Mark the line as changed, changing its background color and applying the respective operation (see OP_??? constant)
-				when user call saveChanged() */
-		void markOperationOnRow(OperationId operation, int row);
-		
+		//! \brief Replaces the model of the results grid (destroying the previous one) and connects its signals
+		void setGridModel(DataGridModel *model);
+
+		//! \brief Returns the selected ranges of the results grid
+		QItemSelection getSelectedRanges();
+
 		//! \brief Generates a DML command for the row depending on the it's operation type
 		QString getDMLCommand(int row);
+
+		/*! \brief Returns the columns used to identify the rows in updates and deletes. When the table
+		 * doesn't have a primary key all the columns (except the bytea ones) are returned */
+		QStringList getKeyColumns();
+
+		/*! \brief Applies the pending operations of the provided rows in bulk: inserted rows are sent through COPY ... FROM STDIN and the keys
+		 * and values of updated and deleted rows are copied to temporary tables used by a single set-based UPDATE/DELETE. The rows that can't be
+		 * handled that way (e.g. holding unescaped values or values reset to default) are returned to be applied via getDMLCommand() */
+		std::vector<int> applyChangesInBulk(Connection &conn, const std::vector<int> &rows, TaskProgressWidget &task_prog_wgt);
+
+		//! \brief Appends a value to the buffer of a COPY ... FROM STDIN (text format) followed by a tab character
+		static void appendCopyValue(QByteArray &buffer, const QString &value, bool is_null, bool is_user_value);
 		
-		//! \brief Remove the rows marked as OP_INSERT which ids are specified on the parameter vector
-		void removeNewRows(std::vector<int> ins_rows);
-		
-		//! \brief Reset the state of changed rows, clearing all attributes used to control the modifications on them
-		void clearChangedRows();
+		//! \brief Updates the state of the buttons used to save or undo the changes made on the rows
+		void updateChangesButtons();
 
 		//! brief Browse a referenced or referencing table by the provided foreign key name
 		void browseTable(const QString &fk_name, bool browse_ref_tab);
@@ -119,6 +157,9 @@ class __libgui DataManipulationForm: public QDialog, public Ui::DataManipulation
 		bool eventFilter(QObject *object, QEvent *event);
 
 	public:
+		//! \brief Name of the server-side cursor used to fetch the rows of tables that can't be browsed by keyset
+		static const QString PageCursorName;
+
 		DataManipulationForm(QWidget * parent = nullptr, Qt::WindowFlags f = Qt::Widget);
 		
 		//! \brief Defines the connection and current schema and table to be handled, this method should be called before show the dialog
@@ -141,6 +182,10 @@ class __libgui DataManipulationForm: public QDialog, public Ui::DataManipulation
 		
 		//! \brief Retrieve the data for the current table filtering the data as configured on the advanced tab
 		void retrieveData();
+
+		/*! \brief Fetches the next page of rows of the current table appending them to the grid.
+		 * Called when the grid is scrolled to its end and there are more rows to be fetched */
+		void fetchNextPage();
 		
 		//! \brief Disable the buttons used to handle data
 		void disableControlButtons();
@@ -166,9 +211,6 @@ class __libgui DataManipulationForm: public QDialog, public Ui::DataManipulation
 		//! \brief Toggles the sort mode between ASC and DESC when right clicking on a element at order by list
 		void changeOrderMode(QListWidgetItem *item);
 		
-		//! \brief Mark the entire row in which the item resides
-		void markUpdateOnRow(QTableWidgetItem *item);
-		
 		//! \brief Mark a seleciton of rows to be delete. New rows are automatically removed
 		void markDeleteOnRows();
 		
@@ -48,6 +48,8 @@ ModelDatabaseDiffForm::ModelDatabaseDiffForm(QWidget *parent, Qt::WindowFlags fl
 		sqlcode_txt=GuiUtilsNs::createNumberedTextEditor(sqlcode_wgt);
 		sqlcode_txt->setReadOnly(true);
 
+		diff_file.setFileTemplate(GlobalAttributes::getTemporaryFilePath(QString("diff_XXXXXX.sql")));
+
 		htmlitem_del=new HtmlItemDelegate(this);
 		output_trw->setItemDelegateForColumn(0, htmlitem_del);
 
@@ -632,6 +634,7 @@ void ModelDatabaseDiffForm::importDatabase(ThreadId thread_id)
 		import_hlp->setCurrentDatabase(db_cmb->currentText());
 		import_hlp->setImportOptions(import_sys_objs_chk->isChecked(), import_ext_objs_chk->isChecked(), true,
 																 ignore_errors_chk->isChecked(), debug_mode_chk->isChecked(), false, false);
+		import_hlp->setUseSnapshot(use_snapshot_chk->isChecked());
 		thread->start();
 	}
 	catch(Exception &e)
@@ -668,9 +671,17 @@ void ModelDatabaseDiffForm::diffModels()
 	diff_helper->setDiffOption(ModelsDiffHelper::OptPreserveDbName, preserve_db_name_chk->isChecked());
 	diff_helper->setDiffOption(ModelsDiffHelper::OptDontDropMissingObjs, dont_drop_missing_objs_chk->isChecked());
 	diff_helper->setDiffOption(ModelsDiffHelper::OptDropMissingColsConstr, drop_missing_cols_constr_chk->isChecked());
+	diff_helper->setDiffOption(ModelsDiffHelper::OptParallelComparison, parallel_diff_chk->isChecked());
 
 	diff_helper->setModels(source_model, imported_model);
 
+	if(!diff_file.isOpen() && !diff_file.open())
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(diff_file.fileTemplate()),
+										ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	diff_file.resize(0);
+	diff_helper->setDiffOutput(&diff_file);
+
 	/* If the user has chosen diff between a model and database
 	 * We need to retrieve the filtered object in partial diff tab */
 	if(src_model_rb->isChecked())
@@ -716,7 +727,7 @@ void ModelDatabaseDiffForm::exportDiff(bool confirm)
 		diff_progress=step_pb->value();
 		export_item=GuiUtilsNs::createOutputTreeItem(output_trw, step_lbl->text(), step_ico_lbl->pixmap(Qt::ReturnByValue), nullptr);
 
-		export_helper->setExportToDBMSParams(sqlcode_txt->toPlainText(), export_conn,
+		export_helper->setExportToDBMSParams(&diff_file, export_conn,
 																				 database_cmb->currentText(), ignore_duplic_chk->isChecked());
 		if(ignore_error_codes_chk->isChecked())
 			export_helper->setIgnoredErrors(error_codes_edt->text().simplified().split(' '));
@@ -776,7 +787,7 @@ void ModelDatabaseDiffForm::loadDiffInSQLTool()
 		filename = tmp_sql_file.fileName();
 		tmp_sql_file.close();
 
-		UtilsNs::saveFile(filename, sqlcode_txt->toPlainText().toUtf8());
+		copyDiffFile(filename);
 	}
 
 	emit s_loadDiffInSQLTool(conn.getConnectionId(), database, filename);
@@ -795,7 +806,7 @@ void ModelDatabaseDiffForm::resetButtons()
 
 void ModelDatabaseDiffForm::saveDiffToFile()
 {
-	if(!sqlcode_txt->toPlainText().isEmpty())
+	if(diff_helper->hasDiffCode())
 	{
 		step_lbl->setText(tr("Saving diff to file <strong>%1</strong>").arg(file_sel->getSelectedFile()));
 		step_ico_lbl->setPixmap(QPixmap(GuiUtilsNs::getIconPath("save")));
@@ -803,12 +814,69 @@ void ModelDatabaseDiffForm::saveDiffToFile()
 		step_pb->setValue(90);
 		progress_pb->setValue(100);
 
-		UtilsNs::saveFile(file_sel->getSelectedFile(), sqlcode_txt->toPlainText().toUtf8());
+		copyDiffFile(file_sel->getSelectedFile());
 	}
 
 	finishDiff();
 }
 
+void ModelDatabaseDiffForm::copyDiffFile(const QString &filename)
+{
+	QFile output(filename);
+	QByteArray buffer;
+
+	if(!output.open(QFile::WriteOnly | QFile::Truncate))
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(filename),
+										ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	diff_file.flush();
+	diff_file.seek(0);
+
+	//Copying the code in chunks so the whole diff is never held in memory
+	while(!diff_file.atEnd())
+	{
+		buffer = diff_file.read(MaxPreviewSize);
+
+		if(output.write(buffer) != buffer.size())
+		{
+			output.close();
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(filename),
+											ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+		}
+	}
+
+	output.close();
+}
+
+void ModelDatabaseDiffForm::showDiffPreview()
+{
+	QByteArray buffer;
+	QString code;
+
+	if(!diff_helper->hasDiffCode())
+	{
+		sqlcode_txt->setPlainText(tr("-- No differences were detected between model and database. --"));
+		return;
+	}
+
+	diff_file.flush();
+	diff_file.seek(0);
+	buffer = diff_file.read(MaxPreviewSize);
+
+	if(diff_file.atEnd())
+		code = QString::fromUtf8(buffer);
+	else
+	{
+		//Cutting the preview in the last complete line to avoid breaking multibyte characters
+		buffer.truncate(buffer.lastIndexOf('\n') + 1);
+		code = QString::fromUtf8(buffer);
+		code += tr("\n-- Preview truncated at %1 of %2. The complete diff code is used when applying or saving it. --")
+						.arg(QLocale().formattedDataSize(buffer.size()), QLocale().formattedDataSize(diff_file.size()));
+	}
+
+	sqlcode_txt->setPlainText(code);
+}
+
 void ModelDatabaseDiffForm::finishDiff()
 {
 	cancelOperation(false);
@@ -906,31 +974,29 @@ void ModelDatabaseDiffForm::handleImportFinished(Exception e)
 void ModelDatabaseDiffForm::handleDiffFinished()
 {
 	curr_step++;
-	sqlcode_txt->setPlainText(diff_helper->getDiffDefinition());
+	diff_helper->setDiffOutput(nullptr);
 
 #ifdef DEMO_VERSION
 #warning "DEMO VERSION: SQL code preview truncated."
-	if(!sqlcode_txt->toPlainText().isEmpty())
+	if(diff_helper->hasDiffCode())
 	{
-		QString code=sqlcode_txt->toPlainText();
-		code=code.mid(0, code.size()/2);
-		code+=tr("\n\n-- SQL code purposely truncated at this point in demo version!");
-		sqlcode_txt->setPlainText(code);
+		diff_file.flush();
+		diff_file.resize(diff_file.size()/2);
+		diff_file.seek(diff_file.size());
+		diff_file.write(tr("\n\n-- SQL code purposely truncated at this point in demo version!").toUtf8());
 	}
 #endif
 
+	showDiffPreview();
 	settings_tbw->setTabEnabled(2, true);
 	diff_thread->quit();
 
 	if(store_in_file_rb->isChecked())
 		saveDiffToFile();
-	else if(!sqlcode_txt->toPlainText().isEmpty())
+	else if(diff_helper->hasDiffCode())
 		exportDiff();
 	else
 		finishDiff();
-
-	if(sqlcode_txt->toPlainText().isEmpty())
-		sqlcode_txt->setPlainText(tr("-- No differences were detected between model and database. --"));
 }
 
 void ModelDatabaseDiffForm::handleExportFinished()
@@ -1202,9 +1268,11 @@ void ModelDatabaseDiffForm::selectPreset()
 	force_recreation_chk->setChecked(conf[Attributes::ForceObjsRecreation] == Attributes::True);
 	recreate_unmod_chk->setChecked(conf[Attributes::ForceObjsRecreation] == Attributes::True &&
 																 conf[Attributes::RecreateUnmodObjs] == Attributes::True);
+	parallel_diff_chk->setChecked(conf[Attributes::ParallelDiff] == Attributes::True);
 
 	import_sys_objs_chk->setChecked(conf[Attributes::ImportSysObjs] == Attributes::True);
 	import_ext_objs_chk->setChecked(conf[Attributes::ImportExtObjs] == Attributes::True);
+	use_snapshot_chk->setChecked(conf[Attributes::UseSnapshot] == Attributes::True);
 	ignore_duplic_chk->setChecked(conf[Attributes::IgnoreDuplicErrors] == Attributes::True);
 	ignore_errors_chk->setChecked(conf[Attributes::IgnoreImportErrors] == Attributes::True);
 	ignore_error_codes_chk->setChecked(!conf[Attributes::IgnoreErrorCodes].isEmpty());
@@ -1299,9 +1367,11 @@ void ModelDatabaseDiffForm::savePreset()
 	conf[Attributes::ReuseSequences] = reuse_sequences_chk->isChecked() ? Attributes::True : Attributes::False;
 	conf[Attributes::ForceObjsRecreation] = force_recreation_chk->isChecked() ? Attributes::True : Attributes::False;
 	conf[Attributes::RecreateUnmodObjs] = recreate_unmod_chk->isChecked() ? Attributes::True : Attributes::False;
+	conf[Attributes::ParallelDiff] = parallel_diff_chk->isChecked() ? Attributes::True : Attributes::False;
 
 	conf[Attributes::ImportSysObjs] = import_sys_objs_chk->isChecked() ? Attributes::True : Attributes::False;
 	conf[Attributes::ImportExtObjs] = import_ext_objs_chk->isChecked() ? Attributes::True : Attributes::False;
+	conf[Attributes::UseSnapshot] = use_snapshot_chk->isChecked() ? Attributes::True : Attributes::False;
 	conf[Attributes::IgnoreDuplicErrors] = ignore_duplic_chk->isChecked() ? Attributes::True : Attributes::False;
 	conf[Attributes::IgnoreImportErrors] = ignore_errors_chk->isChecked() ? Attributes::True : Attributes::False;
 	conf[Attributes::IgnoreErrorCodes] = error_codes_edt->text();
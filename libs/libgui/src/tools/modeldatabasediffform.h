@@ -37,6 +37,7 @@
 #include "widgets/objectsfilterwidget.h"
 #include "widgets/findreplacewidget.h"
 #include <QThread>
+#include <QTemporaryFile>
 
 class __libgui ModelDatabaseDiffForm: public BaseConfigWidget, public Ui::ModelDatabaseDiffForm {
 	private:
@@ -56,6 +57,9 @@ class __libgui ModelDatabaseDiffForm: public BaseConfigWidget, public Ui::ModelD
 
 		static std::map<QString, attribs_map> config_params;
 
+		//! \brief Maximum amount of bytes of the diff code displayed in the preview tab
+		static constexpr qint64 MaxPreviewSize = 5242880;
+
 		QEventLoop event_loop;
 
 		bool is_adding_new_preset;
@@ -108,6 +112,11 @@ class __libgui ModelDatabaseDiffForm: public BaseConfigWidget, public Ui::ModelD
 		//! \brief PostgreSQL version used by the diff process
 		QString pgsql_ver;
 
+		/*! \brief Temporary file that receives the complete diff code generated by the diff helper.
+		 * The preview tab only displays the first MaxPreviewSize bytes of it while the export,
+		 * saving and loading in SQL tool operations read the code from this file */
+		QTemporaryFile diff_file;
+
 		int diff_progress, curr_step, total_steps;
 
 		bool process_paused;
@@ -128,6 +137,12 @@ class __libgui ModelDatabaseDiffForm: public BaseConfigWidget, public Ui::ModelD
 		void resetForm();
 		void resetButtons();
 		void saveDiffToFile();
+
+		//! \brief Copies the contents of the temporary diff file to the provided file
+		void copyDiffFile(const QString &filename);
+
+		//! \brief Fills the preview tab with the diff code stored in the temporary diff file
+		void showDiffPreview();
 		void finishDiff();
 
 		//! \brief Returns true when one or more threads of the whole diff process are running.
@@ -15,6 +15,7 @@ void ModelExportHelper::resetExportParams()
 	created_objs[ObjectType::Role]=created_objs[ObjectType::Tablespace]=-1;
 	db_model=nullptr;
 	connection=nullptr;
+	sql_input=nullptr;
 	scene=nullptr;
 	zoom=100;
 	show_grid=show_delim=page_by_page=split=browsable=false;
@@ -36,8 +37,7 @@ void ModelExportHelper::abortExport(Exception &e)
 void ModelExportHelper::handleSQLError(Exception &e, const QString &sql_cmd, bool ignore_dup)
 {
 	//Ignoring the error if it is in the ignored list
-	if(ignored_errors.indexOf(e.getExtraInfo()) >= 0 ||
-			(ignore_dup && isDuplicationError(e.getExtraInfo())))
+	if(isIgnoredError(e, ignore_dup))
 		emit s_errorIgnored(e.getExtraInfo(), e.getErrorMessage(), sql_cmd);
 	//Raises an excpetion if the error returned by the database is not listed in the ignored list of errors
 	else if(ignored_errors.indexOf(e.getExtraInfo()) < 0)
@@ -46,6 +46,12 @@ void ModelExportHelper::handleSQLError(Exception &e, const QString &sql_cmd, boo
 		errors.push_back(e);
 }
 
+bool ModelExportHelper::isIgnoredError(Exception &e, bool ignore_dup)
+{
+	return (ignored_errors.indexOf(e.getExtraInfo()) >= 0 ||
+					(ignore_dup && isDuplicationError(e.getExtraInfo())));
+}
+
 void ModelExportHelper::setIgnoredErrors(const QStringList &err_codes)
 {
 	QRegularExpression valid_code = QRegularExpression(QRegularExpression::anchoredPattern("([a-z]|[A-Z]|[0-9])+"));
@@ -804,18 +810,33 @@ bool ModelExportHelper::isDuplicationError(const QString &error_code)
 }
 
 void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &conn, bool drop_objs)
+{
+	SQLStatementSplitter splitter;
+	QByteArray buf = buffer.toUtf8();
+
+	splitter.setBuffer(buf);
+	exportBufferToDBMS(splitter, nullptr, buf.size(), conn, drop_objs);
+}
+
+void ModelExportHelper::exportBufferToDBMS(QIODevice &input, Connection &conn, bool drop_objs)
+{
+	SQLStatementSplitter splitter;
+	exportBufferToDBMS(splitter, &input, input.size(), conn, drop_objs);
+}
+
+void ModelExportHelper::exportBufferToDBMS(SQLStatementSplitter &splitter, QIODevice *input, qint64 buf_size, Connection &conn, bool drop_objs)
 {
 	Connection aux_conn;
-	QString sql_buf=buffer, sql_cmd, aux_cmd, lin, msg,
+	QString sql_cmd, aux_cmd, lin, msg,
 			obj_name, obj_tp_name, tab_name, orig_conn_db_name,
 			alter_tab=QString("ALTER TABLE");
 	std::vector<QString> db_sql_cmds;
-	QTextStream ts;
+	QStringList pending_cmds;
+	SQLStatementSplitter::Span span;
 	ObjectType obj_type=ObjectType::BaseObject;
-	bool ddl_tk_found=false, is_create=false, is_drop=false;
-	unsigned aux_prog=0, curr_size=0, buf_size=sql_buf.size(),
-			factor=(db_name.isEmpty() ? 70 : 90);
-	int pos=0, pos1=0, comm_cnt=0;
+	bool is_create=false, is_drop=false;
+	unsigned aux_prog=0, factor=(db_name.isEmpty() ? 70 : 90);
+	int pos=0, pos1=0;
 
 	//Regexp used to extract the object being created
 	QRegularExpression obj_reg("(CREATE|DROP|ALTER)(.)+(\n)"),
@@ -837,7 +858,37 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 
 	/* Extract each SQL command from the buffer and execute them separately. This is done
    to permit the user, in case of error, identify what object is wrongly configured. */
-	ts.setString(&sql_buf);
+	if(buf_size <= 0)
+		buf_size=1;
+
+	/* The commented DROP commands placed before the objects' DDL are only
+	 * needed (as comment spans) when the drop objects option is checked */
+	splitter.setCommentsEnabled(drop_objs);
+
+	/* Each object's DDL (as well as generic SQL and appended code) is delimited by the DDL end token
+	 * and is sent as a single command even when it holds several statements */
+	splitter.setDdlEndTokenOnly(true);
+
+	/* Sends the accumulated commands to the server in a single batch (transaction). If the batch fails it's rolled back
+	 * and its commands are executed one by one, so ignored errors are only notified while the others abort the export
+	 * without running the remaining commands (the failed command is assigned to sql_cmd so the error handling below can report it) */
+	auto exec_pending_cmds = [&](){
+		QStringList cmds;
+
+		cmds.swap(pending_cmds);
+		conn.executeDDLCommands(cmds, [&](int cmd_idx, Exception *e){
+			if(!e)
+				return;
+
+			if(isIgnoredError(*e, ignore_dup))
+				handleSQLError(*e, cmds[cmd_idx], ignore_dup);
+			else
+			{
+				sql_cmd = cmds[cmd_idx];
+				throw *e;
+			}
+		});
+	};
 
 	if(!conn.isStablished())
 	{
@@ -849,43 +900,35 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 		conn.connect();
 	}
 
-	while(!ts.atEnd() && !export_canceled)
+	while(!splitter.atEnd() && !export_canceled)
 	{
 		try
 		{
-			//Cleanup single line comments
-			lin=ts.readLine();
-			curr_size+=lin.size();
-			aux_prog=progress + ((curr_size/static_cast<double>(buf_size)) * factor);
-
-			/* If the simulation mode is off and the drop objects option is checked,
-		 check if the current line matches one of the accepted drop commands
-		 (DROP [OBJECT] or ALTER TABLE...DROP) */
-			if(drop_objs && (drop_reg.match(lin).hasMatch() || drop_tab_obj_reg.match(lin).hasMatch()))
+			if(!splitter.nextSpan(span))
 			{
-				comm_cnt=lin.count("--");
-				lin=lin.remove("--").trimmed();
-
-				/* If the count of comment indicators (--) is 1 indicates that the DDL of the
-		   object related to the DROP is enabled, so the DROP is executed otherwise ignored */
-				if(comm_cnt==1)
-				{
-					sql_cmd=lin + "\n";
-					ddl_tk_found=true;
-				}
+				//Feeding the splitter with the next chunk of the input or finishing it
+				if(input && !input->atEnd())
+					splitter.appendData(input->read(SQLChunkSize));
+				else
+					splitter.finishInput();
 			}
-			else
+			else if(span.type == SQLStatementSplitter::Comment)
 			{
-				ddl_tk_found=(lin.indexOf(Attributes::DdlEndToken) >= 0);
-				lin.remove(QRegularExpression("^(--)+(.)+$"));
-
-				//If the line isn't empty after cleanup it will be included on sql command
-				if(!lin.isEmpty())
-					sql_cmd += lin + "\n";
+				lin = splitter.getSpanText(span);
+
+				/* If the drop objects option is checked, check if the comment matches one of
+				 * the accepted drop commands (DROP [OBJECT] or ALTER TABLE...DROP). If the count
+				 * of comment indicators (--) is 1 indicates that the DDL of the object related to
+				 * the DROP is enabled, so the DROP is executed otherwise ignored */
+				if((drop_reg.match(lin).hasMatch() || drop_tab_obj_reg.match(lin).hasMatch()) && lin.count("--") == 1)
+					sql_cmd = lin.remove("--").trimmed() + "\n";
 			}
+			else
+				sql_cmd = splitter.getSpanText(span) + "\n";
+
+			aux_prog=progress + ((splitter.getProcessedSize()/static_cast<double>(buf_size)) * factor);
 
-			//If the ddl end token is found
-			if(ddl_tk_found || (!sql_cmd.isEmpty() && ts.atEnd()))
+			if(!sql_cmd.isEmpty())
 			{
 				//Checking if the command is a column or constraint creation via ALTER TABLE
 				aux_cmd = sql_cmd;
@@ -1056,18 +1099,20 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 				if(!sql_cmd.isEmpty() && !export_canceled)
 				{
 					if(obj_type != ObjectType::Database)
-						conn.executeDDLCommand(sql_cmd);
+						pending_cmds.push_back(sql_cmd);
 					else
 						//If it's a database level command (e.g. ALTER DATABASE ... RENAME TO ...)
 						db_sql_cmds.push_back(sql_cmd);
 				}
 
 				sql_cmd.clear();
-				ddl_tk_found=false;
 			}
 
+			if(!export_canceled && (pending_cmds.size() >= DDLBatchSize || (splitter.atEnd() && !pending_cmds.isEmpty())))
+				exec_pending_cmds();
+
 			//Executing the pending database level commands
-			if(ts.atEnd() && !db_sql_cmds.empty() && !export_canceled)
+			if(splitter.atEnd() && !db_sql_cmds.empty() && !export_canceled)
 			{
 				conn.close();
 				aux_conn=conn;
@@ -1082,7 +1127,6 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 		}
 		catch(Exception &e)
 		{
-			if(ddl_tk_found) ddl_tk_found=false;
 			handleSQLError(e, sql_cmd, ignore_dup);
 			sql_cmd.clear();
 		}
@@ -1112,6 +1156,7 @@ void ModelExportHelper::setExportToDBMSParams(DatabaseModel *db_model, Connectio
 	this->drop_objs=drop_objs && !drop_db;
 	this->use_tmp_names=use_rand_names;
 	this->sql_buffer.clear();
+	this->sql_input=nullptr;
 	this->db_name.clear();
 	this->errors.clear();
 }
@@ -1119,6 +1164,7 @@ void ModelExportHelper::setExportToDBMSParams(DatabaseModel *db_model, Connectio
 void ModelExportHelper::setExportToDBMSParams(const QString &sql_buffer, Connection *conn, const QString &db_name, bool ignore_dup)
 {
 	this->sql_buffer=sql_buffer;
+	this->sql_input=nullptr;
 	this->connection=conn;
 	this->db_name=db_name;
 	this->ignore_dup=ignore_dup;
@@ -1128,6 +1174,12 @@ void ModelExportHelper::setExportToDBMSParams(const QString &sql_buffer, Connect
 	this->errors.clear();
 }
 
+void ModelExportHelper::setExportToDBMSParams(QIODevice *sql_input, Connection *conn, const QString &db_name, bool ignore_dup)
+{
+	setExportToDBMSParams(QString(), conn, db_name, ignore_dup);
+	this->sql_input=sql_input;
+}
+
 void ModelExportHelper::setExportToSQLParams(DatabaseModel *db_model, const QString &filename, const QString &pgsql_ver, bool split, DatabaseModel::CodeGenMode code_gen_mode)
 {
 	this->db_model=db_model;
@@ -1168,13 +1220,22 @@ void ModelExportHelper::exportToDBMS()
 {
 	if(connection)
 	{
-		if(sql_buffer.isEmpty())
+		if(sql_buffer.isEmpty() && !sql_input)
 			exportToDBMS(db_model, *connection, pgsql_ver, ignore_dup, drop_db, drop_objs, simulate, use_tmp_names);
 		else
 		{
 			try
 			{
-				exportBufferToDBMS(sql_buffer, *connection);
+				if(sql_input)
+				{
+					if(!sql_input->isOpen() && !sql_input->open(QIODevice::ReadOnly | QIODevice::Text))
+						throw Exception(sql_input->errorString(), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+					sql_input->seek(0);
+					exportBufferToDBMS(*sql_input, *connection);
+				}
+				else
+					exportBufferToDBMS(sql_buffer, *connection);
 
 				if(export_canceled)
 					emit s_exportCanceled();
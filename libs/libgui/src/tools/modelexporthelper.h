@@ -27,11 +27,20 @@
 
 #include "widgets/modelwidget.h"
 #include "connection.h"
+#include "sqlstatementsplitter.h"
+#include <QTextStream>
 
 class __libgui ModelExportHelper: public QObject {
 	private:
 		Q_OBJECT
 
+		/*! \brief Maximum number of DDL commands accumulated before sending them to the server in a single
+		 *  batch (transaction) when exporting a buffer to DBMS (see Connection::executeDDLCommands()) */
+		static constexpr int DDLBatchSize = 50;
+
+		//! \brief Amount of bytes read at once from the input device when exporting a script to DBMS
+		static constexpr qint64 SQLChunkSize = 65536;
+
 		//! \brief  Stores the total progress
 		int progress,
 
@@ -91,6 +100,10 @@ class __libgui ModelExportHelper: public QObject {
 
 		QString sql_buffer, db_name;
 
+		/*! \brief Device from which the SQL commands are read when exporting a script that isn't held in memory,
+		 *  e.g. a diff written to a file (only in thread mode) */
+		QIODevice *sql_input;
+
 		//! \brief List of ignored error codes
 		QStringList ignored_errors;
 
@@ -134,6 +147,15 @@ class __libgui ModelExportHelper: public QObject {
 		//! \brief Exports the contents of the buffer to a previously opened connection
 		void exportBufferToDBMS(const QString &buffer, Connection &conn, bool drop_objs=false);
 
+		/*! \brief Exports the SQL commands read from the device to a previously opened connection. The device is read
+		 * in chunks so the whole script isn't held in memory (e.g. a diff written to a file) */
+		void exportBufferToDBMS(QIODevice &input, Connection &conn, bool drop_objs=false);
+
+		/*! \brief Exports the statements returned by the splitter to a previously opened connection. When the input device
+		 * is provided the splitter is fed with its chunks as the statements are consumed. The buf_size is the amount
+		 * of bytes of the whole script and is used only to calculate the progress */
+		void exportBufferToDBMS(SQLStatementSplitter &splitter, QIODevice *input, qint64 buf_size, Connection &conn, bool drop_objs);
+
 		//! \brief Returns if the error code is one of the treated by the export process as object duplication error
 		bool isDuplicationError(const QString &error_code);
 
@@ -150,6 +172,9 @@ class __libgui ModelExportHelper: public QObject {
 		3) abort the export by immediatelly redirecting the error to the user */
 		void handleSQLError(Exception &e, const QString &sql_cmd, bool ignore_dup);
 
+		//! \brief Returns if the error code in the provided exception is one of the ignored ones (see handleSQLError())
+		bool isIgnoredError(Exception &e, bool ignore_dup);
+
 	public:
 		ModelExportHelper(QObject *parent = nullptr);
 
@@ -195,6 +220,12 @@ class __libgui ModelExportHelper: public QObject {
 		This form receive a previously generated sql buffer to be exported the the helper */
 		void setExportToDBMSParams(const QString &sql_buffer, Connection *conn, const QString &db_name, bool ignore_dup=false);
 
+		/*! \brief Configures the DBMS export params before start the export thread (when in thread mode).
+		This form receive a device from which the sql code is read from the start while exporting. This is the
+		preferred way to export large scripts since they don't need to be held in memory. The device is
+		opened in read only mode if it's not opened yet */
+		void setExportToDBMSParams(QIODevice *sql_input, Connection *conn, const QString &db_name, bool ignore_dup=false);
+
 		/*! \brief Configures the SQL export params before start the export thread (when in thread mode).
 		This form receive the model, output filename and pgsql version to be used */
 		void setExportToSQLParams(DatabaseModel *db_model, const QString &filename, const QString &pgsql_ver, bool split, DatabaseModel::CodeGenMode code_gen_mode);
@@ -18,8 +18,11 @@
 
 #include "modelsdiffhelper.h"
 #include <QThread>
+#include <QThreadPool>
+#include <atomic>
 #include "utilsns.h"
 #include <QDate>
+#include <QTextStream>
 #include "catalog.h"
 
 const QStringList ModelsDiffHelper::TableObjsIgnoredAttribs = { Attributes::Alias };
@@ -41,8 +44,10 @@ const QStringList ModelsDiffHelper::RolesIgnoredTags = {
 ModelsDiffHelper::ModelsDiffHelper()
 {
 	diff_canceled=false;
+	has_diff_code=false;
 	pgsql_version=PgSqlVersions::DefaulVersion;
 	source_model=imported_model=nullptr;
+	diff_output=nullptr;
 	resetDiffCounter();
 
 	diff_opts[OptKeepClusterObjs]=true;
@@ -54,6 +59,7 @@ ModelsDiffHelper::ModelsDiffHelper()
 	diff_opts[OptPreserveDbName]=true;
 	diff_opts[OptDontDropMissingObjs]=false;
 	diff_opts[OptDropMissingColsConstr]=false;
+	diff_opts[OptParallelComparison]=false;
 }
 
 ModelsDiffHelper::~ModelsDiffHelper()
@@ -63,7 +69,7 @@ ModelsDiffHelper::~ModelsDiffHelper()
 
 void ModelsDiffHelper::setDiffOption(DiffOptions opt_id, bool value)
 {
-	if(opt_id > OptDropMissingColsConstr)
+	if(opt_id > OptParallelComparison)
 		throw Exception(ErrorCode::RefElementInvalidIndex,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	if(opt_id == OptDropMissingColsConstr)
@@ -90,6 +96,16 @@ QString ModelsDiffHelper::getDiffDefinition()
 	return diff_def;
 }
 
+void ModelsDiffHelper::setDiffOutput(QIODevice *output)
+{
+	diff_output=output;
+}
+
+bool ModelsDiffHelper::hasDiffCode()
+{
+	return has_diff_code;
+}
+
 void ModelsDiffHelper::setModels(DatabaseModel *src_model, DatabaseModel *imp_model)
 {
 	source_model=src_model;
@@ -233,6 +249,9 @@ void ModelsDiffHelper::diffModels()
 		if(!source_model || !imported_model)
 			throw Exception(ErrorCode::OprNotAllocatedObject ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+		diff_def.clear();
+		has_diff_code=false;
+
 		//First, we need to detect the objects to be dropped
 		diffModels(ObjectsDiffInfo::DropObject);
 		//Second, we will check the objects to be created or modified
@@ -365,6 +384,205 @@ void ModelsDiffHelper::diffTables(PhysicalTable *src_table, PhysicalTable *imp_t
 	}
 }
 
+bool ModelsDiffHelper::isObjectDiscarded(BaseObject *object, ObjectsDiffInfo::DiffType diff_type)
+{
+	ObjectType obj_type = object->getObjectType();
+
+	/* The following objects are discarded:
+	 * 1) ObjectType::ObjBaseRelationship objects
+	 * 2) Objects which SQL code is disabled or system objects
+	 * 3) Cluster objects such as roles and tablespaces (when the operatoin is DROP and keep_cluster_objs is true) */
+	return !(obj_type!=ObjectType::BaseRelationship &&
+					 !object->isSystemObject() && !object->isSQLDisabled() &&
+					 ((diff_type==ObjectsDiffInfo::DropObject && (!diff_opts[OptKeepClusterObjs] || (diff_opts[OptKeepClusterObjs] && obj_type!=ObjectType::Role && obj_type!=ObjectType::Tablespace))) ||
+						(diff_type!=ObjectsDiffInfo::DropObject)));
+}
+
+bool ModelsDiffHelper::isObjectComparable(BaseObject *object)
+{
+	ObjectType obj_type = object->getObjectType();
+
+	/* Database, permissions and relationships have their own comparison rules (see diffModels(DiffType))
+	 * any other object is compared against its counterpart in the other model */
+	return obj_type!=ObjectType::Database && obj_type!=ObjectType::Permission &&
+				 obj_type!=ObjectType::Relationship && obj_type!=ObjectType::BaseRelationship;
+}
+
+void ModelsDiffHelper::compareObjects(BaseObject *object, DatabaseModel *aux_model, ObjectsDiffInfo::DiffType diff_type, ObjectComparison &comp, bool defer_xml_cmp)
+{
+	QString obj_name = object->getSignature();
+	ObjectType obj_type = object->getObjectType();
+
+	//Get the object from the database
+	comp.aux_object = aux_model->getObject(obj_name, obj_type);
+
+	//Special case for many-to-many relationships
+	if(obj_type==ObjectType::Table && !comp.aux_object)
+		comp.aux_object = getRelNNTable(obj_name, aux_model);
+
+	if(diff_type == ObjectsDiffInfo::DropObject || !comp.aux_object)
+		return;
+
+	/* Try to get a diff from the retrieve object and the current object,
+	 * comparing only basic attributes like schema, tablespace and owner
+	 * this is why the BaseObject::getAlterCode is called */
+	comp.objs_differs = !comp.aux_object->BaseObject::getAlterCode(object).isEmpty();
+
+	//If the objects does not differ, try to compare their XML definition
+	if(!comp.objs_differs)
+	{
+		comp.ignored_attribs = &ObjectsIgnoredAttribs;
+		comp.ignored_tags = (obj_type != ObjectType::Role ? &ObjectsIgnoredTags : &RolesIgnoredTags);
+
+		if(defer_xml_cmp)
+		{
+			comp.obj_code = object->getComparisonCode();
+			comp.aux_code = comp.aux_object->getComparisonCode();
+			comp.xml_cmp_pending = true;
+		}
+		else
+			comp.xml_differs = object->isCodeDiffersFrom(comp.aux_object, *comp.ignored_attribs, *comp.ignored_tags);
+	}
+}
+
+void ModelsDiffHelper::compareTableObjects(TableObject *tab_obj, ObjectsDiffInfo::DiffType diff_type, ObjectComparison &comp, bool defer_xml_cmp)
+{
+	BaseTable *base_tab=nullptr, *aux_base_tab=nullptr;
+	ObjectType obj_type=tab_obj->getObjectType();
+	QString tab_name, obj_name=tab_obj->getName(true);
+
+	//Get the parent table of the object
+	base_tab=tab_obj->getParentTable();
+	tab_name=base_tab->getSignature();
+
+	//If the operation is a DROP, try to get the table from the source mode
+	if(diff_type==ObjectsDiffInfo::DropObject)
+	{
+		aux_base_tab=dynamic_cast<BaseTable *>(source_model->getObject(tab_name, base_tab->getObjectType()));
+
+		//If the table was not found, try to find it between the many-to-many relationships
+		if(!aux_base_tab)
+			aux_base_tab=dynamic_cast<BaseTable *>(getRelNNTable(tab_name, source_model));
+	}
+	else if(diff_type==ObjectsDiffInfo::CreateObject || diff_type==ObjectsDiffInfo::AlterObject)
+	{
+		aux_base_tab=dynamic_cast<BaseTable *>(imported_model->getObject(tab_name, base_tab->getObjectType()));
+
+		//If the table was not found, try to find it between the many-to-many relationships
+		if(!aux_base_tab)
+			aux_base_tab=dynamic_cast<BaseTable *>(getRelNNTable(obj_name, imported_model));
+	}
+
+	if(aux_base_tab)
+	{
+		if(obj_type==ObjectType::Constraint)
+		{
+			PhysicalTable *aux_table=dynamic_cast<PhysicalTable *>(aux_base_tab);
+			comp.aux_object=aux_table->getObject(obj_name, obj_type);
+		}
+		else
+			comp.aux_object=aux_base_tab->getObject(obj_name, obj_type);
+	}
+
+	if(diff_type == ObjectsDiffInfo::DropObject || !comp.aux_object)
+		return;
+
+	comp.ignored_attribs = &TableObjsIgnoredAttribs;
+	comp.ignored_tags = nullptr;
+
+	if(defer_xml_cmp)
+	{
+		comp.obj_code = tab_obj->getComparisonCode();
+		comp.aux_code = comp.aux_object->getComparisonCode();
+		comp.xml_cmp_pending = true;
+	}
+	else
+		comp.xml_differs = tab_obj->isCodeDiffersFrom(comp.aux_object, TableObjsIgnoredAttribs);
+}
+
+std::vector<ModelsDiffHelper::ObjectComparison> ModelsDiffHelper::compareObjectsInParallel(const std::vector<BaseObject *> &objects, DatabaseModel *aux_model,
+																																																	ObjectsDiffInfo::DiffType diff_type, double prog, double factor)
+{
+	std::vector<ObjectComparison> comps(objects.size());
+	std::map<std::pair<QString, ObjectType>, std::vector<unsigned>> partitions;
+	std::atomic<unsigned> compared_count(0);
+	unsigned pending_count = 0, idx = 0;
+	BaseObject *object = nullptr;
+	BaseObject *schema = nullptr;
+	TableObject *tab_obj = nullptr;
+	QThreadPool pool;
+
+	/* First step: looking up the objects' counterparts and generating their code. Since the code generation
+	 * changes the internal state of the objects (attributes, cached code) and reaches other objects (schemas, owners, etc)
+	 * this is done in the current thread, in the same order of the sequential mode */
+	for(idx = 0; idx < objects.size() && !diff_canceled; idx++)
+	{
+		object = objects[idx];
+
+		if(isObjectDiscarded(object, diff_type) || !isObjectComparable(object))
+			continue;
+
+		emit s_progressUpdated(prog + ((idx/static_cast<double>(objects.size())) * factor),
+													 tr("Generating code of object `%1' (%2)...").arg(object->getSignature()).arg(object->getTypeName()),
+													 object->getObjectType());
+
+		tab_obj = dynamic_cast<TableObject *>(object);
+
+		if(tab_obj)
+			compareTableObjects(tab_obj, diff_type, comps[idx], true);
+		else
+			compareObjects(object, aux_model, diff_type, comps[idx], true);
+
+		comps[idx].computed = true;
+
+		if(!comps[idx].xml_cmp_pending)
+			continue;
+
+		/* Grouping the pending XML comparisons by schema and object type. Table children
+		 * are placed in the same schema of their parent tables */
+		schema = tab_obj && tab_obj->getParentTable() ? tab_obj->getParentTable()->getSchema() : object->getSchema();
+		partitions[{ schema ? schema->getName() : QString(), object->getObjectType() }].push_back(idx);
+		pending_count++;
+	}
+
+	if(diff_canceled || pending_count == 0)
+		return comps;
+
+	/* Second step: the XML buffers are normalized and compared in a pool of workers. Each worker
+	 * only touches the code buffers and the result of the objects in its partition, so no lock is needed */
+	for(auto &itr : partitions)
+	{
+		std::vector<unsigned> *part_idxs = &itr.second;
+
+		pool.start(QRunnable::create([this, part_idxs, &comps, &objects, &compared_count](){
+			for(auto &cmp_idx : *part_idxs)
+			{
+				ObjectComparison &comp = comps[cmp_idx];
+
+				if(diff_canceled)
+					break;
+
+				comp.xml_differs = objects[cmp_idx]->isCodeDiffersFrom(comp.obj_code, comp.aux_code,
+																																 *comp.ignored_attribs,
+																																 comp.ignored_tags ? *comp.ignored_tags : QStringList());
+				comp.obj_code.clear();
+				comp.aux_code.clear();
+				comp.xml_cmp_pending = false;
+				compared_count++;
+			}
+		}));
+	}
+
+	// Reporting the progress from the current thread while the workers are running
+	while(!pool.waitForDone(100))
+	{
+		emit s_progressUpdated(prog + factor,
+													 tr("Comparing objects code (%1 of %2)...").arg(compared_count.load()).arg(pending_count));
+	}
+
+	return comps;
+}
+
 void ModelsDiffHelper::diffModels(ObjectsDiffInfo::DiffType diff_type)
 {
 	if(diff_canceled)
@@ -373,12 +591,14 @@ void ModelsDiffHelper::diffModels(ObjectsDiffInfo::DiffType diff_type)
 	try
 	{
 		std::map<unsigned, BaseObject *> obj_order;
+		std::vector<BaseObject *> objects;
+		std::vector<ObjectComparison> comps;
+		ObjectComparison comp;
 		BaseObject *object=nullptr, *aux_object=nullptr;
 		ObjectType obj_type;
-		QString obj_name;
-		unsigned idx=0, factor=0, prog=0;
+		unsigned idx=0;
+		double factor=0, prog=0;
 		DatabaseModel *aux_model=nullptr;
-		bool objs_differs=false, xml_differs=false;
 
 		if(diff_type==ObjectsDiffInfo::DropObject)
 		{
@@ -403,25 +623,50 @@ void ModelsDiffHelper::diffModels(ObjectsDiffInfo::DiffType diff_type)
 			prog=50;
 		}
 
+		objects.reserve(obj_order.size());
+
 		for(auto &obj_itr : obj_order)
+			objects.push_back(obj_itr.second);
+
+		/* In parallel mode the XML comparisons (the most expensive part of the process) are done upfront
+		 * by a pool of workers. The loop below then consumes the results in the same order of the sequential mode
+		 * so the generated diff infos are exactly the same in both modes. DROP detection is always sequential since
+		 * it doesn't compare the objects' code */
+		if(diff_opts[OptParallelComparison] && diff_type != ObjectsDiffInfo::DropObject)
 		{
-			object=obj_itr.second;
+			factor /= 2;
+			comps = compareObjectsInParallel(objects, aux_model, diff_type, prog, factor);
+			prog += factor;
+
+			if(diff_canceled)
+				return;
+		}
+
+		for(idx = 0; idx < objects.size(); idx++)
+		{
+			object=objects[idx];
 			obj_type=object->getObjectType();
-			idx++;
-
-			/* If this checking the following objects are discarded:
-			 * 1) ObjectType::ObjBaseRelationship objects
-			 * 2) Objects which SQL code is disabled or system objects
-			 * 3) Cluster objects such as roles and tablespaces (when the operatoin is DROP and keep_cluster_objs is true) */
-			if(obj_type!=ObjectType::BaseRelationship &&
-					!object->isSystemObject() && !object->isSQLDisabled() &&
-					((diff_type==ObjectsDiffInfo::DropObject && (!diff_opts[OptKeepClusterObjs] || (diff_opts[OptKeepClusterObjs] && obj_type!=ObjectType::Role && obj_type!=ObjectType::Tablespace))) ||
-					 (diff_type!=ObjectsDiffInfo::DropObject)))
+
+			if(!isObjectDiscarded(object, diff_type))
 			{
-				emit s_progressUpdated(prog + ((idx/static_cast<double>(obj_order.size())) * factor),
+				emit s_progressUpdated(prog + (((idx + 1)/static_cast<double>(objects.size())) * factor),
 															 tr("Processing object `%1' (%2)...").arg(object->getSignature()).arg(object->getTypeName()),
 															 object->getObjectType());
 
+				/* Retrieving the comparison done in parallel mode or comparing the object
+				 * in place if we are in sequential mode */
+				if(!comps.empty() && comps[idx].computed)
+					comp = comps[idx];
+				else if(isObjectComparable(object))
+				{
+					comp = ObjectComparison();
+
+					if(TableObject::isTableObject(obj_type))
+						compareTableObjects(dynamic_cast<TableObject *>(object), diff_type, comp, false);
+					else
+						compareObjects(object, aux_model, diff_type, comp, false);
+				}
+
 				//Processing objects that are not database, table child object (they are processed further)
 				if(obj_type!=ObjectType::Database && !TableObject::isTableObject(obj_type))
 				{
@@ -478,30 +723,12 @@ void ModelsDiffHelper::diffModels(ObjectsDiffInfo::DiffType diff_type)
 					}
 					else if(obj_type!=ObjectType::Permission)
 					{
-						//Get the object from the database
-						obj_name=object->getSignature();
-						aux_object=aux_model->getObject(obj_name, obj_type);
-
-						//Special case for many-to-many relationships
-						if(obj_type==ObjectType::Table && !aux_object)
-							aux_object=getRelNNTable(obj_name, aux_model);
+						aux_object=comp.aux_object;
 
 						if(diff_type != ObjectsDiffInfo::DropObject && aux_object)
 						{
-							/* Try to get a diff from the retrieve object and the current object,
-							 * comparing only basic attributes like schema, tablespace and owner
-							 * this is why the BaseObject::getAlterCode is called */
-							objs_differs=!aux_object->BaseObject::getAlterCode(object).isEmpty();
-
-							//If the objects does not differ, try to compare their XML definition
-							if(!objs_differs)
-							{
-								xml_differs = object->isCodeDiffersFrom(aux_object,	ObjectsIgnoredAttribs,
-																												obj_type != ObjectType::Role ? ObjectsIgnoredTags : RolesIgnoredTags);
-							}
-
 							//If a difference was detected between the objects
-							if(objs_differs || xml_differs)
+							if(comp.objs_differs || comp.xml_differs)
 							{
 								generateDiffInfo(ObjectsDiffInfo::AlterObject, object, aux_object);
 
@@ -514,8 +741,6 @@ void ModelsDiffHelper::diffModels(ObjectsDiffInfo::DiffType diff_type)
 									diffTables(tab, aux_tab, ObjectsDiffInfo::DropObject);
 									diffTables(tab, aux_tab, ObjectsDiffInfo::CreateObject);
 								}
-
-								objs_differs=xml_differs=false;
 							}
 						}
 						else if(!aux_object)
@@ -530,7 +755,7 @@ void ModelsDiffHelper::diffModels(ObjectsDiffInfo::DiffType diff_type)
 				}
 				//Comparison for constraints (fks), triggers, rules, indexes
 				else if(TableObject::isTableObject(obj_type))
-					diffTableObject(dynamic_cast<TableObject *>(object), diff_type);
+					diffTableObject(dynamic_cast<TableObject *>(object), diff_type, comp);
 				//Comparison between model db and the imported db
 				else if(diff_type==ObjectsDiffInfo::CreateObject)
 				{
@@ -544,7 +769,7 @@ void ModelsDiffHelper::diffModels(ObjectsDiffInfo::DiffType diff_type)
 			else
 			{
 				generateDiffInfo(ObjectsDiffInfo::IgnoreObject, object);
-				emit s_progressUpdated(prog + ((idx/static_cast<double>(obj_order.size())) * factor),
+				emit s_progressUpdated(prog + (((idx + 1)/static_cast<double>(objects.size())) * factor),
 									   tr("Skipping object `%1' (%2)...").arg(object->getSignature()).arg(object->getTypeName()),
 									   object->getObjectType());
 
@@ -559,47 +784,9 @@ void ModelsDiffHelper::diffModels(ObjectsDiffInfo::DiffType diff_type)
 	}
 }
 
-void ModelsDiffHelper::diffTableObject(TableObject *tab_obj, ObjectsDiffInfo::DiffType diff_type)
+void ModelsDiffHelper::diffTableObject(TableObject *tab_obj, ObjectsDiffInfo::DiffType diff_type, const ObjectComparison &comp)
 {
-	BaseTable *base_tab=nullptr, *aux_base_tab=nullptr;
-	ObjectType obj_type=tab_obj->getObjectType();
-	QString tab_name, obj_name=tab_obj->getName(true);
-	BaseObject *aux_tab_obj=nullptr;
-
-	//Get the parent table of the object
-	base_tab=tab_obj->getParentTable();
-	tab_name=base_tab->getSignature();
-
-	//If the operation is a DROP, try to get the table from the source mode
-	if(diff_type==ObjectsDiffInfo::DropObject)
-	{
-		aux_base_tab=dynamic_cast<BaseTable *>(source_model->getObject(tab_name, base_tab->getObjectType()));
-
-		//If the table was not found, try to find it between the many-to-many relationships
-		if(!aux_base_tab)
-			aux_base_tab=dynamic_cast<BaseTable *>(getRelNNTable(tab_name, source_model));
-	}
-	else if(diff_type==ObjectsDiffInfo::CreateObject || diff_type==ObjectsDiffInfo::AlterObject)
-	{
-		aux_base_tab=dynamic_cast<BaseTable *>(imported_model->getObject(tab_name, base_tab->getObjectType()));
-
-		//If the table was not found, try to find it between the many-to-many relationships
-		if(!aux_base_tab)
-			aux_base_tab=dynamic_cast<BaseTable *>(getRelNNTable(obj_name, imported_model));
-	}
-
-	if(aux_base_tab)
-	{
-		if(obj_type==ObjectType::Constraint)
-		{
-			PhysicalTable *aux_table=dynamic_cast<PhysicalTable *>(aux_base_tab);
-			aux_tab_obj=aux_table->getObject(obj_name, obj_type);
-		}
-		else
-			aux_tab_obj=aux_base_tab->getObject(obj_name, obj_type);
-	}
-
-	if(!aux_tab_obj)
+	if(!comp.aux_object)
 	{
 		if(diff_type!=ObjectsDiffInfo::DropObject ||
 			 (diff_type==ObjectsDiffInfo::DropObject && !diff_opts[OptDontDropMissingObjs]))
@@ -607,8 +794,8 @@ void ModelsDiffHelper::diffTableObject(TableObject *tab_obj, ObjectsDiffInfo::Di
 		else
 			generateDiffInfo(ObjectsDiffInfo::IgnoreObject, tab_obj);
 	}
-	else if(diff_type!=ObjectsDiffInfo::DropObject && tab_obj->isCodeDiffersFrom(aux_tab_obj, TableObjsIgnoredAttribs))
-		generateDiffInfo(ObjectsDiffInfo::AlterObject, tab_obj, aux_tab_obj);
+	else if(diff_type!=ObjectsDiffInfo::DropObject && comp.xml_differs)
+		generateDiffInfo(ObjectsDiffInfo::AlterObject, tab_obj, comp.aux_object);
 }
 
 BaseObject *ModelsDiffHelper::getRelNNTable(const QString &obj_name, DatabaseModel *model)
@@ -647,7 +834,7 @@ void ModelsDiffHelper::generateDiffInfo(ObjectsDiffInfo::DiffType diff_type, Bas
 					!isDiffInfoExists(ObjectsDiffInfo::CreateObject, object, nullptr))
 			{
 				diff_info=ObjectsDiffInfo(ObjectsDiffInfo::CreateObject, object, nullptr);
-				diff_infos.push_back(diff_info);
+				diff_infos.addDiffInfo(diff_info);
 				diffs_counter[ObjectsDiffInfo::CreateObject]++;
 				emit s_objectsDiffInfoGenerated(diff_info);
 			}
@@ -699,7 +886,7 @@ void ModelsDiffHelper::generateDiffInfo(ObjectsDiffInfo::DiffType diff_type, Bas
 							 (old_col->getSequence() && old_col->getSequence()->getSignature() != seq->getSignature()))))
 					{
 						diff_info=ObjectsDiffInfo(ObjectsDiffInfo::AlterObject, aux_col, col);
-						diff_infos.push_back(diff_info);
+						diff_infos.addDiffInfo(diff_info);
 						diffs_counter[ObjectsDiffInfo::AlterObject]++;
 						emit s_objectsDiffInfoGenerated(diff_info);
 					}
@@ -708,27 +895,23 @@ void ModelsDiffHelper::generateDiffInfo(ObjectsDiffInfo::DiffType diff_type, Bas
 					{
 						//Creates a CREATE info with the sequence
 						diff_info=ObjectsDiffInfo(ObjectsDiffInfo::CreateObject, seq, nullptr);
-						diff_infos.push_back(diff_info);
+						diff_infos.addDiffInfo(diff_info);
 						diffs_counter[ObjectsDiffInfo::CreateObject]++;
 						emit s_objectsDiffInfoGenerated(diff_info);
 					}
 					else if(diff_opts[OptReuseSequences])
 					{
 						//Removing DROP infos related to the sequence that will be reused
-						std::vector<ObjectsDiffInfo>::iterator itr=diff_infos.begin(),
-								itr_end=diff_infos.end();
-
-						while(itr!=itr_end)
+						for(unsigned idx : diff_infos.getDiffInfosIndexes(ObjectsDiffInfo::DropObject))
 						{
-							if(itr->getDiffType()==ObjectsDiffInfo::DropObject &&
-									itr->getObject()->getObjectType()==ObjectType::Sequence &&
-									itr->getObject()->getSignature()==seq->getSignature())
+							ObjectsDiffInfo &drop_info = diff_infos.getDiffInfo(idx);
+
+							if(drop_info.getObject()->getObjectType()==ObjectType::Sequence &&
+									drop_info.getObject()->getSignature()==seq->getSignature())
 							{
-								diff_infos.erase(itr);
+								diff_infos.removeDiffInfo(idx);
 								break;
 							}
-
-							itr++;
 						}
 					}
 
@@ -740,7 +923,7 @@ void ModelsDiffHelper::generateDiffInfo(ObjectsDiffInfo::DiffType diff_type, Bas
 				else
 				{
 					diff_info=ObjectsDiffInfo(diff_type, object, old_object);
-					diff_infos.push_back(diff_info);
+					diff_infos.addDiffInfo(diff_info);
 					diffs_counter[diff_type]++;
 					emit s_objectsDiffInfoGenerated(diff_info);
 				}
@@ -779,22 +962,7 @@ void ModelsDiffHelper::generateDiffInfo(ObjectsDiffInfo::DiffType diff_type, Bas
 
 bool ModelsDiffHelper::isDiffInfoExists(ObjectsDiffInfo::DiffType  diff_type, BaseObject *object, BaseObject *old_object, bool exact_match)
 {
-	bool found_diff=false;
-	ObjectsDiffInfo aux_diff(diff_type, object, old_object);
-
-	for(ObjectsDiffInfo diff : diff_infos)
-	{
-		if((exact_match && diff==aux_diff) ||
-				(!exact_match &&
-				 ((object && diff.getObject()==object) ||
-				  (old_object && diff.getOldObject()==old_object))))
-		{
-			found_diff=true;
-			break;
-		}
-	}
-
-	return found_diff;
+	return diff_infos.isDiffInfoExists(diff_type, object, old_object, exact_match);
 }
 
 void ModelsDiffHelper::processDiffInfos()
@@ -818,6 +986,8 @@ void ModelsDiffHelper::processDiffInfos()
 	PhysicalTable *parent_tab=nullptr;
 	bool skip_obj=false;
 	QStringList sch_names;
+	QString diff_file;
+	std::map<QString, std::vector<const QString *>> sections;
 
 	try
 	{
@@ -1026,6 +1196,7 @@ void ModelsDiffHelper::processDiffInfos()
 			col_drop_def+=getSourceCode(col, true);
 
 		diff_def.clear();
+		has_diff_code=false;
 
 		if(!drop_objs.empty() || !create_objs.empty() || !alter_objs.empty() ||
 			 !create_fks.empty() || !create_constrs.empty() || !inherit_def.isEmpty() ||
@@ -1047,51 +1218,107 @@ void ModelsDiffHelper::processDiffInfos()
 			attribs[Attributes::Change]=QString::number(alter_objs.size());
 			attribs[Attributes::Create]=QString::number(create_objs_count);
 			attribs[Attributes::Drop]=QString::number(drop_objs.size());
-			attribs[Attributes::AlterCmds]="";
-			attribs[Attributes::DropCmds]="";
-			attribs[Attributes::CreateCmds]="";
-			attribs[Attributes::ConstrDefs]="";
-			attribs[Attributes::FkDefs]="";
-			attribs[Attributes::UnsetPerms]=unset_perms;
-			attribs[Attributes::SetPerms]=set_perms;
 			attribs[Attributes::Function]=(has_diffs && source_model->getObjectCount(ObjectType::Function)!=0 ? Attributes::True : "");
 			attribs[Attributes::SearchPath]=(has_diffs ? sch_names.join(',') : "");
 
+			/* Gathering the code of each section of the diff script. The code pieces are referenced
+			 * instead of copied so the script isn't duplicated in memory when written to diff_output */
+			sections[Attributes::UnsetPerms].push_back(&unset_perms);
+			sections[Attributes::DropCmds].push_back(&no_inherit_def);
+
 			ritr=drop_objs.rbegin();
 			ritr_end=drop_objs.rend();
 
-			attribs[Attributes::DropCmds]+=no_inherit_def;
-
 			while(ritr!=ritr_end)
 			{
-				attribs[Attributes::DropCmds]+=ritr->second;
+				sections[Attributes::DropCmds].push_back(&ritr->second);
 				ritr++;
 			}
 
-			attribs[Attributes::DropCmds]+=col_drop_def;
-
+			sections[Attributes::DropCmds].push_back(&col_drop_def);
 
 			for(auto &itr : create_objs)
-				attribs[Attributes::CreateCmds]+=itr.second;
+				sections[Attributes::CreateCmds].push_back(&itr.second);
 
-			attribs[Attributes::CreateCmds]+=inherit_def;
+			sections[Attributes::CreateCmds].push_back(&inherit_def);
 
 			for(auto &itr : create_constrs)
-				attribs[Attributes::ConstrDefs]+=itr.second;
+				sections[Attributes::ConstrDefs].push_back(&itr.second);
 
 			for(auto &itr : create_fks)
-				attribs[Attributes::FkDefs]+=itr.second;
+				sections[Attributes::FkDefs].push_back(&itr.second);
 
 			for(auto &itr : alter_objs)
-				attribs[Attributes::AlterCmds]+=itr.second;
+				sections[Attributes::AlterCmds].push_back(&itr.second);
+
+			sections[Attributes::SetPerms].push_back(&set_perms);
 
-			//Generating the whole diff buffer
 			schparser.setPgSQLVersion(pgsql_version);
-			diff_def=schparser.getSourceCode(GlobalAttributes::getSchemaFilePath(GlobalAttributes::AlterSchemaDir, Attributes::Diff),
-																					 attribs);
+			diff_file=GlobalAttributes::getSchemaFilePath(GlobalAttributes::AlterSchemaDir, Attributes::Diff);
+
+			if(!diff_output)
+			{
+				for(auto &itr : sections)
+				{
+					attribs[itr.first]="";
+
+					for(auto &code : itr.second)
+						attribs[itr.first]+=*code;
+				}
+
+				//Generating the whole diff buffer
+				diff_def=schparser.getSourceCode(diff_file, attribs);
+			}
+			else
+			{
+				QTextStream out(diff_output);
+				std::map<int, QString> sections_pos;
+				QString diff_tmpl;
+				int pos=0;
+
+				emit s_progressUpdated(100, tr("Writing diff code..."));
+
+				/* The diff schema file is parsed using placeholders in place of the sections' code
+				 * resulting in a small template. The template is then written to the output replacing
+				 * each placeholder by the code pieces of the respective section */
+				for(auto &itr : sections)
+				{
+					bool has_code=std::any_of(itr.second.begin(), itr.second.end(),
+																		[](const QString *code){ return !code->isEmpty(); });
+
+					attribs[itr.first]=(has_code ? QString("%1%2%1").arg(QChar(QChar::ParagraphSeparator), itr.first) : "");
+				}
+
+				diff_tmpl=schparser.getSourceCode(diff_file, attribs);
+
+				for(auto &itr : sections)
+				{
+					pos=(attribs[itr.first].isEmpty() ? -1 : diff_tmpl.indexOf(attribs[itr.first]));
+
+					if(pos >= 0)
+						sections_pos[pos]=itr.first;
+				}
+
+				pos=0;
+
+				for(auto &itr : sections_pos)
+				{
+					out << diff_tmpl.mid(pos, itr.first - pos);
+
+					for(auto &code : sections[itr.second])
+						out << *code;
+
+					pos=itr.first + attribs[itr.second].size();
+				}
+
+				out << diff_tmpl.mid(pos);
+				out.flush();
+			}
+
+			has_diff_code=true;
 		}
 
-		if(diff_def.isEmpty())
+		if(!has_diff_code)
 			emit s_progressUpdated(100, tr("No differences detected."));
 		else
 			emit s_progressUpdated(100, tr("Preparing diff code..."));
@@ -26,8 +26,9 @@
 #define MODELS_DIFF_HELPER_H
 
 #include <QObject>
+#include <atomic>
 #include "databasemodel.h"
-#include "objectsdiffinfo.h"
+#include "objectsdiffinfolist.h"
 
 class __libgui ModelsDiffHelper: public QObject {
 	private:
@@ -51,8 +52,12 @@ class __libgui ModelsDiffHelper: public QObject {
 		//! \brief PostgreSQL version used to generate the diff
 		pgsql_version;
 
-		//! \brief Indicates if the diff was cancelled by user
-		bool diff_canceled,
+		/*! \brief Indicates if the diff was cancelled by user. It's written by the thread that cancels the
+		 * diff and read by the worker threads of the parallel comparison, so it's atomic */
+		std::atomic_bool diff_canceled;
+
+		//! \brief Indicates if the last diff process generated SQL code (stored in diff_def or written to diff_output)
+		bool has_diff_code,
 
 		//!brief Diff options. See OPT_??? constants
 		diff_opts[10];
@@ -66,8 +71,14 @@ class __libgui ModelsDiffHelper: public QObject {
 		//! \brief Model which is compared to the source one
 		*imported_model;
 
-		//! \brief Stores all generated diff information during the process
-		std::vector<ObjectsDiffInfo> diff_infos;
+		/*! \brief Device in which the diff code is written while it's composed. When this device is set
+		 * the code isn't held in diff_def, avoiding keeping the whole script in memory (see setDiffOutput()) */
+		QIODevice *diff_output;
+
+		/*! \brief Stores all generated diff information during the process. The infos are indexed
+		 * so existence checks don't need to scan the whole list, but they are kept in the order they
+		 * were generated since that's the order in which the SQL code is emitted */
+		ObjectsDiffInfoList diff_infos;
 
 		//! \brief Stores all temporary objects created during the diff process
 		std::vector<BaseObject *> tmp_objects;
@@ -75,6 +86,30 @@ class __libgui ModelsDiffHelper: public QObject {
 		//! \brief Stores all objects filtered by the partial diff filters
 		std::map<unsigned, BaseObject *> filtered_objs;
 
+		//! \brief Stores the result of the comparison between an object and its counterpart in the other model
+		struct ObjectComparison {
+			//! \brief The object's counterpart in the other model (null if it doesn't exist there)
+			BaseObject *aux_object = nullptr;
+
+			//! \brief Lists of XML attributes and tags ignored when comparing the objects' code
+			const QStringList *ignored_attribs = nullptr, *ignored_tags = nullptr;
+
+			//! \brief Indicates that the comparison was already done for the object
+			bool computed = false,
+
+			//! \brief Indicates that the basic attributes (schema, owner, tablespace, comment) of the objects differ
+			objs_differs = false,
+
+			//! \brief Indicates that the XML code of the objects differ
+			xml_differs = false,
+
+			//! \brief Indicates that the XML code was generated but still needs to be compared (parallel mode only)
+			xml_cmp_pending = false;
+
+			//! \brief The XML code of both objects held until a worker compares them (parallel mode only)
+			QString obj_code, aux_code;
+		};
+
 		/*! note The parameter diff_type in any methods below is one of the values in
 		ObjectsDiffInfo::CreateObject|AlterObject|DropObject */
 
@@ -84,9 +119,29 @@ class __libgui ModelsDiffHelper: public QObject {
 		//! \brief Compares the two models storing the diff between them in the diff_infos vector.
 		void diffModels(ObjectsDiffInfo::DiffType diff_type);
 
-		/*! \brief Compares the specified table object against the ones on the source model or imported
-		model depending on the diff_type parameter. */
-		void diffTableObject(TableObject *tab_obj, ObjectsDiffInfo::DiffType diff_type);
+		/*! \brief Generates the diff info for the specified table object based upon the result of its comparison
+		against the ones on the source model or imported model (see compareTableObjects()) */
+		void diffTableObject(TableObject *tab_obj, ObjectsDiffInfo::DiffType diff_type, const ObjectComparison &comp);
+
+		//! \brief Returns if the object must be ignored in the current diff step (system objects, sql disabled ones, etc)
+		bool isObjectDiscarded(BaseObject *object, ObjectsDiffInfo::DiffType diff_type);
+
+		//! \brief Returns if the object is compared against its counterpart in the other model via compareObjects/compareTableObjects
+		bool isObjectComparable(BaseObject *object);
+
+		/*! \brief Retrieves the counterpart of the object in aux_model and compares both. If defer_xml_cmp is true
+		 * the XML code of the objects is only generated and stored in comp so the comparison can be done later by a worker thread */
+		void compareObjects(BaseObject *object, DatabaseModel *aux_model, ObjectsDiffInfo::DiffType diff_type, ObjectComparison &comp, bool defer_xml_cmp);
+
+		/*! \brief Retrieves the counterpart of the table object on the source model or imported model
+		 * (depending on the diff_type parameter) and compares both. See compareObjects() */
+		void compareTableObjects(TableObject *tab_obj, ObjectsDiffInfo::DiffType diff_type, ObjectComparison &comp, bool defer_xml_cmp);
+
+		/*! \brief Compares all objects in the provided list against their counterparts in aux_model. The objects' code is generated
+		 * in the calling thread (code generation isn't thread safe) and the XML comparisons are partitioned by schema and object type
+		 * and done in a pool of worker threads. The returned vector has the results in the same positions of the objects in the list */
+		std::vector<ObjectComparison> compareObjectsInParallel(const std::vector<BaseObject *> &objects, DatabaseModel *aux_model,
+																													 ObjectsDiffInfo::DiffType diff_type, double prog, double factor);
 
 		/*! \brief Compares the two tables' columns and if needed generates the CREATE statments for the missing ones in child_tab.
 		 * This is used when a new inheritance relationship is detected between two tables that previously were not parent and child.
@@ -152,7 +207,11 @@ class __libgui ModelsDiffHelper: public QObject {
 			/*! \brief Indicates to generate and execute commands to drop missing columns and constraints. For instance, if user
 			try to diff a partial model against the original database and the OPT_DONT_DROP_MISSING_OBJS is set, DROP commands will not be generated,
 			except for columns and constraints. This option is only considered in the process when OPT_DONT_DROP_MISSING_OBJS is enabled. */
-			OptDropMissingColsConstr
+			OptDropMissingColsConstr,
+
+			/*! \brief Indicates to compare the objects' code using a pool of worker threads. The generated
+			diff is the same as the one produced when this option is disabled */
+			OptParallelComparison
 		};
 
 		ModelsDiffHelper();
@@ -192,6 +251,15 @@ class __libgui ModelsDiffHelper: public QObject {
 		//! \brief Returns the diff containing all the SQL commands needed to synchronize the model and database
 		QString getDiffDefinition();
 
+		/*! \brief Defines the device in which the diff code is written while it's composed, e.g. a file or a buffer to be
+		 * consumed by the export process. The device must be opened for writing by the caller and the code is written from
+		 * the current position on. When a device is set getDiffDefinition() returns an empty string.
+		 * Passing a null device makes the diff code to be held in memory again */
+		void setDiffOutput(QIODevice *output);
+
+		//! \brief Returns true when the last diff process generated SQL code to synchronize the model and database
+		bool hasDiffCode();
+
 	public slots:
 		void diffModels();
 		void cancelDiff();
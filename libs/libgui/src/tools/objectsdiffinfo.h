@@ -58,6 +58,7 @@ class __libgui ObjectsDiffInfo {
 		bool operator == (ObjectsDiffInfo &info);
 
 		friend class ModelsDiffHelper;
+		friend class ObjectsDiffInfoList;
 		friend class QVariant;
 };
 
@@ -0,0 +1,148 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "objectsdiffinfolist.h"
+#include <algorithm>
+
+size_t ObjectsDiffInfoList::DiffInfoKeyHash::operator()(const DiffInfoKey &key) const
+{
+	std::hash<BaseObject *> ptr_hash;
+	size_t seed = std::hash<unsigned>()(key.diff_type);
+
+	// Combining the hashes of the key members (same strategy as boost::hash_combine)
+	seed ^= ptr_hash(key.object) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	seed ^= ptr_hash(key.old_object) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+
+	return seed;
+}
+
+template<class Index, class Key>
+void ObjectsDiffInfoList::decrementIndex(Index &index, const Key &key)
+{
+	auto itr = index.find(key);
+
+	if(itr == index.end())
+		return;
+
+	if(itr->second <= 1)
+		index.erase(itr);
+	else
+		itr->second--;
+}
+
+void ObjectsDiffInfoList::addDiffInfo(const ObjectsDiffInfo &diff_info)
+{
+	if(diff_info.diff_type >= ObjectsDiffInfo::NoDifference)
+		throw Exception(ErrorCode::RefElementInvalidIndex ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	type_buckets[diff_info.diff_type].push_back(diff_infos.size());
+	diff_infos.push_back(diff_info);
+	infos_index[DiffInfoKey(diff_info.diff_type, diff_info.object, diff_info.old_object)]++;
+
+	if(diff_info.object)
+		objects_index[diff_info.object]++;
+
+	if(diff_info.old_object)
+		old_objects_index[diff_info.old_object]++;
+}
+
+void ObjectsDiffInfoList::removeDiffInfo(unsigned idx)
+{
+	if(idx >= diff_infos.size())
+		throw Exception(ErrorCode::RefElementInvalidIndex ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	ObjectsDiffInfo &diff_info = diff_infos[idx];
+	std::vector<unsigned> &bucket = type_buckets[diff_info.diff_type];
+
+	decrementIndex(infos_index, DiffInfoKey(diff_info.diff_type, diff_info.object, diff_info.old_object));
+
+	if(diff_info.object)
+		decrementIndex(objects_index, diff_info.object);
+
+	if(diff_info.old_object)
+		decrementIndex(old_objects_index, diff_info.old_object);
+
+	bucket.erase(std::find(bucket.begin(), bucket.end(), idx));
+	diff_infos.erase(diff_infos.begin() + idx);
+
+	// Shifting the positions stored in the buckets that pointed to the infos after the removed one
+	for(auto &bkt : type_buckets)
+	{
+		for(auto &pos : bkt)
+		{
+			if(pos > idx)
+				pos--;
+		}
+	}
+}
+
+bool ObjectsDiffInfoList::isDiffInfoExists(ObjectsDiffInfo::DiffType diff_type, BaseObject *object, BaseObject *old_object, bool exact_match) const
+{
+	if(exact_match)
+		return infos_index.count(DiffInfoKey(diff_type, object, old_object)) != 0;
+
+	return (object && objects_index.count(object) != 0) ||
+				 (old_object && old_objects_index.count(old_object) != 0);
+}
+
+ObjectsDiffInfo &ObjectsDiffInfoList::getDiffInfo(unsigned idx)
+{
+	if(idx >= diff_infos.size())
+		throw Exception(ErrorCode::RefElementInvalidIndex ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	return diff_infos[idx];
+}
+
+const std::vector<unsigned> &ObjectsDiffInfoList::getDiffInfosIndexes(ObjectsDiffInfo::DiffType diff_type) const
+{
+	if(diff_type >= ObjectsDiffInfo::NoDifference)
+		throw Exception(ErrorCode::RefElementInvalidIndex ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	return type_buckets[diff_type];
+}
+
+size_t ObjectsDiffInfoList::size() const
+{
+	return diff_infos.size();
+}
+
+bool ObjectsDiffInfoList::empty() const
+{
+	return diff_infos.empty();
+}
+
+void ObjectsDiffInfoList::clear()
+{
+	diff_infos.clear();
+	infos_index.clear();
+	objects_index.clear();
+	old_objects_index.clear();
+
+	for(auto &bkt : type_buckets)
+		bkt.clear();
+}
+
+ObjectsDiffInfoList::iterator ObjectsDiffInfoList::begin()
+{
+	return diff_infos.begin();
+}
+
+ObjectsDiffInfoList::iterator ObjectsDiffInfoList::end()
+{
+	return diff_infos.end();
+}
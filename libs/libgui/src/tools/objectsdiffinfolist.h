@@ -0,0 +1,102 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libgui
+\class ObjectsDiffInfoList
+\brief Stores the diff infos generated by ModelsDiffHelper keeping their original insertion order
+(which is the order the SQL code is emitted) while indexing them by (diff type, object, old object)
+and by diff type so the existence checks done during the diff process run in constant time.
+*/
+
+#ifndef OBJECTS_DIFF_INFO_LIST_H
+#define OBJECTS_DIFF_INFO_LIST_H
+
+#include "objectsdiffinfo.h"
+#include <unordered_map>
+
+class __libgui ObjectsDiffInfoList {
+	private:
+		//! \brief Key used to index a diff info by its diff type and the objects involved
+		struct DiffInfoKey {
+			unsigned diff_type;
+			BaseObject *object, *old_object;
+
+			DiffInfoKey(unsigned _diff_type, BaseObject *_object, BaseObject *_old_object) :
+				diff_type(_diff_type), object(_object), old_object(_old_object) {}
+
+			bool operator == (const DiffInfoKey &key) const
+			{
+				return diff_type == key.diff_type &&
+							 object == key.object && old_object == key.old_object;
+			}
+		};
+
+		struct DiffInfoKeyHash {
+			size_t operator()(const DiffInfoKey &key) const;
+		};
+
+		//! \brief Stores the diff infos in the same order they were added
+		std::vector<ObjectsDiffInfo> diff_infos;
+
+		//! \brief Stores the indexes (in diff_infos) of the infos of each diff type
+		std::vector<unsigned> type_buckets[ObjectsDiffInfo::NoDifference];
+
+		//! \brief Stores the amount of infos registered for each (diff type, object, old object)
+		std::unordered_map<DiffInfoKey, unsigned, DiffInfoKeyHash> infos_index;
+
+		/*! \brief Stores the amount of infos that reference an object as the main object (objects_index)
+		 * or as the old object (old_objects_index). Used by the non exact match existence check */
+		std::unordered_map<BaseObject *, unsigned> objects_index,	old_objects_index;
+
+		//! \brief Decrements the counter of the key in the provided index removing it if the counter reaches zero
+		template<class Index, class Key>
+		static void decrementIndex(Index &index, const Key &key);
+
+	public:
+		using iterator = std::vector<ObjectsDiffInfo>::iterator;
+
+		ObjectsDiffInfoList() {}
+
+		//! \brief Appends a diff info at the end of the list indexing it
+		void addDiffInfo(const ObjectsDiffInfo &diff_info);
+
+		/*! \brief Removes the diff info in the provided position. Since the insertion order must be preserved
+		 * this operation costs linear time, so it must be used only in exceptional cases */
+		void removeDiffInfo(unsigned idx);
+
+		/*! \brief Returns if a diff information exists for the object. The exact_match parameter is used to force the
+		comparison of all values on the paramenter against the diff infos. When false the exact_match parameter
+		considers one of parameters object or old_object to be used (if not null) regardless the diff type */
+		bool isDiffInfoExists(ObjectsDiffInfo::DiffType diff_type, BaseObject *object, BaseObject *old_object, bool exact_match = true) const;
+
+		//! \brief Returns the diff info in the provided position
+		ObjectsDiffInfo &getDiffInfo(unsigned idx);
+
+		//! \brief Returns the positions of all diff infos of the specified type in the order they were added
+		const std::vector<unsigned> &getDiffInfosIndexes(ObjectsDiffInfo::DiffType diff_type) const;
+
+		size_t size() const;
+		bool empty() const;
+		void clear();
+
+		iterator begin();
+		iterator end();
+};
+
+#endif
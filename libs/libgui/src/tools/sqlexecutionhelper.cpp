@@ -17,11 +17,15 @@
 */
 
 #include "sqlexecutionhelper.h"
+#include <QCoreApplication>
 
 SQLExecutionHelper::SQLExecutionHelper() : QObject(nullptr)
 {
-	cancelled = false;
+	cancelled = rows_failed = false;
 	result_model = nullptr;
+	async_cmd = nullptr;
+	rows_page_size = rows_fetch_limit = 0;
+	cmd_start_time = 0;
 }
 
 void SQLExecutionHelper::setConnection(Connection conn)
@@ -34,6 +38,11 @@ void SQLExecutionHelper::setCommand(const QString &cmd)
 	command = cmd;
 }
 
+void SQLExecutionHelper::setRowsPageSize(unsigned page_size)
+{
+	rows_page_size = page_size;
+}
+
 ResultSetModel *SQLExecutionHelper::getResultSetModel()
 {
 	return result_model;
@@ -49,17 +58,44 @@ QStringList SQLExecutionHelper::getNotices()
 	return notices;
 }
 
+SQLExecutionStats SQLExecutionHelper::getExecutionStats()
+{
+	SQLExecutionStats stats = exec_stats;
+
+	// The streamed rows may still be appended to the model in the main thread, so its memory usage is read on demand
+	if(result_model)
+		stats.peak_model_memory = result_model->getPeakMemoryUsage();
+
+	return stats;
+}
+
+void SQLExecutionHelper::updateExecutionStats(AsyncCommand &cmd, unsigned rows)
+{
+	// The times collected by the command are relative to its start, which happens after the connection is opened
+	auto to_msecs = [this](qint64 usecs) {
+		return usecs < 0 ? -1 : ((cmd_start_time / 1000) + usecs) / 1000.0;
+	};
+
+	exec_stats.send_time = to_msecs(cmd.getSendTime());
+	exec_stats.first_byte_time = to_msecs(cmd.getFirstByteTime());
+	exec_stats.last_byte_time = to_msecs(cmd.getLastByteTime());
+	exec_stats.received_bytes = cmd.getReceivedBytes();
+	exec_stats.row_count = rows;
+}
+
 void SQLExecutionHelper::executeCommand()
 {
 	try
 	{
-		ResultSet res;
-		Catalog catalog;
-		Connection aux_conn = Connection(connection.getConnectionParams());
-
-		catalog.setConnection(aux_conn);
 		result_model = nullptr;
-		cancelled = false;
+		cancelled = rows_failed = false;
+		rows_fetch_limit = rows_page_size;
+
+		exec_stats = SQLExecutionStats();
+		exec_stats.conn_id = connection.getConnectionId(true, true);
+		exec_stats.command = command;
+		exec_stats.start_time = QDateTime::currentDateTime();
+		exec_timer.start();
 
 		if(!connection.isStablished())
 		{
@@ -70,12 +106,172 @@ void SQLExecutionHelper::executeCommand()
 			connection.setSQLExecutionTimout(3600);
 		}
 
-		connection.executeDMLCommand(command, res);
+		exec_stats.connect_time = exec_timer.nsecsElapsed() / 1000000.0;
+
+		/* The command runs asynchronously so the thread's event loop stays responsive while the
+		 * server processes it. The execution is finished in handleCommandFinished() */
+		async_cmd = new AsyncCommand(connection, this);
+
+		/* The rows of single statement commands are streamed so the first ones can be displayed while the
+		 * others are being received. Commands holding several statements are executed at once since only the
+		 * result of the last statement is displayed */
+		if(Connection::isSingleStatement(command))
+			async_cmd->setRowsBatchSize(RowsBatchSize);
+
+		connect(async_cmd, &AsyncCommand::s_rowsFetched, this, &SQLExecutionHelper::handleRowsFetched);
+		connect(async_cmd, &AsyncCommand::s_commandFinished, this, [this](){
+			AsyncCommand *cmd = async_cmd;
+
+			async_cmd = nullptr;
+			handleCommandFinished(*cmd);
+			cmd->deleteLater();
+		});
+
+		cmd_start_time = exec_timer.nsecsElapsed();
+		async_cmd->start(command);
+	}
+	catch(Exception &e)
+	{
+		if(async_cmd)
+		{
+			async_cmd->deleteLater();
+			async_cmd = nullptr;
+		}
+
+		connection.close();
+		emit s_executionAborted(e);
+	}
+}
+
+void SQLExecutionHelper::createResultSetModel(ResultSet &res, bool conn_idle)
+{
+	std::vector<unsigned> type_ids;
+
+	for(int col = 0; col < res.getColumnCount(); col++)
+		type_ids.push_back(res.getColumnTypeId(col));
+
+	result_model = new ResultSetModel(res, Catalog::getTypeNames(connection, type_ids, !conn_idle));
+
+	// The model is displayed, and receives the streamed rows, in the main thread
+	result_model->moveToThread(QCoreApplication::instance()->thread());
+	connect(result_model, &ResultSetModel::s_fetchMoreRequested, this, &SQLExecutionHelper::fetchMoreRows);
+}
+
+void SQLExecutionHelper::handleRowsFetched(ResultSet &rows)
+{
+	// Rows received after a cancel request or a failure are discarded
+	if(cancelled || rows_failed || !async_cmd)
+		return;
+
+	try
+	{
+		QElapsedTimer build_timer;
+
+		build_timer.start();
+
+		if(!result_model)
+		{
+			createResultSetModel(rows, false);
+			exec_stats.model_build_time += build_timer.nsecsElapsed() / 1000000.0;
+			emit s_resultModelReady();
+		}
+		else
+		{
+			result_model->queueTuples(rows);
+			exec_stats.model_build_time += build_timer.nsecsElapsed() / 1000000.0;
+		}
+
+		// The stream is paused when the page is filled until the user requests more rows
+		if(rows_fetch_limit > 0 && async_cmd->getFetchedRowCount() >= rows_fetch_limit)
+		{
+			async_cmd->pauseFetching();
+			result_model->setFetchMoreEnabled(true);
+			emit s_fetchPaused(async_cmd->getFetchedRowCount());
+		}
+	}
+	catch(Exception &e)
+	{
+		// The error is raised when the command finishes (see handleCommandFinished())
+		rows_failed = true;
+		rows_error = Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+		async_cmd->cancel();
+	}
+}
+
+void SQLExecutionHelper::fetchMoreRows()
+{
+	if(!async_cmd || !async_cmd->isFetchPaused())
+		return;
+
+	rows_fetch_limit = async_cmd->getFetchedRowCount() + rows_page_size;
+	async_cmd->resumeFetching();
+}
+
+void SQLExecutionHelper::handleCommandFinished(AsyncCommand &cmd)
+{
+	static const QRegularExpression ddl_regexp("\\b(CREATE|ALTER|DROP|IMPORT)\\b", QRegularExpression::CaseInsensitiveOption);
+
+	try
+	{
+		/* Commands that may have created, renamed or dropped types discard the cached type names of the
+		 * database, even if they failed since a script can have executed some of its statements */
+		Catalog::invalidateTypeNames(connection, command);
+
+		//The same goes for the objects cached by the database explorers
+		if(command.contains(ddl_regexp))
+			Catalog::invalidateObjectsNames(connection);
+
+		if(rows_failed)
+			throw Exception(rows_error.getErrorMessage(), rows_error.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &rows_error);
+
+		if(result_model)
+			result_model->setFetchMoreEnabled(false);
+
+		// Cancelling a stream of results keeps the rows fetched so far
+		if(cmd.getStatus() == AsyncCommand::Cancelled && result_model)
+		{
+			notices = connection.getNotices();
+			updateExecutionStats(cmd, cmd.getFetchedRowCount());
+			emit s_executionFinished(cmd.getFetchedRowCount());
+			return;
+		}
+
+		if(cmd.getStatus() != AsyncCommand::Finished)
+		{
+			Exception error = cmd.getError();
+			throw Exception(error.getErrorMessage(), error.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &error);
+		}
+
+		ResultSet &res = cmd.getResult();
+
 		notices = connection.getNotices();
 
-		if(!res.isEmpty())
-			result_model = new ResultSetModel(res, catalog);
+		// When the rows were streamed the final result holds only the columns of the query
+		if(result_model)
+		{
+			ResultSetModel *model = result_model;
+			std::map<unsigned, QString> type_names = Catalog::getTypeNames(connection, model->getColumnTypeIds());
+
+			// The type names not cached when the model was created are retrieved now that the connection is idle
+			QMetaObject::invokeMethod(model, [model, type_names](){
+				model->setTypeNames(type_names);
+			}, Qt::QueuedConnection);
+
+			updateExecutionStats(cmd, cmd.getFetchedRowCount());
+			emit s_executionFinished(cmd.getFetchedRowCount());
+			return;
+		}
+
+		if(res.isValid() && !res.isEmpty())
+		{
+			QElapsedTimer build_timer;
 
+			build_timer.start();
+			createResultSetModel(res, true);
+			exec_stats.model_build_time += build_timer.nsecsElapsed() / 1000000.0;
+		}
+
+		updateExecutionStats(cmd, res.getTupleCount());
 		emit s_executionFinished(res.getTupleCount());
 	}
 	catch(Exception &e)
@@ -89,7 +285,13 @@ void SQLExecutionHelper::cancelCommand()
 {
 	if(connection.isStablished())
 	{
-		connection.requestCancel();
 		cancelled = true;
+
+		/* This method is called from other threads (see SQLExecutionWidget) so the cancellation
+		 * is done in the helper's thread, resuming the stream of results if it's paused */
+		QMetaObject::invokeMethod(this, [this](){
+			if(async_cmd)
+				async_cmd->cancel();
+		}, Qt::QueuedConnection);
 	}
 }
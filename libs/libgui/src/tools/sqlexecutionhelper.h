@@ -28,24 +28,106 @@
 #include <QObject>
 #include <QTableWidget>
 #include "connection.h"
+#include "asynccommand.h"
 #include "utils/resultsetmodel.h"
+#include <QElapsedTimer>
+#include <QDateTime>
+
+/*! \brief Holds the client-side latency breakdown of a command executed by SQLExecutionHelper. The stages are given as the moment
+ * (in milliseconds since the start of the execution) in which they were reached, so the time spent in a stage is the gap to the previous one.
+ * The connection and model build times are durations instead. A negative value means that the stage was not reached */
+struct SQLExecutionStats {
+	//! \brief Connection identifier (see Connection::getConnectionId()) and the executed command
+	QString conn_id, command;
+
+	QDateTime start_time;
+
+	//! \brief Time spent opening the connection (or leasing it from the pool). Zero when the connection was already open
+	double connect_time = -1,
+
+	//! \brief Moment in which the whole command was sent to the server
+	send_time = -1,
+
+	//! \brief Moment in which the first data of the results was available to be read
+	first_byte_time = -1,
+
+	//! \brief Moment in which the last result was received (including the time the fetching was paused waiting the user to request more rows)
+	last_byte_time = -1,
+
+	//! \brief Time spent converting the received rows into the result model
+	model_build_time = 0,
+
+	//! \brief Moment in which the results grid was painted for the first time after receiving the results (see SQLExecutionWidget)
+	first_paint_time = -1;
+
+	unsigned row_count = 0;
+
+	//! \brief Size of the values received (see AsyncCommand::getReceivedBytes()) and the peak memory used by the result model
+	qint64 received_bytes = 0, peak_model_memory = 0;
+};
 
 class __libgui SQLExecutionHelper : public QObject {
 	private:
 		Q_OBJECT
 
+		//! \brief Amount of rows received from the server at once when the results are streamed
+		static constexpr unsigned RowsBatchSize = 500;
+
 		Connection connection;
 
 		QString command;
 
 		ResultSetModel *result_model;
 
-		bool cancelled;
+		//! \brief Command being executed
+		AsyncCommand *async_cmd;
+
+		bool cancelled,
+
+		//! \brief Indicates that the streamed rows could not be handled (see rows_error)
+		rows_failed;
+
+		//! \brief Error raised while handling the streamed rows, redirected when the command finishes
+		Exception rows_error;
 
 		int affected_rows;
 
+		/*! \brief Amount of rows fetched before pausing the stream of results until the user requests more rows
+		 *  (by scrolling the results to the end). Zero means that all rows are fetched at once */
+		unsigned rows_page_size,
+
+		//! \brief Amount of rows after which the stream of results is paused
+		rows_fetch_limit;
+
 		QStringList notices;
 
+		//! \brief Measures the time elapsed since the start of the current execution
+		QElapsedTimer exec_timer;
+
+		//! \brief Moment (in nanoseconds since the start of the execution) in which the command was started
+		qint64 cmd_start_time;
+
+		//! \brief Latency breakdown of the current (or last) execution
+		SQLExecutionStats exec_stats;
+
+		//! \brief Stores in the execution stats the timings collected by the command and the amount of rows retrieved or affected
+		void updateExecutionStats(AsyncCommand &cmd, unsigned rows);
+
+		/*! \brief Creates the result model from the provided result set moving it to the main thread. The names of the
+		 * columns types are taken from the cache shared by the connections to the same database (see Catalog::getTypeNames()).
+		 * The missing names are retrieved through the helper's connection only when conn_idle is true */
+		void createResultSetModel(ResultSet &res, bool conn_idle);
+
+		//! \brief Creates the result model from the result of the executed command and emits the proper signal
+		void handleCommandFinished(AsyncCommand &cmd);
+
+	private slots:
+		//! \brief Appends the rows streamed by the command to the result model pausing the stream when the page is filled
+		void handleRowsFetched(ResultSet &rows);
+
+		//! \brief Resumes the stream of results paused after a page is filled
+		void fetchMoreRows();
+
 	public:
 		SQLExecutionHelper();
 
@@ -53,6 +135,10 @@ class __libgui SQLExecutionHelper : public QObject {
 
 		void setCommand(const QString &cmd);
 
+		/*! \brief Defines the amount of rows fetched before pausing the results streaming (see rows_page_size).
+		 * This setting affects only commands holding a single statement */
+		void setRowsPageSize(unsigned page_size);
+
 		//! \brief Returns the result set model created in the execution. This object is not deleted after the execution.
 		ResultSetModel *getResultSetModel();
 
@@ -61,12 +147,22 @@ class __libgui SQLExecutionHelper : public QObject {
 		//! \brief Returns the notices generated by the execution
 		QStringList getNotices();
 
+		/*! \brief Returns the latency breakdown of the last execution. The first paint time is not filled by the helper.
+		 * The peak memory of the result model is read at the moment this method is called */
+		SQLExecutionStats getExecutionStats();
+
 	public slots:
 		void executeCommand();
 		void cancelCommand();
 
 	signals:
 		void s_executionFinished(int rows_affected);
+
+		//! \brief Signal emitted when the first rows of the results are fetched and the result model is ready to be displayed
+		void s_resultModelReady();
+
+		//! \brief Signal emitted when the stream of results is paused after fetching a page of rows
+		void s_fetchPaused(int rows_fetched);
 		void s_executionAborted(Exception e);
 };
 
@@ -24,10 +24,17 @@
 #include "utils/plaintextitemdelegate.h"
 #include "datamanipulationform.h"
 #include "utilsns.h"
+#include "sqlstatementsplitter.h"
+#include <QElapsedTimer>
+#include <QMimeData>
+#include <QBuffer>
 
 std::map<QString, QString> SQLExecutionWidget::cmd_history;
 
+std::deque<SQLExecutionStats> SQLExecutionWidget::exec_stats_log;
+
 int SQLExecutionWidget::cmd_history_max_len = 1000;
+int SQLExecutionWidget::rows_page_size = 10000;
 const QString SQLExecutionWidget::ColumnNullValue("␀");
 
 SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
@@ -45,6 +52,10 @@ SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
 
 	output_tbw->widget(2)->installEventFilter(this);
 
+	// The paint events of the grid are watched in order to measure when the results are displayed for the first time
+	first_paint_at = -1;
+	results_tbw->viewport()->installEventFilter(this);
+
 	find_history_wgt = new FindReplaceWidget(cmd_history_txt, find_history_parent);
 	QVBoxLayout *layout = new QVBoxLayout;
 	layout->setContentsMargins(0,0,0,0);
@@ -138,7 +149,7 @@ SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
 	});
 
 	connect(export_tb, &QToolButton::clicked, this, [this](){
-		SQLExecutionWidget::exportResults(results_tbw);
+		SQLExecutionWidget::exportResults(results_tbw, sql_cmd_conn.getConnectionParams(), results_query);
 	});
 
 	connect(close_file_tb, &QToolButton::clicked, this, [this](){
@@ -162,6 +173,8 @@ SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
 
 	connect(&sql_exec_thread, &QThread::started, &sql_exec_hlp, &SQLExecutionHelper::executeCommand);
 	connect(&sql_exec_hlp, &SQLExecutionHelper::s_executionFinished, this, &SQLExecutionWidget::finishExecution);
+	connect(&sql_exec_hlp, &SQLExecutionHelper::s_resultModelReady, this, &SQLExecutionWidget::showResultModel);
+	connect(&sql_exec_hlp, &SQLExecutionHelper::s_fetchPaused, this, &SQLExecutionWidget::handleFetchPaused);
 	connect(&sql_exec_hlp, &SQLExecutionHelper::s_executionAborted, &sql_exec_thread, &QThread::quit);
 	connect(&sql_exec_hlp, &SQLExecutionHelper::s_executionAborted, this, &SQLExecutionWidget::handleExecutionAborted);
 	connect(stop_tb, &QToolButton::clicked, &sql_exec_hlp, &SQLExecutionHelper::cancelCommand, Qt::DirectConnection);
@@ -181,7 +194,14 @@ SQLExecutionWidget::~SQLExecutionWidget()
 
 bool SQLExecutionWidget::eventFilter(QObject *object, QEvent *event)
 {
-	if(event->type() == QEvent::MouseButtonDblClick && object == v_splitter->handle(1))
+	if(event->type() == QEvent::Paint && object == results_tbw->viewport())
+	{
+		if(first_paint_at < 0 && results_tbw->model() && results_tbw->model() == sql_exec_hlp.getResultSetModel())
+			first_paint_at = QDateTime::currentMSecsSinceEpoch();
+
+		return QWidget::eventFilter(object, event);
+	}
+	else if(event->type() == QEvent::MouseButtonDblClick && object == v_splitter->handle(1))
 	{
 		output_tb->setChecked(!v_splitter->handle(1)->isEnabled());
 		return true;
@@ -267,10 +287,7 @@ void SQLExecutionWidget::fillResultsTable(Catalog &catalog, ResultSet &res, QTab
 		int col=0, row=0, col_cnt=res.getColumnCount();
 		QTableWidgetItem *item=nullptr;
 		std::vector<unsigned> type_ids;
-		std::vector<unsigned>::iterator end;
-		std::vector<attribs_map> types;
 		std::map<unsigned, QString> type_names;
-		Catalog::QueryFilter orig_filter=catalog.getQueryFilter();
 
 		results_tbw->setRowCount(0);
 		results_tbw->setColumnCount(col_cnt);
@@ -288,18 +305,8 @@ void SQLExecutionWidget::fillResultsTable(Catalog &catalog, ResultSet &res, QTab
 			results_tbw->setHorizontalHeaderItem(col, item);
 		}
 
-		//Retrieving the data type names for each column
-		catalog.setQueryFilter(Catalog::ListAllObjects);
-		std::sort(type_ids.begin(), type_ids.end());
-		end=std::unique(type_ids.begin(), type_ids.end());
-		type_ids.erase(end, type_ids.end());
-
-		types=catalog.getObjectsAttributes(ObjectType::Type, "", "", type_ids);
-
-		for(auto &tp : types)
-			type_names[tp[Attributes::Oid].toUInt()]=tp[Attributes::Name];
-
-		catalog.setQueryFilter(orig_filter);
+		//Retrieving the data type names for each column (from the cache shared by the connections to the same database)
+		type_names=catalog.getTypeNames(type_ids);
 
 		//Assinging the type names as tooltip on header items
 		for(col=0; col < col_cnt; col++)
@@ -390,42 +397,86 @@ void SQLExecutionWidget::handleExecutionAborted(Exception e)
 	addToSQLHistory(sql_cmd_txt->toPlainText(), 0, e.getErrorMessage());
 }
 
-void SQLExecutionWidget::finishExecution(int rows_affected)
+void SQLExecutionWidget::showResultModel()
 {
-	if(sql_exec_hlp.isCancelled())
-		destroyResultModel();
-	else
-	{
-		bool empty = false;
-		ResultSetModel *res_model = sql_exec_hlp.getResultSetModel();
+	ResultSetModel *res_model = sql_exec_hlp.getResultSetModel();
 
-		end_exec=QDateTime::currentDateTime().toMSecsSinceEpoch();
-		total_exec = end_exec - start_exec;
+	results_tbw->setSortingEnabled(false);
+	results_tbw->blockSignals(true);
+	results_tbw->setUpdatesEnabled(false);
 
-		results_tbw->setSortingEnabled(false);
-		results_tbw->blockSignals(true);
-		results_tbw->setUpdatesEnabled(false);
+	destroyResultModel();
 
-		destroyResultModel();
+	results_tbw->setModel(res_model);
+	results_tbw->resizeColumnsToContents();
 
-		results_tbw->setModel(res_model);
-		results_tbw->resizeColumnsToContents();
-		results_tbw->setUpdatesEnabled(true);
-		results_tbw->blockSignals(false);
+	// The rows are sorted by the model when the user clicks a column header, initially they're kept in the retrieval order
+	results_tbw->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+	results_tbw->setSortingEnabled(res_model != nullptr);
+
+	results_tbw->setUpdatesEnabled(true);
+	results_tbw->blockSignals(false);
+
+	filter_edt->blockSignals(true);
+	filter_edt->clear();
+	filter_edt->blockSignals(false);
+
+	columns_cmb->blockSignals(true);
+	columns_cmb->clear();
+
+	for(int col = 0; res_model && col < res_model->columnCount(QModelIndex()); col++)
+		columns_cmb->addItem(res_model->headerData(col, Qt::Horizontal, Qt::DisplayRole).toString());
+
+	columns_cmb->blockSignals(false);
+
+	if(!res_model)
+		return;
+
+	// While the rows are being streamed the results are displayed as soon as they arrive
+	connect(res_model, &ResultSetModel::rowsInserted, this, [this, res_model](){
+		output_tbw->setTabText(0, tr("Results (%1)").arg(res_model->rowCount()));
+	});
+
+	// Hidden rows refer to positions in the grid, so the filter is applied again after sorting the rows
+	connect(res_model, &ResultSetModel::layoutChanged, this, [this](){
+		if(!filter_edt->text().isEmpty())
+			filterResults();
+	});
+
+	if(sql_exec_thread.isRunning())
+	{
+		output_tbw->setTabEnabled(0, true);
+		output_tbw->setTabText(0, tr("Results (%1)").arg(res_model->rowCount()));
+		output_tbw->setCurrentIndex(0);
+		results_parent->setVisible(true);
+	}
+}
 
-		filter_edt->blockSignals(true);
-		filter_edt->clear();
-		filter_edt->blockSignals(false);
+void SQLExecutionWidget::handleFetchPaused(int rows_fetched)
+{
+	GuiUtilsNs::createOutputListItem(msgoutput_lst,
+																	 tr("[%1]: %2 rows retrieved so far. Scroll the results to the end to retrieve more rows or stop the execution to keep only the retrieved ones.")
+																	 .arg(QTime::currentTime().toString(QString("hh:mm:ss.zzz"))).arg(rows_fetched),
+																	 QPixmap(GuiUtilsNs::getIconPath("info")), false);
+	output_tbw->setTabText(1, tr("Messages (%1)").arg(msgoutput_lst->count()));
+}
 
-		columns_cmb->blockSignals(true);
-		columns_cmb->clear();
+void SQLExecutionWidget::finishExecution(int rows_affected)
+{
+	ResultSetModel *res_model = sql_exec_hlp.getResultSetModel();
 
-		for(int col = 0; res_model && col < res_model->columnCount(QModelIndex()); col++)
-			columns_cmb->addItem(res_model->headerData(col, Qt::Horizontal, Qt::DisplayRole).toString());
+	if(sql_exec_hlp.isCancelled() && !res_model)
+		destroyResultModel();
+	else
+	{
+		bool empty = false;
 
-		columns_cmb->blockSignals(false);
+		end_exec=QDateTime::currentDateTime().toMSecsSinceEpoch();
+		total_exec = end_exec - start_exec;
 
-		addToSQLHistory(sql_cmd_txt->toPlainText(), rows_affected);
+		// The model is already displayed when its rows were streamed
+		if(results_tbw->model() != res_model)
+			showResultModel();
 
 		empty = (!res_model || res_model->rowCount() == 0);
 		output_tbw->setTabEnabled(0, !empty);
@@ -444,6 +495,14 @@ void SQLExecutionWidget::finishExecution(int rows_affected)
 			output_tbw->setCurrentIndex(1);
 		}
 
+		/* When the rows were not streamed the grid is painted for the first time only after this point,
+		 * so the painting is forced now in order to measure the time taken to display the results */
+		if(!empty && first_paint_at < 0 && results_tbw->isVisible())
+			results_tbw->viewport()->repaint();
+
+		collectExecutionStats();
+		addToSQLHistory(sql_cmd_txt->toPlainText(), rows_affected, "", formatExecutionStats(exec_stats));
+
 		msgoutput_lst->clear();
 
 		for(QString notice : sql_exec_hlp.getNotices())
@@ -461,6 +520,11 @@ void SQLExecutionWidget::finishExecution(int rows_affected)
 																																		 .arg(rows_affected)),
 																				QPixmap(GuiUtilsNs::getIconPath("info")));
 
+		GuiUtilsNs::createOutputListItem(msgoutput_lst,
+																				QString("[%1]: %2").arg(QTime::currentTime().toString(QString("hh:mm:ss.zzz")),
+																																formatExecutionStats(exec_stats)),
+																				QPixmap(GuiUtilsNs::getIconPath("info")), false);
+
 		output_tbw->setTabText(1, tr("Messages (%1)").arg(msgoutput_lst->count()));
 	}
 
@@ -470,12 +534,18 @@ void SQLExecutionWidget::finishExecution(int rows_affected)
 
 void SQLExecutionWidget::filterResults()
 {
-	QModelIndexList list;
+	ResultSetModel *res_model = dynamic_cast<ResultSetModel *>(results_tbw->model());
+	QList<int> rows;
 	Qt::MatchFlags flags = Qt::MatchStartsWith;
-	int rows_cnt = results_tbw->model()->rowCount();
 
+	if(!res_model)
+		return;
+
+	int rows_cnt = res_model->rowCount();
+
+	// Exact matches are always case-sensitive
 	if(exact_chk->isChecked())
-		flags = Qt::MatchExactly;
+		flags = Qt::MatchExactly | Qt::MatchCaseSensitive;
 	else if(regexp_chk->isChecked())
 		flags = Qt::MatchRegularExpression;
 	else
@@ -484,8 +554,8 @@ void SQLExecutionWidget::filterResults()
 	if(case_sensitive_chk->isChecked())
 		flags |= Qt::MatchCaseSensitive;
 
-	list = results_tbw->model()->match(results_tbw->model()->index(0, columns_cmb->currentIndex()),
-																		 Qt::DisplayRole, filter_edt->text(), -1, flags);
+	// The rows are matched by the model over its compact values instead of converting all of them to strings
+	rows = res_model->matchRows(columns_cmb->currentIndex(), filter_edt->text(), flags);
 
 	results_tbw->blockSignals(true);
 	results_tbw->setUpdatesEnabled(false);
@@ -493,18 +563,15 @@ void SQLExecutionWidget::filterResults()
 	for(int row = 0; row < rows_cnt; row++)
 		results_tbw->hideRow(row);
 
-	if(!list.isEmpty())
-	{
-		for(auto &idx : list)
-			results_tbw->showRow(idx.row());
-	}
+	for(auto &row : rows)
+		results_tbw->showRow(row);
 
 	results_tbw->blockSignals(false);
 	results_tbw->setUpdatesEnabled(true);
 	results_tbw->update();
 }
 
-void SQLExecutionWidget::addToSQLHistory(const QString &cmd, unsigned rows, const QString &error)
+void SQLExecutionWidget::addToSQLHistory(const QString &cmd, unsigned rows, const QString &error, const QString &stats)
 {
 	if(!cmd.isEmpty())
 	{
@@ -527,6 +594,9 @@ void SQLExecutionWidget::addToSQLHistory(const QString &cmd, unsigned rows, cons
 		else
 			fmt_cmd += QString("-- %1 %2\n").arg(tr("Rows:")).arg(rows);
 
+		if(!stats.isEmpty())
+			fmt_cmd += QString("-- %1\n").arg(stats);
+
 		if(!fmt_cmd.trimmed().endsWith(Attributes::DdlEndToken))
 			fmt_cmd += Attributes::DdlEndToken + QChar('\n');
 
@@ -616,7 +686,10 @@ void SQLExecutionWidget::runSQLCommand()
 		cmd.replace(QChar::ParagraphSeparator, '\n');
 
 	msgoutput_lst->clear();
+	results_query = getCopyableQuery(cmd);
+	first_paint_at = -1;
 	sql_exec_hlp.setCommand(cmd);
+	sql_exec_hlp.setRowsPageSize(rows_page_size);
 	start_exec=QDateTime::currentDateTime().toMSecsSinceEpoch();
 	sql_exec_thread.start();
 	switchToExecutionMode(true);
@@ -677,17 +750,21 @@ void SQLExecutionWidget::loadCommands()
 	}
 }
 
-void SQLExecutionWidget::exportResults(QTableView *results_tbw)
+void SQLExecutionWidget::exportResults(QTableView *results_tbw, const attribs_map &conn_params, const QString &query)
 {
 	if(!results_tbw)
 		throw Exception(ErrorCode::OprNotAllocatedObject ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	QFileDialog csv_file_dlg;
+	QString name_filter = tr("Comma-separated values file (*.csv)");
+
+	if(CsvWriter::isCompressionSupported())
+		name_filter += tr(";;Compressed comma-separated values file (*.csv.gz)");
 
 	csv_file_dlg.setDefaultSuffix(QString("csv"));
 	csv_file_dlg.setFileMode(QFileDialog::AnyFile);
 	csv_file_dlg.setWindowTitle(tr("Save CSV file"));
-	csv_file_dlg.setNameFilter(tr("Comma-separated values file (*.csv);;All files (*.*)"));
+	csv_file_dlg.setNameFilter(name_filter + tr(";;All files (*.*)"));
 	csv_file_dlg.setModal(true);
 	csv_file_dlg.setAcceptMode(QFileDialog::AcceptSave);
 
@@ -695,22 +772,129 @@ void SQLExecutionWidget::exportResults(QTableView *results_tbw)
 	csv_file_dlg.exec();
 	GuiUtilsNs::saveFileDialogState(&csv_file_dlg);
 
-	if(csv_file_dlg.result()==QDialog::Accepted)
+	if(csv_file_dlg.result()!=QDialog::Accepted)
+		return;
+
+	QString filename = csv_file_dlg.selectedFiles().at(0);
+	bool from_server = false, finished = true;
+	TaskProgressWidget task_prog_wgt;
+	CsvWriter writer;
+	Connection conn;
+
+	if(!conn_params.empty() && !query.isEmpty())
 	{
-		QApplication::setOverrideCursor(Qt::WaitCursor);
-		results_tbw->setUpdatesEnabled(false);
-		results_tbw->blockSignals(true);
-		results_tbw->selectAll();
+		Messagebox msg_box;
 
-		UtilsNs::saveFile(csv_file_dlg.selectedFiles().at(0), generateCSVBuffer(results_tbw));
+		msg_box.show(tr("Export results"),
+								 tr("The results can be exported from the rows currently loaded in the grid or the query can be executed again in the server so all its rows are exported without being loaded by pgModeler. How do you want to proceed?"),
+								 Messagebox::ConfirmIcon, Messagebox::AllButtons,
+								 tr("Query the server"), tr("Loaded rows"), "",
+								 GuiUtilsNs::getIconPath("database"), GuiUtilsNs::getIconPath("table"));
 
-		results_tbw->clearSelection();
-		results_tbw->blockSignals(false);
-		results_tbw->setUpdatesEnabled(true);
-		QApplication::restoreOverrideCursor();
+		if(msg_box.isCancelled())
+			return;
+
+		from_server = msg_box.result() == QDialog::Accepted;
+	}
+
+	task_prog_wgt.setWindowTitle(tr("Exporting results..."));
+	task_prog_wgt.setWindowModality(Qt::ApplicationModal);
+	task_prog_wgt.setCancelEnabled(true);
+	task_prog_wgt.show();
+
+	try
+	{
+		writer.open(filename, filename.endsWith(".gz", Qt::CaseInsensitive));
+
+		if(from_server)
+		{
+			QElapsedTimer timer;
+			unsigned rows = 0;
+
+			/* The rows are written by the server in the same CSV format produced from the grid and
+			 * streamed to the file as they arrive, so the complete result is never held in memory */
+			conn = Connection(conn_params);
+			conn.connect();
+			timer.start();
+
+			conn.executeCopyTo(QString("COPY (%1\n) TO STDOUT WITH (FORMAT csv, HEADER, DELIMITER '%2', QUOTE '%3', FORCE_QUOTE *)")
+												 .arg(query, QString(CsvDocument::Separator), QString(CsvDocument::TextDelimiter)),
+												 [&](const char *data, int size) {
+				writer.writeRaw(data, size);
+				rows++;
+
+				if(timer.elapsed() >= 100)
+				{
+					task_prog_wgt.updateProgress(0, tr("Exporting rows from the server... (%1 rows)").arg(rows), enum_t(ObjectType::Table));
+					qApp->processEvents();
+					timer.restart();
+				}
+
+				return !task_prog_wgt.isCancelRequested();
+			});
+
+			conn.close();
+			finished = !task_prog_wgt.isCancelRequested();
+		}
+		else
+			finished = writeResults(results_tbw, writer, true, false, &task_prog_wgt);
+
+		writer.close();
+		task_prog_wgt.close();
+
+		// Partially written files are discarded
+		if(!finished)
+			QFile::remove(filename);
+	}
+	catch(Exception &e)
+	{
+		task_prog_wgt.close();
+
+		try
+		{
+			writer.close();
+		}
+		catch(Exception &)
+		{
+			// The error raised by the export itself is the one reported
+		}
+
+		QFile::remove(filename);
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
 
+QString SQLExecutionWidget::getCopyableQuery(const QString &sql)
+{
+	static const QRegularExpression query_start_regexp("^\\s*(SELECT|WITH|VALUES|TABLE)\\b", QRegularExpression::CaseInsensitiveOption),
+			data_change_regexp("\\b(INSERT|UPDATE|DELETE|MERGE|INTO)\\b", QRegularExpression::CaseInsensitiveOption),
+			row_lock_regexp("\\bFOR\\s+(UPDATE|NO\\s+KEY\\s+UPDATE|SHARE|KEY\\s+SHARE)\\b", QRegularExpression::CaseInsensitiveOption);
+	SQLStatementSplitter splitter;
+	SQLStatementSplitter::Span span;
+	QString query;
+
+	splitter.setBuffer(sql.toUtf8());
+
+	while(splitter.nextSpan(span))
+	{
+		// Only a single statement can be wrapped by the COPY command
+		if(!query.isEmpty())
+			return "";
+
+		query = splitter.getSpanText(span);
+
+		if(span.end == SQLStatementSplitter::Semicolon)
+			query.chop(1);
+	}
+
+	/* Commands that change data or create tables (SELECT INTO) are discarded as well as queries that lock rows (FOR [NO KEY] UPDATE, FOR [KEY] SHARE)
+	 * since they can't be executed inside a COPY or would have side effects when executed again */
+	if(!query.contains(query_start_regexp) || query.contains(data_change_regexp) || query.contains(row_lock_regexp))
+		return "";
+
+	return query;
+}
+
 int SQLExecutionWidget::clearAll()
 {
 	Messagebox msg_box;
@@ -751,71 +935,97 @@ QByteArray SQLExecutionWidget::generateBuffer(QTableView *results_tbw, QChar sep
 	if(!results_tbw->selectionModel())
 		return QByteArray();
 
-	QAbstractItemModel *model = results_tbw->model();
-	QModelIndexList sel_indexes = results_tbw->selectionModel()->selectedIndexes();
 	QByteArray buf;
-	QStringList line;
-	QModelIndex index;
-	QString str_pattern = csv_format ?
-													QString("%1%2%1").arg(CsvDocument::TextDelimiter).arg("%1") :
-													QString("%1"),
-			value;
-	int start_row = -1, start_col = -1,
-			row_cnt = 0, col_cnt = 0;
-
-	start_row = sel_indexes.at(0).row();
-	start_col = sel_indexes.at(0).column();
-	row_cnt = (sel_indexes.last().row() - start_row) + 1;
-	col_cnt = (sel_indexes.last().column() - start_col) + 1;
-
-	int col=0, row=0,
-			max_col=start_col + col_cnt,
-			max_row=start_row + row_cnt;
-
-	if(incl_col_names)
+	QBuffer output(&buf);
+	CsvWriter writer;
+
+	output.open(QBuffer::WriteOnly);
+	writer.setSpecialChars(separator, CsvDocument::TextDelimiter, CsvDocument::LineBreak);
+	writer.setDelimitValues(csv_format);
+	writer.open(&output);
+	writeResults(results_tbw, writer, incl_col_names, true);
+	writer.close();
+
+	return buf;
+}
+
+bool SQLExecutionWidget::writeResults(QTableView *results_tbw, CsvWriter &writer, bool incl_col_names, bool sel_only, TaskProgressWidget *task_prog_wgt)
+{
+	if(!results_tbw)
+		throw Exception(ErrorCode::OprNotAllocatedObject ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	QAbstractItemModel *model = results_tbw->model();
+	QString value;
+	int start_row = 0, start_col = 0,
+			max_row = model ? model->rowCount() : 0,
+			max_col = model ? model->columnCount() : 0,
+			row = 0, col = 0, progress = 0;
+
+	/* The rectangle that encloses the selection is calculated from the selection ranges instead of
+	 * the selected indexes since the latter creates one index per cell, which is expensive for large selections */
+	if(sel_only)
 	{
-		//Creating the header
-		for(col=start_col; col < max_col; col++)
-		{
-			if(results_tbw->isColumnHidden(col))
-				continue;
+		QItemSelection selection = results_tbw->selectionModel() ?
+																 results_tbw->selectionModel()->selection() : QItemSelection();
 
-			value = model->headerData(col, Qt::Horizontal).toString();
+		if(selection.isEmpty())
+			return true;
 
-			if(csv_format)
-				value.replace(CsvDocument::TextDelimiter, QString("%1%1").arg(CsvDocument::TextDelimiter));
+		start_row = start_col = std::numeric_limits<int>::max();
+		max_row = max_col = -1;
 
-			line.append(str_pattern.arg(value));
+		for(auto &range : selection)
+		{
+			start_row = std::min(start_row, range.top());
+			start_col = std::min(start_col, range.left());
+			max_row = std::max(max_row, range.bottom() + 1);
+			max_col = std::max(max_col, range.right() + 1);
 		}
-
-		buf.append(line.join(separator).toUtf8());
-		buf.append(CsvDocument::LineBreak.unicode());
-		line.clear();
 	}
 
-	//Creating the content
-	for(row=start_row; row < max_row; row++)
+	try
 	{
-		for(col=start_col; col < max_col; col++)
+		if(incl_col_names)
 		{
-			if(results_tbw->isColumnHidden(col))
-				continue;
+			//Creating the header
+			for(col=start_col; col < max_col; col++)
+			{
+				if(!results_tbw->isColumnHidden(col))
+					writer.writeValue(model->headerData(col, Qt::Horizontal).toString());
+			}
+
+			writer.endRow();
+		}
+
+		//Creating the content
+		for(row=start_row; row < max_row; row++)
+		{
+			for(col=start_col; col < max_col; col++)
+			{
+				if(!results_tbw->isColumnHidden(col))
+					writer.writeValue(model->index(row, col).data().toString());
+			}
 
-			index = model->index(row, col);
-			value = index.data().toString();
+			writer.endRow();
 
-			if(csv_format)
-				value.replace(CsvDocument::TextDelimiter, QString("%1%1").arg(CsvDocument::TextDelimiter));
+			if(task_prog_wgt && progress != ((row - start_row + 1) * 100) / (max_row - start_row))
+			{
+				progress = ((row - start_row + 1) * 100) / (max_row - start_row);
+				task_prog_wgt->updateProgress(progress, tr("Exporting row %1 of %2...").arg(row - start_row + 1).arg(max_row - start_row),
+																			enum_t(ObjectType::Table));
+				qApp->processEvents();
 
-			line.append(str_pattern.arg(value));
+				if(task_prog_wgt->isCancelRequested())
+					return false;
+			}
 		}
-
-		buf.append(line.join(separator).toUtf8());
-		line.clear();
-		buf.append(CsvDocument::LineBreak.unicode());
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 
-	return buf;
+	return true;
 }
 
 void SQLExecutionWidget::copySelection(QTableView *results_tbw, bool use_popup, bool csv_is_default)
@@ -854,7 +1064,11 @@ void SQLExecutionWidget::copySelection(QTableView *results_tbw, bool use_popup,
 				buf=generateTextBuffer(results_tbw);
 			}
 
-			qApp->clipboard()->setText(buf);
+			/* The generated UTF-8 buffer is handed to the clipboard as is, avoiding the
+			 * conversion of a possibly large selection to an intermediate string */
+			QMimeData *mime_data = new QMimeData;
+			mime_data->setData("text/plain", buf);
+			qApp->clipboard()->setMimeData(mime_data);
 		}
 	}
 }
@@ -997,6 +1211,73 @@ int SQLExecutionWidget::getSQLHistoryMaxLength()
 	return SQLExecutionWidget::cmd_history_max_len;
 }
 
+void SQLExecutionWidget::setRowsPageSize(int size)
+{
+	if(size < 1000 || size > 1000000)
+		size = 10000;
+
+	SQLExecutionWidget::rows_page_size = size;
+}
+
+int SQLExecutionWidget::getRowsPageSize()
+{
+	return SQLExecutionWidget::rows_page_size;
+}
+
+void SQLExecutionWidget::collectExecutionStats()
+{
+	exec_stats = sql_exec_hlp.getExecutionStats();
+
+	if(first_paint_at >= 0)
+		exec_stats.first_paint_time = first_paint_at - exec_stats.start_time.toMSecsSinceEpoch();
+
+	exec_stats_log.push_back(exec_stats);
+
+	while(exec_stats_log.size() > ExecStatsLogMaxLength)
+		exec_stats_log.pop_front();
+
+	emit s_executionStatsCollected(exec_stats);
+}
+
+SQLExecutionStats SQLExecutionWidget::getExecutionStats()
+{
+	return exec_stats;
+}
+
+std::vector<SQLExecutionStats> SQLExecutionWidget::getExecutionStatsLog()
+{
+	return std::vector<SQLExecutionStats>(exec_stats_log.begin(), exec_stats_log.end());
+}
+
+QString SQLExecutionWidget::formatExecutionStats(const SQLExecutionStats &stats)
+{
+	QStringList times;
+	QLocale locale;
+	auto fmt_time = [](double msecs) {
+		return msecs >= 1000 ? QString("%1 s").arg(msecs / 1000.0, 0, 'f', 2) : QString("%1 ms").arg(msecs, 0, 'f', 1);
+	};
+
+	std::vector<std::pair<QString, double>> stages = {
+		{ tr("connect"), stats.connect_time },
+		{ tr("send"), stats.send_time },
+		{ tr("first byte"), stats.first_byte_time },
+		{ tr("last byte"), stats.last_byte_time },
+		{ tr("model build"), stats.model_build_time },
+		{ tr("first paint"), stats.first_paint_time }
+	};
+
+	for(auto &[stage, msecs] : stages)
+	{
+		if(msecs >= 0)
+			times.append(QString("%1 %2").arg(stage, fmt_time(msecs)));
+	}
+
+	return tr("Timings: %1. Rows: %2, received: %3, model peak memory: %4.")
+			.arg(times.join(", "))
+			.arg(stats.row_count)
+			.arg(locale.formattedDataSize(stats.received_bytes), locale.formattedDataSize(stats.peak_model_memory));
+}
+
 void SQLExecutionWidget::enableSQLExecution(bool enable)
 {
 	try
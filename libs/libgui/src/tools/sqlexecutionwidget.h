@@ -35,6 +35,10 @@
 #include "widgets/findreplacewidget.h"
 #include "utils/resultsetmodel.h"
 #include "sqlexecutionhelper.h"
+#include "csvwriter.h"
+#include <deque>
+
+class TaskProgressWidget;
 
 class __libgui SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 	private:
@@ -42,9 +46,21 @@ class __libgui SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget
 
 		static std::map<QString, QString> cmd_history;
 
-		static int cmd_history_max_len;
+		//! \brief Latency breakdown of the last executions of all instances, oldest first (see getExecutionStatsLog())
+		static std::deque<SQLExecutionStats> exec_stats_log;
+
+		static int cmd_history_max_len,
+
+		//! \brief Amount of rows retrieved before pausing the results fetching until the user scrolls to the end of the results
+		rows_page_size;
+
+		qint64 start_exec, end_exec, total_exec,
+
+		//! \brief Moment (msecs since epoch) in which the results grid was painted for the first time in the current execution
+		first_paint_at;
 
-		qint64 start_exec, end_exec, total_exec;
+		//! \brief Latency breakdown of the last execution
+		SQLExecutionStats exec_stats;
 
 		SchemaParser schparser;
 
@@ -61,6 +77,10 @@ class __libgui SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget
 		//! \brief Connection used to run commands specified on sql input field
 		Connection sql_cmd_conn;
 
+		/*! \brief The last executed command when it's a single query that can be run again inside a COPY command
+		 * so the results can be exported directly from the server (see exportResults()) */
+		QString results_query;
+
 		//! \brief Dialog for SQL save/load
 		QFileDialog sql_file_dlg;
 
@@ -80,8 +100,11 @@ class __libgui SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget
 				When enabling a new connection to server will be opened. */
 		void enableSQLExecution(bool enable);
 
-		//! \brief Stores the command on the sql command history
-		void addToSQLHistory(const QString &cmd, unsigned rows=0, const QString &error="");
+		//! \brief Stores the command on the sql command history along with the latency breakdown of its execution (see formatExecutionStats())
+		void addToSQLHistory(const QString &cmd, unsigned rows=0, const QString &error="", const QString &stats="");
+
+		//! \brief Collects the latency breakdown of the finished execution, storing it in the log and emitting s_executionStatsCollected()
+		void collectExecutionStats();
 
 		static void validateSQLHistoryLength(const QString &conn_id, const QString &fmt_cmd = "", NumberedTextEditor *cmd_history_txt = nullptr);
 
@@ -102,6 +125,9 @@ class __libgui SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget
 	public:
 		static const QString ColumnNullValue;
 
+		//! \brief Maximum amount of entries kept in the execution stats log
+		static constexpr unsigned ExecStatsLogMaxLength = 500;
+
 		SQLExecutionWidget(QWidget * parent = nullptr);
 		virtual ~SQLExecutionWidget();
 
@@ -128,8 +154,20 @@ class __libgui SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget
 		 *  buffer is whether in CSV format or not */
 		static QByteArray generateBuffer(QTableView *results_tbw, QChar separator, bool incl_col_names, bool csv_format);
 
-		//! \brief Exports the results to csv file
-		static void exportResults(QTableView *results_tbw);
+		/*! \brief Writes the rows of the results grid to the provided writer, skipping the hidden columns. When sel_only is true only the
+		 * rows and columns enclosing the selected cells are written. If a progress widget is provided it's updated while the rows are written
+		 * and the method returns false when the user cancels the operation */
+		static bool writeResults(QTableView *results_tbw, CsvWriter &writer, bool incl_col_names, bool sel_only, TaskProgressWidget *task_prog_wgt = nullptr);
+
+		/*! \brief Exports the results to csv file (gzip compressed if the file name ends with .gz and the feature is available).
+		 * The rows are streamed to the file so the whole CSV document is never held in memory. If the connection parameters
+		 * and the query that produced the results are provided the user can choose to export all the rows directly
+		 * from the server via COPY ... TO STDOUT instead of the rows loaded in the grid */
+		static void exportResults(QTableView *results_tbw, const attribs_map &conn_params = attribs_map(), const QString &query = "");
+
+		/*! \brief Returns the provided SQL (without the trailing semicolon) if it's a single read-only query (SELECT, WITH, VALUES or TABLE)
+		 * that can be used in a COPY (query) TO STDOUT command, otherwise returns an empty string */
+		static QString getCopyableQuery(const QString &sql);
 
 		//! \brief Save the history of all connections open in the SQL Execution to the sql-history.conf
 		static void saveSQLHistory();
@@ -143,6 +181,20 @@ class __libgui SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget
 
 		static int getSQLHistoryMaxLength();
 
+		static void setRowsPageSize(int size);
+
+		static int getRowsPageSize();
+
+		//! \brief Returns the latency breakdown of the last command executed in this instance
+		SQLExecutionStats getExecutionStats();
+
+		/*! \brief Returns the latency breakdown of the last commands executed in all instances (oldest first),
+		 * so it can be queried by plugins. Up to ExecStatsLogMaxLength entries are kept */
+		static std::vector<SQLExecutionStats> getExecutionStatsLog();
+
+		//! \brief Formats the latency breakdown in a single line of text, omitting the stages not reached
+		static QString formatExecutionStats(const SQLExecutionStats &stats);
+
 	public slots:
 		void configureSnippets();
 
@@ -173,8 +225,18 @@ class __libgui SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget
 
 		void finishExecution(int rows_affected = 0);
 
+		//! \brief Displays the result model created by the helper, which may still be receiving rows
+		void showResultModel();
+
+		//! \brief Informs the user that the fetching of the rows is paused until more rows are requested
+		void handleFetchPaused(int rows_fetched);
+
 		void filterResults();
 
+	signals:
+		//! \brief Signal emitted when the latency breakdown of a successful execution is collected
+		void s_executionStatsCollected(const SQLExecutionStats &stats);
+
 		friend class SQLToolWidget;
 };
 
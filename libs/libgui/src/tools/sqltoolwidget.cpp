@@ -469,6 +469,10 @@ void SQLToolWidget::dropDatabase(int database_idx)
 			conn.executeDDLCommand(QString("DROP DATABASE \"%1\";").arg(dbname));
 			conn.close();
 
+			//Discarding the objects cached for the dropped database since a new one can be created with the same name
+			conn.setConnectionParam(Connection::ParamDbName, dbname);
+			Catalog::invalidateObjectsNames(conn);
+
 			//Closing tabs related to the database to be dropped
 			for(int i=0; i < databases_tbw->count(); i++)
 			{
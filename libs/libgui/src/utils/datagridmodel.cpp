@@ -0,0 +1,325 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "datagridmodel.h"
+#include "widgets/objectstablewidget.h"
+#include <algorithm>
+
+DataGridModel::DataGridModel(ResultSet &res, const std::map<unsigned, QString> &type_names, QObject *parent) : ResultSetModel(res, type_names, parent)
+{
+	new_row_count = 0;
+	editable = false;
+
+	for(int col = 0; col < col_count; col++)
+		read_only_cols.push_back(tooltip_data.at(col) == "bytea");
+}
+
+int DataGridModel::rowCount(const QModelIndex &) const
+{
+	return row_count + new_row_count;
+}
+
+QVariant DataGridModel::data(const QModelIndex &index, int role) const
+{
+	if(!index.isValid() || index.row() >= rowCount() || index.column() >= col_count)
+		return QVariant();
+
+	int row = index.row(), col = index.column();
+	OperationId operation = getOperation(row);
+
+	if(role == Qt::DisplayRole || role == Qt::EditRole)
+	{
+		if(isNewRow(row) && read_only_cols[col])
+			return tr("[binary data]");
+
+		return getCellValue(row, col);
+	}
+
+	if(role == Qt::TextAlignmentRole)
+		return QVariant(Qt::AlignLeft | Qt::AlignVCenter);
+
+	// The colors, fonts and tooltips are generated only for the rows being drawn
+	if(operation != NoOperation && !read_only_cols[col])
+	{
+		static const ObjectsTableWidget::TableItemColor bg_colors[3] = { ObjectsTableWidget::AddedItemBgColor,
+																																		 ObjectsTableWidget::UpdatedItemBgColor,
+																																		 ObjectsTableWidget::RemovedItemBgColor },
+
+		fg_colors[3] = { ObjectsTableWidget::AddedItemFgColor,
+										 ObjectsTableWidget::UpdatedItemFgColor,
+										 ObjectsTableWidget::RemovedItemFgColor };
+
+		if(role == Qt::BackgroundRole)
+			return ObjectsTableWidget::getTableItemColor(bg_colors[operation - 1]);
+
+		if(role == Qt::ForegroundRole)
+			return ObjectsTableWidget::getTableItemColor(fg_colors[operation - 1]);
+
+		if(role == Qt::ToolTipRole)
+		{
+			QString op_names[3] = { tr("inserted"), tr("updated"), tr("deleted") };
+			return tr("This row is marked to be %1").arg(op_names[operation - 1]);
+		}
+
+		// The changed values of updated rows are highlighted
+		if(role == Qt::FontRole && operation == OpUpdate && row_changes.at(row).values.count(col))
+		{
+			QFont fnt;
+			fnt.setBold(true);
+			return fnt;
+		}
+	}
+
+	return ResultSetModel::data(index, role);
+}
+
+bool DataGridModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+	if(role != Qt::EditRole || !index.isValid() || !flags(index).testFlag(Qt::ItemIsEditable))
+		return false;
+
+	int row = index.row(), col = index.column();
+	QString text = value.toString();
+	OperationId prev_op = getOperation(row);
+
+	if(text == getCellValue(row, col))
+		return true;
+
+	if(isNewRow(row))
+		row_changes[row].values[col] = text;
+	else
+	{
+		// Only the values that differ from the retrieved ones are kept, so the row is unmarked if all of them are restored
+		if(text == getOriginalValue(row, col))
+		{
+			if(row_changes.count(row))
+				row_changes[row].values.erase(col);
+		}
+		else
+			row_changes[row].values[col] = text;
+
+		if(row_changes[row].values.empty())
+			row_changes.erase(row);
+		else
+			row_changes[row].operation = OpUpdate;
+	}
+
+	emitRowChanged(row);
+
+	if(prev_op != getOperation(row))
+		emit s_operationsChanged();
+
+	return true;
+}
+
+Qt::ItemFlags DataGridModel::flags(const QModelIndex &index) const
+{
+	Qt::ItemFlags flags = Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+
+	// Rows marked to be deleted can't be edited until the operation is undone
+	if(editable && index.isValid() && index.column() < col_count &&
+		 !read_only_cols[index.column()] && getOperation(index.row()) != OpDelete)
+		flags |= Qt::ItemIsEditable;
+
+	return flags;
+}
+
+void DataGridModel::appendRows(ResultSet &res)
+{
+	int added_rows = res.isValid() && !res.isEmpty() ? res.getTupleCount() : 0;
+
+	if(added_rows == 0)
+		return;
+
+	if(new_row_count > 0)
+	{
+		std::map<int, RowChange> moved_changes;
+
+		// The changes of the inserted rows are moved to the positions they'll have after the appending
+		for(auto itr = row_changes.lower_bound(row_count); itr != row_changes.end();)
+		{
+			moved_changes[itr->first + added_rows] = std::move(itr->second);
+			itr = row_changes.erase(itr);
+		}
+
+		row_changes.merge(moved_changes);
+	}
+
+	append(res);
+}
+
+int DataGridModel::getRetrievedRowCount() const
+{
+	return row_count;
+}
+
+void DataGridModel::setEditable(bool value)
+{
+	editable = value;
+}
+
+bool DataGridModel::isReadOnlyColumn(int column) const
+{
+	return column >= 0 && column < col_count && read_only_cols[column];
+}
+
+QString DataGridModel::getColumnTypeName(int column) const
+{
+	if(column < 0 || column >= col_count)
+		return "";
+
+	return tooltip_data.at(column);
+}
+
+QString DataGridModel::getCellValue(int row, int column) const
+{
+	auto itr = row_changes.find(row);
+
+	if(itr != row_changes.end() && itr->second.values.count(column))
+		return itr->second.values.at(column);
+
+	return getOriginalValue(row, column);
+}
+
+QString DataGridModel::getOriginalValue(int row, int column, bool *is_null) const
+{
+	if(isNewRow(row) || row < 0 || column < 0 || column >= col_count)
+	{
+		if(is_null)
+			*is_null = true;
+
+		return "";
+	}
+
+	if(binary_cols[column])
+	{
+		if(is_null)
+			*is_null = false;
+
+		return tr("[binary data]");
+	}
+
+	return QString::fromUtf8(getValue(getStoredRow(row), column, is_null));
+}
+
+DataGridModel::OperationId DataGridModel::getOperation(int row) const
+{
+	auto itr = row_changes.find(row);
+	return itr != row_changes.end() ? itr->second.operation : NoOperation;
+}
+
+void DataGridModel::markOperation(const std::vector<int> &rows, OperationId operation)
+{
+	if(operation == OpInsert || operation == OpUpdate)
+		return;
+
+	for(auto &row : rows)
+	{
+		if(row < 0 || row >= row_count)
+			continue;
+
+		// Deleted rows have their changed values discarded
+		if(operation == NoOperation)
+			row_changes.erase(row);
+		else
+			row_changes[row] = RowChange{ OpDelete, {} };
+
+		emitRowChanged(row);
+	}
+
+	emit s_operationsChanged();
+}
+
+std::vector<int> DataGridModel::getChangedRows() const
+{
+	std::vector<int> rows;
+
+	for(auto &itr : row_changes)
+		rows.push_back(itr.first);
+
+	return rows;
+}
+
+bool DataGridModel::isNewRow(int row) const
+{
+	return row >= row_count && row < row_count + new_row_count;
+}
+
+int DataGridModel::addRow()
+{
+	int row = rowCount();
+
+	beginInsertRows(QModelIndex(), row, row);
+	row_changes[row] = RowChange{ OpInsert, {} };
+	new_row_count++;
+	endInsertRows();
+
+	emit s_operationsChanged();
+	return row;
+}
+
+void DataGridModel::removeNewRows(std::vector<int> rows)
+{
+	std::sort(rows.begin(), rows.end());
+	rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+	// Removing from the last row so the indexes of the remaining ones to be removed are kept
+	for(auto itr = rows.rbegin(); itr != rows.rend(); itr++)
+	{
+		int row = *itr;
+
+		if(!isNewRow(row))
+			continue;
+
+		beginRemoveRows(QModelIndex(), row, row);
+
+		// The inserted rows placed after the removed one are moved up
+		for(int next_row = row + 1; next_row < rowCount(); next_row++)
+			row_changes[next_row - 1] = std::move(row_changes[next_row]);
+
+		row_changes.erase(rowCount() - 1);
+		new_row_count--;
+		endRemoveRows();
+	}
+
+	emit s_operationsChanged();
+}
+
+void DataGridModel::clearChanges()
+{
+	if(new_row_count > 0)
+	{
+		beginRemoveRows(QModelIndex(), row_count, row_count + new_row_count - 1);
+		new_row_count = 0;
+		row_changes.clear();
+		endRemoveRows();
+	}
+
+	row_changes.clear();
+
+	if(row_count > 0 && col_count > 0)
+		emit dataChanged(index(0, 0, QModelIndex()), index(row_count - 1, col_count - 1, QModelIndex()));
+
+	emit s_operationsChanged();
+}
+
+void DataGridModel::emitRowChanged(int row)
+{
+	if(col_count > 0)
+		emit dataChanged(index(row, 0, QModelIndex()), index(row, col_count - 1, QModelIndex()));
+}
@@ -0,0 +1,123 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libgui
+\class DataGridModel
+\brief Implements an editable model of the data of a table used by the data manipulation form. The retrieved rows are kept
+in the compact form of ResultSetModel and the changes made by the user are held in a separated overlay, by row, until they're saved.
+*/
+
+#ifndef DATA_GRID_MODEL_H
+#define DATA_GRID_MODEL_H
+
+#include "resultsetmodel.h"
+
+class __libgui DataGridModel: public ResultSetModel {
+	public:
+		//! \brief Constants used to mark the type of operation performed on rows
+		enum OperationId: unsigned {
+			NoOperation,
+			OpInsert,
+			OpUpdate,
+			OpDelete
+		};
+
+	private:
+		Q_OBJECT
+
+		//! \brief Stores the pending operation of a row and the values changed by the user (by column)
+		struct RowChange {
+			OperationId operation;
+			std::map<int, QString> values;
+		};
+
+		/*! \brief Changes made on the rows (keys) that weren't saved yet. The rows inserted by the user are
+		 * placed after the retrieved ones and have all their values stored here */
+		std::map<int, RowChange> row_changes;
+
+		//! \brief Amount of rows inserted by the user
+		int new_row_count;
+
+		//! \brief Indicates that the values of the rows can be edited
+		bool editable;
+
+		//! \brief Holds the columns which values can't be edited (bytea columns)
+		std::vector<bool> read_only_cols;
+
+		//! \brief Notifies the views that the whole row must be redrawn (colors, fonts and tooltips changed)
+		void emitRowChanged(int row);
+
+	public:
+		DataGridModel(ResultSet &res, const std::map<unsigned, QString> &type_names, QObject *parent = nullptr);
+
+		virtual int rowCount(const QModelIndex & = QModelIndex()) const;
+		virtual QVariant data(const QModelIndex &index, int role) const;
+		virtual bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole);
+		virtual Qt::ItemFlags flags(const QModelIndex &index) const;
+
+		/*! \brief Appends the tuples of the result set after the retrieved rows (e.g. the next page of the table). The rows inserted
+		 * by the user are kept after the retrieved ones, so their pending changes are moved along with them */
+		void appendRows(ResultSet &res);
+
+		//! \brief Returns the amount of rows retrieved from the database (not considering the ones inserted by the user)
+		int getRetrievedRowCount() const;
+
+		//! \brief Toggles the edition of the values (disabled for views)
+		void setEditable(bool value);
+
+		//! \brief Returns if the values of the column can't be edited (bytea columns)
+		bool isReadOnlyColumn(int column) const;
+
+		//! \brief Returns the name of the data type of the column
+		QString getColumnTypeName(int column) const;
+
+		//! \brief Returns the current value of a cell, considering the changes made by the user
+		QString getCellValue(int row, int column) const;
+
+		//! \brief Returns the retrieved value of a cell. Inserted rows have only null values
+		QString getOriginalValue(int row, int column, bool *is_null = nullptr) const;
+
+		//! \brief Returns the pending operation of a row
+		OperationId getOperation(int row) const;
+
+		/*! \brief Marks the rows to be deleted or restores their retrieved values (NoOperation). Inserted rows can't
+		 * be marked this way, they must be removed (see removeNewRows()) */
+		void markOperation(const std::vector<int> &rows, OperationId operation);
+
+		//! \brief Returns the rows with pending operations in ascending order
+		std::vector<int> getChangedRows() const;
+
+		//! \brief Returns if a row was inserted by the user
+		bool isNewRow(int row) const;
+
+		//! \brief Appends an empty row marked to be inserted returning its index
+		int addRow();
+
+		//! \brief Removes the rows inserted by the user which indexes are in the provided vector
+		void removeNewRows(std::vector<int> rows);
+
+		//! \brief Removes all the rows inserted by the user and restores the retrieved values of the others
+		void clearChanges();
+
+	signals:
+		//! \brief Signal emitted whenever the pending operation of a row changes
+		void s_operationsChanged();
+};
+
+#endif
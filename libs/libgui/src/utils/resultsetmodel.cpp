@@ -17,63 +17,150 @@
 */
 
 #include "resultsetmodel.h"
+#include <QRegularExpression>
+#include <numeric>
+#include <cstring>
 
-ResultSetModel::ResultSetModel(ResultSet &res, Catalog &catalog, QObject *parent) : QAbstractTableModel(parent)
+ResultSetModel::ResultSetModel(ResultSet &res, const std::map<unsigned, QString> &type_names, QObject *parent) : QAbstractTableModel(parent)
 {
 	try
 	{
-		Catalog aux_cat = catalog;
-		std::vector<unsigned> type_ids;
-		std::vector<unsigned>::iterator end;
-		std::vector<attribs_map> types;
-		std::map<int, QString> type_names;
-		int col = 0;
+		std::vector<TuplesBlock> new_blocks;
 
+		// Oids of the built-in types which values are sorted as numbers (int8, int2, int4, oid, float4, float8 and numeric)
+		static const std::vector<unsigned> numeric_type_ids = { 20, 21, 23, 26, 700, 701, 1700 };
+
+		append_scheduled = false;
+		fetch_more = false;
+		mem_usage = queued_mem_usage = peak_mem_usage = 0;
 		col_count = res.getColumnCount();
-		row_count = res.getTupleCount();
+		row_count = 0;
 		insertColumns(0, col_count);
-		insertRows(0, row_count);
 
-		for(col=0; col < col_count; col++)
+		for(int col=0; col < col_count; col++)
 		{
 			header_data.push_back(res.getColumnName(col));
 			type_ids.push_back(res.getColumnTypeId(col));
+			binary_cols.push_back(res.isColumnBinaryFormat(col));
+			numeric_cols.push_back(std::find(numeric_type_ids.begin(), numeric_type_ids.end(),
+																			 res.getColumnTypeId(col)) != numeric_type_ids.end());
 		}
 
-		if(res.accessTuple(ResultSet::FirstTuple))
+		new_blocks.push_back(createBlock(res));
+		appendBlocks(new_blocks);
+		insertRows(0, row_count);
+		setTypeNames(type_names);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+ResultSetModel::TuplesBlock ResultSetModel::createBlock(ResultSet &res)
+{
+	TuplesBlock block;
+	int res_col_count = std::min(col_count, res.getColumnCount());
+	std::vector<qsizetype> arena_sizes(col_count, 0);
+	bool store_value = false;
+
+	block.first_row = 0;
+	block.row_count = res.isValid() && !res.isEmpty() ? res.getTupleCount() : 0;
+	block.columns.resize(col_count);
+
+	// The sizes of the values are known in advance so each arena is allocated only once
+	for(auto tuple : res)
+	{
+		for(int col=0; col < res_col_count; col++)
 		{
-			do
-			{
-				//Fills the current row with the values of current tuple
-				for(int col=0; col < col_count; col++)
-				{
-					if(res.isColumnBinaryFormat(col))
-						item_data.push_back(tr("[binary data]"));
-					else
-						item_data.push_back(res.getColumnValue(col));
-				}
-			}
-			while(res.accessTuple(ResultSet::NextTuple));
+			if(!binary_cols[col])
+				arena_sizes[col] += tuple.getLength(col);
 		}
+	}
+
+	for(int col=0; col < col_count; col++)
+	{
+		block.columns[col].values.reserve(arena_sizes[col]);
+		block.columns[col].offsets.reserve(block.row_count + 1);
+		block.columns[col].offsets.push_back(0);
+		block.columns[col].nulls.reserve(block.row_count);
+	}
 
-		aux_cat.setQueryFilter(Catalog::ListAllObjects);
-		std::sort(type_ids.begin(), type_ids.end());
-		end=std::unique(type_ids.begin(), type_ids.end());
-		type_ids.erase(end, type_ids.end());
+	for(auto tuple : res)
+	{
+		for(int col=0; col < col_count; col++)
+		{
+			ColumnArena &arena = block.columns[col];
 
-		types = aux_cat.getObjectsAttributes(ObjectType::Type, "", "", type_ids);
-		col = 0;
+			/* Binary values aren't stored since they're not displayed. Columns missing
+			 * in the result set (when appending tuples) are filled with empty values */
+			store_value = col < res_col_count && !binary_cols[col] && !tuple.isNull(col);
 
-		for(auto &tp : types)
-			type_names[tp[Attributes::Oid].toInt()]=tp[Attributes::Name];
+			if(store_value)
+				arena.values.append(tuple.getValue(col), tuple.getLength(col));
 
-		for(col=0; col < col_count; col++)
-			tooltip_data.push_back(type_names[res.getColumnTypeId(col)]);
+			arena.offsets.push_back(arena.values.size());
+			arena.nulls.push_back(col < res_col_count && tuple.isNull(col));
+		}
 	}
-	catch(Exception &e)
+
+	return block;
+}
+
+void ResultSetModel::appendBlocks(std::vector<TuplesBlock> &new_blocks)
+{
+	int new_rows = 0;
+
+	for(auto &block : new_blocks)
 	{
-		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+		block.first_row = row_count + new_rows;
+		new_rows += block.row_count;
 	}
+
+	if(new_rows == 0)
+		return;
+
+	// The values are moved to the model, so the arenas are appended without copying them
+	beginInsertRows(QModelIndex(), row_count, row_count + new_rows - 1);
+
+	for(auto &block : new_blocks)
+	{
+		if(block.row_count > 0)
+		{
+			mem_usage += getBlockMemoryUsage(block);
+			blocks.push_back(std::move(block));
+		}
+	}
+
+	updatePeakMemoryUsage();
+
+	row_count += new_rows;
+	endInsertRows();
+	new_blocks.clear();
+}
+
+int ResultSetModel::getStoredRow(int row) const
+{
+	if(static_cast<size_t>(row) < sorted_rows.size())
+		return sorted_rows[row];
+
+	return row;
+}
+
+QByteArrayView ResultSetModel::getValue(int stored_row, int column, bool *is_null) const
+{
+	// Locating the block that holds the row, blocks are ordered by their first rows
+	auto itr = std::upper_bound(blocks.begin(), blocks.end(), stored_row,
+															[](int row, const TuplesBlock &block) { return row < block.first_row; });
+	const TuplesBlock &block = *(--itr);
+	const ColumnArena &arena = block.columns[column];
+	int blk_row = stored_row - block.first_row;
+
+	if(is_null)
+		*is_null = arena.nulls[blk_row];
+
+	return QByteArrayView(arena.values.constData() + arena.offsets[blk_row],
+												arena.offsets[blk_row + 1] - arena.offsets[blk_row]);
 }
 
 int ResultSetModel::rowCount(const QModelIndex &) const
@@ -100,8 +187,14 @@ QVariant ResultSetModel::data(const QModelIndex &index, int role) const
 {
 	if(index.row() < row_count && index.column() < col_count)
 	{
+		// The values are converted to strings only when displayed
 		if(role == Qt::DisplayRole)
-			return (item_data.at(index.row() * col_count + index.column()));
+		{
+			if(binary_cols[index.column()])
+				return tr("[binary data]");
+
+			return QString::fromUtf8(getValue(getStoredRow(index.row()), index.column()));
+		}
 
 		if(role == Qt::TextAlignmentRole)
 			return QVariant(Qt::AlignLeft | Qt::AlignVCenter);
@@ -139,31 +232,12 @@ void ResultSetModel::append(ResultSet &res)
 {
 	try
 	{
-		if(res.isValid() && !res.isEmpty())
+		if(res.isValid() && !res.isEmpty() && res.getTupleCount() > 0)
 		{
-			if(res.accessTuple(ResultSet::FirstTuple))
-			{
-				do
-				{
-					for(int col=0; col < col_count; col++)
-					{
-						if(col < res.getColumnCount())
-						{
-							if(res.isColumnBinaryFormat(col))
-								item_data.push_back(tr("[binary data]"));
-							else
-								item_data.push_back(res.getColumnValue(col));
-						}
-						else
-						{
-							item_data.push_back("");
-						}
-					}
-				}
-				while(res.accessTuple(ResultSet::NextTuple));
-			}
+			std::vector<TuplesBlock> new_blocks;
 
-			row_count += res.getTupleCount();
+			new_blocks.push_back(createBlock(res));
+			appendBlocks(new_blocks);
 		}
 	}
 	catch(Exception &e)
@@ -172,8 +246,252 @@ void ResultSetModel::append(ResultSet &res)
 	}
 }
 
+void ResultSetModel::queueTuples(ResultSet &res)
+{
+	try
+	{
+		if(!res.isValid() || res.isEmpty() || res.getTupleCount() == 0)
+			return;
+
+		QMutexLocker locker(&queue_mtx);
+
+		queued_blocks.push_back(createBlock(res));
+		queued_mem_usage += getBlockMemoryUsage(queued_blocks.back());
+		updatePeakMemoryUsage();
+
+		/* The tuples are appended in the model's thread. Further tuples queued before
+		 * that happens are appended at once, so only one call is scheduled at time */
+		if(!append_scheduled)
+		{
+			append_scheduled = true;
+			QMetaObject::invokeMethod(this, &ResultSetModel::appendQueuedTuples, Qt::QueuedConnection);
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void ResultSetModel::appendQueuedTuples()
+{
+	std::vector<TuplesBlock> new_blocks;
+
+	queue_mtx.lock();
+	new_blocks.swap(queued_blocks);
+	append_scheduled = false;
+	queued_mem_usage = 0;
+	queue_mtx.unlock();
+
+	appendBlocks(new_blocks);
+}
+
+void ResultSetModel::setFetchMoreEnabled(bool value)
+{
+	fetch_more = value;
+}
+
+bool ResultSetModel::canFetchMore(const QModelIndex &parent) const
+{
+	return !parent.isValid() && fetch_more;
+}
+
+void ResultSetModel::fetchMore(const QModelIndex &parent)
+{
+	if(!canFetchMore(parent))
+		return;
+
+	// More rows are requested only once per page, the producer enables the request again when the page is fetched
+	fetch_more = false;
+	emit s_fetchMoreRequested();
+}
+
+void ResultSetModel::sort(int column, Qt::SortOrder order)
+{
+	QModelIndexList old_indexes, new_indexes;
+	std::vector<int> stored_rows, displayed_rows;
+
+	emit layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+
+	// Saving the stored rows of the indexes held by the views so they can be relocated after sorting
+	old_indexes = persistentIndexList();
+
+	for(auto &idx : old_indexes)
+		stored_rows.push_back(getStoredRow(idx.row()));
+
+	if(column < 0 || column >= col_count || binary_cols[column])
+		sorted_rows.clear();
+	else
+	{
+		std::vector<int> rows(row_count);
+		std::vector<double> num_values;
+		std::vector<bool> nulls(row_count);
+		std::vector<QByteArrayView> values(row_count);
+		bool is_null = false;
+
+		std::iota(rows.begin(), rows.end(), 0);
+
+		for(int row = 0; row < row_count; row++)
+		{
+			values[row] = getValue(row, column, &is_null);
+			nulls[row] = is_null;
+		}
+
+		if(numeric_cols[column])
+		{
+			num_values.resize(row_count);
+
+			for(int row = 0; row < row_count; row++)
+				num_values[row] = QByteArray::fromRawData(values[row].data(), values[row].size()).toDouble();
+		}
+
+		// Null values are greater than any other value, as in PostgreSQL
+		auto less_than = [&](int row1, int row2) {
+			if(nulls[row1] || nulls[row2])
+				return !nulls[row1] && nulls[row2];
+
+			if(numeric_cols[column])
+				return num_values[row1] < num_values[row2];
+
+			int cmp = std::memcmp(values[row1].data(), values[row2].data(),
+														std::min(values[row1].size(), values[row2].size()));
+
+			return cmp < 0 || (cmp == 0 && values[row1].size() < values[row2].size());
+		};
+
+		if(order == Qt::AscendingOrder)
+			std::stable_sort(rows.begin(), rows.end(), less_than);
+		else
+			std::stable_sort(rows.begin(), rows.end(), [&](int row1, int row2) { return less_than(row2, row1); });
+
+		sorted_rows = std::move(rows);
+	}
+
+	displayed_rows.resize(row_count);
+
+	for(int row = 0; row < row_count; row++)
+		displayed_rows[getStoredRow(row)] = row;
+
+	for(int idx = 0; idx < old_indexes.size(); idx++)
+		new_indexes.push_back(index(displayed_rows[stored_rows[idx]], old_indexes[idx].column(), QModelIndex()));
+
+	changePersistentIndexList(old_indexes, new_indexes);
+	emit layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+}
+
+QList<int> ResultSetModel::matchRows(int column, const QString &text, Qt::MatchFlags flags) const
+{
+	QList<int> rows;
+
+	if(column < 0 || column >= col_count)
+		return rows;
+
+	Qt::MatchFlags match_type = flags & Qt::MatchTypeMask;
+	Qt::CaseSensitivity case_sens = flags.testFlag(Qt::MatchCaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive;
+	QByteArray utf8_text = text.toUtf8();
+	QRegularExpression regexp;
+	QByteArrayView value;
+	QString str_value;
+	bool matched = false;
+
+	if(match_type == Qt::MatchRegularExpression)
+		regexp.setPattern(text);
+
+	if(case_sens == Qt::CaseInsensitive)
+		regexp.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+
+	for(int row = 0; row < row_count; row++)
+	{
+		if(binary_cols[column])
+			str_value = tr("[binary data]");
+		else
+		{
+			value = getValue(getStoredRow(row), column);
+
+			// Case-sensitive comparisons are done on the UTF-8 values avoiding converting them
+			if(match_type != Qt::MatchRegularExpression && case_sens == Qt::CaseSensitive)
+			{
+				if(match_type == Qt::MatchExactly)
+					matched = value.size() == utf8_text.size() && std::memcmp(value.data(), utf8_text.constData(), value.size()) == 0;
+				else
+					matched = QByteArray::fromRawData(value.data(), value.size()).contains(utf8_text);
+
+				if(matched)
+					rows.push_back(row);
+
+				continue;
+			}
+
+			str_value = QString::fromUtf8(value);
+		}
+
+		if(match_type == Qt::MatchRegularExpression)
+			matched = regexp.match(str_value).hasMatch();
+		else if(match_type == Qt::MatchExactly)
+			matched = str_value.compare(text, case_sens) == 0;
+		else
+			matched = str_value.contains(text, case_sens);
+
+		if(matched)
+			rows.push_back(row);
+	}
+
+	return rows;
+}
+
+std::vector<unsigned> ResultSetModel::getColumnTypeIds()
+{
+	return type_ids;
+}
+
+void ResultSetModel::setTypeNames(const std::map<unsigned, QString> &type_names)
+{
+	tooltip_data.clear();
+
+	for(auto &type_id : type_ids)
+	{
+		auto itr = type_names.find(type_id);
+		tooltip_data.push_back(itr != type_names.end() ? itr->second : "");
+	}
+
+	if(col_count > 0)
+		emit headerDataChanged(Qt::Horizontal, 0, col_count - 1);
+}
+
 bool ResultSetModel::isEmpty()
 {
 	return (row_count <= 0);
 }
 
+qint64 ResultSetModel::getBlockMemoryUsage(const TuplesBlock &block)
+{
+	qint64 size = 0;
+
+	for(auto &col : block.columns)
+	{
+		size += col.values.capacity() +
+						(col.offsets.capacity() * sizeof(unsigned)) +
+						(col.nulls.capacity() / 8);
+	}
+
+	return size;
+}
+
+void ResultSetModel::updatePeakMemoryUsage()
+{
+	qint64 curr_usage = mem_usage + queued_mem_usage,
+			peak_usage = peak_mem_usage;
+
+	while(curr_usage > peak_usage && !peak_mem_usage.compare_exchange_weak(peak_usage, curr_usage));
+}
+
+qint64 ResultSetModel::getMemoryUsage()
+{
+	return mem_usage;
+}
+
+qint64 ResultSetModel::getPeakMemoryUsage()
+{
+	return peak_mem_usage;
+}
+
@@ -27,6 +27,8 @@
 
 #include "guiglobal.h"
 #include <QAbstractTableModel>
+#include <QMutex>
+#include <atomic>
 #include "resultset.h"
 #include "catalog.h"
 
@@ -34,14 +36,90 @@ class __libgui ResultSetModel: public QAbstractTableModel {
 	private:
 		Q_OBJECT
 
-		int col_count, row_count;
-		QStringList item_data, header_data, tooltip_data;
+		/*! \brief Stores the values of a column for a set of rows in a compact form: the values are kept
+		 * in UTF-8 (as received from the server) concatenated in a single buffer, delimited by an offset array
+		 * holding the start of each value plus the end of the last one, and a null bitmap */
+		struct ColumnArena {
+			QByteArray values;
+			std::vector<unsigned> offsets;
+			std::vector<bool> nulls;
+		};
+
+		//! \brief Stores the values of the rows appended at once (the tuples of a result set)
+		struct TuplesBlock {
+			//! \brief Index of the first row of the block in the model (considering the unsorted rows)
+			int first_row;
+
+			int row_count;
+
+			std::vector<ColumnArena> columns;
+		};
+
+		//! \brief Holds the data type oids of the columns
+		std::vector<unsigned> type_ids;
+
+		//! \brief Holds the columns which values are compared as numbers when sorting the rows
+		std::vector<bool> numeric_cols;
+
+		//! \brief Blocks of rows in the order they were appended
+		std::vector<TuplesBlock> blocks;
+
+		/*! \brief Maps the rows displayed (sorted) to the stored rows. When empty the rows are displayed
+		 * in the order they were retrieved. Rows appended after a sort operation are displayed at the end */
+		std::vector<int> sorted_rows;
+
+		//! \brief Blocks queued by another thread that weren't appended to the model yet (see queueTuples())
+		std::vector<TuplesBlock> queued_blocks;
+
+		//! \brief Guards the queued blocks since they are produced and consumed in different threads
+		QMutex queue_mtx;
+
+		//! \brief Indicates that the appending of the queued tuples is already scheduled
+		bool append_scheduled;
+
+		//! \brief Indicates that more rows can be requested to the producer of the tuples (see setFetchMoreEnabled())
+		std::atomic_bool fetch_more;
+
+		/*! \brief Memory (in bytes) allocated by the blocks appended to the model and by the ones queued to be appended.
+		 * The peak is the highest sum of both observed so far, since the blocks are allocated before being queued */
+		std::atomic<qint64> mem_usage, queued_mem_usage, peak_mem_usage;
+
+		//! \brief Returns the memory allocated by the values of a block
+		static qint64 getBlockMemoryUsage(const TuplesBlock &block);
+
+		//! \brief Updates the peak memory usage with the current amount of memory allocated by the stored and queued blocks
+		void updatePeakMemoryUsage();
 
 		void insertColumn(int, const QModelIndex &){}
 		void insertRow(int, const QModelIndex &){}
 
+		//! \brief Creates a block holding the values of all tuples of the result set
+		TuplesBlock createBlock(ResultSet &res);
+
+		//! \brief Moves the provided blocks to the end of the model notifying the attached views
+		void appendBlocks(std::vector<TuplesBlock> &new_blocks);
+
+	protected:
+		int col_count, row_count;
+		QStringList header_data, tooltip_data;
+
+		//! \brief Holds the columns which values are in binary format. Those values are not stored
+		std::vector<bool> binary_cols;
+
+		//! \brief Returns the index of the stored row displayed in the provided position (see sorted_rows)
+		int getStoredRow(int row) const;
+
+		//! \brief Returns the value of a stored row and column without converting it. A null value is returned as an empty view
+		QByteArrayView getValue(int stored_row, int column, bool *is_null = nullptr) const;
+
+	private slots:
+		//! \brief Appends the queued tuples to the model notifying the attached views
+		void appendQueuedTuples();
+
 	public:
-		ResultSetModel(ResultSet &res, Catalog &catalog, QObject *parent = 0);
+		/*! \brief Creates a model holding the tuples of the result set. The names of the columns data types (displayed as
+		 * header tooltips) are taken from the provided map (see Catalog::getTypeNames()) */
+		ResultSetModel(ResultSet &res, const std::map<unsigned, QString> &type_names, QObject *parent = 0);
 		virtual int rowCount(const QModelIndex & = QModelIndex()) const;
 		virtual int columnCount(const QModelIndex &) const;
 		virtual QModelIndex index(int row, int column, const QModelIndex &parent) const;
@@ -49,8 +127,49 @@ class __libgui ResultSetModel: public QAbstractTableModel {
 		virtual QVariant data(const QModelIndex &index, int role) const;
 		virtual QVariant headerData(int section, Qt::Orientation orientation, int role) const;
 		virtual Qt::ItemFlags flags(const QModelIndex &) const;
+
+		//! \brief Appends the tuples of the result set to the model. Must be called from the thread that owns the model
 		void append(ResultSet &res);
+
+		/*! \brief Converts the tuples of the result set and queues them to be appended to the model in the thread that owns it.
+		 * This method can be called from any thread, so the rows can be produced while the model is attached to a view */
+		void queueTuples(ResultSet &res);
+
+		/*! \brief Toggles the requesting of more rows when a view attached to the model is scrolled to its end.
+		 * Used when the tuples are fetched in pages, the request is notified via s_fetchMoreRequested() */
+		void setFetchMoreEnabled(bool value);
+
+		virtual bool canFetchMore(const QModelIndex &parent) const;
+		virtual void fetchMore(const QModelIndex &parent);
+
+		/*! \brief Sorts the rows by the values of the provided column without converting them to strings. Numeric columns
+		 * are compared as numbers and the others byte by byte (which is the code point order for UTF-8 values).
+		 * Null values are placed after the others. A negative column restores the order the rows were retrieved */
+		virtual void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
+
+		/*! \brief Returns the rows (in display order) which values in the provided column match the text. The supported flags are
+		 * Qt::MatchExactly, Qt::MatchContains, Qt::MatchRegularExpression and Qt::MatchCaseSensitive. The case-sensitive
+		 * comparisons are done directly over the stored values, the others convert only the value being tested */
+		QList<int> matchRows(int column, const QString &text, Qt::MatchFlags flags) const;
+
+		//! \brief Returns the data type oids of the columns
+		std::vector<unsigned> getColumnTypeIds();
+
+		/*! \brief Updates the names of the columns data types. Used when the names can't be retrieved while the
+		 * model is created. Must be called from the thread that owns the model */
+		void setTypeNames(const std::map<unsigned, QString> &type_names);
+
 		bool isEmpty();
+
+		//! \brief Returns the memory (in bytes) allocated by the values stored in the model
+		qint64 getMemoryUsage();
+
+		//! \brief Returns the highest amount of memory (in bytes) allocated by the model, including the tuples queued to be appended
+		qint64 getPeakMemoryUsage();
+
+	signals:
+		//! \brief Signal emitted when a view requests more rows and the fetching of more rows is enabled
+		void s_fetchMoreRequested();
 };
 
 #endif
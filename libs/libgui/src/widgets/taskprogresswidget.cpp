@@ -26,6 +26,7 @@ TaskProgressWidget::TaskProgressWidget(QWidget *parent, Qt::WindowFlags f) : QDi
 
 	setupUi(this);
 	setWindowFlags(Qt::Dialog | Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint);
+	cancel_enabled = cancel_requested = false;
 	setAttribute(Qt::WA_TranslucentBackground, true);
 
 	for(auto &obj_tp : obj_types)
@@ -37,6 +38,29 @@ void TaskProgressWidget::addIcon(unsigned id, const QIcon &ico)
 	icons[id]=ico;
 }
 
+void TaskProgressWidget::setCancelEnabled(bool value)
+{
+	cancel_enabled = value;
+}
+
+bool TaskProgressWidget::isCancelRequested()
+{
+	return cancel_requested;
+}
+
+void TaskProgressWidget::reject()
+{
+	// When the task can be cancelled the widget remains visible until the task stops
+	if(cancel_enabled)
+	{
+		cancel_requested = true;
+		text_lbl->setText(tr("Cancelling the task..."));
+		return;
+	}
+
+	QDialog::reject();
+}
+
 void TaskProgressWidget::show()
 {
 	/* Using a event loop as a workaround to give a little time to task progress
@@ -90,7 +114,13 @@ void TaskProgressWidget::updateProgress(int progress, QString text, unsigned ico
 
 void TaskProgressWidget::close()
 {
+	bool enable_cancel = cancel_enabled;
+
+	// QDialog::close() calls reject() which would only flag a cancellation request
+	cancel_enabled = false;
 	QDialog::close();
+	cancel_enabled = enable_cancel;
+	cancel_requested = false;
 	progress_pb->setValue(0);
 	text_lbl->clear();
 	icon_lbl->clear();
@@ -38,13 +38,26 @@ class __libgui TaskProgressWidget: public QDialog, public Ui::TaskProgressWidget
 		//! \brief Stores the icons that are shown as the icons tokens are send via	updateProgress() slot
 		std::map<unsigned, QIcon> icons;
 
+		//! \brief Indicates that the user can request the cancellation of the task by pressing Esc (see setCancelEnabled())
+		bool cancel_enabled,
+
+		//! \brief Indicates that the user requested the cancellation of the task
+		cancel_requested;
+
 	public:
 		TaskProgressWidget(QWidget *parent = nullptr, Qt::WindowFlags f = Qt::Widget);
 		void addIcon(unsigned id, const QIcon &ico);
 
+		/*! \brief Toggles the cancellation of the task by pressing Esc. The widget only flags the request (see isCancelRequested()),
+		 * the task must process the pending events periodically and check the flag in order to stop */
+		void setCancelEnabled(bool value);
+
+		bool isCancelRequested();
+
 	public slots:
 		void show();
 		void close();
+		void reject();
 		void updateProgress(int progress, unsigned icon_id);
 		void updateProgress(int progress, QString text, unsigned icon_id);
 };
@@ -11,17 +11,21 @@ HEADERS += src/parsersglobal.h \
 src/schemaparser.h \
 src/csvdocument.h \
 src/csvparser.h \
+src/csvwriter.h \
 src/xmlparser.h \
+src/sqlstatementsplitter.h \
 src/attribsmap.h \
 src/attributes.h
 
 SOURCES += src/schemaparser.cpp \
 src/csvdocument.cpp \
 src/csvparser.cpp \
+src/csvwriter.cpp \
 src/xmlparser.cpp \
+src/sqlstatementsplitter.cpp \
 src/attributes.cpp
 
-unix|windows: LIBS += $$LIBUTILS_LIB $$XML_LIB
+unix|windows: LIBS += $$LIBUTILS_LIB $$XML_LIB $$ZLIB_LIB
 
 INCLUDEPATH += $$LIBUTILS_INC
 
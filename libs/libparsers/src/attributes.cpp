@@ -235,6 +235,7 @@ namespace Attributes {
 	FillColor("fill-color"),
 	Filter("filter"),
 	FilterOids("filter-oids"),
+	FilterTables("filter-tables"),
 	FilterTableTypes("filter-tab-types"),
 	FinalFunc("final"),
 	FiringType("firing-type"),
@@ -431,6 +432,7 @@ namespace Attributes {
 	PaperMargin("paper-margin"),
 	PaperOrientation("paper-orientation"),
 	PaperType("paper-type"),
+	ParallelDiff("parallel-diff"),
 	ParallelType("parallel-type"),
 	Parameter("parameter"),
 	Parameters("parameters"),
@@ -541,6 +543,7 @@ namespace Attributes {
 	RoleMembers("rolemembers"),
 	RoleType("role-type"),
 	RowAmount("row-amount"),
+	RowsPageSize("rows-page-size"),
 	Rules("rules"),
 	SaveLastPosition("save-last-position"),
 	SaveRestoreGeometry("save-restore-geometry"),
@@ -677,6 +680,7 @@ namespace Attributes {
 	UseCurvedLines("use-curved-lines"),
 	UsePlaceholders("use-placeholders"),
 	UseSignature("use-signature"),
+	UseSnapshot("use-snapshot"),
 	UseSorting("use-sorting"),
 	UseUniqueNames("use-unique-names"),
 	UsingExp("using-exp"),
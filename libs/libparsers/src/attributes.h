@@ -249,6 +249,7 @@ namespace Attributes {
 	FillColor,
 	Filter,
 	FilterOids,
+	FilterTables,
 	FilterTableTypes,
 	FinalFunc,
 	FiringType,
@@ -446,6 +447,7 @@ namespace Attributes {
 	PaperMargin,
 	PaperOrientation,
 	PaperType,
+	ParallelDiff,
 	ParallelType,
 	Parameter,
 	Parameters,
@@ -556,6 +558,7 @@ namespace Attributes {
 	RoleMembers,
 	RoleType,
 	RowAmount,
+	RowsPageSize,
 	Rules,
 	SaveLastPosition,
 	SaveRestoreGeometry,
@@ -692,6 +695,7 @@ namespace Attributes {
 	UseCurvedLines,
 	UsePlaceholders,
 	UseSignature,
+	UseSnapshot,
 	UseSorting,
 	UseUniqueNames,
 	UsingExp,
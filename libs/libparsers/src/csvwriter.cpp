@@ -0,0 +1,296 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "csvwriter.h"
+#include "csvdocument.h"
+#include "exception.h"
+
+#ifdef ZLIB_SUPPORT
+	#include <zlib.h>
+#endif
+
+CsvWriter::CsvWriter()
+{
+	setSpecialChars(CsvDocument::Separator,
+									CsvDocument::TextDelimiter,
+									CsvDocument::LineBreak);
+	delimit_values = true;
+	row_started = false;
+	output = nullptr;
+	gz_file = nullptr;
+	bytes_written = 0;
+	row_count = 0;
+}
+
+CsvWriter::~CsvWriter()
+{
+	try
+	{
+		close();
+	}
+	catch(Exception &)
+	{
+		/* Errors raised while closing in the destructor are ignored
+		 * since exceptions can't escape from it */
+	}
+}
+
+void CsvWriter::setSpecialChars(const QChar &sep, const QChar &txt_delim, const QChar &ln_break)
+{
+	separator = sep;
+	text_delim = txt_delim;
+	line_break = ln_break;
+}
+
+void CsvWriter::setDelimitValues(bool value)
+{
+	delimit_values = value;
+}
+
+void CsvWriter::open(const QString &filename, bool compress)
+{
+	close();
+
+#ifndef ZLIB_SUPPORT
+	if(compress)
+		throw Exception(Exception::getErrorMessage(ErrorCode::UnsupportedFileCompression).arg(filename),
+										ErrorCode::UnsupportedFileCompression,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+#else
+	if(compress)
+	{
+		#ifdef Q_OS_WIN
+			gz_file = gzopen_w(reinterpret_cast<const wchar_t *>(filename.utf16()), "wb");
+		#else
+			gz_file = gzopen(filename.toLocal8Bit().constData(), "wb");
+		#endif
+
+		if(!gz_file)
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(filename),
+											ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+	else
+#endif
+	{
+		file.setFileName(filename);
+
+		if(!file.open(QFile::WriteOnly | QFile::Truncate))
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(filename),
+											ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		output = &file;
+	}
+
+	this->filename = filename;
+	bytes_written = 0;
+	row_count = 0;
+	buffer.reserve(BufferSize);
+}
+
+void CsvWriter::open(QIODevice *device)
+{
+	close();
+
+	if(!device || !device->isWritable())
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	output = device;
+	bytes_written = 0;
+	row_count = 0;
+	buffer.reserve(BufferSize);
+}
+
+void CsvWriter::close()
+{
+	if(!isOpen())
+		return;
+
+	try
+	{
+		if(row_started)
+			endRow();
+
+		flush(true);
+	}
+	catch(Exception &e)
+	{
+		#ifdef ZLIB_SUPPORT
+			if(gz_file)
+				gzclose(static_cast<gzFile>(gz_file));
+		#endif
+
+		gz_file = nullptr;
+
+		if(output == &file)
+			file.close();
+
+		output = nullptr;
+		row_started = false;
+		buffer.clear();
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+
+#ifdef ZLIB_SUPPORT
+	if(gz_file && gzclose(static_cast<gzFile>(gz_file)) != Z_OK)
+	{
+		gz_file = nullptr;
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(filename),
+										ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+#endif
+
+	gz_file = nullptr;
+
+	if(output == &file)
+		file.close();
+
+	output = nullptr;
+	row_started = false;
+	filename.clear();
+	buffer.clear();
+	buffer.squeeze();
+}
+
+bool CsvWriter::isOpen()
+{
+	return output || gz_file;
+}
+
+void CsvWriter::flush(bool force)
+{
+	if(buffer.isEmpty() || (!force && buffer.size() < BufferSize))
+		return;
+
+	bool error = false;
+
+#ifdef ZLIB_SUPPORT
+	if(gz_file)
+		error = gzwrite(static_cast<gzFile>(gz_file), buffer.constData(),
+										static_cast<unsigned>(buffer.size())) != buffer.size();
+	else
+#endif
+		error = output->write(buffer) != buffer.size();
+
+	if(error)
+	{
+		QString name = !filename.isEmpty() ? filename : QString("<buffer>");
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(name),
+										ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+
+	bytes_written += buffer.size();
+	buffer.resize(0);
+}
+
+void CsvWriter::writeValue(const QString &value)
+{
+	if(!isOpen())
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	if(row_started)
+		buffer.append(QString(separator).toUtf8());
+
+	if(delimit_values)
+	{
+		QString delim = QString(text_delim);
+
+		buffer.append(delim.toUtf8());
+
+		if(value.contains(text_delim))
+			buffer.append(QString(value).replace(delim, delim + delim).toUtf8());
+		else
+			buffer.append(value.toUtf8());
+
+		buffer.append(delim.toUtf8());
+	}
+	else
+		buffer.append(value.toUtf8());
+
+	row_started = true;
+}
+
+void CsvWriter::endRow()
+{
+	if(!isOpen())
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	buffer.append(QString(line_break).toUtf8());
+	row_started = false;
+	row_count++;
+
+	try
+	{
+		flush(false);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void CsvWriter::writeRow(const QStringList &values)
+{
+	try
+	{
+		for(auto &value : values)
+			writeValue(value);
+
+		endRow();
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void CsvWriter::writeRaw(const char *data, qint64 size)
+{
+	if(!isOpen())
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	if(!data || size <= 0)
+		return;
+
+	try
+	{
+		buffer.append(data, size);
+		flush(false);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+qint64 CsvWriter::getBytesWritten()
+{
+	return bytes_written;
+}
+
+unsigned CsvWriter::getRowCount()
+{
+	return row_count;
+}
+
+bool CsvWriter::isCompressionSupported()
+{
+#ifdef ZLIB_SUPPORT
+	return true;
+#else
+	return false;
+#endif
+}
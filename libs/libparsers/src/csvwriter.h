@@ -0,0 +1,126 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libparsers
+\class CsvWriter
+\brief This class implements a forward-only CSV/plain text writer that streams rows to a file (optionally gzip compressed)
+or to any other output device in small chunks so big result sets don't need to be fully kept in memory.
+*/
+
+#ifndef CSV_WRITER_H
+#define CSV_WRITER_H
+
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include "parsersglobal.h"
+
+class __libparsers CsvWriter {
+	private:
+		//! \brief Indicates the character used as values separator
+		QChar separator,
+
+		//! \brief Indicates the character used as text delimiter
+		text_delim,
+
+		//! \brief Indicates the character used as line break
+		line_break;
+
+		//! \brief Indicates if the values must be delimited by the text delimiter (CSV format)
+		bool delimit_values,
+
+		//! \brief Indicates if the writer is in the middle of a row (at least one value written in it)
+		row_started;
+
+		//! \brief The file opened by open(QString)
+		QFile file;
+
+		//! \brief The device in which data is effectively written (file or the one provided in open(QIODevice *))
+		QIODevice *output;
+
+		//! \brief The gzip handle used when the output file is compressed (gzFile)
+		void *gz_file;
+
+		//! \brief Holds the data not yet written to the output
+		QByteArray buffer;
+
+		//! \brief The name of the current output file (empty when writing to a custom device)
+		QString filename;
+
+		//! \brief Amount of bytes written to the output so far
+		qint64 bytes_written;
+
+		//! \brief Amount of rows written so far
+		unsigned row_count;
+
+		//! \brief Writes the buffered data to the output if its size reached BufferSize or if force is true
+		void flush(bool force);
+
+	public:
+		//! \brief Size of the chunks written to the output
+		static constexpr int BufferSize = 65536;
+
+		CsvWriter();
+
+		//! \brief Closes the output writing any pending data
+		~CsvWriter();
+
+		void setSpecialChars(const QChar &separator, const QChar &text_delim, const QChar &ln_break);
+
+		/*! \brief Toggles the enclosing of values with the text delimiter (CSV format).
+		 * When false, values are written as is, which is used to generate plain text (e.g. tab separated) */
+		void setDelimitValues(bool value);
+
+		/*! \brief Opens the file to be written. If compress is true the contents are written in gzip format.
+		 * Raises an exception if the file can't be opened or if compression was requested but pgModeler
+		 * was built without zlib support */
+		void open(const QString &filename, bool compress = false);
+
+		//! \brief Uses an already opened device (e.g. a QBuffer) as output
+		void open(QIODevice *device);
+
+		//! \brief Writes pending data and closes the output. Files opened by the writer are closed as well
+		void close();
+
+		//! \brief Returns if the writer has an output opened
+		bool isOpen();
+
+		//! \brief Writes a single value of the current row, separating it from the previous one when needed
+		void writeValue(const QString &value);
+
+		//! \brief Ends the current row by writing a line break
+		void endRow();
+
+		//! \brief Writes a complete row
+		void writeRow(const QStringList &values);
+
+		//! \brief Writes data already formatted (e.g. the output of a COPY ... TO STDOUT command)
+		void writeRaw(const char *data, qint64 size);
+
+		//! \brief Returns the amount of bytes written to the output (pending data in buffer not included)
+		qint64 getBytesWritten();
+
+		//! \brief Returns the amount of complete rows written via endRow()/writeRow()
+		unsigned getRowCount();
+
+		//! \brief Returns if pgModeler was built with gzip compression support
+		static bool isCompressionSupported();
+};
+
+#endif
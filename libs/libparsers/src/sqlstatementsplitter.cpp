@@ -0,0 +1,416 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "sqlstatementsplitter.h"
+#include "attributes.h"
+#include <cctype>
+#include <cstring>
+
+SQLStatementSplitter::SQLStatementSplitter()
+{
+	comments_enabled = ddl_end_token_only = false;
+	reset();
+}
+
+void SQLStatementSplitter::reset()
+{
+	buffer.clear();
+	dollar_tag.clear();
+	state = NoState;
+	pos = comment_start = discarded_size = 0;
+	stmt_start = -1;
+	comment_depth = paren_depth = atomic_depth = 0;
+	input_finished = begin_found = false;
+}
+
+void SQLStatementSplitter::setBuffer(const QByteArray &data)
+{
+	reset();
+	buffer = data;
+	input_finished = true;
+}
+
+void SQLStatementSplitter::appendData(QByteArrayView data)
+{
+	qsizetype keep_pos = pos;
+
+	/* Discarding the data already scanned that is not part of the statement or comment
+	 * being scanned in order to keep the buffer as small as possible */
+	if(stmt_start >= 0)
+		keep_pos = stmt_start;
+	else if(state == LineComment || state == BlockComment)
+		keep_pos = comment_start;
+
+	if(keep_pos > 0)
+	{
+		buffer.remove(0, keep_pos);
+		pos -= keep_pos;
+		comment_start -= keep_pos;
+		discarded_size += keep_pos;
+
+		if(stmt_start >= 0)
+			stmt_start -= keep_pos;
+	}
+
+	buffer.append(data);
+}
+
+void SQLStatementSplitter::finishInput()
+{
+	input_finished = true;
+}
+
+void SQLStatementSplitter::setCommentsEnabled(bool value)
+{
+	comments_enabled = value;
+}
+
+void SQLStatementSplitter::setDdlEndTokenOnly(bool value)
+{
+	ddl_end_token_only = value;
+}
+
+bool SQLStatementSplitter::isIdentifierChar(char chr)
+{
+	unsigned char uchr = static_cast<unsigned char>(chr);
+	return uchr >= 0x80 || std::isalnum(uchr) || chr == '_';
+}
+
+qsizetype SQLStatementSplitter::matchWord()
+{
+	qsizetype len = buffer.size(), idx = pos;
+	const char *data = buffer.constData();
+
+	// Words can't start in the middle of another one (e.g. after the $ of an identifier like foo$bar)
+	if(!isIdentifierChar(data[pos]) || (pos > 0 && (isIdentifierChar(data[pos - 1]) || data[pos - 1] == '$')))
+		return 0;
+
+	while(idx < len && isIdentifierChar(data[idx]))
+		idx++;
+
+	if(idx >= len && !input_finished)
+		return -1;
+
+	return idx - pos;
+}
+
+bool SQLStatementSplitter::isKeyword(qsizetype word_len, const char *keyword) const
+{
+	return word_len == static_cast<qsizetype>(std::strlen(keyword)) &&
+				 qstrnicmp(buffer.constData() + pos, keyword, word_len) == 0;
+}
+
+qsizetype SQLStatementSplitter::matchDollarTag()
+{
+	qsizetype len = buffer.size(), idx = pos + 1;
+	const char *data = buffer.constData();
+
+	if(idx >= len)
+		return input_finished ? 0 : -1;
+
+	// Anonymous tag $$
+	if(data[idx] == '$')
+		return 2;
+
+	// Tags follow the identifiers rules but can't start with digits (e.g. $1 is a parameter)
+	if(std::isdigit(static_cast<unsigned char>(data[idx])) || !isIdentifierChar(data[idx]))
+		return 0;
+
+	while(idx < len && isIdentifierChar(data[idx]))
+		idx++;
+
+	if(idx >= len)
+		return input_finished ? 0 : -1;
+
+	return data[idx] == '$' ? idx - pos + 1 : 0;
+}
+
+bool SQLStatementSplitter::finishStatement(qsizetype end_pos, SpanEnd end, Span &span)
+{
+	const char *data = buffer.constData();
+
+	while(end_pos > stmt_start && std::isspace(static_cast<unsigned char>(data[end_pos - 1])))
+		end_pos--;
+
+	span.offset = stmt_start;
+	span.length = end_pos - stmt_start;
+	span.type = Statement;
+	span.end = end;
+	stmt_start = -1;
+	paren_depth = atomic_depth = 0;
+	begin_found = false;
+
+	// Empty statements (a lone semicolon) are skipped
+	return span.length > 0 && !(span.length == 1 && data[span.offset] == ';');
+}
+
+bool SQLStatementSplitter::nextSpan(Span &span)
+{
+	static const QByteArray ddl_end_token = Attributes::DdlEndToken.toUtf8();
+	qsizetype len = buffer.size(), tag_len = 0, word_len = 0, eol = 0;
+	const char *data = buffer.constData();
+	char chr = 0, next_chr = 0;
+	bool has_next = false;
+
+	while(pos < len)
+	{
+		chr = data[pos];
+		has_next = pos + 1 < len;
+		next_chr = has_next ? data[pos + 1] : 0;
+
+		// Two-chars sequences can't be decided without the next char
+		if(!has_next && !input_finished &&
+			 (state == SingleQuote || state == EscapeString || state == BlockComment ||
+				(state == NoState && (chr == '-' || chr == '/'))))
+			return false;
+
+		if(state == SingleQuote || state == EscapeString)
+		{
+			if(state == EscapeString && chr == '\\')
+				pos += 2;
+			// Doubled quotes don't end the string
+			else if(chr == '\'' && next_chr == '\'')
+				pos += 2;
+			else
+			{
+				if(chr == '\'')
+					state = NoState;
+
+				pos++;
+			}
+		}
+		else if(state == DoubleQuote)
+		{
+			if(chr == '"')
+				state = NoState;
+
+			pos++;
+		}
+		else if(state == DollarQuote)
+		{
+			if(chr == '$')
+			{
+				if(len - pos < dollar_tag.size() && !input_finished)
+					return false;
+
+				if(len - pos >= dollar_tag.size() &&
+					 std::memcmp(data + pos, dollar_tag.constData(), dollar_tag.size()) == 0)
+				{
+					pos += dollar_tag.size();
+					dollar_tag.clear();
+					state = NoState;
+					continue;
+				}
+			}
+
+			pos++;
+		}
+		else if(state == LineComment)
+		{
+			eol = buffer.indexOf('\n', pos);
+
+			if(eol < 0 && !input_finished)
+				return false;
+
+			if(eol < 0)
+				eol = len;
+
+			state = NoState;
+			pos = eol < len ? eol + 1 : eol;
+
+			// Ignoring the trailing whitespaces (e.g. carriage return) of the comment
+			while(eol > comment_start && std::isspace(static_cast<unsigned char>(data[eol - 1])))
+				eol--;
+
+			// The DDL end token finishes the statement being scanned
+			if(eol - comment_start == ddl_end_token.size() &&
+				 std::memcmp(data + comment_start, ddl_end_token.constData(), ddl_end_token.size()) == 0)
+			{
+				if(stmt_start >= 0 && finishStatement(comment_start, DdlEndToken, span))
+					return true;
+			}
+			else if(stmt_start < 0 && comments_enabled)
+			{
+				span.offset = comment_start;
+				span.length = eol - comment_start;
+				span.type = Comment;
+				span.end = EndOfInput;
+				return true;
+			}
+		}
+		else if(state == BlockComment)
+		{
+			if(chr == '/' && next_chr == '*')
+			{
+				comment_depth++;
+				pos += 2;
+			}
+			else if(chr == '*' && next_chr == '/')
+			{
+				comment_depth--;
+				pos += 2;
+
+				if(comment_depth == 0)
+				{
+					state = NoState;
+
+					if(stmt_start < 0 && comments_enabled)
+					{
+						span.offset = comment_start;
+						span.length = pos - comment_start;
+						span.type = Comment;
+						span.end = EndOfInput;
+						return true;
+					}
+				}
+			}
+			else
+				pos++;
+		}
+		else if(std::isspace(static_cast<unsigned char>(chr)))
+			pos++;
+		else if(chr == '-' && next_chr == '-')
+		{
+			state = LineComment;
+			comment_start = pos;
+			pos += 2;
+		}
+		else if(chr == '/' && next_chr == '*')
+		{
+			state = BlockComment;
+			comment_start = pos;
+			comment_depth = 1;
+			pos += 2;
+		}
+		else
+		{
+			word_len = matchWord();
+
+			if(word_len < 0)
+				return false;
+
+			if(stmt_start < 0)
+				stmt_start = pos;
+
+			/* Tracking the SQL-standard function bodies (BEGIN ATOMIC ... END), including the CASE ... END
+			 * constructions inside them, so the semicolons of their statements don't end the whole statement */
+			if(word_len > 0)
+			{
+				if(begin_found && paren_depth == 0 && isKeyword(word_len, "ATOMIC"))
+					atomic_depth++;
+				else if(atomic_depth > 0 && isKeyword(word_len, "CASE"))
+					atomic_depth++;
+				else if(atomic_depth > 0 && isKeyword(word_len, "END"))
+					atomic_depth--;
+
+				begin_found = isKeyword(word_len, "BEGIN");
+				pos += word_len;
+				continue;
+			}
+
+			begin_found = false;
+
+			if(chr == '(' || chr == ')')
+			{
+				if(chr == '(')
+					paren_depth++;
+				else if(paren_depth > 0)
+					paren_depth--;
+
+				pos++;
+			}
+			else if(chr == ';')
+			{
+				pos++;
+
+				// Only the top-level semicolons end the statement
+				if(!ddl_end_token_only && paren_depth == 0 && atomic_depth == 0 &&
+					 finishStatement(pos, Semicolon, span))
+					return true;
+			}
+			else if(chr == '\'')
+			{
+				// Escape strings E'...' accept backslash escapes
+				if(pos > 0 && (data[pos - 1] == 'E' || data[pos - 1] == 'e') &&
+					 (pos - 1 == 0 || !isIdentifierChar(data[pos - 2])))
+					state = EscapeString;
+				else
+					state = SingleQuote;
+
+				pos++;
+			}
+			else if(chr == '"')
+			{
+				state = DoubleQuote;
+				pos++;
+			}
+			else if(chr == '$' && (pos == 0 || !isIdentifierChar(data[pos - 1])))
+			{
+				tag_len = matchDollarTag();
+
+				if(tag_len < 0)
+					return false;
+
+				if(tag_len > 0)
+				{
+					dollar_tag = buffer.mid(pos, tag_len);
+					state = DollarQuote;
+					pos += tag_len;
+				}
+				else
+					pos++;
+			}
+			else
+				pos++;
+		}
+	}
+
+	// Any remaining statement (even with unterminated strings or comments) is returned when the input finishes
+	if(input_finished)
+	{
+		pos = len;
+
+		if(stmt_start >= 0)
+			return finishStatement(len, EndOfInput, span);
+	}
+
+	return false;
+}
+
+bool SQLStatementSplitter::atEnd()
+{
+	return input_finished && pos >= buffer.size() && stmt_start < 0;
+}
+
+QByteArrayView SQLStatementSplitter::getSpanData(const Span &span) const
+{
+	if(span.offset < 0 || span.offset + span.length > buffer.size())
+		return QByteArrayView();
+
+	return QByteArrayView(buffer.constData() + span.offset, span.length);
+}
+
+QString SQLStatementSplitter::getSpanText(const Span &span) const
+{
+	return QString::fromUtf8(getSpanData(span));
+}
+
+qsizetype SQLStatementSplitter::getProcessedSize() const
+{
+	return discarded_size + pos;
+}
@@ -0,0 +1,183 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libparsers
+\class SQLStatementSplitter
+\brief Implements an incremental tokenizer that splits an UTF-8 encoded SQL script into statements in a single pass.
+The splitter is aware of quoted strings and identifiers, escape strings (E'...'), dollar-quoted bodies, line and (nested) block comments,
+so semicolons inside them don't end a statement. Semicolons inside parenthesis (e.g. the actions of a rule) and inside
+SQL-standard function bodies (BEGIN ATOMIC ... END) don't end a statement either. A statement ends at a top-level semicolon,
+at the DDL end token (Attributes::DdlEndToken) or at the end of the input. The script can be provided at once (setBuffer) or in chunks (appendData), in the latter case
+a statement split between two chunks is only returned when the chunk that completes it is appended.
+The splits are returned as spans (offset and length) over the buffer held by the splitter, so no statement is copied.
+*/
+
+#ifndef SQL_STATEMENT_SPLITTER_H
+#define SQL_STATEMENT_SPLITTER_H
+
+#include "parsersglobal.h"
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+
+class __libparsers SQLStatementSplitter {
+	public:
+		enum SpanType: unsigned {
+			//! \brief The span is a statement (it may contain comments placed among its tokens)
+			Statement,
+
+			//! \brief The span is a comment placed between two statements (returned only when comments are enabled)
+			Comment
+		};
+
+		enum SpanEnd: unsigned {
+			//! \brief The statement ends at a semicolon (included in the span)
+			Semicolon,
+
+			//! \brief The statement ends at a DDL end token (the token is not included in the span)
+			DdlEndToken,
+
+			//! \brief The statement ends at the end of the input or the span is a comment
+			EndOfInput
+		};
+
+		struct Span {
+			//! \brief Position of the first byte of the span in the splitter's buffer (see getSpanData())
+			qsizetype offset = 0;
+
+			//! \brief Number of bytes in the span
+			qsizetype length = 0;
+
+			SpanType type = Statement;
+
+			SpanEnd end = EndOfInput;
+		};
+
+	private:
+		//! \brief Scanning states which may be kept between two chunks of data
+		enum ScanState: unsigned {
+			NoState,
+			SingleQuote,
+			EscapeString,
+			DoubleQuote,
+			DollarQuote,
+			LineComment,
+			BlockComment
+		};
+
+		//! \brief Holds the data being split. Data already returned in spans is discarded when new chunks are appended
+		QByteArray buffer;
+
+		//! \brief The tag of the current dollar-quoted body (including the dollar signs)
+		QByteArray dollar_tag;
+
+		ScanState state;
+
+		//! \brief Current position of the scanner in the buffer
+		qsizetype pos,
+
+		//! \brief Start position of the statement being scanned (-1 when no statement was started yet)
+		stmt_start,
+
+		//! \brief Start position of the comment being scanned
+		comment_start,
+
+		//! \brief Amount of bytes discarded from the start of the buffer since the last reset (see getProcessedSize())
+		discarded_size;
+
+		//! \brief Nesting level of the current block comment
+		unsigned comment_depth,
+
+		//! \brief Nesting level of the parenthesis in the statement being scanned
+		paren_depth,
+
+		//! \brief Nesting level of the BEGIN ATOMIC ... END blocks (and the CASE ... END inside them) in the statement being scanned
+		atomic_depth;
+
+		//! \brief Indicates that no more data will be appended so incomplete tokens at the end of the buffer are accepted
+		bool input_finished,
+
+		//! \brief Indicates that comments placed between statements are returned as spans
+		comments_enabled,
+
+		//! \brief Indicates that statements end only at the DDL end token or at the end of the input (semicolons are ignored)
+		ddl_end_token_only,
+
+		//! \brief Indicates that the last word scanned in the statement is BEGIN (used to detect BEGIN ATOMIC)
+		begin_found;
+
+		//! \brief Returns if the byte can be part of an identifier (non-ASCII bytes are considered letters)
+		static bool isIdentifierChar(char chr);
+
+		/*! \brief Tries to match a word (identifier or keyword) at the current position. Returns the size of the word,
+		 * 0 when there's no word or -1 when more data is needed to decide */
+		qsizetype matchWord();
+
+		//! \brief Returns if the word at the current position with the provided size is the keyword (case insensitive)
+		bool isKeyword(qsizetype word_len, const char *keyword) const;
+
+		/*! \brief Tries to match a dollar quote tag ($tag$ or $$) at the current position. Returns the size of the tag,
+		 * 0 when there's no tag or -1 when more data is needed to decide */
+		qsizetype matchDollarTag();
+
+		/*! \brief Configures the span with the statement being scanned, ending it at end_pos (exclusive). Trailing whitespaces
+		 * are not included in the span. Returns false if the statement is empty */
+		bool finishStatement(qsizetype end_pos, SpanEnd end, Span &span);
+
+	public:
+		SQLStatementSplitter();
+
+		//! \brief Discards all the data and resets the scanning state
+		void reset();
+
+		//! \brief Sets the whole script to be split (the data is implicitly shared not copied). This method finishes the input.
+		void setBuffer(const QByteArray &data);
+
+		/*! \brief Appends a chunk of the script to be split. The data already returned in spans is discarded, so spans
+		 * returned before this call are no longer valid */
+		void appendData(QByteArrayView data);
+
+		//! \brief Indicates that no more data will be appended, so the remaining data in the buffer can be returned as the last statement
+		void finishInput();
+
+		//! \brief Toggles the return of the comments placed between statements as spans of the type Comment
+		void setCommentsEnabled(bool value);
+
+		/*! \brief Toggles the split of the statements only at DDL end tokens and at the end of the input, so a block
+		 * delimited by DDL end tokens holding several statements (e.g. generic SQL objects) is returned as a single span */
+		void setDdlEndTokenOnly(bool value);
+
+		/*! \brief Scans the buffer for the next span. Returns false when the end of the buffer is reached,
+		 * in that case if the input is not finished more data must be appended to continue the scanning */
+		bool nextSpan(Span &span);
+
+		//! \brief Returns if all the input was provided and scanned
+		bool atEnd();
+
+		//! \brief Returns the data of the provided span as a view over the splitter's buffer (valid until new data is appended)
+		QByteArrayView getSpanData(const Span &span) const;
+
+		//! \brief Returns the data of the provided span as a string
+		QString getSpanText(const Span &span) const;
+
+		//! \brief Returns the amount of bytes of the input scanned since the last reset (used to calculate progress)
+		qsizetype getProcessedSize() const;
+};
+
+#endif
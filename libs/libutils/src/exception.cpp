@@ -284,6 +284,11 @@ QString Exception::messages[Exception::ErrorCount][2]={
 	{"MalformedCsvMissingDelim", QT_TR_NOOP("Malformed CSV document detected! Missing close text delimiter `%1' row `%2'!")},
 	{"RefInvCsvDocumentValue", QT_TR_NOOP("Trying to get a value from the CSV document in an invalid position: row `%1', column `%2'!")},
 	{"ModelFileSaveFailure", QT_TR_NOOP("Failed to save the database model to file `%1'! In order to avoid data loss, the backup file `%2' was restored. Note that the backup file will not be erased automatically, the user must delete it manually or, if preferred, copy it to a safe place to have an extra security copy!")},
+	{"InvCatalogRecordingFile", QT_TR_NOOP("The file `%1' is not a valid catalog recording or it was created by an incompatible version of pgModeler!")},
+	{"QueryNotRecorded", QT_TR_NOOP("The result of the executed query is not present in the catalog recording `%1'! Make sure the recording was created using the same database, objects and options of the current operation.")},
+	{"AsyncCommandRunning", QT_TR_NOOP("Trying to execute a command while another one is still running asynchronously in the same connection!")},
+	{"CommandExecTimeout", QT_TR_NOOP("The command execution was cancelled because it exceeded the timeout of `%1' milliseconds!")},
+	{"UnsupportedFileCompression", QT_TR_NOOP("The file `%1' can't be written in compressed format because this build of pgModeler has no support to gzip compression!")},
 };
 
 Exception::Exception()
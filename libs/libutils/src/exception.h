@@ -300,12 +300,17 @@ enum class ErrorCode: unsigned {
 	MalformedCsvInvalidCols,
 	MalformedCsvMissingDelim,
 	RefInvCsvDocumentValue,
-	ModelFileSaveFailure
+	ModelFileSaveFailure,
+	InvCatalogRecordingFile,
+	QueryNotRecorded,
+	AsyncCommandRunning,
+	CommandExecTimeout,
+	UnsupportedFileCompression
 };
 
 class __libutils Exception {
 	private:
-		static constexpr unsigned ErrorCount=265;
+		static constexpr unsigned ErrorCount=270;
 
 		//! \brief Constants used to access the error details
 		static constexpr unsigned ErrorCodeId=0, ErrorMessage=1;
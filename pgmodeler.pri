@@ -63,6 +63,14 @@ defined(DEMO_VERSION, var) {
 # Set up the flag passed to compiler to disable all code related to update checking
 defined(NO_UPDATE_CHECK, var): DEFINES+=NO_UPDATE_CHECK
 
+# Set up the flag passed to compiler to enable gzip compression of exported files.
+# ZLIB_LIB -> Full path to libz.(so | dll | dylib) or the linker flags (e.g. -lz)
+# ZLIB_INC -> Root path where zlib headers can be found (optional)
+defined(ZLIB_LIB, var) {
+  DEFINES+=ZLIB_SUPPORT
+  defined(ZLIB_INC, var): INCLUDEPATH += "$$ZLIB_INC"
+}
+
 # Set up the plugin folder to be used
 PLUGINS_FOLDER=plugins
 defined(PRIVATE_PLUGINS, var) {
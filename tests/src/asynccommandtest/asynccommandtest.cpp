@@ -0,0 +1,199 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "asynccommand.h"
+#include "catalogreplayfixture.h"
+
+class AsyncCommandTest: public QObject {
+	private:
+		Q_OBJECT
+
+		static constexpr char RecordingFile[] = "asynccommand.rec",
+		DbName[] = "testdb",
+		Query[] = "SELECT nspname FROM pg_namespace";
+
+		Connection conn;
+
+	private slots:
+		void initTestCase();
+		void cleanupTestCase();
+		void testCallbackReceivesResult();
+		void testCommandsAreMultiplexed();
+		void testCancelCommand();
+		void testFailedCommandDeliversError();
+		void testRaiseExceptionWhenCommandIsRunning();
+		void testExecutionTimingsAreCollected();
+};
+
+void AsyncCommandTest::initTestCase()
+{
+	CatalogReplayFixture::recordResults(RecordingFile, DbName, {{ Query, CatalogReplayFixture::createResult(
+		{{ "nspname", 19 }}, {{ "public" }, { "pg_catalog" }}) }});
+
+	// The commands are executed over a replayed connection so no server is needed
+	CatalogReplayFixture::connectReplay(conn, RecordingFile, DbName);
+}
+
+void AsyncCommandTest::cleanupTestCase()
+{
+	conn.close();
+	Connection::stopRecording();
+}
+
+void AsyncCommandTest::testCallbackReceivesResult()
+{
+	try
+	{
+		bool called = false;
+		AsyncCommand::CommandStatus status = AsyncCommand::NotStarted;
+		int tuple_count = 0;
+
+		AsyncCommand::execute(conn, Query, [&](AsyncCommand &cmd) {
+			called = true;
+			status = cmd.getStatus();
+			tuple_count = cmd.getResult().getTupleCount();
+		});
+
+		// The callback is never called before the control returns to the event loop
+		QVERIFY(!called);
+		QTRY_VERIFY(called);
+		QCOMPARE(status, AsyncCommand::Finished);
+		QCOMPARE(tuple_count, 2);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void AsyncCommandTest::testCommandsAreMultiplexed()
+{
+	try
+	{
+		Connection other_conn = conn;
+		AsyncCommand cmd1(conn), cmd2(other_conn);
+		QSignalSpy spy1(&cmd1, &AsyncCommand::s_commandFinished),
+				spy2(&cmd2, &AsyncCommand::s_commandFinished);
+
+		other_conn.connect();
+		cmd1.start(Query);
+		cmd2.start(Query);
+
+		QVERIFY(cmd1.isRunning());
+		QVERIFY(cmd2.isRunning());
+		QTRY_COMPARE(spy1.count(), 1);
+		QTRY_COMPARE(spy2.count(), 1);
+		QCOMPARE(cmd1.getStatus(), AsyncCommand::Finished);
+		QCOMPARE(cmd2.getStatus(), AsyncCommand::Finished);
+
+		QVERIFY(cmd2.getResult().accessTuple(ResultSet::LastTuple));
+		QCOMPARE(QString(cmd2.getResult().getColumnValue(0)), QString("pg_catalog"));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void AsyncCommandTest::testCancelCommand()
+{
+	try
+	{
+		AsyncCommand cmd(conn);
+		QSignalSpy spy(&cmd, &AsyncCommand::s_commandFinished);
+
+		cmd.start(Query);
+		cmd.cancel();
+
+		QTRY_COMPARE(spy.count(), 1);
+		QCOMPARE(cmd.getStatus(), AsyncCommand::Cancelled);
+		QVERIFY(!cmd.isRunning());
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void AsyncCommandTest::testFailedCommandDeliversError()
+{
+	try
+	{
+		AsyncCommand cmd(conn);
+		QSignalSpy spy(&cmd, &AsyncCommand::s_commandFinished);
+
+		cmd.start("SELECT 1");
+
+		QTRY_COMPARE(spy.count(), 1);
+		QCOMPARE(cmd.getStatus(), AsyncCommand::Failed);
+		QVERIFY(cmd.getError().getErrorCode() == ErrorCode::QueryNotRecorded);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void AsyncCommandTest::testRaiseExceptionWhenCommandIsRunning()
+{
+	AsyncCommand cmd(conn);
+	QSignalSpy spy(&cmd, &AsyncCommand::s_commandFinished);
+
+	cmd.start(Query);
+
+	try
+	{
+		cmd.start(Query);
+		QFAIL("Expected exception not thrown!");
+	}
+	catch(Exception &e)
+	{
+		QVERIFY(e.getErrorCode() == ErrorCode::AsyncCommandRunning);
+	}
+
+	QTRY_COMPARE(spy.count(), 1);
+}
+
+void AsyncCommandTest::testExecutionTimingsAreCollected()
+{
+	try
+	{
+		AsyncCommand cmd(conn);
+		QSignalSpy spy(&cmd, &AsyncCommand::s_commandFinished);
+
+		cmd.start(Query);
+		QCOMPARE(cmd.getLastByteTime(), qint64(-1));
+
+		QTRY_COMPARE(spy.count(), 1);
+		QCOMPARE(cmd.getStatus(), AsyncCommand::Finished);
+		QVERIFY(cmd.getSendTime() >= 0);
+		QVERIFY(cmd.getFirstByteTime() >= cmd.getSendTime());
+		QVERIFY(cmd.getLastByteTime() >= cmd.getFirstByteTime());
+
+		// The values "public" and "pg_catalog"
+		QCOMPARE(cmd.getReceivedBytes(), qint64(16));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+QTEST_MAIN(AsyncCommandTest)
+#include "asynccommandtest.moc"
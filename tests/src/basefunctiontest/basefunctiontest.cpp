@@ -26,6 +26,9 @@ class BaseFunctionTest: public QObject, public PgModelerUnitTest {
 	private:
 		Q_OBJECT
 
+		//! \brief Configures the function as public.funct_test() returning integer written in SQL
+		void configureFunction(Function &func, Schema &sch, Language &lang);
+
 	public:
 		BaseFunctionTest() : PgModelerUnitTest(SCHEMASDIR) {}
 
@@ -42,8 +45,25 @@ class BaseFunctionTest: public QObject, public PgModelerUnitTest {
 
 		void modelCreatesFunctionWithTransformTypesAndConfigParams();
 		void modelCreatesProcedureWithTransformTypesAndConfigParams();
+
+		void equalFunctionsGenerateNoAlterCommand();
+		void functionAlterCommandHasChangedSecurityType();
+		void functionAlterCommandHasChangedConfigParams();
+		void functionAlterCommandHasChangedCostAndRows();
 };
 
+void BaseFunctionTest::configureFunction(Function &func, Schema &sch, Language &lang)
+{
+	sch.BaseObject::setName("public");
+	lang.BaseObject::setName(DefaultLanguages::Sql);
+
+	func.setName("funct_test");
+	func.setSchema(&sch);
+	func.setLanguage(&lang);
+	func.setReturnType(PgSqlType("integer"));
+	func.setFunctionSource("SELECT 0;");
+}
+
 void BaseFunctionTest::doesntAddDuplicatedTransformType()
 {
 	Function func;
@@ -354,5 +374,125 @@ security-type=\"SECURITY INVOKER\"> \
 	}
 }
 
+void BaseFunctionTest::equalFunctionsGenerateNoAlterCommand()
+{
+	try
+	{
+		Function func1, func2;
+		Schema sch;
+		Language lang;
+
+		configureFunction(func1, sch, lang);
+		func1.setSecurityType(SecurityType(SecurityType::Definer));
+		func1.setConfigurationParam("search_path", "public");
+		func1.setExecutionCost(200);
+
+		configureFunction(func2, sch, lang);
+		func2.setSecurityType(SecurityType(SecurityType::Definer));
+		func2.setConfigurationParam("search_path", "public");
+		func2.setExecutionCost(200);
+
+		QVERIFY(func1.getAlterableAttributes() == func2.getAlterableAttributes());
+		QVERIFY(func1.getAlterCode(&func2).isEmpty());
+	}
+	catch (Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void BaseFunctionTest::functionAlterCommandHasChangedSecurityType()
+{
+	try
+	{
+		Function func1, func2;
+		Schema sch;
+		Language lang;
+		QString alter_cmd;
+
+		configureFunction(func1, sch, lang);
+		configureFunction(func2, sch, lang);
+		func2.setSecurityType(SecurityType(SecurityType::Definer));
+
+		alter_cmd = func1.getAlterCode(&func2).simplified();
+		QVERIFY(alter_cmd.contains("ALTER FUNCTION public.funct_test()"));
+		QVERIFY(alter_cmd.contains("SECURITY DEFINER"));
+		QVERIFY(!alter_cmd.contains("CREATE OR REPLACE"));
+		QVERIFY(!alter_cmd.contains("COST"));
+	}
+	catch (Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void BaseFunctionTest::functionAlterCommandHasChangedConfigParams()
+{
+	try
+	{
+		Function func1, func2;
+		Schema sch;
+		Language lang;
+		QString alter_cmd;
+
+		configureFunction(func1, sch, lang);
+		func1.setConfigurationParam("work_mem", "64MB");
+
+		configureFunction(func2, sch, lang);
+		func2.setConfigurationParam("work_mem", "64MB");
+		func2.setConfigurationParam("search_path", "public");
+
+		alter_cmd = func1.getAlterCode(&func2).simplified();
+		QVERIFY(alter_cmd.contains("SET search_path = public"));
+		QVERIFY(!alter_cmd.contains("work_mem"));
+
+		alter_cmd = func2.getAlterCode(&func1).simplified();
+		QVERIFY(alter_cmd.contains("RESET search_path"));
+		QVERIFY(!alter_cmd.contains("work_mem"));
+
+		// Changing only the value of a parameter must produce the command as well
+		func1.setConfigurationParam("work_mem", "128MB");
+		alter_cmd = func2.getAlterCode(&func1).simplified();
+		QVERIFY(alter_cmd.contains("SET work_mem = 128MB"));
+	}
+	catch (Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void BaseFunctionTest::functionAlterCommandHasChangedCostAndRows()
+{
+	try
+	{
+		Function func1, func2;
+		Schema sch;
+		Language lang;
+		QString alter_cmd;
+
+		configureFunction(func1, sch, lang);
+		configureFunction(func2, sch, lang);
+		func2.setExecutionCost(200);
+
+		alter_cmd = func1.getAlterCode(&func2).simplified();
+		QVERIFY(alter_cmd.contains("COST 200"));
+		QVERIFY(!alter_cmd.contains("ROWS"));
+
+		func1.setReturnSetOf(true);
+		func1.setRowAmount(1000);
+		func2.setReturnSetOf(true);
+		func2.setExecutionCost(100);
+		func2.setRowAmount(500);
+
+		alter_cmd = func1.getAlterCode(&func2).simplified();
+		QVERIFY(alter_cmd.contains("ROWS 500"));
+		QVERIFY(!alter_cmd.contains("COST"));
+	}
+	catch (Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
 QTEST_MAIN(BaseFunctionTest)
 #include "basefunctiontest.moc"
@@ -0,0 +1,247 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "catalogreplayfixture.h"
+#include "resultset.h"
+
+class CatalogRecorderTest: public QObject {
+	private:
+		Q_OBJECT
+
+		static constexpr char RecordingFile[] = "catalog.rec",
+		DbName[] = "testdb",
+		Query[] = "SELECT oid, nspname FROM pg_namespace",
+		ParamQuery[] = "SELECT oid, nspname FROM pg_namespace WHERE nspname = $1";
+
+		//! \brief Values containing quotes and backslashes used as parameters of ParamQuery
+		static const QStringList ParamValues;
+
+		//! \brief Records a result with two tuples (the second one with a null value) in RecordingFile
+		void recordSampleResult();
+
+		//! \brief Records in RecordingFile one result of ParamQuery for each value in ParamValues holding the value itself
+		void recordParameterizedResults();
+
+	private slots:
+		void testReplayRecordedValuesAndNulls();
+		void testRaiseExceptionOnQueryNotRecorded();
+		void testRaiseExceptionOnInvalidRecordingFile();
+		void testConnectionServesResultsFromRecording();
+		void testConnectionServesParameterizedResultsFromRecording();
+};
+
+const QStringList CatalogRecorderTest::ParamValues = { "O'Reilly", "C:\\temp\\", "it''s \\'quoted\\'" };
+
+void CatalogRecorderTest::recordSampleResult()
+{
+	CatalogReplayFixture::recordResults(RecordingFile, DbName, {{ Query, CatalogReplayFixture::createResult(
+		{{ "oid", 26 }, { "nspname", 19 }}, {{ "2200", "public" }, { "16384", QByteArray() }}) }});
+}
+
+void CatalogRecorderTest::recordParameterizedResults()
+{
+	std::vector<std::pair<QString, PGresult *>> results;
+	unsigned oid = 16384;
+
+	for(auto &value : ParamValues)
+	{
+		results.push_back({ CatalogReplayFixture::getParameterizedQuery(ParamQuery, { value }),
+												CatalogReplayFixture::createResult({{ "oid", 26 }, { "nspname", 19 }},
+																													 {{ QByteArray::number(oid++), value.toUtf8() }}) });
+	}
+
+	CatalogReplayFixture::recordResults(RecordingFile, DbName, results);
+}
+
+void CatalogRecorderTest::testReplayRecordedValuesAndNulls()
+{
+	try
+	{
+		CatalogRecorder recorder;
+		PGresult *res = nullptr;
+
+		recordSampleResult();
+		recorder.startReplay(RecordingFile);
+		res = recorder.createResult(DbName, Query);
+
+		QCOMPARE(recorder.getServerVersion(), CatalogReplayFixture::ServerVersion);
+		QCOMPARE(PQresultStatus(res), PGRES_TUPLES_OK);
+		QCOMPARE(PQntuples(res), 2);
+		QCOMPARE(PQnfields(res), 2);
+		QCOMPARE(QString(PQfname(res, 1)), QString("nspname"));
+		QCOMPARE(PQftype(res, 0), static_cast<Oid>(26));
+		QCOMPARE(QString(PQgetvalue(res, 0, 1)), QString("public"));
+		QCOMPARE(QString(PQgetvalue(res, 1, 0)), QString("16384"));
+		QVERIFY(!PQgetisnull(res, 0, 1));
+		QVERIFY(PQgetisnull(res, 1, 1));
+
+		PQclear(res);
+		recorder.stop();
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void CatalogRecorderTest::testRaiseExceptionOnQueryNotRecorded()
+{
+	CatalogRecorder recorder;
+
+	recordSampleResult();
+	recorder.startReplay(RecordingFile);
+
+	try
+	{
+		recorder.createResult("otherdb", Query);
+		QFAIL("Expected exception not thrown!");
+	}
+	catch(Exception &e)
+	{
+		QVERIFY(e.getErrorCode() == ErrorCode::QueryNotRecorded);
+	}
+
+	try
+	{
+		recorder.createResult(DbName, "SELECT 1");
+		QFAIL("Expected exception not thrown!");
+	}
+	catch(Exception &e)
+	{
+		QVERIFY(e.getErrorCode() == ErrorCode::QueryNotRecorded);
+	}
+}
+
+void CatalogRecorderTest::testRaiseExceptionOnInvalidRecordingFile()
+{
+	QFile file("invalid.rec");
+
+	QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+	file.write("not a catalog recording");
+	file.close();
+
+	try
+	{
+		CatalogRecorder recorder;
+		recorder.startReplay("invalid.rec");
+		QFAIL("Expected exception not thrown!");
+	}
+	catch(Exception &e)
+	{
+		QVERIFY(e.getErrorCode() == ErrorCode::InvCatalogRecordingFile);
+	}
+}
+
+void CatalogRecorderTest::testConnectionServesResultsFromRecording()
+{
+	try
+	{
+		attribs_map params = {{ Connection::ParamServerFqdn, "localhost" },
+													{ Connection::ParamDbName, DbName }};
+		Connection conn(params);
+		ResultSet res;
+
+		recordSampleResult();
+		Connection::startReplay(RecordingFile);
+
+		conn.connect();
+		QVERIFY(conn.isStablished());
+		QCOMPARE(conn.getPgSQLVersion(true), QString("15.0"));
+
+		conn.executeDMLCommand(Query, res);
+		QCOMPARE(res.getTupleCount(), 2);
+		QVERIFY(res.accessTuple(ResultSet::FirstTuple));
+		QCOMPARE(res.getColumnValue("nspname"), QString("public"));
+
+		// DDL commands are ignored while replaying
+		conn.executeDDLCommand("CREATE TABLE public.foo (id integer)");
+
+		conn.close();
+		Connection::stopRecording();
+	}
+	catch(Exception &e)
+	{
+		Connection::stopRecording();
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void CatalogRecorderTest::testConnectionServesParameterizedResultsFromRecording()
+{
+	attribs_map params = {{ Connection::ParamServerFqdn, "localhost" },
+												{ Connection::ParamDbName, DbName }};
+	Connection conn(params);
+	ResultSet res;
+
+	try
+	{
+		recordParameterizedResults();
+		Connection::startReplay(RecordingFile);
+		conn.connect();
+
+		// The same command is executed several times (as done with the compiled catalog queries) changing only the parameter
+		for(int round = 0; round < 2; round++)
+		{
+			for(int idx = 0; idx < ParamValues.size(); idx++)
+			{
+				conn.executeDMLCommand(ParamQuery, { ParamValues[idx] }, res);
+				QCOMPARE(res.getTupleCount(), 1);
+				QVERIFY(res.accessTuple(ResultSet::FirstTuple));
+				QCOMPARE(res.getColumnValue("oid"), QString::number(16384 + idx));
+				QCOMPARE(res.getColumnValue("nspname"), ParamValues[idx]);
+			}
+		}
+	}
+	catch(Exception &e)
+	{
+		conn.close();
+		Connection::stopRecording();
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+
+	// The parameters are sent as they are so escaped values or the command without parameters aren't the same command
+	for(auto &param : QStringList { "O''Reilly", "C:\\\\temp\\\\", "" })
+	{
+		try
+		{
+			conn.executeDMLCommand(ParamQuery, { param }, res);
+			QFAIL("Expected exception not thrown!");
+		}
+		catch(Exception &e)
+		{
+			QVERIFY(e.getErrorCode() == ErrorCode::QueryNotRecorded);
+		}
+	}
+
+	try
+	{
+		conn.executeDMLCommand(ParamQuery, res);
+		QFAIL("Expected exception not thrown!");
+	}
+	catch(Exception &e)
+	{
+		QVERIFY(e.getErrorCode() == ErrorCode::QueryNotRecorded);
+	}
+
+	conn.close();
+	Connection::stopRecording();
+}
+
+QTEST_MAIN(CatalogRecorderTest)
+#include "catalogrecordertest.moc"
@@ -0,0 +1,116 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup tests
+\class CatalogReplayFixture
+\brief Builds raw libpq results, stores them in a catalog recording and replays them through connections,
+so the tests of the code that handles query results don't need a running server. The tests using this
+fixture must link against libpq since the results are created with its API.
+*/
+
+#ifndef CATALOG_REPLAY_FIXTURE_H
+#define CATALOG_REPLAY_FIXTURE_H
+
+#include "catalogrecorder.h"
+#include "connection.h"
+#include <QByteArray>
+#include <vector>
+
+class CatalogReplayFixture {
+	public:
+		//! \brief Name and type oid of a column of the results created by createResult()
+		struct ColumnDesc {
+			QByteArray name;
+			Oid type;
+		};
+
+		//! \brief Version of the server stored in the recordings
+		static constexpr int ServerVersion = 150002;
+
+		/*! \brief Creates a result with the provided columns and rows. Null byte arrays in the rows are
+		 * stored as null values. The caller is responsible to free the returned result */
+		static PGresult *createResult(const std::vector<ColumnDesc> &columns, const std::vector<std::vector<QByteArray>> &rows)
+		{
+			PGresult *res = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+			std::vector<PGresAttDesc> attribs(columns.size());
+			std::vector<QByteArray> names;
+
+			for(auto &col : columns)
+				names.push_back(col.name);
+
+			for(unsigned idx = 0; idx < columns.size(); idx++)
+			{
+				attribs[idx] = {};
+				attribs[idx].name = names[idx].data();
+				attribs[idx].typid = columns[idx].type;
+				attribs[idx].typlen = -1;
+				attribs[idx].atttypmod = -1;
+			}
+
+			// The attributes names are copied to the result so the local buffers can be discarded afterwards
+			PQsetResultAttrs(res, attribs.size(), attribs.data());
+
+			for(unsigned row = 0; row < rows.size(); row++)
+			{
+				for(unsigned col = 0; col < rows[row].size(); col++)
+				{
+					QByteArray value = rows[row][col];
+					PQsetvalue(res, row, col, value.isNull() ? nullptr : value.data(), value.isNull() ? -1 : value.size());
+				}
+			}
+
+			return res;
+		}
+
+		/*! \brief Stores the results (second) of the queries (first) executed in the named database in a new recording file.
+		 * The results are freed after being recorded */
+		static void recordResults(const QString &filename, const QString &dbname, const std::vector<std::pair<QString, PGresult *>> &results)
+		{
+			CatalogRecorder recorder;
+
+			recorder.startRecording(filename);
+			recorder.setServerVersion(ServerVersion);
+
+			for(auto &itr : results)
+			{
+				recorder.storeResult(dbname, itr.first, itr.second);
+				PQclear(itr.second);
+			}
+
+			recorder.stop();
+		}
+
+		/*! \brief Returns the text under which the connections record a command executed with parameters
+		 * (see Connection::executeDMLCommand(const QString &, const QStringList &, ResultSet &)) */
+		static QString getParameterizedQuery(const QString &sql, const QStringList &params)
+		{
+			return sql + QChar('\0') + params.join(QChar('\0'));
+		}
+
+		/*! \brief Starts replaying the provided recording and connects the connection to the named database.
+		 * The replay must be finished with Connection::stopRecording() */
+		static void connectReplay(Connection &conn, const QString &filename, const QString &dbname)
+		{
+			Connection::startReplay(filename);
+			conn.setConnectionParams({{ Connection::ParamServerFqdn, "localhost" }, { Connection::ParamDbName, dbname }});
+			conn.connect();
+		}
+};
+
+#endif
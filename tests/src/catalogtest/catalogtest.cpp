@@ -0,0 +1,225 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "catalog.h"
+#include "attributes.h"
+#include "catalogreplayfixture.h"
+#include "resultset.h"
+
+class CatalogTest: public QObject {
+	private:
+		Q_OBJECT
+
+		static constexpr char RecordingFile[] = "catalog.rec",
+		DbName[] = "testdb";
+
+	private slots:
+		void testExtensionObjectsOfLargeInstalls();
+		void testExtensionObjectsDontMatchPartialOids();
+		void testExtensionObjectsOfUnknownExtension();
+		void testCompileScalarAndArrayParameters();
+		void testCompileRepeatedPlaceholders();
+		void testCompileSameShapeWithDifferentValues();
+		void testDontCompileUnexpectedPlaceholderUsage();
+};
+
+void CatalogTest::testExtensionObjectsOfLargeInstalls()
+{
+	Catalog catalog;
+	std::vector<unsigned> postgis_oids, timescale_oids;
+
+	// Simulating a database with PostGIS and TimescaleDB (including its chunks) installed
+	for(unsigned oid = 16384; oid < 16384 + 8000; oid++)
+		postgis_oids.push_back(oid);
+
+	for(unsigned oid = 30000; oid < 30000 + 200000; oid++)
+		timescale_oids.push_back(oid);
+
+	catalog.addExtensionObjects("postgis", postgis_oids);
+	catalog.addExtensionObjects("timescaledb", timescale_oids);
+
+	for(auto &oid : postgis_oids)
+	{
+		QVERIFY(catalog.isExtensionObject(oid));
+		QVERIFY(catalog.isExtensionObject(oid, "postgis"));
+		QVERIFY(!catalog.isExtensionObject(oid, "timescaledb"));
+	}
+
+	for(auto &oid : timescale_oids)
+	{
+		QVERIFY(catalog.isExtensionObject(oid));
+		QVERIFY(catalog.isExtensionObject(oid, "timescaledb"));
+		QVERIFY(!catalog.isExtensionObject(oid, "postgis"));
+	}
+
+	QVERIFY(!catalog.isExtensionObject(16383));
+	QVERIFY(!catalog.isExtensionObject(16384 + 8000));
+	QVERIFY(!catalog.isExtensionObject(30000 + 200000));
+}
+
+void CatalogTest::testExtensionObjectsDontMatchPartialOids()
+{
+	Catalog catalog;
+
+	catalog.addExtensionObjects("postgis", { 123456, 7890 });
+
+	QVERIFY(catalog.isExtensionObject(123456, "postgis"));
+	QVERIFY(catalog.isExtensionObject(7890, "postgis"));
+	QVERIFY(!catalog.isExtensionObject(1234, "postgis"));
+	QVERIFY(!catalog.isExtensionObject(3456));
+	QVERIFY(!catalog.isExtensionObject(789));
+	QVERIFY(!catalog.isExtensionObject(890));
+}
+
+void CatalogTest::testExtensionObjectsOfUnknownExtension()
+{
+	Catalog catalog;
+
+	catalog.addExtensionObjects("hstore", { 20000, 20001 });
+
+	QVERIFY(!catalog.isExtensionObject(20000, "postgis"));
+	QVERIFY(catalog.isExtensionObject(20001, "hstore"));
+	QVERIFY(!catalog.isExtensionObject(0));
+}
+
+void CatalogTest::testCompileScalarAndArrayParameters()
+{
+	attribs_map placeholders = {{ Attributes::FilterOids, "__pgmodeler_param_0__" },
+															{ Attributes::Name, "__pgmodeler_param_1__" },
+															{ Attributes::Schema, "__pgmodeler_param_2__" }};
+	Catalog::CompiledQuery cmp_query;
+
+	cmp_query = Catalog::compileQueryParameters("SELECT oid FROM pg_class WHERE relnamespace::regnamespace::text = '__pgmodeler_param_2__' "
+																							"AND oid IN ( __pgmodeler_param_0__ ) ORDER BY oid", placeholders);
+
+	// The placeholder of the name isn't used in the query so it doesn't consume a parameter
+	QVERIFY(cmp_query.parameterized);
+	QCOMPARE(cmp_query.sql, QString("SELECT oid FROM pg_class WHERE relnamespace::regnamespace::text = $2 AND oid = ANY($1) ORDER BY oid"));
+	QCOMPARE(cmp_query.param_attribs, QStringList({ Attributes::FilterOids, Attributes::Schema }));
+}
+
+void CatalogTest::testCompileRepeatedPlaceholders()
+{
+	attribs_map placeholders = {{ Attributes::Schema, "__pgmodeler_param_0__" },
+															{ Attributes::Table, "__pgmodeler_param_1__" }};
+	Catalog::CompiledQuery cmp_query;
+
+	cmp_query = Catalog::compileQueryParameters("SELECT * FROM a WHERE a.ns = '__pgmodeler_param_0__' AND a.tab = '__pgmodeler_param_1__' "
+																							"UNION SELECT * FROM b WHERE b.ns = '__pgmodeler_param_0__' AND b.tab = '__pgmodeler_param_1__'",
+																							placeholders);
+
+	QVERIFY(cmp_query.parameterized);
+	QCOMPARE(cmp_query.sql, QString("SELECT * FROM a WHERE a.ns = $1 AND a.tab = $2 UNION SELECT * FROM b WHERE b.ns = $1 AND b.tab = $2"));
+	QCOMPARE(cmp_query.param_attribs, QStringList({ Attributes::Schema, Attributes::Table }));
+}
+
+void CatalogTest::testCompileSameShapeWithDifferentValues()
+{
+	attribs_map placeholders = {{ Attributes::Schema, "__pgmodeler_param_0__" }};
+	QString shape = "SELECT oid FROM pg_namespace WHERE nspname = '%1' AND nspname NOT LIKE 'pg_temp%'";
+	Catalog::CompiledQuery cmp_query, cmp_query1;
+
+	cmp_query = Catalog::compileQueryParameters(shape.arg("__pgmodeler_param_0__"), placeholders);
+	cmp_query1 = Catalog::compileQueryParameters(shape.arg("__pgmodeler_param_0__"), placeholders);
+
+	// Queries of the same shape are compiled to the very same command so it can be prepared once and reused
+	QVERIFY(cmp_query.parameterized);
+	QCOMPARE(cmp_query.sql, cmp_query1.sql);
+	QCOMPARE(cmp_query.param_attribs, cmp_query1.param_attribs);
+	QCOMPARE(cmp_query.sql, QString("SELECT oid FROM pg_namespace WHERE nspname = $1 AND nspname NOT LIKE 'pg_temp%'"));
+
+	/* Values containing quotes and backslashes are never part of the compiled query, so a query in which they
+	 * are used inline (as done when the parameters are not in use) is left untouched */
+	for(auto &value : QStringList { "O''Reilly", "C:\\temp\\", "it''s \\''quoted\\''" })
+	{
+		cmp_query1 = Catalog::compileQueryParameters(shape.arg(value), placeholders);
+		QVERIFY(cmp_query1.parameterized);
+		QCOMPARE(cmp_query1.sql, shape.arg(value));
+		QVERIFY(cmp_query1.param_attribs.isEmpty());
+	}
+
+	QStringList values = { "public", "O'Reilly", "C:\\temp\\", "it's \\'quoted\\'" };
+	Connection conn;
+	ResultSet res;
+
+	try
+	{
+		std::vector<std::pair<QString, PGresult *>> results;
+		unsigned oid = 2200;
+
+		for(auto &value : values)
+		{
+			results.push_back({ CatalogReplayFixture::getParameterizedQuery(cmp_query.sql, { value }),
+													CatalogReplayFixture::createResult({{ "oid", 26 }, { "nspname", 19 }},
+																														 {{ QByteArray::number(oid++), value.toUtf8() }}) });
+		}
+
+		CatalogReplayFixture::recordResults(RecordingFile, DbName, results);
+		CatalogReplayFixture::connectReplay(conn, RecordingFile, DbName);
+
+		// The query is compiled and executed once per value as done by the catalog in each call with the same shape
+		for(int idx = 0; idx < values.size(); idx++)
+		{
+			cmp_query1 = Catalog::compileQueryParameters(shape.arg("__pgmodeler_param_0__"), placeholders);
+			conn.executeDMLCommand(cmp_query1.sql, { values[idx] }, res);
+
+			// The statement is prepared in the second execution and the very same one is reused by the further executions
+			QCOMPARE(conn.getPreparedStatement(cmp_query1.sql), idx == 0 ? QByteArray() : QByteArray("pgmodeler_stmt_0"));
+
+			// Each execution returns the rows of its own parameter value
+			QCOMPARE(res.getTupleCount(), 1);
+			QVERIFY(res.accessTuple(ResultSet::FirstTuple));
+			QCOMPARE(res.getColumnValue("oid"), QString::number(2200 + idx));
+			QCOMPARE(res.getColumnValue("nspname"), values[idx]);
+		}
+
+		conn.close();
+		Connection::stopRecording();
+	}
+	catch(Exception &e)
+	{
+		conn.close();
+		Connection::stopRecording();
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void CatalogTest::testDontCompileUnexpectedPlaceholderUsage()
+{
+	attribs_map placeholders = {{ Attributes::Schema, "__pgmodeler_param_0__" },
+															{ Attributes::FilterOids, "__pgmodeler_param_1__" }};
+	Catalog::CompiledQuery cmp_query;
+
+	// Placeholders used inside other literals or expressions can't be replaced by a parameter
+	cmp_query = Catalog::compileQueryParameters("SELECT oid FROM pg_namespace WHERE nspname LIKE '__pgmodeler_param_0__%'", placeholders);
+	QVERIFY(!cmp_query.parameterized);
+	QVERIFY(cmp_query.sql.isEmpty());
+	QVERIFY(cmp_query.param_attribs.isEmpty());
+
+	cmp_query = Catalog::compileQueryParameters("SELECT oid FROM pg_namespace WHERE oid IN (__pgmodeler_param_1__, 2200)", placeholders);
+	QVERIFY(!cmp_query.parameterized);
+	QVERIFY(cmp_query.sql.isEmpty());
+
+	// Array placeholders are only accepted as the sole element of an IN (...) list
+	cmp_query = Catalog::compileQueryParameters("SELECT oid FROM pg_namespace WHERE oid = '__pgmodeler_param_1__'", placeholders);
+	QVERIFY(!cmp_query.parameterized);
+}
+
+QTEST_MAIN(CatalogTest)
+#include "catalogtest.moc"
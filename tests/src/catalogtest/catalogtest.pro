@@ -0,0 +1,3 @@
+include(../../tests.pri)
+unix|windows: LIBS += $$PGSQL_LIB
+SOURCES += catalogtest.cpp
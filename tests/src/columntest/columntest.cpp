@@ -0,0 +1,204 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "table.h"
+#include "schema.h"
+#include "pgmodelerunittest.h"
+
+class ColumnTest: public QObject, public PgModelerUnitTest {
+	private:
+		Q_OBJECT
+
+		Schema schema;
+		Table table;
+
+		//! \brief Configures the column as an integer column named "id" of the test table
+		void configureColumn(Column &col);
+
+	public:
+		ColumnTest() : PgModelerUnitTest(SCHEMASDIR) {}
+
+	private slots:
+		void initTestCase();
+		void equalColumnsGenerateNoAlterCommand();
+		void alterCommandHasChangedType();
+		void alterCommandHasChangedDefaultValue();
+		void alterCommandHasChangedNotNull();
+		void alterCommandHasChangedIdentitySequence();
+		void alterCommandHasChangedComment();
+};
+
+void ColumnTest::initTestCase()
+{
+	schema.BaseObject::setName("public");
+	table.setName("tab");
+	table.setSchema(&schema);
+}
+
+void ColumnTest::configureColumn(Column &col)
+{
+	col.setName("id");
+	col.setType(PgSqlType("integer"));
+	col.setParentTable(&table);
+}
+
+void ColumnTest::equalColumnsGenerateNoAlterCommand()
+{
+	try
+	{
+		Column col1, col2;
+
+		configureColumn(col1);
+		col1.setNotNull(true);
+		col1.setDefaultValue("0");
+		col1.setComment("identifier");
+
+		configureColumn(col2);
+		col2.setNotNull(true);
+		col2.setDefaultValue("0");
+		col2.setComment("identifier");
+
+		QVERIFY(col1.getAlterableAttributes() == col2.getAlterableAttributes());
+		QVERIFY(col1.getAlterCode(&col2).isEmpty());
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void ColumnTest::alterCommandHasChangedType()
+{
+	try
+	{
+		Column col1, col2;
+		QString alter_cmd;
+
+		configureColumn(col1);
+		configureColumn(col2);
+		col2.setType(PgSqlType("bigint"));
+
+		alter_cmd = col1.getAlterCode(&col2).simplified();
+		QVERIFY(alter_cmd.contains("ALTER TABLE public.tab ALTER COLUMN id TYPE bigint"));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void ColumnTest::alterCommandHasChangedDefaultValue()
+{
+	try
+	{
+		Column col1, col2;
+		QString alter_cmd;
+
+		configureColumn(col1);
+		col1.setDefaultValue("0");
+
+		configureColumn(col2);
+		col2.setDefaultValue("10");
+
+		alter_cmd = col1.getAlterCode(&col2).simplified();
+		QVERIFY(alter_cmd.contains("ALTER COLUMN id SET DEFAULT 10"));
+
+		alter_cmd = col2.getAlterCode(&col1).simplified();
+		QVERIFY(alter_cmd.contains("ALTER COLUMN id SET DEFAULT 0"));
+		QVERIFY(!alter_cmd.contains("NOT NULL"));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void ColumnTest::alterCommandHasChangedNotNull()
+{
+	try
+	{
+		Column col1, col2;
+		QString alter_cmd;
+
+		configureColumn(col1);
+		configureColumn(col2);
+		col2.setNotNull(true);
+
+		alter_cmd = col1.getAlterCode(&col2).simplified();
+		QVERIFY(alter_cmd.contains("ALTER COLUMN id SET NOT NULL"));
+		QVERIFY(!alter_cmd.contains("TYPE"));
+
+		alter_cmd = col2.getAlterCode(&col1).simplified();
+		QVERIFY(alter_cmd.contains("ALTER COLUMN id DROP NOT NULL"));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void ColumnTest::alterCommandHasChangedIdentitySequence()
+{
+	try
+	{
+		Column col1, col2;
+		QString alter_cmd;
+
+		configureColumn(col1);
+		col1.setIdentityType(IdentityType(IdentityType::Always));
+		col1.setIdSeqAttributes("1", "100", "1", "1", "1", false);
+
+		configureColumn(col2);
+		col2.setIdentityType(IdentityType(IdentityType::Always));
+		col2.setIdSeqAttributes("1", "200", "1", "1", "1", false);
+
+		alter_cmd = col1.getAlterCode(&col2).simplified();
+		QVERIFY(alter_cmd.contains("SET MAXVALUE 200"));
+		QVERIFY(!alter_cmd.contains("MINVALUE"));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void ColumnTest::alterCommandHasChangedComment()
+{
+	try
+	{
+		Column col1, col2;
+		QString alter_cmd;
+
+		configureColumn(col1);
+		configureColumn(col2);
+		col2.setComment("identifier");
+
+		alter_cmd = col1.getAlterCode(&col2).simplified();
+		QVERIFY(alter_cmd.contains("COMMENT ON COLUMN"));
+		QVERIFY(alter_cmd.contains("identifier"));
+		QVERIFY(!alter_cmd.contains("ALTER TABLE"));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+QTEST_MAIN(ColumnTest)
+#include "columntest.moc"
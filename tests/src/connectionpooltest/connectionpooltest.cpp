@@ -0,0 +1,282 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "connectionpool.h"
+#include "connection.h"
+
+class ConnectionPoolTest: public QObject {
+	private:
+		Q_OBJECT
+
+		static constexpr char ConnStr[] = "host=/nonexistent dbname=testdb connect_timeout=1",
+		OtherConnStr[] = "host=/nonexistent dbname=otherdb connect_timeout=1",
+		ServerId[] = "localhost:5432",
+		OtherServerId[] = "otherhost:5432";
+
+		//! \brief Amount of times the session handlers installed by useFakeSessionHandlers() were called
+		unsigned reset_count, validate_count;
+
+		//! \brief Creates a connection object without reaching any server (its status is never CONNECTION_OK)
+		PGconn *createConnection();
+
+		/*! \brief Replaces the session reset and validation of the pool, which need a server, by functions
+		 * that only count the calls and return the provided values */
+		void useFakeSessionHandlers(bool reset_result, bool validate_result);
+
+	private slots:
+		void cleanup();
+		void testAcquireWithoutIdleConnections();
+		void testReleaseUnmanagedConnection();
+		void testLimitConnectionsPerServer();
+		void testBrokenConnectionIsNotReused();
+		void testZeroLimitDisablesPooling();
+		void testReleasedConnectionIsReused();
+		void testIdleConnectionExpires();
+		void testSessionIsResetBeforeReuse();
+		void testConnectionIsClosedWhenResetFails();
+		void testBrokenIdleConnectionIsDiscarded();
+		void testReusedConnectionDeliversNotices();
+};
+
+PGconn *ConnectionPoolTest::createConnection()
+{
+	return PQconnectStart(ConnStr);
+}
+
+void ConnectionPoolTest::useFakeSessionHandlers(bool reset_result, bool validate_result)
+{
+	reset_count = validate_count = 0;
+
+	ConnectionPool::setSessionHandlers([this, reset_result](PGconn *) {
+		reset_count++;
+		return reset_result;
+	},
+	[this, validate_result](PGconn *) {
+		validate_count++;
+		return validate_result;
+	});
+}
+
+void ConnectionPoolTest::cleanup()
+{
+	ConnectionPool::clear();
+	ConnectionPool::setSessionHandlers(nullptr, nullptr);
+	ConnectionPool::setLimits(60, 8);
+}
+
+void ConnectionPoolTest::testAcquireWithoutIdleConnections()
+{
+	QVERIFY(ConnectionPool::acquire(ConnStr) == nullptr);
+}
+
+void ConnectionPoolTest::testReleaseUnmanagedConnection()
+{
+	PGconn *conn = createConnection();
+
+	QVERIFY(conn != nullptr);
+	QVERIFY(!ConnectionPool::release(conn, ConnStr));
+	PQfinish(conn);
+}
+
+void ConnectionPoolTest::testLimitConnectionsPerServer()
+{
+	PGconn *conn1 = createConnection(), *conn2 = createConnection(),
+			*conn3 = createConnection(), *conn4 = createConnection();
+
+	useFakeSessionHandlers(true, true);
+	ConnectionPool::setLimits(60, 1);
+
+	// The connections opened while the limit is reached are still managed, but only until they're released
+	QVERIFY(ConnectionPool::add(conn1, ServerId));
+	QVERIFY(ConnectionPool::add(conn2, ServerId));
+	QVERIFY(ConnectionPool::add(conn3, OtherServerId));
+	QCOMPARE(ConnectionPool::getConnectionCount(ServerId), 2u);
+
+	QVERIFY(!ConnectionPool::release(conn1, ConnStr));
+	QCOMPARE(ConnectionPool::getConnectionCount(ServerId), 1u);
+	PQfinish(conn1);
+
+	QVERIFY(ConnectionPool::release(conn2, ConnStr));
+	QCOMPARE(ConnectionPool::getIdleConnectionCount(ServerId), 1u);
+
+	// Opening a new connection to a server in the limit closes the oldest idle one (conn2)
+	QVERIFY(ConnectionPool::add(conn4, ServerId));
+	QCOMPARE(ConnectionPool::getConnectionCount(ServerId), 1u);
+	QCOMPARE(ConnectionPool::getIdleConnectionCount(ServerId), 0u);
+	QVERIFY(ConnectionPool::acquire(ConnStr) == nullptr);
+
+	QVERIFY(ConnectionPool::release(conn4, ConnStr));
+	QVERIFY(ConnectionPool::release(conn3, ConnStr));
+	QCOMPARE(ConnectionPool::getConnectionCount(OtherServerId), 1u);
+}
+
+void ConnectionPoolTest::testBrokenConnectionIsNotReused()
+{
+	PGconn *conn = createConnection();
+
+	QVERIFY(ConnectionPool::add(conn, ServerId));
+	QVERIFY(!ConnectionPool::release(conn, ConnStr));
+	QVERIFY(ConnectionPool::acquire(ConnStr) == nullptr);
+	PQfinish(conn);
+}
+
+void ConnectionPoolTest::testZeroLimitDisablesPooling()
+{
+	PGconn *conn = createConnection();
+
+	ConnectionPool::setLimits(60, 0);
+	QVERIFY(!ConnectionPool::add(conn, ServerId));
+	PQfinish(conn);
+}
+
+void ConnectionPoolTest::testReleasedConnectionIsReused()
+{
+	PGconn *conn = createConnection();
+
+	useFakeSessionHandlers(true, true);
+
+	QVERIFY(ConnectionPool::add(conn, ServerId));
+	QVERIFY(ConnectionPool::release(conn, ConnStr));
+	QCOMPARE(ConnectionPool::getIdleConnectionCount(ServerId), 1u);
+
+	// Only the connections opened with the same parameters are reused
+	QVERIFY(ConnectionPool::acquire(OtherConnStr) == nullptr);
+	QCOMPARE(ConnectionPool::acquire(ConnStr), conn);
+	QCOMPARE(ConnectionPool::getIdleConnectionCount(ServerId), 0u);
+	QCOMPARE(ConnectionPool::getConnectionCount(ServerId), 1u);
+
+	// A reused connection can be returned to the pool again
+	QVERIFY(ConnectionPool::release(conn, ConnStr));
+	QCOMPARE(ConnectionPool::acquire(ConnStr), conn);
+	QVERIFY(ConnectionPool::release(conn, ConnStr));
+}
+
+void ConnectionPoolTest::testIdleConnectionExpires()
+{
+	PGconn *conn = createConnection();
+
+	useFakeSessionHandlers(true, true);
+	ConnectionPool::setLimits(1, 8);
+
+	QVERIFY(ConnectionPool::add(conn, ServerId));
+	QVERIFY(ConnectionPool::release(conn, ConnStr));
+	QCOMPARE(ConnectionPool::getIdleConnectionCount(ServerId), 1u);
+
+	// The expired connection is closed by the pool instead of being reused
+	QTest::qWait(1100);
+	QVERIFY(ConnectionPool::acquire(ConnStr) == nullptr);
+	QCOMPARE(ConnectionPool::getConnectionCount(ServerId), 0u);
+	QCOMPARE(validate_count, 0u);
+}
+
+void ConnectionPoolTest::testSessionIsResetBeforeReuse()
+{
+	PGconn *conn = createConnection();
+
+	useFakeSessionHandlers(true, true);
+
+	QVERIFY(ConnectionPool::add(conn, ServerId));
+	QVERIFY(ConnectionPool::release(conn, ConnStr));
+
+	// The session is reset once, when the connection is released, and only validated when reused
+	QCOMPARE(reset_count, 1u);
+	QCOMPARE(validate_count, 0u);
+
+	QCOMPARE(ConnectionPool::acquire(ConnStr), conn);
+	QCOMPARE(reset_count, 1u);
+	QCOMPARE(validate_count, 1u);
+
+	QVERIFY(ConnectionPool::release(conn, ConnStr));
+	QCOMPARE(reset_count, 2u);
+}
+
+void ConnectionPoolTest::testConnectionIsClosedWhenResetFails()
+{
+	PGconn *conn = createConnection();
+
+	useFakeSessionHandlers(false, true);
+
+	QVERIFY(ConnectionPool::add(conn, ServerId));
+	QVERIFY(!ConnectionPool::release(conn, ConnStr));
+	QCOMPARE(reset_count, 1u);
+
+	// The connection is no longer managed by the pool so it's never handed to another user
+	QCOMPARE(ConnectionPool::getConnectionCount(ServerId), 0u);
+	QVERIFY(ConnectionPool::acquire(ConnStr) == nullptr);
+	QCOMPARE(validate_count, 0u);
+	PQfinish(conn);
+}
+
+void ConnectionPoolTest::testBrokenIdleConnectionIsDiscarded()
+{
+	PGconn *conn1 = createConnection(), *conn2 = createConnection();
+
+	useFakeSessionHandlers(true, false);
+
+	QVERIFY(ConnectionPool::add(conn1, ServerId));
+	QVERIFY(ConnectionPool::add(conn2, ServerId));
+	QVERIFY(ConnectionPool::release(conn1, ConnStr));
+	QVERIFY(ConnectionPool::release(conn2, ConnStr));
+
+	// All the idle connections are tried and closed since none of them is valid
+	QVERIFY(ConnectionPool::acquire(ConnStr) == nullptr);
+	QCOMPARE(validate_count, 2u);
+	QCOMPARE(ConnectionPool::getConnectionCount(ServerId), 0u);
+}
+
+void ConnectionPoolTest::testReusedConnectionDeliversNotices()
+{
+	PGconn *conn = createConnection();
+	PGresult *res = nullptr;
+	qsizetype notice_cnt = 0;
+
+	useFakeSessionHandlers(true, true);
+
+	// The first user of the connection doesn't want notices
+	Connection::setNoticeEnabled(false);
+	Connection::configureNoticeOutput(conn);
+	notice_cnt = Connection::getNotices().size();
+
+	// libpq reports the access to a nonexistent tuple as a notice through the notice hooks of the connection
+	res = PQmakeEmptyPGresult(conn, PGRES_TUPLES_OK);
+	PQgetvalue(res, 5, 0);
+	PQclear(res);
+	QCOMPARE(Connection::getNotices().size(), notice_cnt);
+
+	QVERIFY(ConnectionPool::add(conn, ServerId));
+	QVERIFY(ConnectionPool::release(conn, ConnStr));
+	QCOMPARE(ConnectionPool::acquire(ConnStr), conn);
+
+	// The next user wants notices so they're configured again as done by Connection::connect()
+	Connection::setNoticeEnabled(true);
+	Connection::configureNoticeOutput(conn);
+
+	res = PQmakeEmptyPGresult(conn, PGRES_TUPLES_OK);
+	PQgetvalue(res, 5, 0);
+	PQclear(res);
+
+	QCOMPARE(Connection::getNotices().size(), notice_cnt + 1);
+	QVERIFY(Connection::getNotices().last().contains("out of range"));
+
+	Connection::setNoticeEnabled(false);
+	QVERIFY(ConnectionPool::release(conn, ConnStr));
+}
+
+QTEST_MAIN(ConnectionPoolTest)
+#include "connectionpooltest.moc"
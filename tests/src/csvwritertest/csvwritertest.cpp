@@ -0,0 +1,159 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include <QBuffer>
+#include "csvwriter.h"
+#include "csvparser.h"
+#include "utilsns.h"
+
+class CsvWriterTest: public QObject {
+	private:
+		Q_OBJECT
+
+	private slots:
+		void testWrittenFileIsParsedBack();
+		void testWritePlainTextToBuffer();
+		void testWriteRawDataInChunks();
+		void testRaiseExceptionWhenWritingClosedWriter();
+		void testRaiseExceptionOnUnsupportedCompression();
+};
+
+void CsvWriterTest::testWrittenFileIsParsedBack()
+{
+	try
+	{
+		CsvWriter writer;
+		CsvParser parser;
+		CsvDocument csvdoc;
+
+		writer.open("test_writer.csv");
+		writer.writeRow({ "column1", "colu\"mn2", "column;3" });
+		writer.writeRow({ "\"quoted\"", "value \n with break", "" });
+		writer.writeValue("value 1");
+		writer.writeValue("value 2");
+		writer.writeValue("value 3");
+		writer.close();
+
+		QCOMPARE(writer.getRowCount(), 3u);
+
+		parser.setColumnInFirstRow(true);
+		csvdoc = parser.parseFile("test_writer.csv");
+
+		QCOMPARE(csvdoc.getColumnCount(), 3);
+		QCOMPARE(csvdoc.getRowCount(), 2);
+		QCOMPARE(csvdoc.getColumnNames().at(1), "colu\"mn2");
+		QCOMPARE(csvdoc.getColumnNames().at(2), "column;3");
+		QCOMPARE(csvdoc.getValue(0, 0), "\"quoted\"");
+		QCOMPARE(csvdoc.getValue(0, 1), "value \n with break");
+		QCOMPARE(csvdoc.getValue(1, 2), "value 3");
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void CsvWriterTest::testWritePlainTextToBuffer()
+{
+	try
+	{
+		CsvWriter writer;
+		QByteArray data;
+		QBuffer buffer(&data);
+
+		buffer.open(QBuffer::WriteOnly);
+		writer.setSpecialChars('\t', '"', '\n');
+		writer.setDelimitValues(false);
+		writer.open(&buffer);
+		writer.writeRow({ "id", "name" });
+		writer.writeRow({ "1", "açaí \"fruit\"" });
+		writer.close();
+
+		QCOMPARE(QString::fromUtf8(data), QString("id\tname\n1\taçaí \"fruit\"\n"));
+		QCOMPARE(writer.getBytesWritten(), data.size());
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void CsvWriterTest::testWriteRawDataInChunks()
+{
+	try
+	{
+		CsvWriter writer;
+		QByteArray data, row = "\"value\";\"other value\"\n", expected;
+		QBuffer buffer(&data);
+		int rows = (CsvWriter::BufferSize / row.size()) * 3;
+
+		buffer.open(QBuffer::WriteOnly);
+		writer.open(&buffer);
+
+		for(int i = 0; i < rows; i++)
+		{
+			writer.writeRaw(row.constData(), row.size());
+			expected.append(row);
+
+			// Pending data is never bigger than the chunk size plus the last written piece
+			QVERIFY(expected.size() - data.size() < CsvWriter::BufferSize + row.size());
+		}
+
+		writer.close();
+		QCOMPARE(data, expected);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void CsvWriterTest::testRaiseExceptionWhenWritingClosedWriter()
+{
+	try
+	{
+		CsvWriter writer;
+		writer.writeRow({ "value" });
+		QFAIL("Expected exception not thrown!");
+	}
+	catch(Exception &e)
+	{
+		QVERIFY(e.getErrorCode() == ErrorCode::OprNotAllocatedObject);
+	}
+}
+
+void CsvWriterTest::testRaiseExceptionOnUnsupportedCompression()
+{
+	if(CsvWriter::isCompressionSupported())
+		QSKIP("pgModeler was built with gzip compression support.");
+
+	try
+	{
+		CsvWriter writer;
+		writer.open("test_writer.csv.gz", true);
+		QFAIL("Expected exception not thrown!");
+	}
+	catch(Exception &e)
+	{
+		QVERIFY(e.getErrorCode() == ErrorCode::UnsupportedFileCompression);
+	}
+}
+
+QTEST_MAIN(CsvWriterTest)
+#include "csvwritertest.moc"
@@ -0,0 +1,251 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "connection.h"
+
+class DDLCommandsTest: public QObject {
+	private:
+		Q_OBJECT
+
+		//! \brief Commands used by the tests, the ones at indexes 2 and 5 can't be sent in a batch
+		static const QStringList Commands;
+
+		//! \brief Holds the batches, single commands and handled commands (with their error codes) of a call to Connection::runDDLCommands()
+		struct ExecutionLog {
+			QList<QStringList> batches;
+			QStringList single_cmds;
+			QList<int> handled_cmds;
+			QStringList handled_errors;
+		};
+
+		/*! \brief Runs the commands logging each execution. The batch execution (when enabled) succeeds unless batch_err_code is
+		 *  set, and the single command execution fails for the command at index fail_idx raising an error with the provided code */
+		void runCommands(ExecutionLog &log, bool use_batch, bool batch_available,
+										 const QString &batch_err_code, int fail_idx, const QString &cmd_err_code,
+										 const std::function<void(int, Exception *)> &cmd_handler = nullptr);
+
+	private slots:
+		void testDetectSingleStatements();
+		void testDetectCommandsNotAllowedInTransactionBlock();
+		void testDetectReindexNotAllowedInTransactionBlock();
+		void testDetectTransactionControlInCallAndDoBlocks();
+		void testBatchConsecutiveTransactionalCommands();
+		void testExecuteCommandsOneByOneWithoutBatches();
+		void testFallbackToSingleCommandsWhenBatchIsUnavailable();
+		void testMapBatchErrorToFailedCommand();
+		void testStopExecutionWhenHandlerRaisesError();
+		void testRedirectErrorsNotRelatedToCommands();
+};
+
+const QStringList DDLCommandsTest::Commands = {
+	"CREATE SCHEMA foo;",
+	"CREATE TABLE foo.bar (id integer, name text DEFAULT ';');",
+	"CREATE TYPE foo.baz AS (a integer); CREATE TYPE foo.qux AS (b text);",
+	"CREATE FUNCTION foo.f() RETURNS integer AS $$ SELECT 1; $$ LANGUAGE sql;",
+	"-- object: foo.bar_idx | type: INDEX --\nCREATE INDEX bar_idx ON foo.bar (id);",
+	"ALTER TYPE foo.enum_tp ADD VALUE 'c';",
+	"COMMENT ON SCHEMA foo IS 'a;b';"
+};
+
+void DDLCommandsTest::runCommands(ExecutionLog &log, bool use_batch, bool batch_available,
+																	const QString &batch_err_code, int fail_idx, const QString &cmd_err_code,
+																	const std::function<void(int, Exception *)> &cmd_handler)
+{
+	std::function<bool(const QStringList &)> exec_batch;
+
+	if(use_batch)
+	{
+		exec_batch = [&](const QStringList &cmds) {
+			if(!batch_available)
+				return false;
+
+			log.batches.append(cmds);
+
+			if(!batch_err_code.isEmpty())
+				throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted).arg("batch failed"),
+												ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, batch_err_code);
+
+			return true;
+		};
+	}
+
+	Connection::runDDLCommands(Commands, exec_batch, [&](const QString &sql) {
+		log.single_cmds.append(sql);
+
+		if(Commands.indexOf(sql) == fail_idx)
+			throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted).arg("command failed"),
+											ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, cmd_err_code);
+	},
+	[&](int cmd_idx, Exception *e) {
+		log.handled_cmds.append(cmd_idx);
+		log.handled_errors.append(e ? e->getExtraInfo() : QString());
+
+		if(cmd_handler)
+			cmd_handler(cmd_idx, e);
+	});
+}
+
+void DDLCommandsTest::testDetectSingleStatements()
+{
+	QVERIFY(Connection::isSingleStatement(Commands[0]));
+	QVERIFY(Connection::isSingleStatement(Commands[1]));
+	QVERIFY(!Connection::isSingleStatement(Commands[2]));
+	QVERIFY(Connection::isSingleStatement(Commands[3]));
+	QVERIFY(Connection::isSingleStatement(Commands[4]));
+	QVERIFY(Connection::isSingleStatement("CREATE TABLE foo.t (\"a;b\" integer); -- ; trailing comment"));
+	QVERIFY(Connection::isSingleStatement("SELECT E'it\\'s;' /* ; */"));
+}
+
+void DDLCommandsTest::testDetectCommandsNotAllowedInTransactionBlock()
+{
+	QVERIFY(Connection::isTransactionBlockAllowed(Commands[0]));
+	QVERIFY(Connection::isTransactionBlockAllowed(Commands[4]));
+	QVERIFY(!Connection::isTransactionBlockAllowed(Commands[5]));
+	QVERIFY(Connection::isTransactionBlockAllowed("ALTER TYPE foo.tp RENAME TO tp1;"));
+	QVERIFY(Connection::isTransactionBlockAllowed("CREATE FUNCTION foo.g() RETURNS void AS $$ BEGIN VACUUM; END $$ LANGUAGE plpgsql;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("CREATE DATABASE foo;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("create tablespace ts LOCATION '/tmp';"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("/* index */ CREATE UNIQUE INDEX CONCURRENTLY idx ON foo.bar (id);"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("ALTER DATABASE foo SET TABLESPACE ts;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("VACUUM ANALYZE foo.bar;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("-- transaction\nBEGIN;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("COMMIT;"));
+}
+
+void DDLCommandsTest::testDetectReindexNotAllowedInTransactionBlock()
+{
+	QVERIFY(Connection::isTransactionBlockAllowed("REINDEX INDEX foo.bar_idx;"));
+	QVERIFY(Connection::isTransactionBlockAllowed("REINDEX (VERBOSE) TABLE foo.bar;"));
+	QVERIFY(Connection::isTransactionBlockAllowed("REINDEX SCHEMA foo;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("REINDEX DATABASE foo;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("reindex system foo;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("REINDEX (VERBOSE) DATABASE foo;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("REINDEX INDEX CONCURRENTLY foo.bar_idx;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("REINDEX (CONCURRENTLY) TABLE foo.bar;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("REINDEX(TABLESPACE ts, CONCURRENTLY) SCHEMA foo;"));
+}
+
+void DDLCommandsTest::testDetectTransactionControlInCallAndDoBlocks()
+{
+	QVERIFY(Connection::isTransactionBlockAllowed("DO $$ BEGIN PERFORM 1; END $$;"));
+	QVERIFY(Connection::isTransactionBlockAllowed("CREATE PROCEDURE foo.p() AS $$ BEGIN COMMIT; END $$ LANGUAGE plpgsql;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("DO $$ BEGIN INSERT INTO foo.bar VALUES (1); COMMIT; END $$;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("do language plpgsql $body$ begin rollback; end $body$;"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("CALL foo.p();"));
+	QVERIFY(!Connection::isTransactionBlockAllowed("-- procedure\ncall foo.p(1, 'a');"));
+}
+
+void DDLCommandsTest::testBatchConsecutiveTransactionalCommands()
+{
+	ExecutionLog log;
+
+	runCommands(log, true, true, "", -1, "");
+
+	QCOMPARE(log.batches, QList<QStringList>({ Commands.mid(0, 2), Commands.mid(3, 2) }));
+	QCOMPARE(log.single_cmds, QStringList({ Commands[2], Commands[5], Commands[6] }));
+	QCOMPARE(log.handled_cmds, QList<int>({ 0, 1, 2, 3, 4, 5, 6 }));
+	QCOMPARE(log.handled_errors, QStringList(Commands.size(), QString()));
+}
+
+void DDLCommandsTest::testExecuteCommandsOneByOneWithoutBatches()
+{
+	ExecutionLog log;
+
+	runCommands(log, false, false, "", -1, "");
+
+	QVERIFY(log.batches.isEmpty());
+	QCOMPARE(log.single_cmds, Commands);
+	QCOMPARE(log.handled_cmds, QList<int>({ 0, 1, 2, 3, 4, 5, 6 }));
+}
+
+void DDLCommandsTest::testFallbackToSingleCommandsWhenBatchIsUnavailable()
+{
+	ExecutionLog log;
+
+	runCommands(log, true, false, "", -1, "");
+
+	QVERIFY(log.batches.isEmpty());
+	QCOMPARE(log.single_cmds, Commands);
+	QCOMPARE(log.handled_cmds, QList<int>({ 0, 1, 2, 3, 4, 5, 6 }));
+}
+
+void DDLCommandsTest::testMapBatchErrorToFailedCommand()
+{
+	ExecutionLog log;
+
+	// The error in the second batch is ignored by the handler so the remaining commands are still executed
+	runCommands(log, true, true, "42P07", 4, "42P07");
+
+	QCOMPARE(log.batches.size(), 2);
+	QCOMPARE(log.single_cmds, Commands);
+	QCOMPARE(log.handled_cmds, QList<int>({ 0, 1, 2, 3, 4, 5, 6 }));
+	QCOMPARE(log.handled_errors, QStringList({ "", "", "", "", "42P07", "", "" }));
+}
+
+void DDLCommandsTest::testStopExecutionWhenHandlerRaisesError()
+{
+	ExecutionLog log;
+
+	try
+	{
+		runCommands(log, true, true, "42601", 3, "42601", [](int, Exception *e) {
+			if(e)
+				throw *e;
+		});
+
+		QFAIL("The error of the failed command should be raised by the handler!");
+	}
+	catch(Exception &e)
+	{
+		QCOMPARE(e.getErrorCode(), ErrorCode::SQLCommandNotExecuted);
+		QCOMPARE(e.getExtraInfo(), QString("42601"));
+	}
+
+	// The commands of the failed batch are executed again until the failed one, the following ones are never executed
+	QCOMPARE(log.batches, QList<QStringList>({ Commands.mid(0, 2), Commands.mid(3, 2) }));
+	QCOMPARE(log.single_cmds, QStringList({ Commands[0], Commands[1], Commands[2], Commands[3] }));
+	QCOMPARE(log.handled_cmds, QList<int>({ 0, 1, 2, 3 }));
+}
+
+void DDLCommandsTest::testRedirectErrorsNotRelatedToCommands()
+{
+	int handled_cnt = 0;
+
+	try
+	{
+		Connection::runDDLCommands(Commands, [](const QStringList &) -> bool {
+			throw Exception(ErrorCode::ConnectionBroken, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+		},
+		[](const QString &) {},
+		[&](int, Exception *) {
+			handled_cnt++;
+		});
+
+		QFAIL("The connection error should be redirected!");
+	}
+	catch(Exception &e)
+	{
+		// Errors that aren't raised by the commands themselves aren't passed to the handler and no command is executed again
+		QCOMPARE(e.getErrorCode(), ErrorCode::ConnectionBroken);
+		QCOMPARE(handled_cnt, 0);
+	}
+}
+
+QTEST_MAIN(DDLCommandsTest)
+#include "ddlcommandstest.moc"
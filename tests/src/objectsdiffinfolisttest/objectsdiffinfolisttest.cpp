@@ -0,0 +1,176 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "tools/objectsdiffinfolist.h"
+#include "schema.h"
+
+class ObjectsDiffInfoListTest: public QObject {
+	private:
+		Q_OBJECT
+
+		static constexpr unsigned SyntheticInfoCount = 50000;
+
+		std::vector<Schema *> objects;
+
+	private slots:
+		void initTestCase();
+		void cleanupTestCase();
+		void infosPreserveInsertionOrder();
+		void exactMatchConsidersDiffTypeAndObjects();
+		void nonExactMatchIgnoresDiffType();
+		void removingInfoUpdatesIndexes();
+		void lookupsScaleWithManyInfos();
+};
+
+void ObjectsDiffInfoListTest::initTestCase()
+{
+	objects.reserve(SyntheticInfoCount);
+
+	for(unsigned i = 0; i < SyntheticInfoCount; i++)
+		objects.push_back(new Schema);
+}
+
+void ObjectsDiffInfoListTest::cleanupTestCase()
+{
+	for(auto &obj : objects)
+		delete obj;
+
+	objects.clear();
+}
+
+void ObjectsDiffInfoListTest::infosPreserveInsertionOrder()
+{
+	ObjectsDiffInfoList infos;
+	ObjectsDiffInfo::DiffType types[] = { ObjectsDiffInfo::DropObject, ObjectsDiffInfo::CreateObject,
+																				ObjectsDiffInfo::AlterObject, ObjectsDiffInfo::IgnoreObject };
+	unsigned idx = 0;
+
+	for(unsigned i = 0; i < 100; i++)
+		infos.addDiffInfo(ObjectsDiffInfo(types[i % 4], objects[i], nullptr));
+
+	QCOMPARE(infos.size(), static_cast<size_t>(100));
+
+	for(auto &info : infos)
+	{
+		QVERIFY(info.getObject() == objects[idx]);
+		QVERIFY(info.getDiffType() == types[idx % 4]);
+		idx++;
+	}
+
+	for(auto &type : types)
+	{
+		const std::vector<unsigned> &bucket = infos.getDiffInfosIndexes(type);
+
+		QCOMPARE(bucket.size(), static_cast<size_t>(25));
+
+		for(unsigned i = 0; i < bucket.size(); i++)
+		{
+			QVERIFY(infos.getDiffInfo(bucket[i]).getDiffType() == type);
+
+			if(i > 0)
+				QVERIFY(bucket[i] > bucket[i - 1]);
+		}
+	}
+}
+
+void ObjectsDiffInfoListTest::exactMatchConsidersDiffTypeAndObjects()
+{
+	ObjectsDiffInfoList infos;
+
+	infos.addDiffInfo(ObjectsDiffInfo(ObjectsDiffInfo::AlterObject, objects[0], objects[1]));
+
+	QVERIFY(infos.isDiffInfoExists(ObjectsDiffInfo::AlterObject, objects[0], objects[1]));
+	QVERIFY(!infos.isDiffInfoExists(ObjectsDiffInfo::CreateObject, objects[0], objects[1]));
+	QVERIFY(!infos.isDiffInfoExists(ObjectsDiffInfo::AlterObject, objects[0], nullptr));
+	QVERIFY(!infos.isDiffInfoExists(ObjectsDiffInfo::AlterObject, objects[1], objects[0]));
+}
+
+void ObjectsDiffInfoListTest::nonExactMatchIgnoresDiffType()
+{
+	ObjectsDiffInfoList infos;
+
+	infos.addDiffInfo(ObjectsDiffInfo(ObjectsDiffInfo::AlterObject, objects[0], objects[1]));
+
+	QVERIFY(infos.isDiffInfoExists(ObjectsDiffInfo::DropObject, objects[0], nullptr, false));
+	QVERIFY(infos.isDiffInfoExists(ObjectsDiffInfo::AlterObject, nullptr, objects[1], false));
+	QVERIFY(!infos.isDiffInfoExists(ObjectsDiffInfo::AlterObject, nullptr, objects[0], false));
+	QVERIFY(!infos.isDiffInfoExists(ObjectsDiffInfo::AlterObject, objects[1], nullptr, false));
+}
+
+void ObjectsDiffInfoListTest::removingInfoUpdatesIndexes()
+{
+	ObjectsDiffInfoList infos;
+
+	infos.addDiffInfo(ObjectsDiffInfo(ObjectsDiffInfo::DropObject, objects[0], nullptr));
+	infos.addDiffInfo(ObjectsDiffInfo(ObjectsDiffInfo::DropObject, objects[1], nullptr));
+	infos.addDiffInfo(ObjectsDiffInfo(ObjectsDiffInfo::CreateObject, objects[2], nullptr));
+
+	infos.removeDiffInfo(0);
+
+	QCOMPARE(infos.size(), static_cast<size_t>(2));
+	QVERIFY(!infos.isDiffInfoExists(ObjectsDiffInfo::DropObject, objects[0], nullptr));
+	QVERIFY(!infos.isDiffInfoExists(ObjectsDiffInfo::DropObject, objects[0], nullptr, false));
+	QVERIFY(infos.isDiffInfoExists(ObjectsDiffInfo::DropObject, objects[1], nullptr));
+	QCOMPARE(infos.getDiffInfosIndexes(ObjectsDiffInfo::DropObject).size(), static_cast<size_t>(1));
+	QVERIFY(infos.getDiffInfo(infos.getDiffInfosIndexes(ObjectsDiffInfo::DropObject).at(0)).getObject() == objects[1]);
+	QVERIFY(infos.getDiffInfo(infos.getDiffInfosIndexes(ObjectsDiffInfo::CreateObject).at(0)).getObject() == objects[2]);
+}
+
+void ObjectsDiffInfoListTest::lookupsScaleWithManyInfos()
+{
+	ObjectsDiffInfoList infos;
+	ObjectsDiffInfo::DiffType types[] = { ObjectsDiffInfo::DropObject, ObjectsDiffInfo::CreateObject, ObjectsDiffInfo::AlterObject };
+	QElapsedTimer timer;
+
+	timer.start();
+
+	/* Simulating the diff process: before each info is registered the helper
+	 * checks if the same info (or a conflicting one) was already generated */
+	for(unsigned i = 0; i < SyntheticInfoCount; i++)
+	{
+		ObjectsDiffInfo::DiffType type = types[i % 3];
+		Schema *old_obj = (type == ObjectsDiffInfo::AlterObject ? objects[SyntheticInfoCount - i - 1] : nullptr);
+
+		QVERIFY(!infos.isDiffInfoExists(type, objects[i], old_obj));
+		QVERIFY(!infos.isDiffInfoExists(ObjectsDiffInfo::DropObject, objects[i], nullptr));
+		infos.addDiffInfo(ObjectsDiffInfo(type, objects[i], old_obj));
+	}
+
+	for(unsigned i = 0; i < SyntheticInfoCount; i++)
+	{
+		ObjectsDiffInfo::DiffType type = types[i % 3];
+		Schema *old_obj = (type == ObjectsDiffInfo::AlterObject ? objects[SyntheticInfoCount - i - 1] : nullptr);
+
+		QVERIFY(infos.isDiffInfoExists(type, objects[i], old_obj));
+		QVERIFY(infos.isDiffInfoExists(ObjectsDiffInfo::AlterObject, objects[i], nullptr, false));
+	}
+
+	/* With a linear scan per lookup the 200k checks above would perform billions of comparisons,
+	 * so a generous time limit is enough to detect a quadratic regression */
+	QVERIFY2(timer.elapsed() < 5000, qPrintable(QString("Lookups took %1 ms").arg(timer.elapsed())));
+
+	QCOMPARE(infos.size(), static_cast<size_t>(SyntheticInfoCount));
+	QCOMPARE(infos.getDiffInfosIndexes(ObjectsDiffInfo::DropObject).size() +
+					 infos.getDiffInfosIndexes(ObjectsDiffInfo::CreateObject).size() +
+					 infos.getDiffInfosIndexes(ObjectsDiffInfo::AlterObject).size(),
+					 static_cast<size_t>(SyntheticInfoCount));
+}
+
+QTEST_MAIN(ObjectsDiffInfoListTest)
+#include "objectsdiffinfolisttest.moc"
@@ -0,0 +1,153 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "catalogreplayfixture.h"
+#include "resultset.h"
+
+class ResultSetTest: public QObject {
+	private:
+		Q_OBJECT
+
+		static constexpr char RecordingFile[] = "resultset.rec",
+		DbName[] = "testdb",
+		Query[] = "SELECT oid, flag, num, items FROM sample";
+
+		/*! \brief Records a result with the columns oid, flag (bool), num (integer) and items (text[])
+		 * and fills the provided result set by replaying it through a connection */
+		void replaySampleResult(ResultSet &res);
+
+	private slots:
+		void testIterateTuplesWithTypedAccessors();
+		void testParseTextArrays();
+		void testIterateResultWithoutTuples();
+		void testRaiseExceptionOnInvalidTupleIndex();
+};
+
+void ResultSetTest::replaySampleResult(ResultSet &res)
+{
+	Connection conn;
+
+	CatalogReplayFixture::recordResults(RecordingFile, DbName, {{ Query, CatalogReplayFixture::createResult(
+		{{ "oid", 26 }, { "flag", 16 }, { "num", 23 }, { "items", 1009 }},
+		{{ "16384", "t", "-5", "{a,\"b c\",NULL,\"d\\\"e\",\"NULL\"}" },
+		 { "4294967295", "f", "42", "{}" },
+		 { "20000", QByteArray(), "0", "[0:1]={x,y}" }}) }});
+
+	CatalogReplayFixture::connectReplay(conn, RecordingFile, DbName);
+	conn.executeDMLCommand(Query, res);
+	conn.close();
+	Connection::stopRecording();
+}
+
+void ResultSetTest::testIterateTuplesWithTypedAccessors()
+{
+	try
+	{
+		ResultSet res;
+		int oid_col = -1, flag_col = -1, num_col = -1, count = 0;
+
+		replaySampleResult(res);
+		oid_col = res.getColumnIndex("oid");
+		flag_col = res.getColumnIndex("flag");
+		num_col = res.getColumnIndex("num");
+
+		for(auto tuple : res)
+		{
+			QCOMPARE(tuple.getIndex(), count);
+			count++;
+		}
+
+		QCOMPARE(count, 3);
+
+		QCOMPARE(res.getTuple(0).getOid(oid_col), 16384u);
+		QCOMPARE(res.getTuple(1).getOid(oid_col), 4294967295u);
+		QVERIFY(res.getTuple(0).getBool(flag_col));
+		QVERIFY(!res.getTuple(1).getBool(flag_col));
+		QVERIFY(!res.getTuple(2).getBool(flag_col));
+		QVERIFY(res.getTuple(2).isNull(flag_col));
+		QCOMPARE(res.getTuple(2).getText(flag_col), QString());
+		QCOMPARE(res.getTuple(0).getInt(num_col), -5);
+		QCOMPARE(res.getTuple(1).getInt(num_col), 42);
+		QCOMPARE(res.getTuple(0).getText(oid_col), QString("16384"));
+		QCOMPARE(res.getTuple(0).getLength(oid_col), 5);
+
+		// Iterating over the tuples doesn't affect the navigation
+		QVERIFY(res.accessTuple(ResultSet::LastTuple));
+		QCOMPARE(res.getCurrentTuple(), 2);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void ResultSetTest::testParseTextArrays()
+{
+	try
+	{
+		ResultSet res;
+		int items_col = -1;
+
+		replaySampleResult(res);
+		items_col = res.getColumnIndex("items");
+
+		QCOMPARE(res.getTuple(0).getTextArray(items_col), QStringList({ "a", "b c", "", "d\"e", "NULL" }));
+		QCOMPARE(res.getTuple(1).getTextArray(items_col), QStringList());
+		QCOMPARE(res.getTuple(2).getTextArray(items_col), QStringList({ "x", "y" }));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void ResultSetTest::testIterateResultWithoutTuples()
+{
+	ResultSet res;
+	int count = 0;
+
+	for(auto tuple : res)
+	{
+		Q_UNUSED(tuple);
+		count++;
+	}
+
+	QCOMPARE(count, 0);
+	QVERIFY(res.begin() == res.end());
+}
+
+void ResultSetTest::testRaiseExceptionOnInvalidTupleIndex()
+{
+	ResultSet res;
+
+	replaySampleResult(res);
+
+	try
+	{
+		res.getTuple(3);
+		QFAIL("Expected exception not thrown!");
+	}
+	catch(Exception &e)
+	{
+		QVERIFY(e.getErrorCode() == ErrorCode::RefInvalidTuple);
+	}
+}
+
+QTEST_MAIN(ResultSetTest)
+#include "resultsettest.moc"
@@ -30,6 +30,8 @@ class RoleTest: public QObject, public PgModelerUnitTest {
 
 	private slots:
 		void alterCommandEndsWithSemiColon();
+		void equalRolesGenerateNoAlterCommand();
+		void alterCommandOnlyHasChangedAttributes();
 };
 
 void RoleTest::alterCommandEndsWithSemiColon()
@@ -50,5 +52,43 @@ void RoleTest::alterCommandEndsWithSemiColon()
 	QCOMPARE(alter_cmd.endsWith(";"), true);
 }
 
+void RoleTest::equalRolesGenerateNoAlterCommand()
+{
+	Role role1, role2, member;
+
+	member.setName("member");
+
+	role1.setName("role");
+	role1.setOption(Role::OpLogin, true);
+	role1.setValidity("2030-01-01 00:00:00");
+	role1.addRole(Role::MemberRole, &member);
+
+	role2.setName("role");
+	role2.setOption(Role::OpLogin, true);
+	role2.setValidity("2030-01-01 00:00:00");
+	role2.addRole(Role::MemberRole, &member);
+
+	QVERIFY(role1.getAlterableAttributes() == role2.getAlterableAttributes());
+	QVERIFY(role1.getAlterCode(&role2).isEmpty());
+}
+
+void RoleTest::alterCommandOnlyHasChangedAttributes()
+{
+	Role role1, role2;
+	QString alter_cmd;
+
+	role1.setName("role");
+	role1.setOption(Role::OpLogin, true);
+
+	role2.setName("role");
+	role2.setOption(Role::OpLogin, true);
+	role2.setOption(Role::OpCreateDb, true);
+
+	alter_cmd = role1.getAlterCode(&role2);
+	QVERIFY(alter_cmd.contains("CREATEDB"));
+	QVERIFY(!alter_cmd.contains("LOGIN"));
+	QVERIFY(!alter_cmd.contains("RENAME"));
+}
+
 QTEST_MAIN(RoleTest)
 #include "roletest.moc"
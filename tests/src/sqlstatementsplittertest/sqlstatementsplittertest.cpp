@@ -0,0 +1,210 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "sqlstatementsplitter.h"
+
+class SQLStatementSplitterTest: public QObject {
+	private:
+		Q_OBJECT
+
+		//! \brief SQL script that exercises quotes, dollar-quoting, comments and the DDL end token
+		static const QByteArray Script;
+
+		//! \brief Splits the script (fed in chunks of the provided size, or at once if zero) returning the text of each span
+		QStringList splitScript(const QByteArray &script, int chunk_size, bool comments);
+
+	private slots:
+		void testSplitStatementsIgnoringDelimitersInQuotesAndComments();
+		void testSplitStatementsAtDdlEndToken();
+		void testReturnCommentsBetweenStatements();
+		void testSplitScriptFedInChunks();
+		void testReturnUnterminatedStatementAtEndOfInput();
+		void testKeepRuleCommandsInParenthesis();
+		void testKeepSqlStandardFunctionBodies();
+		void testSplitOnlyAtDdlEndToken();
+};
+
+const QByteArray SQLStatementSplitterTest::Script =
+		"-- object: public.foo | type: TABLE --\n"
+		"-- DROP TABLE IF EXISTS public.foo CASCADE;\n"
+		"CREATE TABLE public.foo (a text DEFAULT 'x;''y', \"b;c\" integer); -- trailing\n"
+		"-- ddl-end --\n"
+		"CREATE FUNCTION public.bar() RETURNS integer AS $fn$ SELECT 1; $$ ; $fn$ LANGUAGE sql;\n"
+		"-- ddl-end --\n"
+		"SELECT E'it\\'s;', $1 /* block /* nested; */ ; */;\n"
+		"SELECT 2\n"
+		"-- ddl-end --\r\n"
+		";;\n";
+
+QStringList SQLStatementSplitterTest::splitScript(const QByteArray &script, int chunk_size, bool comments)
+{
+	SQLStatementSplitter splitter;
+	SQLStatementSplitter::Span span;
+	QStringList spans;
+	qsizetype pos = 0;
+
+	splitter.setCommentsEnabled(comments);
+
+	if(chunk_size <= 0)
+		splitter.setBuffer(script);
+
+	while(!splitter.atEnd())
+	{
+		if(splitter.nextSpan(span))
+			spans.append(splitter.getSpanText(span));
+		else if(pos < script.size())
+		{
+			splitter.appendData(QByteArrayView(script.constData() + pos, std::min<qsizetype>(chunk_size, script.size() - pos)));
+			pos += chunk_size;
+		}
+		else
+			splitter.finishInput();
+	}
+
+	return spans;
+}
+
+void SQLStatementSplitterTest::testSplitStatementsIgnoringDelimitersInQuotesAndComments()
+{
+	QStringList spans = splitScript(Script, 0, false);
+
+	QCOMPARE(spans.size(), 4);
+	QCOMPARE(spans[0], QString("CREATE TABLE public.foo (a text DEFAULT 'x;''y', \"b;c\" integer);"));
+	QCOMPARE(spans[1], QString("CREATE FUNCTION public.bar() RETURNS integer AS $fn$ SELECT 1; $$ ; $fn$ LANGUAGE sql;"));
+	QCOMPARE(spans[2], QString("SELECT E'it\\'s;', $1 /* block /* nested; */ ; */;"));
+}
+
+void SQLStatementSplitterTest::testSplitStatementsAtDdlEndToken()
+{
+	SQLStatementSplitter splitter;
+	SQLStatementSplitter::Span span;
+	QList<SQLStatementSplitter::SpanEnd> ends;
+
+	splitter.setBuffer(Script);
+
+	while(splitter.nextSpan(span))
+		ends.append(span.end);
+
+	QCOMPARE(ends, QList<SQLStatementSplitter::SpanEnd>({ SQLStatementSplitter::Semicolon, SQLStatementSplitter::Semicolon,
+																												SQLStatementSplitter::Semicolon, SQLStatementSplitter::DdlEndToken }));
+	QCOMPARE(splitter.getSpanText(span), QString("SELECT 2"));
+	QVERIFY(splitter.atEnd());
+	QCOMPARE(splitter.getProcessedSize(), Script.size());
+}
+
+void SQLStatementSplitterTest::testReturnCommentsBetweenStatements()
+{
+	QStringList spans = splitScript(Script, 0, true);
+
+	QCOMPARE(spans.size(), 7);
+	QCOMPARE(spans[0], QString("-- object: public.foo | type: TABLE --"));
+	QCOMPARE(spans[1], QString("-- DROP TABLE IF EXISTS public.foo CASCADE;"));
+	QCOMPARE(spans[3], QString("-- trailing"));
+}
+
+void SQLStatementSplitterTest::testSplitScriptFedInChunks()
+{
+	QStringList spans = splitScript(Script, 0, true);
+
+	for(int chunk_size : { 1, 2, 3, 7, 64 })
+		QCOMPARE(splitScript(Script, chunk_size, true), spans);
+}
+
+void SQLStatementSplitterTest::testReturnUnterminatedStatementAtEndOfInput()
+{
+	SQLStatementSplitter splitter;
+	SQLStatementSplitter::Span span;
+
+	splitter.appendData("SELECT 1; SELECT 'unterminated;");
+	QVERIFY(splitter.nextSpan(span));
+	QCOMPARE(splitter.getSpanText(span), QString("SELECT 1;"));
+
+	// The second statement is only returned when the input is finished
+	QVERIFY(!splitter.nextSpan(span));
+	splitter.finishInput();
+
+	QVERIFY(splitter.nextSpan(span));
+	QCOMPARE(splitter.getSpanText(span), QString("SELECT 'unterminated;"));
+	QVERIFY(span.end == SQLStatementSplitter::EndOfInput);
+	QVERIFY(splitter.atEnd());
+}
+
+void SQLStatementSplitterTest::testKeepRuleCommandsInParenthesis()
+{
+	QByteArray script = "CREATE RULE r AS ON INSERT TO public.t DO ALSO (INSERT INTO public.log VALUES (1, ';'); UPDATE public.c SET n = n + 1);\n"
+											"SELECT (1));\n"
+											"SELECT 2;";
+	QStringList spans = splitScript(script, 0, false);
+
+	QCOMPARE(spans.size(), 3);
+	QCOMPARE(spans[0], QString("CREATE RULE r AS ON INSERT TO public.t DO ALSO (INSERT INTO public.log VALUES (1, ';'); UPDATE public.c SET n = n + 1);"));
+
+	// Unbalanced closing parenthesis don't prevent the further statements from being split
+	QCOMPARE(spans[1], QString("SELECT (1));"));
+	QCOMPARE(spans[2], QString("SELECT 2;"));
+}
+
+void SQLStatementSplitterTest::testKeepSqlStandardFunctionBodies()
+{
+	QByteArray script = "CREATE FUNCTION public.f(a integer) RETURNS integer LANGUAGE sql\n"
+											"BEGIN ATOMIC\n"
+											"  SELECT CASE WHEN a > 0 THEN 1 ELSE 0 END;\n"
+											"  SELECT a; -- ; end\n"
+											"END;\n"
+											"CREATE TABLE public.t (begin integer, atomic text);\n"
+											"BEGIN; COMMIT;";
+	QStringList spans = splitScript(script, 0, false);
+
+	QCOMPARE(spans.size(), 4);
+	QVERIFY(spans[0].startsWith("CREATE FUNCTION public.f(a integer)"));
+	QVERIFY(spans[0].endsWith("END;"));
+	QCOMPARE(spans[1], QString("CREATE TABLE public.t (begin integer, atomic text);"));
+	QCOMPARE(spans[2], QString("BEGIN;"));
+	QCOMPARE(spans[3], QString("COMMIT;"));
+
+	// Keywords split between chunks are handled as a whole
+	for(int chunk_size : { 1, 2, 5 })
+		QCOMPARE(splitScript(script, chunk_size, false), spans);
+}
+
+void SQLStatementSplitterTest::testSplitOnlyAtDdlEndToken()
+{
+	SQLStatementSplitter splitter;
+	SQLStatementSplitter::Span span;
+	QStringList spans;
+
+	splitter.setDdlEndTokenOnly(true);
+	splitter.setBuffer("CREATE TABLE public.a (id integer);\n"
+										 "CREATE TABLE public.b (id integer);\n"
+										 "-- ddl-end --\n"
+										 "SELECT (1;\n"
+										 "-- ddl-end --\n"
+										 "ALTER TABLE public.a OWNER TO postgres;\n");
+
+	while(splitter.nextSpan(span))
+		spans.append(splitter.getSpanText(span));
+
+	// Statements delimited by the DDL end token are returned as a whole, even with unbalanced parenthesis
+	QCOMPARE(spans, QStringList({ "CREATE TABLE public.a (id integer);\nCREATE TABLE public.b (id integer);",
+																"SELECT (1;",
+																"ALTER TABLE public.a OWNER TO postgres;" }));
+}
+
+QTEST_MAIN(SQLStatementSplitterTest)
+#include "sqlstatementsplittertest.moc"
@@ -0,0 +1,157 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2023 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "table.h"
+#include "schema.h"
+#include "pgmodelerunittest.h"
+
+class TableTest: public QObject, public PgModelerUnitTest {
+	private:
+		Q_OBJECT
+
+		Schema schema;
+
+	public:
+		TableTest() : PgModelerUnitTest(SCHEMASDIR) {}
+
+	private slots:
+		void initTestCase();
+		void equalTablesGenerateNoAlterCommand();
+		void alterCommandHasChangedUnlogged();
+		void alterCommandHasChangedRLS();
+		void alterCommandHasChangedComment();
+};
+
+void TableTest::initTestCase()
+{
+	schema.BaseObject::setName("public");
+}
+
+void TableTest::equalTablesGenerateNoAlterCommand()
+{
+	try
+	{
+		Table tab1, tab2;
+
+		tab1.setName("tab");
+		tab1.setSchema(&schema);
+		tab1.setUnlogged(true);
+		tab1.setRLSEnabled(true);
+
+		tab2.setName("tab");
+		tab2.setSchema(&schema);
+		tab2.setUnlogged(true);
+		tab2.setRLSEnabled(true);
+
+		QVERIFY(tab1.getAlterableAttributes() == tab2.getAlterableAttributes());
+		QVERIFY(tab1.getAlterCode(&tab2).isEmpty());
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void TableTest::alterCommandHasChangedUnlogged()
+{
+	try
+	{
+		Table tab1, tab2;
+		QString alter_cmd;
+
+		tab1.setName("tab");
+		tab1.setSchema(&schema);
+
+		tab2.setName("tab");
+		tab2.setSchema(&schema);
+		tab2.setUnlogged(true);
+
+		alter_cmd = tab1.getAlterCode(&tab2).simplified();
+		QVERIFY(alter_cmd.contains("ALTER TABLE public.tab SET UNLOGGED"));
+		QVERIFY(!alter_cmd.contains("ROW LEVEL SECURITY"));
+
+		alter_cmd = tab2.getAlterCode(&tab1).simplified();
+		QVERIFY(alter_cmd.contains("ALTER TABLE public.tab SET LOGGED"));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void TableTest::alterCommandHasChangedRLS()
+{
+	try
+	{
+		Table tab1, tab2;
+		QString alter_cmd;
+
+		tab1.setName("tab");
+		tab1.setSchema(&schema);
+
+		tab2.setName("tab");
+		tab2.setSchema(&schema);
+		tab2.setRLSEnabled(true);
+
+		alter_cmd = tab1.getAlterCode(&tab2).simplified();
+		QVERIFY(alter_cmd.contains("ALTER TABLE public.tab ENABLE ROW LEVEL SECURITY"));
+		QVERIFY(!alter_cmd.contains("FORCE"));
+
+		tab1.setRLSEnabled(true);
+		tab2.setRLSForced(true);
+
+		alter_cmd = tab1.getAlterCode(&tab2).simplified();
+		QVERIFY(alter_cmd.contains("ALTER TABLE public.tab FORCE ROW LEVEL SECURITY"));
+		QVERIFY(!alter_cmd.contains("ENABLE"));
+
+		alter_cmd = tab2.getAlterCode(&tab1).simplified();
+		QVERIFY(alter_cmd.contains("ALTER TABLE public.tab NO FORCE ROW LEVEL SECURITY"));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void TableTest::alterCommandHasChangedComment()
+{
+	try
+	{
+		Table tab1, tab2;
+		QString alter_cmd;
+
+		tab1.setName("tab");
+		tab1.setSchema(&schema);
+
+		tab2.setName("tab");
+		tab2.setSchema(&schema);
+		tab2.setComment("a table");
+
+		alter_cmd = tab1.getAlterCode(&tab2).simplified();
+		QVERIFY(alter_cmd.contains("COMMENT ON TABLE"));
+		QVERIFY(alter_cmd.contains("a table"));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+QTEST_MAIN(TableTest)
+#include "tabletest.moc"
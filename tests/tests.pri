@@ -26,7 +26,8 @@ DEPENDPATH += $$LIBGUI_ROOT \
 	      $$LIBUTILS_ROOT \
 	      $$PWD/src
 
-HEADERS += $$PWD/src/pgmodelerunittest.h
+HEADERS += $$PWD/src/pgmodelerunittest.h \
+	   $$PWD/src/catalogreplayfixture.h
 
 # Deployment settings
 target.path = $$BINDIR/tests
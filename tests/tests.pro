@@ -18,3 +18,14 @@ src/xmlparsertest \
 src/proceduretest \
 src/basefunctiontest \
 src/csvparsertest \
+src/csvwritertest \
+src/objectsdiffinfolisttest \
+src/catalogrecordertest \
+src/catalogtest \
+src/resultsettest \
+src/asynccommandtest \
+src/connectionpooltest \
+src/sqlstatementsplittertest \
+src/ddlcommandstest \
+src/columntest \
+src/tabletest \